@@ -2,15 +2,18 @@
 #include "model.h"
 
 
-void model(double *xpar, double input[NTSTEP1][NINPUT], double out[NTSTEP2][NINPUT], 
-	   int flag, float mean_streamflow, ResCar_ptr rescar_ptr,
-	   char outfilename[MAX_FNAME_LEN]) {
+/* returns the number of days simulated, less than NTSTEP1 if the
+   simulation was ended by stop (see Reservoir) */
+int model(double *xpar, double input[NTSTEP1][NINPUT], double out[NTSTEP2][NINPUT], 
+	  int flag, float mean_streamflow, ResCar_ptr rescar_ptr,
+	  char outfilename[MAX_FNAME_LEN],
+	  int (*stop)(void *, int, double), void *stoparg) {
 
      int i, j;
      struct OUTPUT output;
      struct OBS obs;
      double tmp;
-     int tw;
+     int tw, nsim;
 
      tw = NTSTEP1-NTSTEP2;    /* steps of warm-up period */
 
@@ -27,11 +30,13 @@ void model(double *xpar, double input[NTSTEP1][NINPUT], double out[NTSTEP2][NINP
 
      obs.datalength = NTSTEP1;
 
-     Reservoir(xpar,&obs,&output,flag,mean_streamflow,rescar_ptr,outfilename); /* CALL to reservoir */
+     nsim = Reservoir(xpar,&obs,&output,flag,mean_streamflow,rescar_ptr,outfilename,
+		      stop,stoparg); /* CALL to reservoir */
 
-     for (i=0;i<NTSTEP1;i++) {
+     for (i=0;i<nsim;i++) {
        out[i][0] = output.Qcomp_total[i][0];
        out[i][1] = output.Qcomp_total[i][1];
      }
-     
+
+     return nsim;
 }
@@ -14,10 +14,16 @@
 int Reservoir(double *xpar,struct OBS *obs,
 	      struct OUTPUT *output, int flag,
 	      float mean_streamflow, ResCar_ptr rescar_ptr, 
-	      char outfilename[MAX_FNAME_LEN]) {
+	      char outfilename[MAX_FNAME_LEN],
+	      int (*stop)(void *, int, double), void *stoparg) {
+
+  /* stop (may be NULL) is called with stoparg after each day; when it
+     returns nonzero the remaining days are not simulated. Returns the
+     number of days simulated, whose results are in output */
 
   FILE *fd,*fm,*fy;
   int i,j;
+  int nsim;
   int mm,dd;
   int years,startyear,year,month,day;
   int ndays;
@@ -83,6 +89,7 @@ int Reservoir(double *xpar,struct OBS *obs,
   }
   waterdemand_mean=waterdemand_accumulated[NTSTEP1-1]/NTSTEP1;
   
+  nsim=NTSTEP1;
   for(i=0;i<NTSTEP1;i++) {
     mm=obs->Month[i];
     dd=obs->Day[i];
@@ -159,6 +166,11 @@ int Reservoir(double *xpar,struct OBS *obs,
     OUTPUT[i][3]=power_prod; //power_prod, in MW
     OUTPUT[i][4]=spill; //spill, in m3day-1
     OUTPUT[i][5]=mean_flood; //mean annual flood, in m3day-1
+
+    if(stop!=NULL && stop(stoparg,i,OUTPUT[i][0])) {
+      nsim=i+1;
+      break;
+    }
   }
 
   if(flag==1) {  //i.e final simulation, after optimization
@@ -185,25 +197,25 @@ int Reservoir(double *xpar,struct OBS *obs,
   }
 
   if(rescar_ptr->ObjectiveFunction==5) { //Pow 
-    for (i=0;i<NTSTEP1;i++) {
+    for (i=0;i<nsim;i++) {
       output->Qcomp_total[i][0] = OUTPUT[i][0]; //outflow, m3day-1
       output->Qcomp_total[i][1] = OUTPUT[i][3]; //power_prod
     }
   }
   if(rescar_ptr->ObjectiveFunction==6) { //Irr 
-    for (i=0;i<NTSTEP1;i++) {
+    for (i=0;i<nsim;i++) {
       output->Qcomp_total[i][0] = OUTPUT[i][0]; //outflow, m3day-1
       output->Qcomp_total[i][1] = OUTPUT[i][1]; //waterdemand+minflow, m3day-1
     }
   }
   if(rescar_ptr->ObjectiveFunction==7) { //Flood 
-    for (i=0;i<NTSTEP1;i++) {
+    for (i=0;i<nsim;i++) {
       output->Qcomp_total[i][0] = OUTPUT[i][0]; //outflow, m3day-1
       output->Qcomp_total[i][1] = mean_flood; //mean annual flood, m3 day-1
     }
   }
   if(rescar_ptr->ObjectiveFunction==9) { //Wat
-    for (i=0;i<NTSTEP1;i++) {
+    for (i=0;i<nsim;i++) {
       output->Qcomp_total[i][0] = OUTPUT[i][0]; //outflow, m3day-1
       output->Qcomp_total[i][1] = mean_streamflow; //mean annual flow
     }
@@ -228,6 +240,6 @@ int Reservoir(double *xpar,struct OBS *obs,
   free(OUTPUT);
   free(demand);
 
-  return 0;
+  return nsim;
 }
 
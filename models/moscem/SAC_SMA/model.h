@@ -75,6 +75,7 @@ int ReservoirWat(double *xpar,struct OBS *obs,
 int Reservoir(double *xpar,struct OBS *obs,
 	      struct OUTPUT *output,int flag,
 	      float mean_streamflow,ResCar_ptr rescar_ptr,
-	      char outfilename[MAX_FNAME_LEN]);
+	      char outfilename[MAX_FNAME_LEN],
+	      int (*stop)(void *, int, double), void *stoparg);
 int DaysOfMonth(int month);
 #endif
@@ -1,42 +1,133 @@
 /*================================ AddToList.c =============================
+      InitSeqList: allocate the sequences of all complexes
       AddSeqList: add new points to sequences
+      InitCvgList: allocate the list of convergence values
       AddCvgList: add convergence values to a list for records
 
+      The sequences and the convergence list are contiguous arrays that
+      grow by doubling, so any point can be reached by index. Each
+      sequence keeps the running mean and sum of squared deviations of
+      its parameters over the window used by Gelman (the last half of
+      the sequence), updated in constant time per point.
+
       Yuqiong Liu        March 2003
 ============================================================================*/
 
-
+#include <stdlib.h>
 #include "constant.h"
 #include "datatype.h"
+#include "utility.h"
 #include "moscem.h"
 
-void AddSeqList(int i, SeqList_ptr NewPoint) {
+#define INIT_LIST_SIZE 64
 
-     int j;
-     if (SeqHead[i] == NULL) {
-	 SeqHead[i] = NewPoint;
-         SeqHead[i]->Index = 0;
-	 SeqTail[i] = SeqHead[i];
+static void WinAdd(SeqList_ptr seq, double *par, int n);
+static void WinRemove(SeqList_ptr seq, double *par, int n);
+
+void InitSeqList(int n, int npar, int nobj) {
+
+     int i;
+
+     Seq = (SeqList_ptr) malloc(n*sizeof(SeqList));
+     if (!Seq) PrintError("allocation failure in InitSeqList()");
+     for (i=0; i<n; i++) {
+         Seq[i].Index     = 0;
+         Seq[i].Size      = INIT_LIST_SIZE;
+         Seq[i].nPar      = npar;
+         Seq[i].nObj      = nobj;
+         Seq[i].ParValue  = DoubleVector(INIT_LIST_SIZE*npar);
+         Seq[i].ObjValue  = DoubleVector(INIT_LIST_SIZE*nobj);
+         Seq[i].ProbValue = DoubleVector(INIT_LIST_SIZE);
+         Seq[i].WinStart  = 0;
+         Seq[i].WinMean   = DoubleVector(npar);
+         Seq[i].WinM2     = DoubleVector(npar);
+     }
+}
+
+void AddSeqList(int i, double *par, double *obj, double prob) {
+
+     int j, k, start;
+     SeqList_ptr seq;
+
+     seq = &Seq[i];
+     if (seq->Index == seq->Size) {
+         seq->Size *= 2;
+         seq->ParValue  = (double *)realloc(seq->ParValue, seq->Size*seq->nPar*sizeof(double));
+         seq->ObjValue  = (double *)realloc(seq->ObjValue, seq->Size*seq->nObj*sizeof(double));
+         seq->ProbValue = (double *)realloc(seq->ProbValue, seq->Size*sizeof(double));
+         if (!seq->ParValue || !seq->ObjValue || !seq->ProbValue)
+             PrintError("allocation failure in AddSeqList()");
      }
-     else {
-         SeqTail[i]->Next = NewPoint;
-	 SeqTail[i] = SeqTail[i]->Next;
+
+     k = seq->Index;
+     for (j=0; j<seq->nPar; j++) seq->ParValue[k*seq->nPar+j] = par[j];
+     for (j=0; j<seq->nObj; j++) seq->ObjValue[k*seq->nObj+j] = obj[j];
+     seq->ProbValue[k] = prob;
+     seq->Index++;
+
+/* -------- move the Gelman window: last half of the sequence, or all of it
+            for short sequences (see Gelman.c) ------------------------------ */
+     WinAdd(seq, SeqPar(i, k), seq->Index - seq->WinStart);
+     if (seq->Index > 10) start = seq->Index/2 + seq->Index%2;
+     else start = 0;
+     while (seq->WinStart < start) {
+         WinRemove(seq, SeqPar(i, seq->WinStart), seq->Index - seq->WinStart - 1);
+         seq->WinStart++;
      }
-     SeqHead[i]->Index++;
 }
 
-void AddCvgList(CvgList_ptr NewPoint) {
+/* add a point to the window, n is the window length including the point */
+static void WinAdd(SeqList_ptr seq, double *par, int n) {
 
      int j;
-     if (CvgHead == NULL) {
-         CvgHead = NewPoint;
-         CvgHead->Index = 0;
-         CvgTail = CvgHead;
+     double delta;
+
+     for (j=0; j<seq->nPar; j++) {
+         delta = par[j] - seq->WinMean[j];
+         seq->WinMean[j] += delta/n;
+         seq->WinM2[j] += delta*(par[j] - seq->WinMean[j]);
      }
-     else {
-         CvgTail->Next = NewPoint;
-         CvgTail = CvgTail->Next;
+}
+
+/* remove a point from the window, n is the window length without the point */
+static void WinRemove(SeqList_ptr seq, double *par, int n) {
+
+     int j;
+     double delta;
+
+     for (j=0; j<seq->nPar; j++) {
+         if (n == 0) {
+             seq->WinMean[j] = 0.;
+             seq->WinM2[j] = 0.;
+             continue;
+         }
+         delta = par[j] - seq->WinMean[j];
+         seq->WinMean[j] -= delta/n;
+         seq->WinM2[j] -= delta*(par[j] - seq->WinMean[j]);
      }
-     CvgHead->Index++;
 }
 
+void InitCvgList(int npar) {
+
+     Cvg.Index = 0;
+     Cvg.Size  = INIT_LIST_SIZE;
+     Cvg.nPar  = npar;
+     Cvg.Iter  = IntVector(INIT_LIST_SIZE);
+     Cvg.Convergence = DoubleVector(INIT_LIST_SIZE*npar);
+}
+
+void AddCvgList(int iter, double *converg) {
+
+     int j;
+
+     if (Cvg.Index == Cvg.Size) {
+         Cvg.Size *= 2;
+         Cvg.Iter = (int *)realloc(Cvg.Iter, Cvg.Size*sizeof(int));
+         Cvg.Convergence = (double *)realloc(Cvg.Convergence, Cvg.Size*Cvg.nPar*sizeof(double));
+         if (!Cvg.Iter || !Cvg.Convergence)
+             PrintError("allocation failure in AddCvgList()");
+     }
+     Cvg.Iter[Cvg.Index] = iter;
+     for (j=0; j<Cvg.nPar; j++) Cvg.Convergence[Cvg.Index*Cvg.nPar+j] = converg[j];
+     Cvg.Index++;
+}
@@ -26,7 +26,7 @@ void CompObj(Moscem *moscem, Data_ptr data_ptr, Parameter_ptr par_ptr,
         control = ParControl(moscem, par_ptr, xpar);   /*check for mutual consistency */
 		if (control == -1)   for(j=0; j<moscem->nFluxes; j++) data_ptr->ObjValue[i][j] = INF;
         else  {
-	    DriveModel(moscem,xpar,data_ptr,rescar_ptr,files);
+	    DriveModel(moscem,xpar,data_ptr,rescar_ptr,files,NULL,NULL);
 	    ObjFunc(moscem, data_ptr->Output,data_ptr->ValData,data_ptr->ObjValue[i], 
 		    &(data_ptr->Iter),mean_streamflow,rescar_ptr);
 	    //for (j=0; j<moscem->nFluxes; j++) printf("compobj objvalue %12.3E",data_ptr->ObjValue[i][j]); 
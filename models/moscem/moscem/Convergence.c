@@ -1,6 +1,10 @@
 /*===================================================================
 Call "Gelman" to calculate the convergence and check if it meets
-the convergence criteria
+the convergence criteria. With Gelman_Stop, the sequences have
+converged as soon as the Gelman-Rubin criterion holds for every
+parameter once the sequences are long enough for the half-sequence
+window (more than 10 points); otherwise the criterion must also
+have been stable over the last NL records.
 
 Yuqiong Liu, March  2003
 ====================================================================*/ 
@@ -18,7 +22,6 @@ int Convergence(Moscem *moscem, int iter) {
 
      int i, j,flag;
      double *converg, *tmp, *max_conv, *min_conv, *delConv, max_delconv;
-     CvgList_ptr cvg_ptr, tmp_ptr;
 
      converg = DoubleVector(moscem->nOptPar);
      tmp = DoubleVector(NL); 
@@ -26,23 +29,19 @@ int Convergence(Moscem *moscem, int iter) {
      min_conv = DoubleVector(moscem->nOptPar);
      delConv = DoubleVector(moscem->nOptPar);
 
-     cvg_ptr = (CvgList_ptr)malloc(sizeof(*cvg_ptr));
-     cvg_ptr->Convergence = DoubleVector(moscem->nOptPar);
-     cvg_ptr->Next = NULL;
-
      Gelman(moscem->nOptPar, moscem->nComplex, converg);
  
-     for (i=0; i<moscem->nOptPar; i++) cvg_ptr->Convergence[i] = converg[i]; 
-     cvg_ptr->Iter = iter;
-     AddCvgList(cvg_ptr);
+     AddCvgList(iter, converg);
 
-     if (CvgHead->Index >= NL)  {
+     if (moscem->GelmanStop == 1 && Seq[0].Index > 10) {
+         flag = 0;
+         for(i=0; i<moscem->nOptPar; i++)
+             if (converg[i] >= 1.2) { flag = -1; break; }
+     }
+     else if (Cvg.Index >= NL)  {
          for(i=0; i<moscem->nOptPar; i++)  {
-             tmp_ptr = CvgHead;
-             for (j=0; j<CvgHead->Index; j++) {
-                 if (j>=CvgHead->Index-NL) tmp[j-CvgHead->Index+NL] = tmp_ptr->Convergence[i];
-                 tmp_ptr=tmp_ptr->Next;
-             }
+             for (j=0; j<NL; j++)
+                 tmp[j] = CvgValue(Cvg.Index-NL+j)[i];
              max_conv[i] = Max(NL, tmp);
              min_conv[i] = Min(NL, tmp);
              delConv[i] = max_conv[i] - min_conv[i];
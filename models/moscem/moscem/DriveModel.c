@@ -1,6 +1,10 @@
 /*======================== Drivemodel.c =============================
       Call the hydrological model to obtain model simulations
 
+      stop (NULL: simulate the whole period) is called by the model
+      after each day with stoparg; returns 1 if it stopped the
+      simulation, data_ptr->Output is then not filled
+
       Yuqiong Liu      March 2003
 ====================================================================*/
 
@@ -8,13 +12,14 @@
 #include "datatype.h"
 #include "moscem.h"
 
-void DriveModel(Moscem *moscem, double *xpar, Data_ptr data_ptr, 
-		ResCar_ptr rescar_ptr,Files *files)  {
+int DriveModel(Moscem *moscem, double *xpar, Data_ptr data_ptr, 
+		ResCar_ptr rescar_ptr,Files *files,
+		int (*stop)(void *, int, double), void *stoparg)  {
 
     double input[NTSTEP1][NINPUT];
     double out[NTSTEP2][NINPUT];
     float maxh,minh,surfacearea,capacity;
-    int i,j;
+    int i,j,nsim;
 
     for (i=0;i<moscem->nTSteps_Inputs; i++) {
       for (j=0; j<moscem->nInputs; j++) input[i][j] = data_ptr->InputData[i][j]; 
@@ -26,11 +31,14 @@ void DriveModel(Moscem *moscem, double *xpar, Data_ptr data_ptr,
     minh=rescar_ptr->MinHead;
     surfacearea=rescar_ptr->SurfArea;
     capacity=rescar_ptr->InstCap;
-    model(xpar, input, out, 0, data_ptr->input_mean,rescar_ptr,files->RoutOutFile);
+    nsim = model(xpar, input, out, 0, data_ptr->input_mean,rescar_ptr,files->RoutOutFile,
+		 stop, stoparg);
+    if (nsim < moscem->nTSteps_Inputs) return 1;
     for (i=0;i<moscem->nTSteps_Fluxes; i++) {
       for (j=0; j<moscem->nFluxes; j++) { //nFluxes = 1 in single optimization
 	data_ptr->Output[i][j] = out[i][j]; //single optimization: out[i][0]=outflow from reservoir
       }
       data_ptr->Output[i][1] = out[i][1]; //out[i][1]: Power production, in MW
     }
+    return 0;
 } 
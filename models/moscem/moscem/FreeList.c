@@ -14,34 +14,21 @@
 void FreeSeqList(int n) {
 
     int i;
-    SeqList_ptr tmp_ptr1,tmp_ptr2;
 
     for (i=0;i<n; i++) {
-        tmp_ptr1 = SeqHead[i];
-	while(tmp_ptr1 != NULL)
-        {
-	     tmp_ptr2 = tmp_ptr1;
-	     tmp_ptr1 = tmp_ptr1->Next;
-	     FreeDoubleVector( tmp_ptr2->ObjValue );
-	     FreeDoubleVector( tmp_ptr2->ParValue );
-	     free( tmp_ptr2 );
-	 }
+        FreeDoubleVector( Seq[i].ParValue );
+        FreeDoubleVector( Seq[i].ObjValue );
+        FreeDoubleVector( Seq[i].ProbValue );
+        FreeDoubleVector( Seq[i].WinMean );
+        FreeDoubleVector( Seq[i].WinM2 );
     }
+    free( Seq );
 
 }
 
 void FreeCvgList() {
 
-    CvgList_ptr tmp_ptr1,tmp_ptr2;
-
-    tmp_ptr1 = CvgHead;
-    while(tmp_ptr1 != NULL)
-    {
-        tmp_ptr2 = tmp_ptr1;
-        tmp_ptr1 = tmp_ptr1->Next;
-        FreeDoubleVector( tmp_ptr2->Convergence );
-        free( tmp_ptr2 );
-    }
+    FreeIntVector( Cvg.Iter );
+    FreeDoubleVector( Cvg.Convergence );
 
 }
-
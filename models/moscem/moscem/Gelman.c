@@ -3,6 +3,10 @@ Calculate the convergence diagnostic based on Gelman, A. and D.R. Rubin, 1992.
 Inference from Iterative Simulation Using Multiple Sequences
 Statistical Science, Volume 7, Issue 4, 457-472.
 
+The within-sequence means and variances over the last half of each
+sequence are kept up to date by AddSeqList, so no sequence is scanned
+here unless the sequences differ in length.
+
 Yuqiong Liu, March 2003
 ============================================================================*/
 #include <math.h>
@@ -15,12 +19,12 @@ void Gelman(int npar, int nc, double *converg)  {
 
      int i,j, k;
      int npts, nstart, npts1;
-     SeqList_ptr tmp_ptr1;
+     int equal;
      double **tmpArr, *ave1, *varseq, **varseq1, **varseq2, **atmp, **btmp;
      double ave0, B, W, Vhat, aveseq, var0, varV, df;
      double tmp1, tmp2, tmp3;
 
-     npts = SeqHead[0]->Index;
+     npts = Seq[0].Index;
      if (npts > 10) 
          nstart = npts - npts/2 +1;
      else
@@ -28,7 +32,6 @@ void Gelman(int npar, int nc, double *converg)  {
       
      npts1 = npts - nstart+1;
 
-     tmpArr = DoubleMatrix(npts1, nc);
      ave1   = DoubleVector(nc);
      varseq = DoubleVector(nc);
      varseq1= DoubleMatrix(nc,2);
@@ -36,16 +39,29 @@ void Gelman(int npar, int nc, double *converg)  {
      atmp   = DoubleMatrix(2,2);
      btmp   = DoubleMatrix(2,2);
      
+     equal = 1;
+     for (j=0; j<nc; j++) {
+         if (Seq[j].Index < npts)
+             PrintError("Sequence shorter than the first sequence in 'Gelman'!");
+         if (Seq[j].Index != npts || Seq[j].WinStart != nstart-1) equal = 0;
+     }
+     tmpArr = NULL;
+     if (!equal) tmpArr = DoubleMatrix(npts1, nc);
+
      for (i=0; i<npar; i++)  {
-         for(j=0; j<nc; j++) {
-             tmp_ptr1 = SeqHead[j];
-             for (k=0; k<npts; k++)   {
-                 if (k >= nstart-1)  tmpArr[k-nstart+1][j] = tmp_ptr1->ParValue[i];
-                 tmp_ptr1 = tmp_ptr1->Next;
+         if (tmpArr == NULL) {
+             for (j=0; j<nc; j++) {
+                 ave1[j] = Seq[j].WinMean[i];
+                 varseq[j] = Seq[j].WinM2[i]/(npts1-1);
              }
-         } 
-
-         Mean(npts1, nc, tmpArr, ave1);
+         }
+         else {
+             for(j=0; j<nc; j++)
+                 for (k=nstart-1; k<npts; k++)
+                     tmpArr[k-nstart+1][j] = SeqPar(j, k)[i];
+             Mean(npts1, nc, tmpArr, ave1);
+             Var(npts1, nc, tmpArr, varseq);
+         }
 
          ave0 = 0.;
          for (j=0; j<nc; j++) ave0 = ave0 + ave1[j]/nc;
@@ -53,8 +69,6 @@ void Gelman(int npar, int nc, double *converg)  {
          B = 0.;
          for (j=0; j<nc; j++)  B = B + 1.0*npts1/(nc-1.0) * pow(ave1[j]-ave0, 2.0);
 
-         Var(npts1, nc, tmpArr, varseq);
-         
          W = 0.;
          for (j=0; j<nc; j++) W = W + varseq[j]/nc;
 
@@ -90,7 +104,7 @@ void Gelman(int npar, int nc, double *converg)  {
          } 
      }
 
-     FreeDoubleMatrix(tmpArr, npts1);
+     if (tmpArr != NULL) FreeDoubleMatrix(tmpArr, npts1);
      FreeDoubleVector(ave1);
      FreeDoubleVector(varseq);
      FreeDoubleMatrix(varseq1, nc);
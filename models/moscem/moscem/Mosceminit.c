@@ -3,9 +3,25 @@
 	Input: none
 	Output: moscem - MOSCEM parameters
 
+        Optional lines after Rout_Out_File:
+        Warm_Start_File  file  seed the initial population from the final
+                               population of a previous run (written back
+                               to the same file at the end of this run)
+        Warm_Start_Frac  f     fraction of the samples taken from the
+                               warm start file, the rest is sampled by
+                               Latin (default 0.5)
+        Gelman_Stop      1     stop as soon as the Gelman-Rubin criterion
+                               is met by all parameters
+        Exact_Objective  1     always simulate the whole period; by
+                               default the simulation of a candidate of
+                               the single-objective search (IRR, FLOOD,
+                               WAT) stops once it is sure to be rejected
+
         Yuqiong Liu, March  2003
 ================================================================ */
 
+#include <stdlib.h>
+#include <string.h>
 #include "constant.h"
 #include "datatype.h"
 #include "utility.h"
@@ -14,7 +30,7 @@
 void MoscemInit(Moscem* moscem, Files* files) {
 
      FILE *fp;
-     char str[MAX_LINE_LEN];
+     char str[MAX_LINE_LEN], value[MAX_LINE_LEN];
 
      moscem->nPars          = NPAR;
      moscem->nInputs        = NINPUT;
@@ -43,5 +59,24 @@ void MoscemInit(Moscem* moscem, Files* files) {
      fscanf(fp,"%s%s", str, files->CvgOutFile);
      fscanf(fp,"%s%s", str, files->RoutOutFile);
 
+     files->WarmStartFile[0] = '\0';
+     moscem->WarmFrac = 0.5;
+     moscem->GelmanStop = 0;
+     moscem->ExactObj = 0;
+     while (fscanf(fp,"%s%s", str, value) == 2) {
+         if (strcmp(str, "Warm_Start_File") == 0) {
+             strncpy(files->WarmStartFile, value, MAX_FNAME_LEN-1);
+             files->WarmStartFile[MAX_FNAME_LEN-1] = '\0';
+         }
+         else if (strcmp(str, "Warm_Start_Frac") == 0)
+             moscem->WarmFrac = atof(value);
+         else if (strcmp(str, "Gelman_Stop") == 0)
+             moscem->GelmanStop = atoi(value);
+         else if (strcmp(str, "Exact_Objective") == 0)
+             moscem->ExactObj = atoi(value);
+         else
+             printf("Unknown option %s in data/moscem.in ignored\n", str);
+     }
+
      fclose(fp);
 }
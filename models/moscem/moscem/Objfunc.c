@@ -2,43 +2,60 @@
 Call specified objective function
 RMSE, Standard deviation (STD), HMLE, NSE, POW, IRR or FLOOD
 or WAT
+
+ObjStopInit/ObjStopDay: for the objectives that sum a
+non-negative term per day (IRR, FLOOD, WAT), accumulate the
+objective while the reservoir is simulated and stop the
+simulation as soon as the partial sum already fails the
+acceptance test of OffMetro_singl. The terms are summed in the
+same order as in Irr, Flood and Wat, and the sum can only grow,
+so a stopped candidate would have been rejected by the full
+simulation as well.
 Yuqiong Liu, March 2003
 ===========================================================*/
 
+#include <math.h>
 #include "constant.h"
 #include "datatype.h"
 #include "utility.h"
 #include "moscem.h"
 
+#define STOP_MARGIN 1.0e-9  /* relative margin of the cheap test before pow() */
+
+/* observation the simulated outflow of day j is compared with */
+static double DayObs(int j, double **Output, double **ValData,
+		     double mean_streamflow, ResCar_ptr rescar_ptr) {
+
+     double obs;
+
+     obs = ValData[j][3]; // obs initialized to inflow.
+     if(rescar_ptr->ObjectiveFunction==5 ) //POW
+       obs = Output[j][1]; //power production 
+     if(rescar_ptr->ObjectiveFunction==6 ) //IRR	
+       obs = ValData[j][5]; //water demands downstream, units= m3/day
+     if(rescar_ptr->ObjectiveFunction==7 ) //FLOOD
+       obs = rescar_ptr->MeanFlood; // mean annual flood, units = m3/day
+     if(rescar_ptr->ObjectiveFunction==9 ) //WAT
+       obs = mean_streamflow; //mean annual streamflow, units = m3/day
+
+     return obs;
+}
+
 void ObjFunc(Moscem *moscem,double **Output,double **ValData,
 	     double *Obj, int *iter,double mean_streamflow,
 	     ResCar_ptr rescar_ptr) {
 
      int i,j;
-     double *obs,*comp,*waterdemand;
-     int *month;
+     double *obs,*comp;
 
      obs = DoubleVector(moscem->nTSteps_Fluxes);
      comp = DoubleVector(moscem->nTSteps_Fluxes);
-     waterdemand =  DoubleVector(moscem->nTSteps_Fluxes);
-     month =IntVector(moscem->nTSteps_Fluxes);
 
      for (i=0; i<moscem->nFluxes; i++)  {  
          for (j=0; j<moscem->nTSteps_Fluxes; j++) {
              if (ValData[i][j] != MISSING_VALUE) {
 	       comp[j] = Output[j][0]; //simulated outflow, m3/day
-	       month[j] = (int)ValData[j][1];
-	       waterdemand[j]=ValData[j][5]; //irrigation water demands
-	       obs[j]= ValData[j][3]; // obs[j] initialized to inflow.
-
-	       if(rescar_ptr->ObjectiveFunction==5 ) //POW
-		 obs[j]= Output[j][1]; //power production 
-	       if(rescar_ptr->ObjectiveFunction==6 ) //IRR	
-  		 obs[j]=waterdemand[j]; //water demands downstream, units= m3/day
-	       if(rescar_ptr->ObjectiveFunction==7 ) //FLOOD
-  		 obs[j]=rescar_ptr->MeanFlood; // mean annual flood, units = m3/day
-	       if(rescar_ptr->ObjectiveFunction==9 ) //WAT
-		 obs[j]=mean_streamflow; //mean annual streamflow, units = m3/day
+	       obs[j] = DayObs(j, Output, ValData, mean_streamflow, rescar_ptr);
              }
          }
 
@@ -65,6 +82,58 @@ void ObjFunc(Moscem *moscem,double **Output,double **ValData,
 
      FreeDoubleVector(obs);
      FreeDoubleVector(comp);
-     FreeDoubleVector(waterdemand);
-     FreeIntVector(month);
+}
+
+/* Returns 1 if the objective of flux iflux can be accumulated during the
+   simulation; a candidate is accepted if pow(Obj/obj1, expo) > ru */
+int ObjStopInit(ObjStop *stop, Moscem *moscem, double **ValData,
+		double mean_streamflow, ResCar_ptr rescar_ptr, int iflux,
+		double obj1, double expo, double ru) {
+
+     int objective;
+
+     objective = rescar_ptr->ObjectiveFunction;
+     if (objective != 6 && objective != 7 && objective != 9) return 0;
+     if (moscem->nTSteps_Fluxes == 0 || moscem->nValTsteps[iflux] <= 0) return 0;
+     if (!(obj1 > 0. && obj1 < INF && ru > 0. && expo < 0.)) return 0;
+
+     stop->ValData         = ValData;
+     stop->mean_streamflow = mean_streamflow;
+     stop->rescar_ptr      = rescar_ptr;
+     stop->iflux           = iflux;
+     stop->nDays           = min(moscem->nValTsteps[iflux], moscem->nTSteps_Fluxes);
+     stop->sum             = 0.;
+     stop->obj1            = obj1;
+     stop->expo            = expo;
+     stop->ru              = ru;
+     /* pow(sum/obj1, expo) <= ru for sum >= obj1*pow(ru, 1/expo) */
+     stop->bound           = obj1*pow(ru, 1.0/expo)*(1.0-STOP_MARGIN);
+
+     return 1;
+}
+
+/* Called by the model after simulating day j; returns 1 once the
+   candidate is certain to be rejected */
+int ObjStopDay(void *arg, int j, double outflow) {
+
+     ObjStop *stop = (ObjStop *) arg;
+     double obs, comp;
+
+     if (j >= stop->nDays) return 0;
+     if (stop->ValData[stop->iflux][j] == MISSING_VALUE) return 0;
+
+     comp = outflow;
+     obs  = DayObs(j, NULL, stop->ValData, stop->mean_streamflow, stop->rescar_ptr);
+
+     if (stop->rescar_ptr->ObjectiveFunction == 6) { //IRR
+       if (comp < obs) stop->sum += obs-comp;
+     }
+     else if (stop->rescar_ptr->ObjectiveFunction == 7) { //FLOOD
+       if (comp > obs) stop->sum += (comp-obs)*(comp-obs);
+     }
+     else //WAT
+       stop->sum += fabs(comp-obs);
+
+     if (stop->sum < stop->bound) return 0;
+     return (pow(stop->sum/stop->obj1, stop->expo) <= stop->ru);
 }
@@ -15,58 +15,51 @@ void OffMetro_multi(Moscem *moscem, Parameter_ptr parameter_ptr, Data_ptr data_p
      ResCar_ptr rescar_ptr, int iComplex, Files *files) {
 	
     int i, j;
-    int npts, npar, nobj, nopt;
-    double *par1, *obj1, **pars,**cov, **sqrtm, *newPar;
-    double ru, *z, *newObj, dx, **objs2,*prob, *xpar, *prob1;
-    int *rank, ndom1, control, nsteps;
-    SeqList_ptr newPnt;
+    int npts, nobj, nopt;
+    double *par1, *obj1, **pars, **chol, *newPar;
+    double ru, *z, *newObj, dx, **objs2,*prob, *xpar, *xold;
+    int *rank, ndom1, control;
     double mean_streamflow;
-    float scalingfactor;
+    Proposal_ptr prop;
 
     nobj   = moscem->nFluxes;
-    npar   = moscem->nPars;
     nopt   = moscem->nOptPar;
     npts   = moscem->nSamples/moscem->nComplex;
-    par1   = DoubleVector(nopt);
-    obj1   = DoubleVector(nobj);
-    pars   = DoubleMatrix(npts, nopt);
-    cov    = DoubleMatrix(nopt, nopt);
-    z      = DoubleVector(nopt);
-    sqrtm  = DoubleMatrix(nopt, nopt);
-    newPar = DoubleVector(nopt);
-    newObj = DoubleVector(nobj);
-    objs2  = DoubleMatrix(npts+2, nobj);
-    xpar   = DoubleVector(npar);
-    rank   = IntVector(npts+2);
-    prob   = DoubleVector(npts+2);
-    prob1  = DoubleVector(npts);
 
-    newPnt = (SeqList_ptr)malloc(sizeof(*newPnt));
-    newPnt->ParValue = DoubleVector(nopt);
-    newPnt->ObjValue = DoubleVector(nobj);
-    newPnt->Next = NULL;
+    prop   = data_ptr->Prop;
+    par1   = prop->par1;
+    obj1   = prop->obj1;
+    pars   = data_ptr->Complex[iComplex];
+    z      = prop->z;
+    newPar = prop->newPar;
+    newObj = prop->newObj;
+    objs2  = prop->objs;
+    xpar   = prop->xpar;
+    xold   = prop->xold;
+    rank   = prop->rank;
+    prob   = prop->prob;
+    chol   = prop->Chol[iComplex];
+
     mean_streamflow = data_ptr->input_mean;
 
-    for (i=0; i<nopt; i++) par1[i] = SeqTail[iComplex]->ParValue[i];
-    for (i=0; i<nobj; i++) obj1[i] = SeqTail[iComplex]->ObjValue[i];
+    for (i=0; i<nopt; i++) par1[i] = SeqPar(iComplex, Seq[iComplex].Index-1)[i];
+    for (i=0; i<nobj; i++) obj1[i] = SeqObj(iComplex, Seq[iComplex].Index-1)[i];
  
-    for (i=0; i<npts; i++)  {
-	for(j=0; j<nopt; j++) 
- 	    pars[i][j] = data_ptr->Complex[iComplex][i][j];
-	for (j=0; j<nobj; j++) 
-	    objs2[i][j] = data_ptr->Complex[iComplex][i][j+nopt];
-    }
+    for (i=0; i<npts; i++) objs2[i] = pars[i]+nopt;
 
-    CovMatrix(npts, nopt, pars, cov);  /* calculate covariance matrix */
+/* -------- Cholesky factor of the covariance of the complex; kept up to date
+            by ReplaceProposal until the complex is rebuilt -------------------- */
+    if (!prop->Valid[iComplex]) {
+        CholCov(npts, nopt, pars, prop->Mean[iComplex], chol);
+        prop->Valid[iComplex] = 1;
+    }
 
     ru = UnifRand(&seed);
     for (i=0; i<nopt; i++) z[i] = NormRand(&seed);
 
-    Sqrtm(cov, sqrtm, nopt);   /* calculate matrix square root of the covariance matrix*/
-
     for (i=0; i<nopt; i++) {
 	dx = 0;
-	for (j=0; j<nopt; j++)  dx = dx + sqrtm[i][j]*z[j];
+	for (j=0; j<=i; j++)  dx = dx + chol[i][j]*z[j];
 	newPar[i] = par1[i]+dx;
     }
 
@@ -78,28 +71,17 @@ void OffMetro_multi(Moscem *moscem, Parameter_ptr parameter_ptr, Data_ptr data_p
     if (control == -1)   for(i=0; i<nobj; i++) newObj[i] = INF;
     else            {
 
-        DriveModel(moscem,xpar,data_ptr,rescar_ptr,files);
+        DriveModel(moscem,xpar,data_ptr,rescar_ptr,files,NULL,NULL);
         ObjFunc(moscem, data_ptr->Output, data_ptr->ValData, 
 		newObj, &(data_ptr->Iter),mean_streamflow,rescar_ptr);
 	//	printf("OffMetro_multi4 %d %f %f %12.3E %12.3E\n", 
 	//     nobj,obj1[0],obj1[1],newObj[0],newObj[1]);
-        for (i=0; i<nobj; i++) {
-	    objs2[npts][i] = obj1[i]; objs2[npts+1][i] = newObj[i];
-        }
+        objs2[npts] = obj1; objs2[npts+1] = newObj;
         ParetoRanking(moscem, npts+2, objs2, rank, &ndom1);
 	//printf("OffMetro_multi5\n"); 
         CompProb(nobj, moscem->ObjOptFlag, npts+2, objs2, rank, prob);
-        for (i=0; i<npts; i++) prob1[i] = prob[i];
-        SortProb(npts, nobj, objs2, prob);
-        SortProb(npts, nopt, pars, prob1);
-
-        for (i=0; i<npts; i++)  {
-            for (j=0; j<nopt; j++) 
-                data_ptr->Complex[iComplex][i][j] = pars[i][j];
-            for (j=0; j<nobj; j++)
-                data_ptr->Complex[iComplex][i][j+nopt] = objs2[i][j];
-            data_ptr->Complex[iComplex][i][nopt+nobj] = prob[i];
-        }
+        SortProb(npts, pars, prob, data_ptr);
+        for (i=0; i<npts; i++) pars[i][nopt+nobj] = prob[i];
 
 /* -------- replace the drawn point with the new point ------------------------ */
         if ( pow( prob[npts]/prob[npts+1], 0.5*prob[npts+1]) > ru ) {  
@@ -107,29 +89,15 @@ void OffMetro_multi(Moscem *moscem, Parameter_ptr parameter_ptr, Data_ptr data_p
 	    for (i=0; i<nobj; i++) obj1[i] = newObj[i];
         }
 
-        for (i=0; i<nopt; i++) 
-	    data_ptr->Complex[iComplex][npts-1][i] = par1[i];
+        for (i=0; i<nopt; i++) {
+	    xold[i] = pars[npts-1][i];
+	    pars[npts-1][i] = par1[i];
+        }
         for (i=0; i<nobj; i++)
-	    data_ptr->Complex[iComplex][npts-1][i+nopt] = obj1[i];
-        data_ptr->Complex[iComplex][npts-1][nopt+nobj] = prob[npts+1];
+	    pars[npts-1][i+nopt] = obj1[i];
+        pars[npts-1][nopt+nobj] = prob[npts+1];
+        ReplaceProposal(prop, iComplex, pars, xold, par1);
 
-        for (i=0; i<nopt; i++) newPnt->ParValue[i] = par1[i];
-        for (i=0; i<nobj; i++) newPnt->ObjValue[i] = obj1[i];
-        newPnt->ProbValue = prob[npts];    
-        AddSeqList(iComplex, newPnt);
+        AddSeqList(iComplex, par1, obj1, prob[npts]);
     }
-
-    FreeDoubleVector(par1);
-    FreeDoubleVector(obj1);
-    FreeDoubleMatrix(pars,npts);
-    FreeDoubleMatrix(cov,nopt);
-    FreeDoubleVector(z);
-    FreeDoubleMatrix(sqrtm,nopt);
-    FreeDoubleVector(newPar);
-    FreeDoubleVector(newObj);
-    FreeDoubleMatrix(objs2,npts+2);
-    FreeIntVector(rank);
-    FreeDoubleVector(prob);
-    FreeDoubleVector(xpar);
-    FreeDoubleVector(prob1);
 }
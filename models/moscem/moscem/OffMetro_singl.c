@@ -16,87 +16,64 @@ void OffMetro_singl(Moscem *moscem, Parameter_ptr parameter_ptr, Data_ptr data_p
      ResCar_ptr rescar_ptr,int iComplex, Files *files) {
 	
     int i, j;
-    int npts, npar, nobj, nopt;
-    double *par1, *obj1, **pars, **objs, **cov, **sqrtm, *newPar;
-    double ru, *z, *newObj, dx, *parMean,*prob, *xpar, *prob1;
-    int control, mp, optIdx, nsteps, s, L;
-    double JumpRate, threshold, ratio;
-    SeqList_ptr newPnt, tmp_ptr;
+    int npts, nobj, nopt;
+    double *par1, *obj1, **pars, **chol, *newPar;
+    double ru, *z, *newObj, dx, *parMean,*prob, *xpar, *xold;
+    int control, mp, optIdx, s, L, stopped;
+    double JumpRate, scale, threshold, ratio;
     double pMeanCom, pMeanSeq, Gamma;
-    double mean_streamflow;
+    double mean_streamflow, expo;
+    Proposal_ptr prop;
+    ObjStop stop;
 
     Gamma = 0.;
-    s = SeqHead[iComplex]->Index; 
+    s = Seq[iComplex].Index; 
 
     nobj   = moscem->nFluxes;
-    npar   = moscem->nPars;
     nopt   = moscem->nOptPar;
     npts   = moscem->nSamples/moscem->nComplex;
     L      = npts/5;
 
-    par1   = DoubleVector(nopt);
-    obj1   = DoubleVector(nobj);
-    pars   = DoubleMatrix(npts, nopt);
-    objs   = DoubleMatrix(npts, nopt);
-    cov    = DoubleMatrix(nopt, nopt);
-    z      = DoubleVector(nopt);
-    sqrtm  = DoubleMatrix(nopt, nopt);
-    newPar = DoubleVector(nopt);
-    newObj = DoubleVector(nobj);
-    parMean  = DoubleVector(nopt);
-    xpar   = DoubleVector(npar);
-    prob   = DoubleVector(npts);
-    prob1  = DoubleVector(npts);
-
-    newPnt = (SeqList_ptr)malloc(sizeof(*newPnt));
-    newPnt->ParValue = DoubleVector(nopt);
-    newPnt->ObjValue = DoubleVector(nobj);
-    newPnt->Next = NULL;
+    prop   = data_ptr->Prop;
+    par1   = prop->par1;
+    obj1   = prop->obj1;
+    pars   = data_ptr->Complex[iComplex];
+    z      = prop->z;
+    newPar = prop->newPar;
+    newObj = prop->newObj;
+    xpar   = prop->xpar;
+    xold   = prop->xold;
+    prob   = prop->prob;
+    parMean = prop->Mean[iComplex];
+    chol   = prop->Chol[iComplex];
+
     mean_streamflow = data_ptr->input_mean;
 
-    for (i=0; i<nopt; i++) par1[i] = SeqTail[iComplex]->ParValue[i];
-    for (i=0; i<nobj; i++) obj1[i] = SeqTail[iComplex]->ObjValue[i];
+    for (i=0; i<nopt; i++) par1[i] = SeqPar(iComplex, s-1)[i];
+    for (i=0; i<nobj; i++) obj1[i] = SeqObj(iComplex, s-1)[i];
 
-    for (i=0; i<npts; i++)  {
-	for(j=0; j<nopt; j++) 
- 	    pars[i][j] = data_ptr->Complex[iComplex][i][j];
-        for(j=0; j<nobj; j++)
-            objs[i][j] = data_ptr->Complex[iComplex][i][j+nopt];
-        prob[i] = data_ptr->Complex[iComplex][i][nopt+nobj];
-        prob1[i] = prob[i];
-    }
-    Mean(npts, nopt, pars, parMean);    /* calulate the mean of the parameter sets */
-    CovMatrix(npts, nopt, pars, cov);  /* calculate covariance matrix */
+    for (i=0; i<npts; i++) prob[i] = pars[i][nopt+nobj];
 
+/* -------- mean and Cholesky factor of the covariance of the complex; kept up
+            to date by ReplaceProposal until the complex is rebuilt ------------ */
+    if (!prop->Valid[iComplex]) {
+        CholCov(npts, nopt, pars, parMean, chol);
+        prop->Valid[iComplex] = 1;
+    }
     JumpRate = pow(2.4/sqrt(nopt), 2.0);
-    for (i=0; i<nopt; i++) 
-        for(j=0; j<nopt; j++) cov[i][j] = cov[i][j]*JumpRate;
-    Sqrtm(cov, sqrtm, nopt);   /* calculate matrix square root of the covariance matrix*/
+    scale = sqrt(JumpRate);
 
     control = -1;
     threshold = 1.0E+7;
 
-    SortProb(npts, nobj, objs, prob);
-    SortProb(npts, nopt, pars, prob1);
-        
-    for (i=0; i<npts; i++)  {
-        for (j=0; j<nopt; j++)   
-            data_ptr->Complex[iComplex][i][j] = pars[i][j];
-        for (j=0; j<nobj; j++)
-            data_ptr->Complex[iComplex][i][j+nopt] = objs[i][j];
-        data_ptr->Complex[iComplex][i][nopt+nobj] = prob[i];
-    }
+    SortProb(npts, pars, prob, data_ptr);
 
     pMeanCom = 0.;
     for (i=0;i<npts;i++) pMeanCom = pMeanCom + prob[i]/(npts*1.0);
     if ( s >= npts+L+1) {
-        tmp_ptr = SeqHead[iComplex];        
-        for (i=0; i<s-L-1; i++)  {
-            if (i>=s-L-npts-1) prob1[i-s+L+npts+1] = tmp_ptr->ProbValue;
-            tmp_ptr= tmp_ptr->Next;
-        }
         pMeanSeq = 0.;
-        for (i=0; i<npts; i++) pMeanSeq = pMeanSeq + prob1[i]/(npts*1.0);
+        for (i=s-L-npts-1; i<s-L-1; i++)
+            pMeanSeq = pMeanSeq + Seq[iComplex].ProbValue[i]/(npts*1.0);
     }
     else pMeanSeq = pMeanCom;
 
@@ -108,7 +85,8 @@ void OffMetro_singl(Moscem *moscem, Parameter_ptr parameter_ptr, Data_ptr data_p
          for (i=0; i<nopt; i++) z[i] = NormRand(&seed);
          for (i=0; i<nopt; i++) {
              dx = 0;
-             for (j=0; j<nopt; j++)  dx = dx + sqrtm[i][j]*z[j];
+             for (j=0; j<=i; j++)  dx = dx + chol[i][j]*z[j];
+             dx = dx*scale;
              if (pow(pMeanCom/pMeanSeq, (-1.0)*moscem->nValTsteps[optIdx]*(1.0+Gamma)/2.0 )>threshold )
                  newPar[i] = parMean[i]+dx;
              else
@@ -123,44 +101,46 @@ void OffMetro_singl(Moscem *moscem, Parameter_ptr parameter_ptr, Data_ptr data_p
 
     if (control == -1)   for(i=0; i<nobj; i++) newObj[i] = INF;
     else            {
-        DriveModel(moscem, xpar, data_ptr,rescar_ptr,files);
-        ObjFunc(moscem, data_ptr->Output, data_ptr->ValData, newObj, &(data_ptr->Iter),
-		mean_streamflow,rescar_ptr);
+/* -------- ru is drawn before the simulation so that a candidate can be
+            dropped as soon as its partial objective fails the test below;
+            the model does not use the random numbers ------------------------ */
+        ru = UnifRand(&seed);
+        expo = (-1.0)*moscem->nValTsteps[optIdx]*(1.0+Gamma)/2.0;
+
+        if (!moscem->ExactObj && ObjStopInit(&stop, moscem, data_ptr->ValData, mean_streamflow,
+                                             rescar_ptr, optIdx, obj1[optIdx], expo, ru))
+            stopped = DriveModel(moscem, xpar, data_ptr, rescar_ptr, files, ObjStopDay, &stop);
+        else
+            stopped = DriveModel(moscem, xpar, data_ptr, rescar_ptr, files, NULL, NULL);
+
+        if (stopped) {   /* rejected; the partial objective is kept for the record */
+            for (i=0; i<nobj; i++) newObj[i] = INF;
+            newObj[optIdx] = stop.sum;
+            data_ptr->Iter++;
+            data_ptr->nStop++;
+        }
+        else
+            ObjFunc(moscem, data_ptr->Output, data_ptr->ValData, newObj, &(data_ptr->Iter),
+		    mean_streamflow,rescar_ptr);
 
 /* -------- replace the drawn point with the new point ------------------------ */
 
-        ru = UnifRand(&seed);
-        if (pow(newObj[optIdx]/obj1[optIdx], (-1.0)*moscem->nValTsteps[optIdx]*(1.0+Gamma)/2.0) > ru) {
+        if (pow(newObj[optIdx]/obj1[optIdx], expo) > ru) {
    	    for (i=0; i<nopt; i++) par1[i] = newPar[i];
 	    for (i=0; i<nobj; i++) obj1[i] = newObj[i];
             mp=1;
         }
         else mp=npts;
 
-        for (i=0; i<nopt; i++) 
-	    data_ptr->Complex[iComplex][mp-1][i] = par1[i];
+        for (i=0; i<nopt; i++) {
+	    xold[i] = pars[mp-1][i];
+	    pars[mp-1][i] = par1[i];
+        }
         for (i=0; i<nobj; i++)
-	    data_ptr->Complex[iComplex][mp-1][i+nopt] = obj1[i];
-        data_ptr->Complex[iComplex][mp-1][nopt+nobj] = obj1[optIdx];
+	    pars[mp-1][i+nopt] = obj1[i];
+        pars[mp-1][nopt+nobj] = obj1[optIdx];
+        ReplaceProposal(prop, iComplex, pars, xold, par1);
 
-        for (i=0; i<nopt; i++) newPnt->ParValue[i] = par1[i];
-        for (i=0; i<nobj; i++) newPnt->ObjValue[i] = obj1[i];
-        newPnt->ProbValue = obj1[optIdx];    
-        AddSeqList(iComplex, newPnt);
+        AddSeqList(iComplex, par1, obj1, obj1[optIdx]);
     }
-
-    FreeDoubleVector(par1);
-    FreeDoubleVector(obj1);
-    FreeDoubleMatrix(pars,npts);
-    FreeDoubleMatrix(objs,npts);
-    FreeDoubleMatrix(cov,nopt);
-    FreeDoubleVector(z);
-    FreeDoubleMatrix(sqrtm,nopt);
-    FreeDoubleVector(newPar);
-    FreeDoubleVector(newObj);
-    FreeDoubleVector(parMean);
-    FreeDoubleVector(prob);
-    FreeDoubleVector(xpar);
-    FreeDoubleVector(prob1);
-
 }
@@ -15,15 +15,11 @@ void Output(Moscem *moscem, Data_ptr data_ptr, Parameter_ptr par_ptr, Files *fil
 
     FILE  *fp1, *fp2, *fp3;
     int i, j;
-    double *xpar, *prob1;
-    CvgList_ptr tmp_ptr;
+    double *xpar;
 
     xpar = DoubleVector(moscem->nPars);
-    prob1 = DoubleVector(moscem->nSamples);
 
-    for (i=0; i<moscem->nSamples; i++) prob1[i] = data_ptr->ProbValue[i];
-    SortProb(moscem->nSamples, moscem->nFluxes, data_ptr->ObjValue, data_ptr->ProbValue);
-    SortProb(moscem->nSamples, moscem->nOptPar, data_ptr->ParValue, prob1);
+    SortPopulation(moscem, data_ptr);
 
     fp1 = Fopen(files->ObjOutFile,"w");
     for (i=0; i<moscem->nSamples; i++) {
@@ -47,15 +43,12 @@ void Output(Moscem *moscem, Data_ptr data_ptr, Parameter_ptr par_ptr, Files *fil
     
 
     fp3 = Fopen(files->CvgOutFile,"w");
-    tmp_ptr = CvgHead;
-    for (i=0; i<CvgHead->Index; i++) {
-        fprintf(fp3,"%5d %8d", i+1, tmp_ptr->Iter);
-        for (j=0; j<moscem->nOptPar; j++) fprintf(fp3, "%12.4f", tmp_ptr->Convergence[j]);
+    for (i=0; i<Cvg.Index; i++) {
+        fprintf(fp3,"%5d %8d", i+1, Cvg.Iter[i]);
+        for (j=0; j<moscem->nOptPar; j++) fprintf(fp3, "%12.4f", CvgValue(i)[j]);
         fprintf(fp3,"\n");
-        tmp_ptr = tmp_ptr->Next;
     }
     fclose(fp3);   
 
     FreeDoubleVector(xpar);
-    FreeDoubleVector(prob1);
 }
@@ -1,83 +1,151 @@
 /*=============================================================================  
 This C program was developed to perform pareto ranking based on multi-objective
 function values.   March 2003, Yuqiong Liu  
+
+The ranks are those of the original front-by-front scheme, in which point i
+belongs to the current front unless a later point j is no worse in every
+objective (obj[i] >= obj[j]) or an earlier point j is better in every
+objective (!(obj[j] >= obj[i])), and ranked points take the value INF in
+every objective for the following fronts. Instead of comparing all pairs
+again for every front, the pairwise relation is computed once (fast
+non-dominated sorting): each point keeps the number of unranked points that
+beat it and the list of points it beats, and the counts are decremented as
+fronts are removed. Comparisons with ranked (INF) points only depend on how
+a point compares with INF and on the index order, so they are handled with
+four flags per point. Work arrays are kept between calls.
 ==============================================================================*/
 
+#include <stdlib.h>
 #include "constant.h"
 #include "datatype.h"
 #include "utility.h"
 #include "moscem.h"
 
+static int    nAlloc = 0, mAlloc = 0;
+static double *ob;         /* optimized objectives, point i at ob[i*m] */
+static int    *cnt;        /* number of unranked points beating each point */
+static int    *nbeat;      /* number of points beaten by each point */
+static int    *beat;       /* points beaten by point i at beat[i*n] */
+static int    *ranked;     /* 1 if the point has a rank */
+static int    *front;      /* points of the current front */
+static char   *geInf, *gtInf, *leInf, *ltInf;  /* comparisons with INF */
+
+static void RankingWork(int n, int m) {
+
+    if (n <= nAlloc && m <= mAlloc) return;
+    if (nAlloc > 0) {
+        free(ob); free(cnt); free(nbeat); free(beat); free(ranked); free(front);
+        free(geInf); free(gtInf); free(leInf); free(ltInf);
+    }
+    if (n > nAlloc) nAlloc = n;
+    if (m > mAlloc) mAlloc = m;
+    ob     = (double *) malloc((nAlloc*mAlloc+1)*sizeof(double));
+    cnt    = (int *) malloc(nAlloc*sizeof(int));
+    nbeat  = (int *) malloc(nAlloc*sizeof(int));
+    beat   = (int *) malloc(nAlloc*nAlloc*sizeof(int));
+    ranked = (int *) malloc(nAlloc*sizeof(int));
+    front  = (int *) malloc(nAlloc*sizeof(int));
+    geInf  = (char *) malloc(nAlloc);
+    gtInf  = (char *) malloc(nAlloc);
+    leInf  = (char *) malloc(nAlloc);
+    ltInf  = (char *) malloc(nAlloc);
+    if (!ob || !cnt || !nbeat || !beat || !ranked || !front ||
+        !geInf || !gtInf || !leInf || !ltInf)
+        PrintError("allocation failure in ParetoRanking()");
+}
+
 void ParetoRanking(Moscem *moscem, int npts, double **obj, int *rank, int *ndom) {
 
-    int i,j,k, n1,oldn, ranking, tmp, nobj1;
-    double   **obj1;
-    int     *idx1, *idx2, *rank1;
-     
-    obj1 = DoubleMatrix(npts+1, moscem->nOptObj+1);
-    idx1 = IntVector(npts+1);
-    rank1 = IntVector(npts+1);
-
-    for (i=1;i<=npts;i++) rank1[i] = 0;
-
-    k = 0;
-    for (i=1;i<=moscem->nFluxes; i++) {
-       if (moscem->ObjOptFlag[i-1] == 1) {
-          k++;
-          for (j=1;j<=npts;j++) obj1[j][k] = obj[j-1][i-1];
+    int i, j, k, m, n1, oldn, ranking, nfront;
+    int maxRanked, minRanked, lastLe, firstLt;
+    int jbeats, ibeats;
+    double *oi, *oj;
+
+    m = 0;
+    for (k=0; k<moscem->nFluxes; k++)
+       if (moscem->ObjOptFlag[k] == 1) m++;
+    RankingWork(npts, m);
+
+    j = 0;
+    for (k=0; k<moscem->nFluxes; k++) {
+       if (moscem->ObjOptFlag[k] == 1) {
+          for (i=0; i<npts; i++) ob[i*m+j] = obj[i][k];
+          j++;
+       }
+    }
+
+/* -------- pairwise relation and comparison with INF, computed once -------- */
+    for (i=0; i<npts; i++) {
+       rank[i] = 0;
+       ranked[i] = 0;
+       cnt[i] = 0;
+       nbeat[i] = 0;
+       oi = ob + i*m;
+       geInf[i] = gtInf[i] = leInf[i] = ltInf[i] = 1;
+       for (k=0; k<m; k++) {
+          if (!(oi[k] >= INF)) geInf[i] = 0;
+          if (INF >= oi[k])    gtInf[i] = 0;
+          if (!(INF >= oi[k])) leInf[i] = 0;
+          if (oi[k] >= INF)    ltInf[i] = 0;
        }
     }
 
-    nobj1 = k;
-    n1=0;
+    for (i=0; i<npts; i++) {
+       oi = ob + i*m;
+       for (j=i+1; j<npts; j++) {
+          oj = ob + j*m;
+          jbeats = 1;
+          ibeats = 1;
+          for (k=0; k<m; k++) {
+             if (oi[k] >= oj[k]) ibeats = 0;
+             else jbeats = 0;
+          }
+          if (jbeats) { cnt[i]++; beat[j*npts+nbeat[j]++] = i; }
+          if (ibeats) { cnt[j]++; beat[i*npts+nbeat[i]++] = j; }
+       }
+    }
+
+/* -------- peel off the fronts --------------------------------------------- */
+    n1 = 0;
     ranking = 1;
+    maxRanked = -1;
+    minRanked = npts;
+
+    while ( (npts-n1)>0 && (ranking < npts) ) {
 
-    while ( (npts-n1)>0 & (ranking < npts) ) {
-
-       for (i=1; i<=npts; i++) idx1[i] = 1;
-       for (i=1; i<=npts; i++)   {
-           idx2 = IntVector(npts-i+1);
-           for (j=1; j<=npts-i; j++) idx2[j] = 0;
-           for (k=1; k<=nobj1; k++) {
-               for (j=i+1; j<=npts; j++) {
-                  if ( obj1[i][k] >= obj1[j][k] ) tmp = 1;
-                  else    tmp = 0;
-                  idx2[j-i] = idx2[j-i] + tmp;
-               }
-           }
-           tmp = 0;
-           for (j=1; j<=npts-i; j++)
-               if (idx2[j] == nobj1) tmp++;
-           if (tmp>0) idx1[i] = 0;
-           for (j=i+1; j<=npts; j++)  {
-               if (idx2[j-i] == 0) tmp=1;
-               else tmp = 0;
-               idx1[j] = idx1[j] - tmp;
-           }
-           FreeIntVector(idx2);
+       lastLe = -1;
+       firstLt = npts;
+       for (i=0; i<npts; i++) {
+          if (ranked[i]) continue;
+          if (leInf[i]) lastLe = i;
+          if (ltInf[i] && i < firstLt) firstLt = i;
        }
-       oldn = n1;
-       n1 = 0;
-       for (i=1; i<=npts; i++)  {
-           if (idx1[i] == 1) {
-              n1++;
-              rank1[i] = ranking;
-              for (j=1;j<=nobj1; j++) obj1[i][j] = INF;
-           }
+
+       nfront = 0;
+       for (i=0; i<npts; i++) {
+          if (ranked[i]) {
+             /* an INF point is only beaten by later points, unless
+                no later point is <= INF and no earlier one is < INF */
+             if (i == maxRanked && lastLe < i && firstLt > i) front[nfront++] = i;
+          }
+          else if (cnt[i] == 0 && !(geInf[i] && maxRanked > i)
+                   && !(gtInf[i] && minRanked < i))
+             front[nfront++] = i;
        }
 
-       n1 = n1+oldn;
+       for (j=0; j<nfront; j++) {
+          i = front[j];
+          rank[i] = ranking;
+          if (ranked[i]) continue;
+          ranked[i] = 1;
+          for (k=0; k<nbeat[i]; k++) cnt[beat[i*npts+k]]--;
+          if (i > maxRanked) maxRanked = i;
+          if (i < minRanked) minRanked = i;
+       }
+
+       oldn = n1;
+       n1 = nfront + oldn;
        if (ranking == 1) *ndom = n1; 
        ranking = ranking +1;
     }              
-    
-    for (i=0;i<npts;i++) rank[i] = rank1[i+1];
-
-    FreeIntVector(idx1);
-    FreeIntVector(rank1);
-    FreeDoubleMatrix(obj1,npts+1);
-       
 }
-
-
-      
@@ -1,5 +1,7 @@
 /* ================================================================
-Part the samples into complexes
+Part the samples into complexes; the proposal distributions of
+the rebuilt complexes have to be recomputed. The complexes hold
+pointers to the rows of the population, which are not copied
 Yuqiong Liu, March 2003
 =================================================================*/
 
@@ -8,7 +10,7 @@ Yuqiong Liu, March 2003
 
 void PartSample(Moscem *moscem, Data_ptr data_ptr)  {
 
-    int i,j,k;
+    int i,j;
     int nobj, npar, npts, nc, idx1;
 
     nobj = moscem->nFluxes;
@@ -20,14 +22,13 @@ void PartSample(Moscem *moscem, Data_ptr data_ptr)  {
 
     for (i=0; i<(int)(npts/nc); i++) {
         for (j=0; j<nc; j++)   {
-	    for (k=0; k<npar; k++)  
-	        data_ptr->Complex[j][i][k] = data_ptr->ParValue[idx1][k];
-	    for (k=0; k<nobj; k++)  
-	        data_ptr->Complex[j][i][k+npar] = data_ptr->ObjValue[idx1][k];
+	    data_ptr->Complex[j][i] = data_ptr->ParValue[idx1];
 	    data_ptr->Complex[j][i][npar+nobj] = data_ptr->ProbValue[idx1];
 
 	    idx1++;
 	}
     }
 
+    for (j=0; j<nc; j++) data_ptr->Prop->Valid[j] = 0;
+
 }
@@ -0,0 +1,182 @@
+/*================================ Proposal.c ==============================
+      InitProposal: allocate the proposal distributions and the work space
+                    of OffMetro
+      FreeProposal: free them again
+      CholCov: mean and lower Cholesky factor of the covariance matrix of
+               the parameter sets x[m][n] of a complex
+      CholUpdate: rank-one update (sign = 1) or downdate (sign = -1) of a
+                  Cholesky factor, L*L' +/- x*x'
+      ReplaceProposal: update the mean and the factor of a complex when one
+                       of its points is replaced by a new one
+
+      The proposal distribution of each complex is computed once after the
+      population is partitioned into complexes (PartSample) and is then
+      carried along as points are replaced: replacing xold by xnew changes
+      the covariance by one rank-one update and one downdate, O(n^2)
+      instead of forming and decomposing the matrix again for every draw.
+      If a downdate fails because the factor has become (numerically)
+      singular, the factor is recomputed from the complex.
+============================================================================*/
+
+#include <stdlib.h>
+#include <math.h>
+#include "constant.h"
+#include "datatype.h"
+#include "utility.h"
+#include "moscem.h"
+
+#define CHOL_EPS 1.0E-12   /* relative size of pivots treated as zero */
+
+Proposal_ptr InitProposal(Moscem *moscem) {
+
+     Proposal_ptr prop;
+     int npts, nopt, nobj;
+
+     npts = moscem->nSamples/moscem->nComplex;
+     nopt = moscem->nOptPar;
+     nobj = moscem->nFluxes;
+
+     prop = (Proposal_ptr) malloc(sizeof(Proposal));
+     if (!prop) PrintError("allocation failure in InitProposal()");
+     prop->nPts   = npts;
+     prop->nPar   = nopt;
+     prop->nObj   = nobj;
+     prop->Valid  = IntVector(moscem->nComplex);
+     prop->Mean   = DoubleMatrix(moscem->nComplex, nopt);
+     prop->Chol   = Double3Dim(moscem->nComplex, nopt, nopt);
+     prop->u      = DoubleVector(nopt);
+     prop->v      = DoubleVector(nopt);
+     prop->par1   = DoubleVector(nopt);
+     prop->obj1   = DoubleVector(nobj);
+     prop->newPar = DoubleVector(nopt);
+     prop->newObj = DoubleVector(nobj);
+     prop->z      = DoubleVector(nopt);
+     prop->xpar   = DoubleVector(moscem->nPars);
+     prop->xold   = DoubleVector(nopt);
+     prop->objs   = RowPointers(NULL, npts+2, 0);
+     prop->prob   = DoubleVector(npts+2);
+     prop->rank   = IntVector(npts+2);
+
+     return prop;
+}
+
+void FreeProposal(Moscem *moscem, Proposal_ptr prop) {
+
+     FreeIntVector(prop->Valid);
+     FreeDoubleMatrix(prop->Mean, moscem->nComplex);
+     FreeDouble3Dim(prop->Chol, moscem->nComplex, prop->nPar);
+     FreeDoubleVector(prop->u);
+     FreeDoubleVector(prop->v);
+     FreeDoubleVector(prop->par1);
+     FreeDoubleVector(prop->obj1);
+     FreeDoubleVector(prop->newPar);
+     FreeDoubleVector(prop->newObj);
+     FreeDoubleVector(prop->z);
+     FreeDoubleVector(prop->xpar);
+     FreeDoubleVector(prop->xold);
+     FreeRowPointers(prop->objs);
+     FreeDoubleVector(prop->prob);
+     FreeIntVector(prop->rank);
+     free(prop);
+}
+
+/* x is a complex, only its first n columns (the parameters) are used.
+   Columns of L belonging to zero pivots are set to zero, so duplicated
+   points (which make the covariance singular) give a valid factor. */
+void CholCov(int m, int n, double **x, double *ave, double **L) {
+
+     int i, j, k;
+     double sum, dmax;
+
+     Mean(m, n, x, ave);
+
+     for (i=0; i<n; i++) {
+         for (j=0; j<=i; j++) {
+             sum = 0.;
+             for (k=0; k<m; k++) sum += (x[k][i]-ave[i])*(x[k][j]-ave[j]);
+             L[i][j] = sum/((m-1) * 1.0);
+         }
+         for (j=i+1; j<n; j++) L[i][j] = 0.;
+     }
+
+     dmax = 0.;
+     for (i=0; i<n; i++) if (L[i][i] > dmax) dmax = L[i][i];
+
+     for (j=0; j<n; j++) {
+         sum = L[j][j];
+         for (k=0; k<j; k++) sum -= L[j][k]*L[j][k];
+         if (sum <= CHOL_EPS*dmax) {
+             for (i=j; i<n; i++) L[i][j] = 0.;
+             continue;
+         }
+         L[j][j] = sqrt(sum);
+         for (i=j+1; i<n; i++) {
+             sum = L[i][j];
+             for (k=0; k<j; k++) sum -= L[i][k]*L[j][k];
+             L[i][j] = sum/L[j][j];
+         }
+     }
+}
+
+/* x is overwritten. Returns -1 if a downdate would lose positive
+   definiteness, in which case L is left partly modified. */
+int CholUpdate(int n, double **L, double *x, int sign) {
+
+     int i, k;
+     double r, c, s, t;
+
+     for (k=0; k<n; k++) {
+         if (x[k] == 0.) continue;
+         if (sign > 0) {
+             r = sqrt(L[k][k]*L[k][k] + x[k]*x[k]);
+             c = L[k][k]/r;
+             s = x[k]/r;
+             L[k][k] = r;
+             for (i=k+1; i<n; i++) {
+                 t = L[i][k];
+                 L[i][k] = c*t + s*x[i];
+                 x[i]    = c*x[i] - s*t;
+             }
+         }
+         else {
+             r = L[k][k]*L[k][k] - x[k]*x[k];
+             if (r <= 0. || L[k][k] == 0.) return -1;
+             r = sqrt(r);
+             c = r/L[k][k];
+             s = x[k]/L[k][k];
+             L[k][k] = r;
+             for (i=k+1; i<n; i++) {
+                 L[i][k] = (L[i][k] - s*x[i])/c;
+                 x[i]    = c*x[i] - s*L[i][k];
+             }
+         }
+     }
+     return 0;
+}
+
+/* With m points, mean a and covariance C, replacing xold by xnew gives
+      C' = C + e*e'/m - m*d*d'/(m-1)^2,   a' = a + (xnew-xold)/m
+   where d = xold - a and e = xnew - (m*a - xold)/(m-1). */
+void ReplaceProposal(Proposal_ptr prop, int iComplex, double **x,
+     double *xold, double *xnew) {
+
+     int i, m, n;
+     double *ave;
+
+     m   = prop->nPts;
+     n   = prop->nPar;
+     ave = prop->Mean[iComplex];
+
+     for (i=0; i<n; i++) if (xold[i] != xnew[i]) break;
+     if (i == n) return;
+
+     for (i=0; i<n; i++) {
+         prop->v[i] = (xold[i]-ave[i])*sqrt(m*1.0)/(m-1);
+         prop->u[i] = (xnew[i]-(m*ave[i]-xold[i])/(m-1))/sqrt(m*1.0);
+         ave[i] += (xnew[i]-xold[i])/m;
+     }
+
+     CholUpdate(n, prop->Chol[iComplex], prop->u, 1);
+     if (CholUpdate(n, prop->Chol[iComplex], prop->v, -1) != 0)
+         CholCov(m, n, x, ave, prop->Chol[iComplex]);
+}
@@ -1,5 +1,6 @@
 /* ============================================================
-unpack all the complexes for reshuffling
+unpack all the complexes for reshuffling; only the row pointers
+and the fitness values are gathered
 Yuqiong Liu, March  2003
 ==============================================================*/
 
@@ -10,7 +11,7 @@ Yuqiong Liu, March  2003
 void Reshuffle(Moscem *moscem, Data_ptr data_ptr) {
 
 
-    int i, j, k;
+    int i, j;
     int nobj, npar, npts, nc, idx1, m;
 
     nobj = moscem->nFluxes;
@@ -22,9 +23,9 @@ void Reshuffle(Moscem *moscem, Data_ptr data_ptr) {
     idx1 = 0;
     for (i=0; i<nc; i++)  {
 	for (j=0; j<m; j++) {
-	   for (k=0; k<npar; k++) data_ptr->ParValue[idx1][k] = data_ptr->Complex[i][j][k];
-	   for (k=0; k<nobj; k++) data_ptr->ObjValue[idx1][k] = data_ptr->Complex[i][j][k+npar];
-           data_ptr->ProbValue[idx1] = data_ptr->Complex[i][j][npar+nobj];
+	   data_ptr->ParValue[idx1]  = data_ptr->Complex[i][j];
+	   data_ptr->ObjValue[idx1]  = data_ptr->Complex[i][j] + npar;
+	   data_ptr->ProbValue[idx1] = data_ptr->Complex[i][j][npar+nobj];
 	   idx1++;
         }
     }
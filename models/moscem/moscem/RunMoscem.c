@@ -23,10 +23,8 @@ yqliu@hwr.arizona.edu (520)6213973           March 2003
 #include "moscem.h"
 #include "utility.h"
 
-SeqList_ptr     *SeqHead;
-SeqList_ptr     *SeqTail;
-CvgList_ptr     CvgHead;
-CvgList_ptr     CvgTail;
+SeqList         *Seq;
+CvgList         Cvg;
 
 int            seed;
 
@@ -37,7 +35,7 @@ int main()  {
     Parameter_ptr  parameter_ptr;
     Data_ptr       data_ptr;
     ResCar_ptr     rescar_ptr;
-    double         *xpar, *prob1;  /* temporary varaible */
+    double         *xpar;          /* temporary varaible */
     double         *final_params; 
     double         final_output[NTSTEP1][NINPUT];
     double         final_input[NTSTEP1][NINPUT];
@@ -78,29 +76,27 @@ parameters
     data_ptr->OutputHydro = DoubleMatrix(moscem.nTSteps_Inputs,moscem.nInputs);
     data_ptr->OutputFlood = DoubleMatrix(moscem.nTSteps_Inputs,moscem.nInputs);
     data_ptr->OutputMean = DoubleMatrix(moscem.nTSteps_Inputs,moscem.nInputs);
-    data_ptr->ParValue  = DoubleMatrix(moscem.nSamples, moscem.nOptPar);
-    data_ptr->ObjValue  = DoubleMatrix(moscem.nSamples, moscem.nFluxes);
+    data_ptr->Pop       = DoubleVector(moscem.nSamples*(moscem.nOptPar+moscem.nFluxes+1));
+    data_ptr->ParValue  = RowPointers(data_ptr->Pop, moscem.nSamples, moscem.nOptPar+moscem.nFluxes+1);
+    data_ptr->ObjValue  = RowPointers(data_ptr->Pop+moscem.nOptPar, moscem.nSamples, moscem.nOptPar+moscem.nFluxes+1);
     data_ptr->ProbValue = DoubleVector(moscem.nSamples);
     data_ptr->RankIdx   = IntVector(moscem.nSamples);
+    data_ptr->SortIdx   = IntVector(moscem.nSamples);
+    data_ptr->SortTmp   = IntVector(moscem.nSamples);
+    data_ptr->SortRows  = RowPointers(NULL, moscem.nSamples, 0);
+    data_ptr->SortFit   = DoubleVector(moscem.nSamples);
 
     npts = moscem.nSamples/moscem.nComplex;
-    data_ptr->Complex = Double3Dim(moscem.nComplex,npts, moscem.nOptPar+moscem.nFluxes+1);
+    data_ptr->Complex = RowPointerMatrix(moscem.nComplex, npts);
+    data_ptr->Prop = InitProposal(&moscem);
 
     rescar_ptr = (ResCar_ptr)malloc(sizeof(*rescar_ptr));
 
-    SeqHead = (SeqList_ptr *) malloc(moscem.nComplex*sizeof(SeqList_ptr));
-    SeqTail = (SeqList_ptr *) malloc(moscem.nComplex*sizeof(SeqList_ptr));
-    for (i=0; i<moscem.nComplex; i++) {
-        SeqHead[i] = NULL;
-        SeqTail[i] = NULL;
-    }
-   
-    CvgHead = NULL;
-    CvgTail = NULL;
+    InitSeqList(moscem.nComplex, moscem.nOptPar, moscem.nFluxes);
+    InitCvgList(moscem.nOptPar);
 
     xpar = DoubleVector(moscem.nPars);
     final_params = DoubleVector(moscem.nPars);
-    prob1 = DoubleVector(moscem.nSamples);
  
     time(&t_tot);
 /*----------------------------------------------------------------
@@ -112,11 +108,14 @@ validation data
     LoadData(files.InputFile, files.ValFile, &moscem, data_ptr);
 
 /*----------------------------------------------------------------
-Latin-Hypercube random sampling; compute objective function values
+Latin-Hypercube random sampling, optionally seeded with the final
+population of a previous run; compute objective function values
 for each sample of the entire population
 -----------------------------------------------------------------*/
     Latin(&moscem, parameter_ptr, data_ptr);
+    WarmStart(&moscem, parameter_ptr, data_ptr, files.WarmStartFile);
     data_ptr->Iter = 0;
+    data_ptr->nStop = 0;
 
     printf("\n--------- Objective function values of valid initial samples ---------\n");
 	CompObj(&moscem, data_ptr, parameter_ptr, rescar_ptr, &files);
@@ -157,9 +156,7 @@ assignment; and sort the points in order of decreasing probability
 	 CompProb(moscem.nFluxes, moscem.ObjOptFlag, moscem.nSamples,
              data_ptr->ObjValue, data_ptr->RankIdx, data_ptr->ProbValue);
  
-         for (i=0; i<moscem.nSamples; i++) prob1[i] = data_ptr->ProbValue[i];
-	 SortProb(moscem.nSamples, moscem.nFluxes, data_ptr->ObjValue, data_ptr->ProbValue);
-         SortProb(moscem.nSamples, moscem.nOptPar, data_ptr->ParValue, prob1);
+	 SortPopulation(&moscem, data_ptr);
 
 /* -------------------------------------------------------
 print info of each shuffled loop to the screen 
@@ -199,9 +196,14 @@ Print required output to files;
 Free allocated memory before exiting the program
 ----------------------------------------------------------------*/
 
+    if (data_ptr->nStop > 0)
+        printf("\n%d of %d candidate simulations stopped early (rejected).\n",
+               data_ptr->nStop, data_ptr->Iter);
+
     printf("\nWriting output files\n");
 
     Output(&moscem, data_ptr, parameter_ptr, &files, final_params);
+    SaveWarmStart(&moscem, data_ptr, files.WarmStartFile);
 
     printf("\nfinal parameters:\n");
     for(i=0;i<12;i++) printf("%.3f ",final_params[i]);
@@ -217,7 +219,7 @@ Free allocated memory before exiting the program
     }
 
     model(final_params,final_input,final_output,1,data_ptr->input_mean,
-	  rescar_ptr,files.RoutOutFile);
+	  rescar_ptr,files.RoutOutFile,NULL,NULL);
     //Output2(final_input,final_output,rescar_ptr);
 
     printf("\nMOSCEM completed in %10.4g SECONDS. Free meories.\n", (time(NULL)-t_tot)*1.);
@@ -238,17 +240,22 @@ Free allocated memory before exiting the program
     FreeDoubleMatrix(data_ptr->ValData,  moscem.nTSteps_Inputs);
     FreeDoubleMatrix(data_ptr->Output,   moscem.nTSteps_Inputs);
 
-    FreeDoubleMatrix(data_ptr->ParValue, moscem.nSamples);
-    FreeDoubleMatrix(data_ptr->ObjValue, moscem.nSamples);
+    FreeRowPointers(data_ptr->ParValue);
+    FreeRowPointers(data_ptr->ObjValue);
+    FreeDoubleVector(data_ptr->Pop);
     FreeDoubleVector(data_ptr->ProbValue);
-    FreeDouble3Dim(data_ptr->Complex,    moscem.nComplex, npts);
+    FreeIntVector(data_ptr->SortIdx);
+    FreeIntVector(data_ptr->SortTmp);
+    FreeRowPointers(data_ptr->SortRows);
+    FreeDoubleVector(data_ptr->SortFit);
+    FreeRowPointerMatrix(data_ptr->Complex);
+    FreeProposal(&moscem, data_ptr->Prop);
     if ( data_ptr != NULL) free(data_ptr);
 
     FreeSeqList(moscem.nComplex);  
     FreeCvgList();
 
     FreeDoubleVector(xpar);
-    FreeDoubleVector(prob1);
 
     return 0;
 }
@@ -1,47 +1,64 @@
 /* ===========================================================
 Sort the points from low fitness to high fitness
 
+Only the row pointers data[] and the fitness values prob[] are
+permuted, the rows themselves stay where they are. The sort is a
+stable merge sort of the indices, O(m log m); points with equal
+fitness keep their order. The work space is allocated once with
+the population (data_ptr->Sort*); m must not exceed nSamples.
 Yuqiong Liu, March 2003
 ============================================================*/
 
+#include <stdlib.h>
 #include "constant.h"
 #include "datatype.h"
-#include "utility.h"
 
-void SortProb(int m, int n, double **data, double *prob)  {
+void SortProb(int m, double **data, double *prob, Data_ptr data_ptr)  {
 
-     int i,j;
-     int *idx, *idx1;
+     int i, j, k, lo, mid, hi, w;
+     int *idx, *tmp, *swap;
      double **data1, *prob1;
 
-     idx = IntVector(m);
-     idx1 = IntVector(m);
-     data1 = DoubleMatrix(m, n);
-     prob1 = DoubleVector(m);
+     if (m < 2) return;
 
-     for( i = 0; i < m; i++ )  {
-         idx1[i] = 0;
-         for (j=0; j<n; j++) data1[i][j] = data[i][j];
-         prob1[i] = prob[i];
-     }
+     idx = data_ptr->SortIdx;
+     tmp = data_ptr->SortTmp;
+     data1 = data_ptr->SortRows;
+     prob1 = data_ptr->SortFit;
+
+     for (i=0; i<m; i++) idx[i] = i;
 
-     for( i = 0; i < m-1; i++ )   {
-	 for( j = i+1; j < m; j++ )  {
-	     if( prob[i] <= prob[j] )
-		 idx1[j] += 1;
-	     else
-		 idx1[i] += 1;
-	 }
+     for (w=1; w<m; w*=2) {
+         for (lo=0; lo<m; lo+=2*w) {
+             mid = (lo+w < m) ? lo+w : m;
+             hi  = (lo+2*w < m) ? lo+2*w : m;
+             i = lo; j = mid; k = lo;
+             while (i < mid && j < hi) {
+                 if (prob[idx[i]] <= prob[idx[j]]) tmp[k++] = idx[i++];
+                 else                              tmp[k++] = idx[j++];
+             }
+             while (i < mid) tmp[k++] = idx[i++];
+             while (j < hi)  tmp[k++] = idx[j++];
+         }
+         swap = idx; idx = tmp; tmp = swap;
      }
 
-     for (i=0; i<m; i++)   idx[idx1[i]] = i;
-     for( i=0; i<m; i++ )  {
-         for (j=0; j<n; j++) data[i][j] = data1[idx[i]][j];
+     for (i=0; i<m; i++)  {
+         data1[i] = data[i];
+         prob1[i] = prob[i];
+     }
+     for (i=0; i<m; i++)  {
+         data[i] = data1[idx[i]];
          prob[i] = prob1[idx[i]];
      }
-	
-     FreeIntVector(idx);
-     FreeIntVector(idx1);
-     FreeDoubleVector(prob1);
-     FreeDoubleMatrix(data1, m);
+}
+
+/* sort the population; the objective values follow the parameters */
+void SortPopulation(Moscem *moscem, Data_ptr data_ptr)  {
+
+     int i;
+
+     SortProb(moscem->nSamples, data_ptr->ParValue, data_ptr->ProbValue, data_ptr);
+     for (i=0; i<moscem->nSamples; i++)
+         data_ptr->ObjValue[i] = data_ptr->ParValue[i] + moscem->nOptPar;
 }
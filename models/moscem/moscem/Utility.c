@@ -112,6 +112,34 @@ double ***Double3Dim(int m, int n,int k)
 }
 
 
+/* m row pointers into the m x n array v (left NULL if v is NULL);
+   permuting the pointers reorders the rows without moving them */
+double **RowPointers(double *v, int m, int n)
+{
+   register int i;
+   double **x;
+
+   x=(double **) calloc((size_t) m, (size_t) sizeof(double *));
+   if (!x) PrintError("allocation failure in RowPointers()");
+   if (v) for(i=0;i<m;i++) x[i] = v + (size_t) i*n;
+   return x;
+}
+
+
+/* m sets of n row pointers, in one block */
+double ***RowPointerMatrix(int m, int n)
+{
+   register int i;
+   double ***x;
+
+   x=(double ***) calloc((size_t) m, (size_t) sizeof(double **));
+   if (!x) PrintError("allocation failure 1 in RowPointerMatrix()");
+   x[0] = RowPointers(NULL, m*n, 0);
+   for(i=1;i<m;i++) x[i] = x[0] + (size_t) i*n;
+   return x;
+}
+
+
 int FreeDoubleVector(double *v)
 {
    free((char *) v);
@@ -152,6 +180,19 @@ int FreeDoubleMatrix (double **x, int m)
    return 0;
 }
 
+int FreeRowPointers (double **x)
+{
+   free((char *) x);
+   return 0;
+}
+
+int FreeRowPointerMatrix (double ***x)
+{
+   free((char *) x[0]);
+   free((char *) x);
+   return 0;
+}
+
 int FreeDouble3Dim (double ***x, int m, int n)
 {
    register int i, j;
@@ -0,0 +1,74 @@
+/*================================ WarmStart.c =============================
+      WarmStart: replace part of the Latin-Hypercube samples by the final
+                 population of a previous run (e.g. the same reservoir in
+                 the previous operational year)
+      SaveWarmStart: write the final population for the next run
+
+      The file holds one point per line, the optimized parameters only,
+      best point first. Duplicated points (a converged population has
+      many) and points outside the current parameter bounds are skipped,
+      so the remaining samples stay Latin-Hypercube samples.
+============================================================================*/
+
+#include <stdio.h>
+#include "constant.h"
+#include "datatype.h"
+#include "utility.h"
+#include "moscem.h"
+
+void WarmStart(Moscem *moscem, Parameter_ptr par_ptr, Data_ptr data_ptr, char *fname) {
+
+     FILE *fp;
+     int i, j, k, n, nwarm, nopt, ok;
+     double *x;
+
+     if (fname[0] == '\0') return;
+     if ((fp = fopen(fname, "r")) == NULL) {
+         printf("Warm start file %s not found, all samples from Latin-Hypercube\n", fname);
+         return;
+     }
+
+     nopt  = moscem->nOptPar;
+     nwarm = (int)(moscem->WarmFrac*moscem->nSamples);
+     if (nwarm > moscem->nSamples) nwarm = moscem->nSamples;
+     x = DoubleVector(nopt);
+
+     n = 0;
+     while (n < nwarm) {
+         for (j=0; j<nopt; j++)
+             if (fscanf(fp, "%lf", &x[j]) != 1) break;
+         if (j < nopt) break;
+
+         ok = 1;
+         for (j=0; j<nopt; j++)
+             if (x[j] < par_ptr->LowerBound[j] || x[j] > par_ptr->UpperBound[j]) ok = 0;
+         for (i=0; i<n && ok; i++) {
+             for (k=0; k<nopt; k++)
+                 if (data_ptr->ParValue[i][k] != x[k]) break;
+             if (k == nopt) ok = 0;
+         }
+         if (!ok) continue;
+
+         for (j=0; j<nopt; j++) data_ptr->ParValue[n][j] = x[j];
+         n++;
+     }
+     fclose(fp);
+     FreeDoubleVector(x);
+
+     printf("Warm start: %d of %d samples taken from %s\n", n, moscem->nSamples, fname);
+}
+
+/* the population is expected in order of decreasing probability (Output) */
+void SaveWarmStart(Moscem *moscem, Data_ptr data_ptr, char *fname) {
+
+     FILE *fp;
+     int i, j;
+
+     if (fname[0] == '\0') return;
+     fp = Fopen(fname, "w");
+     for (i=0; i<moscem->nSamples; i++) {
+         for (j=0; j<moscem->nOptPar; j++) fprintf(fp, " %.10g", data_ptr->ParValue[i][j]);
+         fprintf(fp, "\n");
+     }
+     fclose(fp);
+}
@@ -21,6 +21,9 @@ typedef struct Moscem  {  /* moscem parameters */
     int nComplex;        /* number of complexes */
     int nMaxDraw;        /* maximum number of function evaluations */
     int *nValTsteps;     /* valid time steps of calibration data */
+    double WarmFrac;     /* largest fraction of the initial samples taken from the warm start file */
+    int GelmanStop;      /* 1: stop as soon as the Gelman-Rubin criterion is met */
+    int ExactObj;        /* 1: always simulate the whole period, no early stop of candidates */
 
 } Moscem;
 
@@ -34,6 +37,7 @@ typedef struct Files  {  /* input and output file names */
     char CvgOutFile[MAX_FNAME_LEN];      /* convergence values */
     char RoutOutFile[MAX_FNAME_LEN];     /* output file read by routing program */
     char ResCarFile[MAX_FNAME_LEN];      /* file holding reservoir characteristics*/
+    char WarmStartFile[MAX_FNAME_LEN];   /* final population of a previous run, "" if none */
 } Files;
 
 typedef struct Parameter {  /* parameter info */
@@ -55,29 +59,55 @@ typedef struct Data {
     double **OutputHydro; /* simulation by the model, purpose: hydropower */
     double **OutputFlood; /* simulation by the model, purpose: flood */
     double **OutputMean; /* simulation by the model, purpose: close to mean */
-    double **ParValue;   /* parameter values of all the points */
-    double **ObjValue;   /* objective function values of all the points */
+    double *Pop;         /* population, one row of nOptPar+nFluxes+1 values per point:
+                            parameters, objective function values, fitness */
+    double **ParValue;   /* parameter values of all the points (rows of Pop) */
+    double **ObjValue;   /* objective function values of all the points (ParValue[i]+nOptPar) */
     double *ProbValue;   /* fintness of all points */
     int    *RankIdx;     /* pareto rank of points */
-    double ***Complex;   /* complexes */
+    int    *SortIdx, *SortTmp; /* SortProb work space, nSamples long */
+    double **SortRows, *SortFit;
+    double ***Complex;   /* complexes, point i of complex j is the row Complex[j][i] of Pop */
     int    Iter;         /* number of function evaluations */
     int    ndom;         /* number of nondominated points */
+    int    nStop;        /* candidates whose simulation was stopped early */
     double input_mean;   /* mean of input values. ingjerd */
+    struct Proposal *Prop; /* proposal distributions of the complexes */
 } *Data_ptr;
 
-typedef struct SeqList {  /* sequences of initial points */
-    int    Index;        /* Index of nodes */
-    double *ParValue;    /* parameter values of initial points */
-    double *ObjValue;    /* objective function values of inital points */
-    double ProbValue;    /* fitness value of initial points */
-    struct SeqList *Next; /* pointer to the next node */ 
+typedef struct Proposal {  /* proposal distributions and work space of OffMetro */
+    int    nPts;         /* points per complex */
+    int    nPar;         /* optimized parameters */
+    int    nObj;         /* objective function values */
+    int    *Valid;       /* 0: complex was rebuilt, factor must be recomputed */
+    double **Mean;       /* parameter mean of each complex */
+    double ***Chol;      /* lower Cholesky factor of the parameter covariance */
+    double *u, *v;       /* update vectors */
+    double *par1, *obj1, *newPar, *newObj, *z, *xpar, *xold; /* OffMetro work space */
+    double **objs;       /* objective values of a complex and two more points (row pointers) */
+    double *prob;
+    int    *rank;
+} *Proposal_ptr, Proposal;
+
+typedef struct SeqList {  /* Metropolis sequence of one complex */
+    int    Index;        /* number of points in the sequence */
+    int    Size;         /* allocated number of points */
+    int    nPar;         /* parameters per point */
+    int    nObj;         /* objective function values per point */
+    double *ParValue;    /* parameter values, point k at ParValue[k*nPar] */
+    double *ObjValue;    /* objective function values, point k at ObjValue[k*nObj] */
+    double *ProbValue;   /* fitness values */
+    int    WinStart;     /* first point of the Gelman window (last half) */
+    double *WinMean;     /* running mean of the parameters in the window */
+    double *WinM2;       /* running sum of squared deviations in the window */
 } *SeqList_ptr, SeqList;
 
 typedef struct CvgList {   /* List of convergences */
-    int Index;            /* index of nodes */
-    int Iter;             /* Number of Iterations */
-    double *Convergence;  /* convergences of parameters */
-    struct CvgList *Next; /* pointer to the next node */
+    int Index;            /* number of records */
+    int Size;             /* allocated number of records */
+    int nPar;             /* convergence values per record */
+    int *Iter;            /* Number of Iterations of each record */
+    double *Convergence;  /* convergences of parameters, record k at Convergence[k*nPar] */
 } *CvgList_ptr, CvgList;
 
 typedef struct ResCar  {  /* Reservoir characteristics */
@@ -95,4 +125,15 @@ typedef struct ResCar  {  /* Reservoir characteristics */
   float MeanFlood;      /* Mean annual flood (naturalized flow) */
 } *ResCar_ptr, ResCar;
 
+typedef struct ObjStop {  /* objective accumulated during the simulation of a candidate */
+    double     **ValData;
+    double     mean_streamflow;
+    ResCar_ptr rescar_ptr;
+    int        iflux;    /* flux whose objective decides acceptance */
+    int        nDays;    /* days summed by the objective function */
+    double     sum;      /* objective function of the days simulated so far */
+    double     obj1, expo, ru; /* the candidate is accepted if pow(sum/obj1, expo) > ru */
+    double     bound;    /* pow() is only evaluated once sum reaches this value */
+} ObjStop;
+
 #endif
@@ -21,28 +21,37 @@ Yuqiong Liu, March  2003
 #define POWFLO   8
 #define WAT      9
 
-void   AddSeqList(int i, SeqList_ptr NewPoint);
-void   AddCvgList(CvgList_ptr NewPoint);
+void   InitSeqList(int n, int npar, int nobj);
+void   AddSeqList(int i, double *par, double *obj, double prob);
+void   InitCvgList(int npar);
+void   AddCvgList(int iter, double *converg);
 int    CheckPars(Moscem *moscem, Parameter_ptr par,double *OldPar, double *NewPar);
 void   CompObj(Moscem *moscem, Data_ptr data_ptr, Parameter_ptr par_ptr, ResCar_ptr rescar_ptr, Files *files);
 void   CompProb(int nobj,int *optIdx,int ns, double **obj,int *rank, double *prob);
 void   CompleteParsets(Moscem *moscem, Parameter_ptr par_ptr, double *xpar, double *xpar1);
 void   CovMatrix(int m, int n, double **x, double **cov);
+void   CholCov(int m, int n, double **x, double *ave, double **L);
+int    CholUpdate(int n, double **L, double *x, int sign);
 int    Convergence(Moscem *moscem, int iter);
 void   Gelman(int npar, int nc, double *converg);
-void   DriveModel(Moscem *moscem, double *xpar,Data_ptr data_ptr,ResCar_ptr rescar_ptr,Files *files);
+int    DriveModel(Moscem *moscem, double *xpar,Data_ptr data_ptr,ResCar_ptr rescar_ptr,Files *files,
+		  int (*stop)(void *, int, double), void *stoparg);
 void   InitSequence(Moscem *moscem, Data_ptr data_ptr);
 void   Latin(Moscem *moscem, Parameter_ptr par_ptr, Data_ptr data);
 void   LoadData(char *finput, char *fval, Moscem *moscem, Data_ptr data_ptr);
 void   FreeSeqList(int n); 
 void   FreeCvgList();
 void   GetObjOptFlag(char* fname, Moscem *moscem);
-void   model(double *xpar, double input[NTSTEP1][NINPUT], double out[NTSTEP2][NINPUT],int flag,
-	     float mean_streamflow, ResCar_ptr rescar_ptr,char outfilename[MAX_FNAME_LEN]);
+int    model(double *xpar, double input[NTSTEP1][NINPUT], double out[NTSTEP2][NINPUT],int flag,
+	     float mean_streamflow, ResCar_ptr rescar_ptr,char outfilename[MAX_FNAME_LEN],
+	     int (*stop)(void *, int, double), void *stoparg);
 void   MoscemInit(Moscem* moscem, Files* files);
 double NormRand(int* idum);
 void   ObjFunc(Moscem *moscem,double **Output,double **ValData,double *Obj, int *iter, 
 	       double mean_streamflow,ResCar_ptr rescar_ptr);
+int    ObjStopInit(ObjStop *stop, Moscem *moscem, double **ValData, double mean_streamflow,
+		   ResCar_ptr rescar_ptr, int iflux, double obj1, double expo, double ru);
+int    ObjStopDay(void *arg, int j, double outflow);
 #if MOD_ALGO == MULTI
 void   OffMetro_multi(Moscem *moscem, Parameter_ptr parameter_ptr, Data_ptr data_ptr,ResCar_ptr rescar_ptr, int iComplex, Files *files);
 #elif MOD_ALGO == SINGL
@@ -55,10 +64,15 @@ int    ParControl(Moscem *moscem, Parameter_ptr parameter_ptr, double *newPar);
 void   Pareto(int m, int n, double** xf, int* idx, int* ndom);
 void   ParetoRanking(Moscem *moscem, int npts, double **obj, int *rank, int *ndom1);
 void   PartSample(Moscem *moscem, Data_ptr data_ptr);
+Proposal_ptr InitProposal(Moscem *moscem);
+void   FreeProposal(Moscem *moscem, Proposal_ptr prop);
+void   ReplaceProposal(Proposal_ptr prop, int iComplex, double **x, double *xold, double *xnew);
 void   Reshuffle(Moscem *moscem, Data_ptr data_ptr);
-void   SortProb(int m, int n, double **data, double *prob);
-void   Sqrtm(double **x, double **y, int n);
+void   SortProb(int m, double **data, double *prob, Data_ptr data_ptr);
+void   SortPopulation(Moscem *moscem, Data_ptr data_ptr);
 double UnifRand(int* idum);
+void   WarmStart(Moscem *moscem, Parameter_ptr par_ptr, Data_ptr data_ptr, char *fname);
+void   SaveWarmStart(Moscem *moscem, Data_ptr data_ptr, char *fname);
 
 /* These objective functions are defined in Objectives.c */
 double Rmse(double *obs, double *comp,int npts);
@@ -70,8 +84,13 @@ double Irr(double *obs, double *comp,int npts);
 double Flood(double *obs, double *comp, int npts);
 double Wat(double *obs, double *comp, int npts);
 
-extern SeqList_ptr *SeqHead, *SeqTail;
-extern CvgList_ptr CvgHead, CvgTail;
+/* point k of the sequence of complex i */
+#define SeqPar(i, k)  (Seq[i].ParValue + (k)*Seq[i].nPar)
+#define SeqObj(i, k)  (Seq[i].ObjValue + (k)*Seq[i].nObj)
+#define CvgValue(k)   (Cvg.Convergence + (k)*Cvg.nPar)
+
+extern SeqList *Seq;
+extern CvgList Cvg;
 extern int seed;
 
 #endif
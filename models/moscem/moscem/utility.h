@@ -14,12 +14,16 @@ int    **IntMatrix(int, int);
 double **DoubleMatrix(int, int);
 char   **CharMatrix(int, int);
 double ***Double3Dim(int, int, int);
+double **RowPointers(double*, int, int);
+double ***RowPointerMatrix(int, int);
 int    FreeDoubleVector(double*);
 int    FreeIntVector(int*);
 int    FreeDoubleMatrix(double**, int);
 int    FreeIntMatrix(int**, int);
 int    FreeCharMatrix(char**, int);
 int    FreeDouble3Dim(double ***, int, int);
+int    FreeRowPointers(double**);
+int    FreeRowPointerMatrix(double***);
 void   Mean(int m, int n, double **v, double *ave);
 double Min(int n, double *v);
 double Max(int n, double *v);
@@ -0,0 +1,221 @@
+/*=============================================================================
+Check and benchmark for ParetoRanking.
+
+Synthetic objective sets are ranked with ParetoRanking and with the
+original front-by-front ranking (OldParetoRanking below, the version
+before the ranking kept its pairwise relation between fronts). The
+rank of every point and the number of points in the first front must
+be the same; the program stops with exit status 1 at the first set for
+which they are not. The time per call of both versions is printed.
+
+The sets cover the cases met in MOSCEM: random points, points close to
+a trade-off front, values with many ties, points set to INF (parameter
+sets rejected by ParControl) and fluxes that are not optimized.
+
+usage: run_ranktest [repeat]
+==============================================================================*/
+
+#include <stdlib.h>
+#include <time.h>
+#include "constant.h"
+#include "datatype.h"
+#include "utility.h"
+#include "moscem.h"
+
+#define NSETS 5
+
+static char *setName[NSETS] = { "random", "front", "ties", "inf", "flags" };
+
+static void OldParetoRanking(Moscem *moscem, int npts, double **obj, int *rank, int *ndom);
+static void FillSet(int set, int npts, int nflux, double **obj, int *idum);
+static double TimeRanking(int old, Moscem *moscem, int npts, double **obj,
+                          int *rank, int *ndom, int repeat);
+
+int main(int argc, char **argv) {
+
+    static int sizes[] = { 10, 50, 100, 250, 500, 1000 };
+    static int nobj[]  = { 2, 3 };
+    int nsizes = sizeof(sizes)/sizeof(sizes[0]);
+    int nnobj  = sizeof(nobj)/sizeof(nobj[0]);
+    int i, j, k, set, npts, nflux, repeat, idum;
+    int ndomOld, ndomNew;
+    int *rankOld, *rankNew, *flags;
+    double **obj, tOld, tNew;
+    Moscem moscem;
+    char str[MAX_LINE_LEN];
+
+    repeat = (argc > 1) ? atoi(argv[1]) : 1;
+    if (repeat < 1) repeat = 1;
+    idum = IDUM;
+
+    printf("%-7s %5s %4s %6s %12s %12s %8s\n", "set", "npts", "nobj", "ndom",
+           "old (ms)", "new (ms)", "speedup");
+
+    for (set=0; set<NSETS; set++) {
+        for (j=0; j<nnobj; j++) {
+            /* the "flags" set has an extra flux that is not optimized */
+            nflux = (set == NSETS-1) ? nobj[j]+1 : nobj[j];
+            flags = IntVector(nflux);
+            for (k=0; k<nflux; k++) flags[k] = 1;
+            if (set == NSETS-1) flags[1] = 0;
+            moscem.nFluxes = nflux;
+            moscem.nOptObj = nobj[j];
+            moscem.ObjOptFlag = flags;
+
+            for (i=0; i<nsizes; i++) {
+                npts = sizes[i];
+                obj = DoubleMatrix(npts, nflux);
+                rankOld = IntVector(npts);
+                rankNew = IntVector(npts);
+                FillSet(set, npts, nflux, obj, &idum);
+
+                tOld = TimeRanking(1, &moscem, npts, obj, rankOld, &ndomOld, repeat);
+                tNew = TimeRanking(0, &moscem, npts, obj, rankNew, &ndomNew, repeat);
+
+                if (ndomOld != ndomNew) {
+                    sprintf(str, "%s set, %d points: ndom %d instead of %d",
+                            setName[set], npts, ndomNew, ndomOld);
+                    PrintError(str);
+                }
+                for (k=0; k<npts; k++) {
+                    if (rankOld[k] != rankNew[k]) {
+                        sprintf(str, "%s set, %d points: rank of point %d is %d instead of %d",
+                                setName[set], npts, k, rankNew[k], rankOld[k]);
+                        PrintError(str);
+                    }
+                }
+
+                printf("%-7s %5d %4d %6d %12.4f %12.4f %8.1f\n", setName[set], npts,
+                       nobj[j], ndomNew, tOld*1000., tNew*1000.,
+                       (tNew > 0.) ? tOld/tNew : 0.);
+
+                FreeDoubleMatrix(obj, npts);
+                FreeIntVector(rankOld);
+                FreeIntVector(rankNew);
+            }
+            FreeIntVector(flags);
+        }
+    }
+
+    printf("\nranks and ndom identical for all sets\n");
+    return 0;
+}
+
+/* fills obj[npts][nflux] with objective values of the given kind */
+static void FillSet(int set, int npts, int nflux, double **obj, int *idum) {
+
+    int i, k;
+    double s, u;
+
+    for (i=0; i<npts; i++) {
+        switch (set) {
+        case 1:        /* scattered around the front sum(obj) = 1 */
+            s = 0.;
+            for (k=0; k<nflux; k++) {
+                obj[i][k] = UnifRand(idum);
+                s = s + obj[i][k];
+            }
+            u = 1. + 0.05*UnifRand(idum);
+            for (k=0; k<nflux; k++) obj[i][k] = obj[i][k]/s*u;
+            break;
+        case 2:        /* few distinct values, many ties and duplicates */
+            for (k=0; k<nflux; k++) obj[i][k] = (int)(5.*UnifRand(idum));
+            break;
+        case 3:        /* a quarter of the points rejected */
+            for (k=0; k<nflux; k++) obj[i][k] = UnifRand(idum);
+            if (UnifRand(idum) < 0.25)
+                for (k=0; k<nflux; k++) obj[i][k] = INF;
+            break;
+        default:       /* uniform */
+            for (k=0; k<nflux; k++) obj[i][k] = UnifRand(idum);
+            break;
+        }
+    }
+}
+
+/* returns the cpu time in seconds of one call of the old (old = 1) or
+   the new ranking, averaged over repeat calls */
+static double TimeRanking(int old, Moscem *moscem, int npts, double **obj,
+                          int *rank, int *ndom, int repeat) {
+
+    int r;
+    clock_t t0;
+
+    t0 = clock();
+    for (r=0; r<repeat; r++) {
+        if (old) OldParetoRanking(moscem, npts, obj, rank, ndom);
+        else     ParetoRanking(moscem, npts, obj, rank, ndom);
+    }
+    return (double)(clock()-t0)/CLOCKS_PER_SEC/repeat;
+}
+
+/* the ranking as it was before the fast non-dominated sorting */
+static void OldParetoRanking(Moscem *moscem, int npts, double **obj, int *rank, int *ndom) {
+
+    int i,j,k, n1,oldn, ranking, tmp, nobj1;
+    double   **obj1;
+    int     *idx1, *idx2, *rank1;
+
+    obj1 = DoubleMatrix(npts+1, moscem->nOptObj+1);
+    idx1 = IntVector(npts+1);
+    rank1 = IntVector(npts+1);
+
+    for (i=1;i<=npts;i++) rank1[i] = 0;
+
+    k = 0;
+    for (i=1;i<=moscem->nFluxes; i++) {
+       if (moscem->ObjOptFlag[i-1] == 1) {
+          k++;
+          for (j=1;j<=npts;j++) obj1[j][k] = obj[j-1][i-1];
+       }
+    }
+
+    nobj1 = k;
+    n1=0;
+    ranking = 1;
+
+    while ( (npts-n1)>0 & (ranking < npts) ) {
+
+       for (i=1; i<=npts; i++) idx1[i] = 1;
+       for (i=1; i<=npts; i++)   {
+           idx2 = IntVector(npts-i+1);
+           for (j=1; j<=npts-i; j++) idx2[j] = 0;
+           for (k=1; k<=nobj1; k++) {
+               for (j=i+1; j<=npts; j++) {
+                  if ( obj1[i][k] >= obj1[j][k] ) tmp = 1;
+                  else    tmp = 0;
+                  idx2[j-i] = idx2[j-i] + tmp;
+               }
+           }
+           tmp = 0;
+           for (j=1; j<=npts-i; j++)
+               if (idx2[j] == nobj1) tmp++;
+           if (tmp>0) idx1[i] = 0;
+           for (j=i+1; j<=npts; j++)  {
+               if (idx2[j-i] == 0) tmp=1;
+               else tmp = 0;
+               idx1[j] = idx1[j] - tmp;
+           }
+           FreeIntVector(idx2);
+       }
+       oldn = n1;
+       n1 = 0;
+       for (i=1; i<=npts; i++)  {
+           if (idx1[i] == 1) {
+              n1++;
+              rank1[i] = ranking;
+              for (j=1;j<=nobj1; j++) obj1[i][j] = INF;
+           }
+       }
+
+       n1 = n1+oldn;
+       if (ranking == 1) *ndom = n1;
+       ranking = ranking +1;
+    }
+
+    for (i=0;i<npts;i++) rank[i] = rank1[i+1];
+
+    FreeIntVector(idx1);
+    FreeIntVector(rank1);
+    FreeDoubleMatrix(obj1,npts+1);
+}
@@ -28,13 +28,17 @@ void MakeConvolution(int number_of_cells,
   int first_year,
   int first_month,
   int irr_rout,
-  int missing)
+  int missing,
+  int out_format)
 {
   FILE *fp;
+  ROUTBIN *rb;
+  float *binflow;
   int i, j, n, ii, jj;
   int row, col;
   double factor;
   char infile[500];
+  char binfile[510];
   char LATLON[50];
   char fmtstr[50];
   char leftover[MAXSTRING];
@@ -126,9 +130,49 @@ void MakeConvolution(int number_of_cells,
         sprintf(fmtstr, "streamflow_%%.%if_%%.%if", decimal_places, decimal_places);
         sprintf(LATLON, fmtstr, lat, lon);
         strcat(infile, LATLON);
-        printf("File %d of %d: %s\n", n, number_of_cells, infile);
 
-        if ((fp = fopen(infile, "r")) == NULL) {
+        /* Binary routed output is used if this run writes it, unless
+           the ascii file was rewritten after it */
+        rb = NULL;
+        if (out_format & OUT_BINARY) {
+          sprintf(binfile, "%s.bin", infile);
+          rb = OpenRoutBinaryRead(binfile);
+          if (rb != NULL && RoutBinaryStale(binfile, infile)) {
+            printf("%s is older than %s, which was modified after routing.\n",
+              binfile, infile);
+            printf("Route with OUTPUT_FORMAT ASCII, or remove %s.\n", binfile);
+            exit(2);
+          }
+        }
+        printf("File %d of %d: %s\n", n, number_of_cells,
+          rb != NULL ? binfile : infile);
+
+        if (rb != NULL) {
+          if (rb->header.step != ROUTBIN_DAILY || rb->header.nrecs < ndays
+            || rb->header.start_year != first_year
+            || rb->header.start_month != first_month) {
+            printf("Routed output file does not match specified\n");
+            printf("period.\n");
+            exit(2);
+          }
+          binflow = (float*)calloc(ndays, sizeof(float));
+          ReadRoutBinary(rb, ROUTBIN_FLOW, 0, ndays, binflow);
+          DATE[1].year = rb->header.start_year;
+          DATE[1].month = rb->header.start_month;
+          DATE[1].day = rb->header.start_day;
+          for (i = 1; i <= ndays; i++) {
+            if (i > 1) {
+              DATE[i] = DATE[i - 1];
+              RoutBinaryNextDate(ROUTBIN_DAILY, &DATE[i].year,
+                &DATE[i].month, &DATE[i].day);
+            }
+            RUNOFF[i] = binflow[i - 1];
+            BASEFLOW[i] = 0;
+          }
+          free(binflow);
+          CloseRoutBinary(rb);
+        }
+        else if ((fp = fopen(infile, "r")) == NULL) {
           printf("Cannot open file (previously routed streamflow) %s \n", infile);
           exit(0);
         }
@@ -0,0 +1,109 @@
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <stdarg.h>
+#include "rout.h"
+
+static int WarmStartFile(char *,char *,size_t);
+static void PathPrintf(char *,size_t,const char *,...);
+
+/*************************************************************/
+/* MoscemWarmStart                                           */
+/* Keeps the final MOSCEM population of each reservoir and   */
+/* objective function, so that the run for the next         */
+/* operational year can start from it. MOSCEM reads and      */
+/* writes the file named by the line "Warm_Start_File <file>"*/
+/* of <moscem_path>moscem.in; this routine puts the          */
+/* population of the current reservoir in that file before   */
+/* the run (save = 0) and stores it in                       */
+/* <file>.<resname>.<objective> after the run (save = 1).    */
+/* Without that line nothing is done and every run starts    */
+/* from Latin-Hypercube samples.                             */
+/*************************************************************/
+void MoscemWarmStart(char *moscem_path,
+		     char *resname,
+		     int objective,
+		     int save)
+{
+  FILE *fp;
+  char warm_path[BUFSIZ];
+  char saved_path[BUFSIZ];
+  char junk[BUFSIZ];
+
+  if(!WarmStartFile(moscem_path, warm_path, sizeof(warm_path)))
+    return;
+  PathPrintf(saved_path, sizeof(saved_path), "%s.%s.%d",
+	     warm_path, resname, objective);
+
+  if(save) {
+    if((fp = fopen(warm_path, "r")) == NULL)
+      return;
+    fclose(fp);
+    PathPrintf(junk, sizeof(junk), "cp %s %s", warm_path, saved_path);
+  }
+  else {
+    if((fp = fopen(saved_path, "r")) != NULL) {
+      fclose(fp);
+      PathPrintf(junk, sizeof(junk), "cp %s %s", saved_path, warm_path);
+    }
+    else
+      PathPrintf(junk, sizeof(junk), "rm -f %s", warm_path);
+  }
+  system(junk);
+}
+
+/* Reads the name of the warm start file from <moscem_path>moscem.in,
+   which has one "keyword value" pair per line (see MoscemInit).
+   Returns 0 if the file has no Warm_Start_File line. */
+static int WarmStartFile(char *moscem_path,
+			 char *warm_path,
+			 size_t size)
+{
+  FILE *fp;
+  char moscem_in[BUFSIZ];
+  char line[BUFSIZ];
+  char str[BUFSIZ];
+  char value[BUFSIZ];
+  int found;
+
+  PathPrintf(moscem_in, sizeof(moscem_in), "%smoscem.in", moscem_path);
+  if((fp = fopen(moscem_in, "r")) == NULL) {
+    printf("Cannot open %s\n", moscem_in);
+    exit(1);
+  }
+
+  found = 0;
+  while(fgets(line, sizeof(line), fp) != NULL) {
+    if(strchr(line, '\n') == NULL && !feof(fp)) {
+      printf("MoscemWarmStart: line too long in %s\n", moscem_in);
+      exit(1);
+    }
+    if(sscanf(line, "%s %s", str, value) == 2
+       && strcmp(str, "Warm_Start_File") == 0) {
+      PathPrintf(warm_path, size, "%s", value);
+      found = 1;
+    }
+  }
+  fclose(fp);
+
+  return found;
+}
+
+/* sprintf into a buffer of the given size; stops if the result does
+   not fit */
+static void PathPrintf(char *buffer,
+		       size_t size,
+		       const char *format,
+		       ...)
+{
+  va_list ap;
+  int n;
+
+  va_start(ap, format);
+  n = vsnprintf(buffer, size, format, ap);
+  va_end(ap);
+  if(n < 0 || (size_t)n >= size) {
+    printf("MoscemWarmStart: file name too long: %s\n", buffer);
+    exit(1);
+  }
+}
@@ -547,10 +547,12 @@ void ReservoirRouting(char *filename,
             printf("ReservoirRouting.c YY[%d] start_storage=%.2f km3; end_storage aims at %.2f km3 which is %.2f of capacity\n",
               yy, start_storage/km3tom3, end_storage/km3tom3, storage_fraction);
 
+            MoscemWarmStart(moscem_path, resname, 6, 0);
             if (leapyear == 0)
               status = system("./run_moscem_normalyear");
             else
               status = system("./run_moscem_leapyear");
+            MoscemWarmStart(moscem_path, resname, 6, 1);
 
             /* read moscem run results: year,month,day,sim_inflow,sim_outflow,power_production,spill,storage,
                storage/max_storage,minflow (7q10),waterdemand(irrig).
@@ -625,10 +627,12 @@ void ReservoirRouting(char *filename,
             printf("ReservoirRouting.c start_storage %f endstorage aims at %.2f which is %.1f of capacity\n",
               start_storage, end_storage, storage_fraction);
 
+            MoscemWarmStart(moscem_path, resname, 7, 0);
             if (leapyear == 0)
               system("./run_moscem_normalyear");
             else
               system("./run_moscem_leapyear");
+            MoscemWarmStart(moscem_path, resname, 7, 1);
 
             /* read results from moscem runs. in file: year,month,day,inflow,sim_outflow,power_prod (MW),
                spill,storage,storage/max_storage,minoutflow,waterdemand. All numbers in m or m3day-1 */
@@ -702,10 +706,12 @@ void ReservoirRouting(char *filename,
               start_storage, end_storage, storage_fraction);
             printf("ResRout now it's time for moscem (POW) year %d\n", year);
 
+            MoscemWarmStart(moscem_path, resname, 5, 0);
             if (leapyear == 0) 
               system("./run_moscem_normalyear");
             else  
               system("./run_moscem_leapyear");
+            MoscemWarmStart(moscem_path, resname, 5, 1);
 
             /* read results from moscem runs. in file: year,month,day,inflow,sim_outflow,power_prod (MW),
                spill,storage,storage/max_storage,minoutflow,waterdemand. All numbers in m or m3day-1 */
@@ -774,10 +780,12 @@ void ReservoirRouting(char *filename,
             printf("ReservoirRouting.c start_storage %f endstorage aims at %.2f which is %.1f of capacity\n",
               start_storage, end_storage, storage_fraction);
 
+            MoscemWarmStart(moscem_path, resname, 9, 0);
             if (leapyear == 0)
               system("./run_moscem_normalyear");
             else
               system("./run_moscem_leapyear");
+            MoscemWarmStart(moscem_path, resname, 9, 1);
 
             /* read results from moscem runs. in file: year,month,day,inflow,sim_outflow,power_prod (MW),
                spill,storage,storage/max_storage,minoutflow,waterdemand. All numbers in m or m3day-1 */
@@ -0,0 +1,179 @@
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <sys/stat.h>
+#include "routbin.h"
+
+/*************************************************************/
+/* RoutBinary                                                */
+/* Writer and reader for the binary routed time series       */
+/* (see routbin.h for the layout).                           */
+/*************************************************************/
+
+#define ROUTBIN_CHUNK 4096  /* records per read */
+
+/* Open a binary file for writing and write a provisional header;
+   the record count is filled in by CloseRoutBinary */
+ROUTBIN *OpenRoutBinary(char *filename,
+			int type,
+			int step,
+			int nvars,
+			float lat,
+			float lon,
+			int start_year,
+			int start_month,
+			int start_day)
+{
+  ROUTBIN *rb;
+
+  rb = (ROUTBIN*)calloc(1,sizeof(ROUTBIN));
+  if((rb->fp = fopen(filename, "wb")) == NULL) {
+    printf("Cannot open %s\n",filename);
+    exit(1);
+  }
+  rb->writing = 1;
+  strncpy(rb->header.magic,ROUTBIN_MAGIC,8);
+  rb->header.version = ROUTBIN_VERSION;
+  rb->header.type = type;
+  rb->header.step = step;
+  rb->header.nvars = nvars;
+  rb->header.nrecs = 0;
+  rb->header.start_year = start_year;
+  rb->header.start_month = start_month;
+  rb->header.start_day = start_day;
+  rb->header.lat = lat;
+  rb->header.lon = lon;
+  fwrite(&rb->header,sizeof(ROUTBIN_HEADER),1,rb->fp);
+
+  return rb;
+}
+
+/* Append one record of header.nvars values */
+void WriteRoutBinary(ROUTBIN *rb,
+		     float *values)
+{
+  fwrite(values,sizeof(float),rb->header.nvars,rb->fp);
+  rb->header.nrecs++;
+}
+
+/* Close a file opened for reading or writing. Files being
+   written get their header rewritten with the final record count. */
+void CloseRoutBinary(ROUTBIN *rb)
+{
+  if(rb->writing) {
+    rewind(rb->fp);
+    fwrite(&rb->header,sizeof(ROUTBIN_HEADER),1,rb->fp);
+  }
+  fclose(rb->fp);
+  free(rb);
+}
+
+/* Open a binary file for reading. Returns NULL if the file
+   does not exist or is not a routed binary file, so callers
+   can fall back to the ascii files. */
+ROUTBIN *OpenRoutBinaryRead(char *filename)
+{
+  ROUTBIN *rb;
+  FILE *fp;
+
+  if((fp = fopen(filename, "rb")) == NULL)
+    return NULL;
+
+  rb = (ROUTBIN*)calloc(1,sizeof(ROUTBIN));
+  rb->fp = fp;
+  if(fread(&rb->header,sizeof(ROUTBIN_HEADER),1,fp) != 1
+     || strncmp(rb->header.magic,ROUTBIN_MAGIC,8) != 0
+     || rb->header.version != ROUTBIN_VERSION
+     || rb->header.nvars < 1 || rb->header.nvars > ROUTBIN_MAXVARS) {
+    printf("%s is not a routed binary file\n",filename);
+    fclose(fp);
+    free(rb);
+    return NULL;
+  }
+
+  return rb;
+}
+
+/* Read variable var of records skip..skip+nrecs-1 into values.
+   Returns the number of records read. */
+int ReadRoutBinary(ROUTBIN *rb,
+		   int var,
+		   int skip,
+		   int nrecs,
+		   float *values)
+{
+  float *buffer;
+  int nvars;
+  int n,nread,total;
+  int i;
+
+  nvars = rb->header.nvars;
+  if(var < 0 || var >= nvars)
+    return 0;
+  if(skip + nrecs > rb->header.nrecs)
+    nrecs = rb->header.nrecs - skip;
+  if(nrecs <= 0)
+    return 0;
+
+  if(fseek(rb->fp,(long)sizeof(ROUTBIN_HEADER)
+	   + (long)skip*nvars*sizeof(float),SEEK_SET) != 0)
+    return 0;
+
+  buffer = (float*)malloc(ROUTBIN_CHUNK*nvars*sizeof(float));
+  total = 0;
+  while(total < nrecs) {
+    n = nrecs - total;
+    if(n > ROUTBIN_CHUNK) n = ROUTBIN_CHUNK;
+    nread = fread(buffer,nvars*sizeof(float),n,rb->fp);
+    for(i=0;i<nread;i++)
+      values[total+i] = buffer[i*nvars+var];
+    total += nread;
+    if(nread < n) break;
+  }
+  free(buffer);
+
+  return total;
+}
+
+/* Returns 1 if the ascii version of a binary file exists and was
+   modified after it, i.e. the ascii file was rewritten (for example
+   by routing.subtract.water.used.for.irrigation) and the binary file
+   no longer holds the same values; 0 otherwise. Both versions are
+   written in the same run of rout, the binary one last. */
+int RoutBinaryStale(char *binfile,
+		    char *asciifile)
+{
+  struct stat binstat;
+  struct stat asciistat;
+
+  if(stat(binfile,&binstat) != 0 || stat(asciifile,&asciistat) != 0)
+    return 0;
+
+  return asciistat.st_mtime > binstat.st_mtime;
+}
+
+/* Advance a date by one time step of the given type */
+void RoutBinaryNextDate(int step,
+			int *year,
+			int *month,
+			int *day)
+{
+  int DaysInMonth[13] = { 0,31,28,31,30,31,30,31,31,30,31,30,31 };
+  int days;
+
+  if(step == ROUTBIN_DAILY) {
+    days = DaysInMonth[*month];
+    if(*month == 2 && ((*year%4 == 0 && *year%100 != 0) || *year%400 == 0))
+      days++;
+    (*day)++;
+    if(*day <= days)
+      return;
+    *day = 1;
+  }
+  (*month)++;
+  if(*month > 12) {
+    *month = 1;
+    if(step != ROUTBIN_MEANMON)
+      (*year)++;
+  }
+}
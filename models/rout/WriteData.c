@@ -3,6 +3,19 @@
 #include <stdio.h>
 #include "rout.h"
 
+/*************************************************************/
+/* WriteData                                                 */
+/* Writes daily, monthly and mean monthly routed output in   */
+/* one pass over the days. Monthly means are accumulated for */
+/* the current year only and written when the year changes,  */
+/* mean monthly values are accumulated over all years.       */
+/* out_format selects ascii files (.day, .month, .year,      */
+/* streamflow_*, reservoir_*), binary files (see routbin.h)  */
+/* or both.                                                  */
+/*************************************************************/
+static void WriteMonths(FILE *,ROUTBIN *,int,int,int,int,
+			float *,float *,float *,float *,int *,int *);
+
 void WriteData(double *FLOW,
 	       float *R_FLOW,
 	       float *STORAGE,
@@ -22,76 +35,86 @@ void WriteData(double *FLOW,
 	       float lat,
 	       float lon,
 	       int type,
-	       int decimal_places)
+	       int decimal_places,
+	       int out_format)
 
 {
-  FILE *fp,*fp_routed,*fp_reservoir;
-  char *filename_fp,*filename_fp_routed,*filename_fp_reservoir;
+  FILE *fp = NULL,*fp_routed = NULL,*fp_reservoir = NULL,*fp_month = NULL;
+  ROUTBIN *rb_day = NULL,*rb_month = NULL,*rb_year = NULL;
+  char filename[MAXSTRING];
   char fmtstr[17];
   char LATLON[50];
-  float MONTHLY[MAXYEARS+1][13];  /*variables for monthly means*/
+  float MONTHLY[13];  /*monthly sums, current year*/
   float YEARLY[13];
-  float R_MONTHLY[MAXYEARS+1][13];
+  float R_MONTHLY[13];
   float R_YEARLY[13];
-  float S_MONTHLY[MAXYEARS+1][13];
+  float S_MONTHLY[13];
   float S_YEARLY[13];
-  float L_MONTHLY[MAXYEARS+1][13];
+  float L_MONTHLY[13];
   float L_YEARLY[13];
+  float record[ROUTBIN_MAXVARS];
   float days;
   int DaysInMonth[13] = { 0,31,28,31,30,31,30,31,31,30,31,30,31 };
   int nyears[13];
   int feb_days,feb_nrs;
   int i,j,k;
-  int yy,mm;
-  int leap_year;
+  int mm;
+  int year;
   int count_years;
 
-  filename_fp = (char*)calloc(100,sizeof(char));
-  filename_fp_routed = (char*)calloc(100,sizeof(char));
-  filename_fp_reservoir = (char*)calloc(100,sizeof(char));
+  sprintf(fmtstr,"_%%.%if_%%.%if",decimal_places,decimal_places);
+  sprintf(LATLON,fmtstr,lat,lon);
 
-  sprintf(filename_fp,"%s%s.day",outpath,name);
-  if((fp = fopen(filename_fp, "w")) == NULL) {
-    printf("Cannot open %s\n",filename_fp);
-    exit(1);
-  }
+  if(out_format & OUT_ASCII) {
+    sprintf(filename,"%s%s.day",outpath,name);
+    if((fp = fopen(filename, "w")) == NULL) {
+      printf("Cannot open %s\n",filename);
+      exit(1);
+    }
 
-  if(type == 2 ) { //reservoir
-    strcpy(filename_fp_reservoir,outpath);
-    sprintf(fmtstr,"reservoir_%%.%if_%%.%if",
-	    decimal_places,decimal_places);
-    sprintf(LATLON,fmtstr,lat,lon);
-    strcat(filename_fp_reservoir,LATLON);
-    if((fp_reservoir = fopen(filename_fp_reservoir, "w")) == NULL) {
-      printf("Cannot open %s\n",filename_fp_reservoir);
+    if(type == 2 ) { //reservoir
+      sprintf(filename,"%sreservoir%s",outpath,LATLON);
+      if((fp_reservoir = fopen(filename, "w")) == NULL) {
+	printf("Cannot open %s\n",filename);
+	exit(1);
+      }
+    }
+
+    sprintf(filename,"%sstreamflow%s",outpath,LATLON);
+    if((fp_routed = fopen(filename, "w")) == NULL) {
+      printf("Cannot open %s\n",filename);
+      exit(1);
+    }
+    else printf("Routed file opened: %s\n",filename);
+
+    sprintf(filename,"%s%s.month",outpath,name);
+    if((fp_month = fopen(filename, "w")) == NULL) {
+      printf("Cannot open %s\n",filename);
       exit(1);
     }
   }
 
-  strcpy(filename_fp_routed,outpath);
-  sprintf(fmtstr,"streamflow_%%.%if_%%.%if",
-	  decimal_places,decimal_places);
-  sprintf(LATLON,fmtstr,lat,lon);
-  strcat(filename_fp_routed,LATLON);
-  if((fp_routed = fopen(filename_fp_routed, "w")) == NULL) {
-    printf("Cannot open %s\n",filename_fp_routed);
-    exit(1);
+  if(out_format & OUT_BINARY) {
+    sprintf(filename,"%sstreamflow%s.bin",outpath,LATLON);
+    rb_day = OpenRoutBinary(filename,type,ROUTBIN_DAILY,5,lat,lon,
+			    first_year,first_month,1);
+    printf("Routed file opened: %s\n",filename);
+    sprintf(filename,"%s%s.month.bin",outpath,name);
+    rb_month = OpenRoutBinary(filename,type,ROUTBIN_MONTHLY,4,lat,lon,
+			      first_year,first_month,1);
   }
-  else printf("Routed file opened: %s\n",filename_fp_routed);
 
   /* Initialize */
   for(i=0;i<=12;i++) {
+    MONTHLY[i]=0.;
+    R_MONTHLY[i]=0.;
+    S_MONTHLY[i]=0.;
+    L_MONTHLY[i]=0.;
     YEARLY[i]=0.;
     R_YEARLY[i]=0.;    
     S_YEARLY[i]=0.;
     L_YEARLY[i]=0.;    
     nyears[i]=0;
-    for(j=0;j<=MAXYEARS;j++) {
-      MONTHLY[j][i]=0.;
-      R_MONTHLY[j][i]=0.;
-      S_MONTHLY[j][i]=0.;
-      L_MONTHLY[j][i]=0.;
-    }
   }
 
   count_years=0;
@@ -112,174 +135,176 @@ void WriteData(double *FLOW,
     }
   }
 
-  /* Write daily data and store monthly values */
+  /* Write daily data, and monthly data whenever a year is completed */
+  feb_days=feb_nrs=0;
+  year=first_year;
   for(i=1;i<=ndays;i++) {
     if((DATE[i].year>first_year && DATE[i].year<last_year) 
        || (DATE[i].year==first_year && DATE[i].month>=first_month)
        || (DATE[i].year==last_year && DATE[i].month<=last_month)) {
-      yy=DATE[i].year-first_year;
+      while(DATE[i].year>year) {
+	WriteMonths(fp_month,rb_month,year,
+		    (year==first_year) ? first_month : 1,12,type,
+		    MONTHLY,R_MONTHLY,S_MONTHLY,L_MONTHLY,
+		    &feb_days,&feb_nrs);
+	for(j=0;j<=12;j++)
+	  MONTHLY[j]=R_MONTHLY[j]=S_MONTHLY[j]=L_MONTHLY[j]=0.;
+	year++;
+      }
       mm=DATE[i].month;
-      MONTHLY[yy][mm]+=FLOW[i];
+      MONTHLY[mm]+=FLOW[i];
       YEARLY[mm]+=FLOW[i];
-      R_MONTHLY[yy][mm]+=R_FLOW[i];
+      R_MONTHLY[mm]+=R_FLOW[i];
       R_YEARLY[mm]+=R_FLOW[i];
-      S_MONTHLY[yy][mm]+=STORAGE[i];
+      S_MONTHLY[mm]+=STORAGE[i];
       S_YEARLY[mm]+=STORAGE[i];
-      L_MONTHLY[yy][mm]+=LEVEL[i];
+      L_MONTHLY[mm]+=LEVEL[i];
       L_YEARLY[mm]+=LEVEL[i];
       if(type==2) { /* i.e. reservoir */
-	fprintf(fp,"%d %d %d %f %f %.2f %.2f\n",
-		DATE[i].year,DATE[i].month,DATE[i].day,R_FLOW[i],FLOW[i],STORAGE[i],LEVEL[i]);
-	fprintf(fp_reservoir,"%d %d %d %f %f %.2f %.2f %.2f\n",
-		DATE[i].year,DATE[i].month,DATE[i].day,R_FLOW[i],FLOW[i],STORAGE[i],LEVEL[i],PowerProd[i]);
-	fprintf(fp_routed,"%d %d %d %f\n",
-		DATE[i].year,DATE[i].month,DATE[i].day,R_FLOW[i]);
+	if(fp != NULL) {
+	  fprintf(fp,"%d %d %d %f %f %.2f %.2f\n",
+		  DATE[i].year,DATE[i].month,DATE[i].day,R_FLOW[i],FLOW[i],STORAGE[i],LEVEL[i]);
+	  fprintf(fp_reservoir,"%d %d %d %f %f %.2f %.2f %.2f\n",
+		  DATE[i].year,DATE[i].month,DATE[i].day,R_FLOW[i],FLOW[i],STORAGE[i],LEVEL[i],PowerProd[i]);
+	  fprintf(fp_routed,"%d %d %d %f\n",
+		  DATE[i].year,DATE[i].month,DATE[i].day,R_FLOW[i]);
+	}
+	record[ROUTBIN_FLOW]=R_FLOW[i];
+	record[ROUTBIN_FLOW2]=FLOW[i];
+	record[ROUTBIN_STORAGE]=STORAGE[i];
+	record[ROUTBIN_LEVEL]=LEVEL[i];
+	record[ROUTBIN_POWER]=PowerProd[i];
       }
       else {
-	fprintf(fp,"%d %d %d %f %f %.2f %.2f\n",
-		DATE[i].year,DATE[i].month,DATE[i].day,FLOW[i],R_FLOW[i],0.,0.);
-	fprintf(fp_routed,"%d %d %d %f\n",
-		DATE[i].year,DATE[i].month,DATE[i].day,FLOW[i]);
+	if(fp != NULL) {
+	  fprintf(fp,"%d %d %d %f %f %.2f %.2f\n",
+		  DATE[i].year,DATE[i].month,DATE[i].day,FLOW[i],R_FLOW[i],0.,0.);
+	  fprintf(fp_routed,"%d %d %d %f\n",
+		  DATE[i].year,DATE[i].month,DATE[i].day,FLOW[i]);
+	}
+	record[ROUTBIN_FLOW]=FLOW[i];
+	record[ROUTBIN_FLOW2]=R_FLOW[i];
+	record[ROUTBIN_STORAGE]=0.;
+	record[ROUTBIN_LEVEL]=0.;
+	record[ROUTBIN_POWER]=0.;
+      }
+      if(rb_day != NULL) {
+	if(rb_day->header.nrecs == 0) {
+	  rb_day->header.start_year=DATE[i].year;
+	  rb_day->header.start_month=DATE[i].month;
+	  rb_day->header.start_day=DATE[i].day;
+	}
+	WriteRoutBinary(rb_day,record);
       }
     }
   }
 
-  fclose(fp);
-  fclose(fp_routed);
-  if(type==2) fclose(fp_reservoir);
-
-  /* Write monthly data */
-  sprintf(filename_fp,"%s%s.month",outpath,name);
-  if((fp = fopen(filename_fp, "w")) == NULL) {
-    printf("Cannot open %s\n",filename_fp);
-    exit(1);
+  /* Write the remaining monthly data */
+  while(year<=last_year) {
+    WriteMonths(fp_month,rb_month,year,
+		(year==first_year) ? first_month : 1,
+		(year==last_year) ? last_month : 12,type,
+		MONTHLY,R_MONTHLY,S_MONTHLY,L_MONTHLY,
+		&feb_days,&feb_nrs);
+    for(j=0;j<=12;j++)
+      MONTHLY[j]=R_MONTHLY[j]=S_MONTHLY[j]=L_MONTHLY[j]=0.;
+    year++;
   }
 
-  feb_days=feb_nrs=0;
-  i=0;
-  leap_year=IsLeapYear(i+first_year);
-  if(first_year==last_year) {
-    for(j=first_month;j<=last_month;j++) {
-      days=DaysInMonth[j];
-      if(j==2) {
-	days=DaysInMonth[j]+leap_year;
-	feb_days+=days;
-	feb_nrs+=1;
-      }
-      if(type==2) {
-	fprintf(fp,"%d %d %f %f %f %f\n",
-		i+first_year,j,R_MONTHLY[i][j]/days,
-		MONTHLY[i][j]/days,
-		S_MONTHLY[i][j]/days,
-		L_MONTHLY[i][j]/days);
-      }
-      else {
-	fprintf(fp,"%d %d %f %f %f %f\n",
-		i+first_year,j,MONTHLY[i][j]/days,
-		R_MONTHLY[i][j]/days,
-		0.,0.);
-      }
-    }    
+  if(fp != NULL) {
+    fclose(fp);
+    fclose(fp_routed);
+    fclose(fp_month);
+    if(type==2) fclose(fp_reservoir);
   }
-  else {
-    for(j=first_month;j<=12;j++) {
-      days=DaysInMonth[j];
-      if(j==2) {
-        days=DaysInMonth[j]+leap_year;
-	feb_days+=days;
-	feb_nrs+=1;
-      }
-      if(type==2) {
-	fprintf(fp,"%d %d %f %f %f %f\n",
-		i+first_year,j,R_MONTHLY[i][j]/days,
-		MONTHLY[i][j]/days,
-		S_MONTHLY[i][j]/days,
-		L_MONTHLY[i][j]/days);
-      }
-      else {
-	fprintf(fp,"%d %d %f %f %f %f\n",
-		i+first_year,j,MONTHLY[i][j]/days,
-		R_MONTHLY[i][j]/days,
-		0.,0.);
-      }
-    }
-    for(i=1;i<last_year-first_year;i++) {
-      leap_year=IsLeapYear(i+first_year);
-      for(j=1;j<=12;j++) {
-	days=DaysInMonth[j];
-	if(j==2) {
-	  days=DaysInMonth[j]+leap_year;
-	  feb_days+=days;
-	  feb_nrs+=1;
-	}
-	if(type==2) {
-	  fprintf(fp,"%d %d %f %f %f %f\n",
-		  i+first_year,j,R_MONTHLY[i][j]/days,
-		  MONTHLY[i][j]/days,
-		  S_MONTHLY[i][j]/days,
-		  L_MONTHLY[i][j]/days);
-	}
-	else  {
-	  fprintf(fp,"%d %d %f %f %f %f\n",
-		  i+first_year,j,MONTHLY[i][j]/days,
-		  R_MONTHLY[i][j]/days,
-		  0.,0.);
-	}
-      }
-    }
-    i=last_year-first_year;
-    leap_year=IsLeapYear(i+first_year);
-    for(j=1;j<=last_month;j++) {
-      days=DaysInMonth[j];
-      if(j==2) {
-       days=DaysInMonth[j]+leap_year;
-	feb_days+=days;
-	feb_nrs+=1;
-      }
-      if(type==2) {
-	fprintf(fp,"%d %d %f %f %f %f\n",
-		i+first_year,j,R_MONTHLY[i][j]/days,
-		MONTHLY[i][j]/days,
-		S_MONTHLY[i][j]/days,
-		L_MONTHLY[i][j]/days);
-      }
-      else {	
-	fprintf(fp,"%d %d %f %f %f %f\n",
-		i+first_year,j,MONTHLY[i][j]/days,
-		R_MONTHLY[i][j]/days,
-		0.,0.);
-      }
-    }   
+  if(rb_day != NULL) {
+    CloseRoutBinary(rb_day);
+    CloseRoutBinary(rb_month);
   }
-  fclose(fp);
 
   /* Write mean monthly data */
-  sprintf(filename_fp,"%s%s.year",outpath,name);
-  if((fp = fopen(filename_fp, "w")) == NULL) {
-    printf("Cannot open %s\n",filename_fp);
-    exit(1);
+  fp = NULL;
+  if(out_format & OUT_ASCII) {
+    sprintf(filename,"%s%s.year",outpath,name);
+    if((fp = fopen(filename, "w")) == NULL) {
+      printf("Cannot open %s\n",filename);
+      exit(1);
+    }
+  }
+  if(out_format & OUT_BINARY) {
+    sprintf(filename,"%s%s.year.bin",outpath,name);
+    rb_year = OpenRoutBinary(filename,type,ROUTBIN_MEANMON,4,lat,lon,
+			     0,1,1);
   }
 
   for(i=1;i<=12;i++) {
     days=DaysInMonth[i];
     if(i==2) days=(float)feb_days/(float)feb_nrs;
     if(type==2) {
-      fprintf(fp,"%d %f %f %f %f\n",
-	      i,R_YEARLY[i]/(nyears[i]*days),
-	      YEARLY[i]/(nyears[i]*days),
-	      S_YEARLY[i]/(nyears[i]*days),
-	      L_YEARLY[i]/(nyears[i]*days));
+      record[0]=R_YEARLY[i]/(nyears[i]*days);
+      record[1]=YEARLY[i]/(nyears[i]*days);
     }
     else {
-      fprintf(fp,"%d %f %f %f %f\n",
-	      i,YEARLY[i]/(nyears[i]*days),
-	      R_YEARLY[i]/(nyears[i]*days),
-	      S_YEARLY[i]/(nyears[i]*days),
-	      L_YEARLY[i]/(nyears[i]*days));
+      record[0]=YEARLY[i]/(nyears[i]*days);
+      record[1]=R_YEARLY[i]/(nyears[i]*days);
     }
+    record[2]=S_YEARLY[i]/(nyears[i]*days);
+    record[3]=L_YEARLY[i]/(nyears[i]*days);
+    if(fp != NULL)
+      fprintf(fp,"%d %f %f %f %f\n",
+	      i,record[0],record[1],record[2],record[3]);
+    if(rb_year != NULL)
+      WriteRoutBinary(rb_year,record);
   }
 
-  fclose(fp);
+  if(fp != NULL) fclose(fp);
+  if(rb_year != NULL) CloseRoutBinary(rb_year);
 }
 
+/* Write monthly means for months mstart..mend of one year */
+static void WriteMonths(FILE *fp,
+			ROUTBIN *rb,
+			int year,
+			int mstart,
+			int mend,
+			int type,
+			float *MONTHLY,
+			float *R_MONTHLY,
+			float *S_MONTHLY,
+			float *L_MONTHLY,
+			int *feb_days,
+			int *feb_nrs)
+{
+  int DaysInMonth[13] = { 0,31,28,31,30,31,30,31,31,30,31,30,31 };
+  float record[4];
+  float days;
+  int leap_year;
+  int j;
 
+  leap_year=IsLeapYear(year);
+  for(j=mstart;j<=mend;j++) {
+    days=DaysInMonth[j];
+    if(j==2) {
+      days=DaysInMonth[j]+leap_year;
+      (*feb_days)+=days;
+      (*feb_nrs)+=1;
+    }
+    if(type==2) {
+      record[0]=R_MONTHLY[j]/days;
+      record[1]=MONTHLY[j]/days;
+      record[2]=S_MONTHLY[j]/days;
+      record[3]=L_MONTHLY[j]/days;
+    }
+    else {
+      record[0]=MONTHLY[j]/days;
+      record[1]=R_MONTHLY[j]/days;
+      record[2]=0.;
+      record[3]=0.;
+    }
+    if(fp != NULL)
+      fprintf(fp,"%d %d %f %f %f %f\n",
+	      year,j,record[0],record[1],record[2],record[3]);
+    if(rb != NULL)
+      WriteRoutBinary(rb,record);
+  }
+}
@@ -112,6 +112,7 @@ int main(int argc, char *argv[]) {
   int missing;
   int demand;
   int basin_number;           //basin number...  
+  int out_format;             //OUT_ASCII, OUT_BINARY or OUT_BOTH
   int nbytes = 98;              /* nbytes pr day in flux files used in ReadDataForReservoirEvaporation.
                               bad programming....should not be hardcoded!!! */
                               /***********************************************************/
@@ -312,6 +313,21 @@ int main(int argc, char *argv[]) {
   fscanf(fp, "%*s %s", moscem_path);
   /* read file path to moscem output (Ning rev) */
   fscanf(fp, "%*s %s", moscem_outfile);
+  /* Optional: format of routed output files (ASCII, BINARY or BOTH).
+     Default is ASCII, which the scripts and programs in programs/ expect */
+  out_format = OUT_ASCII;
+  if (fscanf(fp, "%*s %s", dummy) == 1) {
+    if (strcmp(dummy, "BINARY") == 0)
+      out_format = OUT_BINARY;
+    else if (strcmp(dummy, "BOTH") == 0)
+      out_format = OUT_BOTH;
+    else if (strcmp(dummy, "ASCII") != 0) {
+      printf("Unknown OUTPUT_FORMAT %s (ASCII, BINARY or BOTH)\n", dummy);
+      exit(1);
+    }
+  }
+  printf("Output format: %s\n", out_format == OUT_ASCII ? "ASCII" :
+    (out_format == OUT_BINARY ? "BINARY" : "BOTH"));
   fclose(fp);
 
   /* Make impulse response function (UH). */
@@ -352,7 +368,7 @@ int main(int argc, char *argv[]) {
         xllcorner, yllcorner, size,
         inpath, outpath, workpath, decimal_places, DATE,
         &factor_sum, first_year, first_month, irr_rout,
-        missing);
+        missing, out_format);
 
       /* Find lat and lon of station */
       lat = yllcorner + STATION[nr].row*size - size / 2.0;
@@ -383,7 +399,7 @@ int main(int argc, char *argv[]) {
         DATE, factor_sum,
         first_year, first_month, last_year,
         last_month, start_year, lat, lon, STATION[nr].type,
-        decimal_places);
+        decimal_places, out_format);
       if (irr_rout == 1) {
         for (i = 3; i <= upstream_cells; i++) {
           irow = CATCHMENT[i][0];
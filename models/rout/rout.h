@@ -2,6 +2,7 @@
 #include <stdlib.h>
 #include <stdio.h>
 #include "rout_def.h"
+#include "routbin.h"
 
 /*** SubRoutine Prototypes ***/
 void CalculateMeanInflow(double *,TIME *,int,float *,
@@ -18,7 +19,7 @@ void MakeConvolution(int,int,int,int **,ARC **,
 		     double *,double *,double *,float **,
 		     LIST *,int,float,float,float,
 		     char *,char *,char *,int,TIME *,float *,
-		     int,int,int,int);
+		     int,int,int,int,int);
 void MakeDirectionFile(ARC **,int **,int,int,int,float,
 		       float,float,int);
 void MakeRoutedFile(ARC **,int **,int,int,int);
@@ -39,6 +40,7 @@ void ReadStation(char *,ARC **,LIST *,int,int,
 void ReadVelocity(char *, ARC **,int,int); 
 void ReadWaterDemand(char *,char *,float **,int,int,int,float *,float,int); 
 void ReadXmask(char *, ARC **,int,int); 
+void MoscemWarmStart(char *,char *,int,int);
 void ReservoirRouting(char *,char *,char *, char *, double *,float *,
 		      float *,float *,float *,float **,float **,
 		      TIME *,char *,int,int,int,int,
@@ -48,4 +50,4 @@ void SearchCatchment(ARC **,int **,int,
 void SearchRouted(ARC **,int,int,int,int);
 void WriteData(double *,float *,float *,float *,
 	       float *,char *,char *,int,int,TIME *,
-	       float,int,int,int,int,int,float,float,int,int);
+	       float,int,int,int,int,int,float,float,int,int,int);
@@ -0,0 +1,72 @@
+/*************************************************************/
+/* Binary time series format for routed output               */
+/*                                                           */
+/* Self-contained so that the stand-alone programs in        */
+/* programs/C can use the reader without rout_def.h:         */
+/*   gcc -I<rout dir> tool.c <rout dir>/RoutBinary.c -lm     */
+/*                                                           */
+/* Layout: one ROUTBIN_HEADER followed by nrecs records of   */
+/* nvars native floats each. Record dates are implied by the */
+/* start date and the time step given in the header.         */
+/*************************************************************/
+#ifndef ROUTBIN_H
+#define ROUTBIN_H
+
+#include <stdio.h>
+
+#define ROUTBIN_MAGIC "ROUTBIN"
+#define ROUTBIN_VERSION 1
+#define ROUTBIN_MAXVARS 5
+
+/* Output formats, OUTPUT_FORMAT in the routing input file */
+#define OUT_ASCII  1
+#define OUT_BINARY 2
+#define OUT_BOTH   (OUT_ASCII|OUT_BINARY)
+
+/* Time step of the records */
+#define ROUTBIN_DAILY   1
+#define ROUTBIN_MONTHLY 2
+#define ROUTBIN_MEANMON 3  /* mean monthly values, 12 records */
+
+/* Variables, in record order. ROUTBIN_FLOW is the value written
+   to the ascii streamflow_<lat>_<lon> files; ROUTBIN_FLOW2 is the
+   second flow column of the .day/.month files (natural inflow for
+   reservoirs). ROUTBIN_POWER is only present in daily files. */
+#define ROUTBIN_FLOW    0
+#define ROUTBIN_FLOW2   1
+#define ROUTBIN_STORAGE 2
+#define ROUTBIN_LEVEL   3
+#define ROUTBIN_POWER   4
+
+typedef struct {
+  char magic[8];
+  int version;
+  int type;        /* station type, 1: Regular, 2: Dam, 3: Irrigated part of cell */
+  int step;        /* ROUTBIN_DAILY, ROUTBIN_MONTHLY or ROUTBIN_MEANMON */
+  int nvars;
+  int nrecs;
+  int start_year;
+  int start_month;
+  int start_day;
+  float lat;
+  float lon;
+} ROUTBIN_HEADER;
+
+typedef struct {
+  FILE *fp;
+  int writing;     /* opened by OpenRoutBinary */
+  ROUTBIN_HEADER header;
+} ROUTBIN;
+
+/* Writer */
+ROUTBIN *OpenRoutBinary(char *,int,int,int,float,float,int,int,int);
+void WriteRoutBinary(ROUTBIN *,float *);
+void CloseRoutBinary(ROUTBIN *);
+
+/* Reader */
+ROUTBIN *OpenRoutBinaryRead(char *);
+int ReadRoutBinary(ROUTBIN *,int,int,int,float *);
+void RoutBinaryNextDate(int,int *,int *,int *);
+int RoutBinaryStale(char *,char *);
+
+#endif
@@ -22,11 +22,16 @@
  *   2004-Oct-04 Merged with Laura Bowling's updated lake model code.		TJB
  *   2007-Apr-03 Module returns an ERROR value that can be trapped in main      GCT
  *   2011-Nov-04 Updated mtclim functions to MTCLIM 4.3.			TJB
+ *   2026-Oct-18 Added BLOWING_TABLE: the suspension layer integrals of
+ *	         CalcSubFlux() can be interpolated from a table of U10 and
+ *	         ushear built by init_blowing_table().
  */
 
 #include <stdarg.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
 #include <vicNl.h>
 #include <mtclim_constants_vic.h>
 
@@ -53,6 +58,22 @@ static char vcid[] = "$Id$";
 #define FETCH 1               /* Include fetch dependence (1). */
 #define CALC_PROB 1             /* Variable (1) or constant (0) probability of occurence. */
 
+/* Table of the suspension layer integrals (BLOWING_TABLE) */
+#define BT_MAGIC "VICBLWT"
+#define BT_VERSION 1
+#define BT_NWIND 129            /* Table points in log(U10). */
+#define BT_NSHEAR 129           /* Table points in log(ushear). */
+#define BT_WINDMIN 0.4          /* Range of U10 (m/s), as limited in CalcBlowingSnow(). */
+#define BT_WINDMAX 25.
+#define BT_SHEARMIN 0.05        /* Range of ushear (m/s). */
+#define BT_SHEARMAX 3.
+#define BT_NCHECK 16            /* Wind speeds per forcing in check_blowing_table(). */
+#define BT_TOL 0.01             /* Largest relative error of a table that is used. */
+#define BT_SUB 0                /* Integrals stored for each point. */
+#define BT_TRANS 1
+#define BT_CONC 2
+#define BT_N 3
+
 double qromb(double (*sub_with_height)(), double es, double Wind, double AirDens, double ZO, 
 	     double EactAir, double F, double hsalt, double phi_r, double ushear, double Zrh, 
 	     double a, double b);
@@ -65,6 +86,9 @@ double sub_with_height(double z,double es,  double Wind, double AirDens, double
 double transport_with_height(double z,double es,  double Wind, double AirDens, double ZO,
 				double EactAir,double F, double hsalt, double phi_r,         
 				double ushear, double Zrh);
+double conc_with_height(double z,double es,  double Wind, double AirDens, double ZO,
+			double EactAir,double F, double hsalt, double phi_r,
+			double ushear, double Zrh);
 double rtnewt(double x1, double x2, double xacc, double Ur, double Zr);
 void get_shear(double x, double *f, double *df, double Ur, double Zr);
 double get_prob(double Tair, double Age, double SurfaceLiquidWater, double U10);
@@ -74,6 +98,15 @@ double CalcSubFlux(double EactAir, double es, double Zrh, double AirDens, double
 		   double ushear, double fe, double Tsnow, double Tair, double U10, 
 		   double Zo_salt, double F, double *Transport);
 
+static void blowing_integrals(double U10, double ushear, double *J);
+static int lookup_blowing_table(double U10, double ushear, double *J);
+static int read_blowing_table(char *filename);
+static void write_blowing_table(char *filename);
+static double check_blowing_table();
+
+static double *blowing_table = NULL;  /* log of the integrals, [wind][shear][BT_N] */
+static char use_table = FALSE;
+
 /*****************************************************************************
   Function name: CalcBlowingSnow()
 
@@ -677,6 +710,8 @@ double CalcSubFlux(double EactAir, double es, double Zrh, double AirDens, double
   double particle;
   double saltation_transport;
   double suspension_transport;
+  double J[BT_N];
+  int tabulated;
 
   SubFlux=0.0;
   particle = utshear*2.8;
@@ -714,6 +749,8 @@ double CalcSubFlux(double EactAir, double es, double Zrh, double AirDens, double
     T = 0.5*(ushear*ushear)/(U10*SETTLING);
     ztop = hsalt*pow(T/(T+1.), (von_K*ushear)/(-1.*SETTLING));
 
+    tabulated = (use_table && lookup_blowing_table(U10, ushear, J));
+
     if(EactAir >= es) {
       SubFlux = 0.0;
     }
@@ -727,16 +764,24 @@ double CalcSubFlux(double EactAir, double es, double Zrh, double AirDens, double
 	SubFlux = phi_s*psi_s*hsalt;
     
 	//  Suspension layer must be integrated
-	SubFlux += qromb(sub_with_height, es, U10, AirDens, Zo_salt, EactAir, F, hsalt,
-			 phi_s, ushear, Zrh, hsalt, ztop);
+	if(tabulated)
+	  SubFlux += ((EactAir/es) - 1.) / F * phi_s * J[BT_SUB];
+	else
+	  SubFlux += qromb(sub_with_height, es, U10, AirDens, Zo_salt, EactAir, F, hsalt,
+			   phi_s, ushear, Zrh, hsalt, ztop);
       }
 
     // Transport out of the domain by saltation Qs(fe) (kg/m*s), eq 10 Liston and Sturm
     saltation_transport = Qsalt*(1-exp(-3.*fe/500.));
 
     // Transport in the suspension layer
-    suspension_transport = qromb(transport_with_height, es, U10, AirDens, Zo_salt, 
-    				 EactAir, F, hsalt, phi_s, ushear, Zrh, hsalt, ztop);
+    if(tabulated)
+      suspension_transport = phi_s * (J[BT_TRANS] + ushear / von_K
+				      * log(0.12*ushear*ushear/(2.*G_STD)/Zo_salt)
+				      * J[BT_CONC]);
+    else
+      suspension_transport = qromb(transport_with_height, es, U10, AirDens, Zo_salt, 
+				   EactAir, F, hsalt, phi_s, ushear, Zrh, hsalt, ztop);
 
     // Transport at the downstream edge of the fetch in kg/m*s
     *Transport = (suspension_transport + saltation_transport);
@@ -800,3 +845,280 @@ double transport_with_height(double z,
   
   return u_z * phi_t;
 }
+
+/*****************************************************************************
+  Function name: conc_with_height()
+
+  Purpose      : Calculate the concentration of turbulent suspended snow
+                 for a given height above the boundary layer.
+
+  Required     : as transport_with_height()
+
+  Returns      :
+   double f(z)             - Concentration in kg/m^3
+
+  Modifies     : none
+
+*****************************************************************************/
+double conc_with_height(double z,
+			double es,
+			double Wind,
+			double AirDens,
+			double ZO,
+			double EactAir,
+			double F,
+			double hsalt,
+			double phi_r,
+			double ushear,
+			double Zrh)
+{
+  double temp;
+
+  // Concentration of turbulent suspended snow Kind (1992)
+
+  temp = (0.5*ushear*ushear)/(Wind*SETTLING);
+  return phi_r* ( (temp + 1.) * pow((z/hsalt),(-1.*SETTLING)/(von_K*ushear)) - temp );
+}
+
+/*****************************************************************************
+  Function name: init_blowing_table()
+
+  Purpose      : Build the table of the suspension layer integrals used by
+                 CalcSubFlux() when options.BLOWING_TABLE is TRUE.
+
+  Required     :
+    char *filename         - Table file, or "MISSING" to build the table
+                             without storing it
+
+  Returns      : none
+
+  Modifies     : the table of this file
+
+  Comments     : For unit humidity deficit (EactAir/es - 1), F and
+                 saltation layer concentration, the integrals of
+                 sub_with_height() and transport_with_height() over the
+                 suspension layer only depend on U10 and ushear.  The
+                 table holds their logarithm on a grid in log(U10) and
+                 log(ushear), with transport taken at the saltation
+                 roughness 0.12*ushear^2/(2g) and the integral of the
+                 concentration, which moves it to any other roughness.
+                 Values are interpolated bilinearly; outside the grid
+                 CalcSubFlux() integrates as before.
+                 The table is read from filename if it holds a table of
+                 the same grid, and written to it otherwise.  Either way
+                 it is compared with the integration by
+                 check_blowing_table() before it is used.
+*****************************************************************************/
+void init_blowing_table(char *filename)
+{
+  char   ErrStr[MAXSTRING];
+  int    i, j, k;
+  int    from_file;
+  double J[BT_N];
+  double err;
+
+  if (blowing_table != NULL)
+    return;
+
+  blowing_table = (double *) malloc(BT_NWIND*BT_NSHEAR*BT_N*sizeof(double));
+  if (blowing_table == NULL)
+    nrerror("Memory allocation error in init_blowing_table().");
+
+  from_file = (strcmp(filename, "MISSING") != 0 && read_blowing_table(filename));
+
+  while (TRUE) {
+    if (!from_file) {
+      for (i = 0; i < BT_NWIND; i++) {
+	for (j = 0; j < BT_NSHEAR; j++) {
+	  blowing_integrals(BT_WINDMIN*pow(BT_WINDMAX/BT_WINDMIN, i/(BT_NWIND-1.)),
+			    BT_SHEARMIN*pow(BT_SHEARMAX/BT_SHEARMIN, j/(BT_NSHEAR-1.)),
+			    J);
+	  for (k = 0; k < BT_N; k++)
+	    blowing_table[(i*BT_NSHEAR+j)*BT_N+k] = log(J[k]);
+	}
+      }
+    }
+
+    err = check_blowing_table();
+    if (err <= BT_TOL)
+      break;
+    if (!from_file) {
+      sprintf(ErrStr, "The blowing snow table differs from the integration by %.3g (relative), more than %.3g.", err, BT_TOL);
+      nrerror(ErrStr);
+    }
+    fprintf(stderr, "WARNING: Blowing snow table %s differs from the integration by %.3g (relative); building it again.\n", filename, err);
+    from_file = FALSE;
+  }
+
+  if (!from_file && strcmp(filename, "MISSING") != 0)
+    write_blowing_table(filename);
+
+  fprintf(stderr, "Blowing snow table: %d x %d points, largest relative error %.3g\n",
+	  BT_NWIND, BT_NSHEAR, err);
+
+  use_table = TRUE;
+}
+
+/* Suspension layer integrals for unit humidity deficit, F and phi_r */
+static void blowing_integrals(double U10, double ushear, double *J)
+{
+  double hsalt, T, ztop, Zo_ref;
+
+  hsalt = 0.08436*pow(ushear,1.27);
+  T = 0.5*(ushear*ushear)/(U10*SETTLING);
+  ztop = hsalt*pow(T/(T+1.), (von_K*ushear)/(-1.*SETTLING));
+  Zo_ref = 0.12*ushear*ushear/(2.*G_STD);
+
+  J[BT_SUB] = qromb(sub_with_height, 1., U10, 1., Zo_ref, 2., 1., hsalt,
+		    1., ushear, 2., hsalt, ztop);
+  J[BT_TRANS] = qromb(transport_with_height, 1., U10, 1., Zo_ref, 2., 1., hsalt,
+		      1., ushear, 2., hsalt, ztop);
+  J[BT_CONC] = qromb(conc_with_height, 1., U10, 1., Zo_ref, 2., 1., hsalt,
+		     1., ushear, 2., hsalt, ztop);
+}
+
+/* Returns FALSE if (U10, ushear) is outside the table */
+static int lookup_blowing_table(double U10, double ushear, double *J)
+{
+  double  x, y;
+  double *t;
+  int     i, j, k;
+
+  if (U10 < BT_WINDMIN || U10 > BT_WINDMAX
+      || ushear < BT_SHEARMIN || ushear > BT_SHEARMAX)
+    return FALSE;
+
+  x = log(U10/BT_WINDMIN) / log(BT_WINDMAX/BT_WINDMIN) * (BT_NWIND-1);
+  y = log(ushear/BT_SHEARMIN) / log(BT_SHEARMAX/BT_SHEARMIN) * (BT_NSHEAR-1);
+  i = (int) x;
+  if (i > BT_NWIND-2) i = BT_NWIND-2;
+  j = (int) y;
+  if (j > BT_NSHEAR-2) j = BT_NSHEAR-2;
+  x -= i;
+  y -= j;
+
+  t = &blowing_table[(i*BT_NSHEAR+j)*BT_N];
+  for (k = 0; k < BT_N; k++)
+    J[k] = exp((1.-x) * ((1.-y)*t[k] + y*t[BT_N+k])
+	       + x * ((1.-y)*t[BT_NSHEAR*BT_N+k] + y*t[(BT_NSHEAR+1)*BT_N+k]));
+
+  return TRUE;
+}
+
+/* Largest relative difference between the fluxes of CalcSubFlux() from
+   the table and from the integration, over forcings that span the
+   conditions with blowing snow */
+static double check_blowing_table()
+{
+  static double Tair[] = { -30., -15., -5., -0.5 };
+  static double ZO[]   = { 0.0001, 0.001, 0.01, 0.03 };
+
+  int    a, r, w;
+  double U10, es, Tk, Ls, F;
+  double utshear, ushear, Zo_salt;
+  double sub, sub_table;
+  double trans, trans_table;
+  double err;
+
+  err = 0.;
+  for (a = 0; a < sizeof(Tair)/sizeof(Tair[0]); a++) {
+    es = svp(Tair[a]);
+    Tk = Tair[a] + KELVIN;
+    Ls = (677. - 0.07 * Tair[a]) * JOULESPCAL * GRAMSPKG;
+    F = (Ls/(Ka*Tk))*(Ls*MW/(R*Tk) - 1.);
+    F += 1./((2.06e-5) * pow(Tk/273.,1.75) * 0.622*es/(287*Tk));
+    for (r = 0; r < sizeof(ZO)/sizeof(ZO[0]); r++) {
+      for (w = 0; w < BT_NCHECK; w++) {
+	U10 = 5. + (BT_WINDMAX - 5.) * (w + 0.5) / BT_NCHECK;
+	utshear = get_thresh(Tair[a], 0., ZO[r], VAR_THRESHOLD);
+	shear_stress(U10, ZO[r], &ushear, &Zo_salt, utshear);
+	if (ushear <= utshear)
+	  continue;
+	use_table = FALSE;
+	sub = CalcSubFlux(0.7*es, es, 2., 1.2, utshear, ushear, 1000., Tair[a],
+			  Tair[a], U10, Zo_salt, F, &trans);
+	use_table = TRUE;
+	sub_table = CalcSubFlux(0.7*es, es, 2., 1.2, utshear, ushear, 1000.,
+				Tair[a], Tair[a], U10, Zo_salt, F, &trans_table);
+	if (fabs(sub_table - sub) > err * fabs(sub))
+	  err = fabs(sub_table - sub) / fabs(sub);
+	if (fabs(trans_table - trans) > err * fabs(trans))
+	  err = fabs(trans_table - trans) / fabs(trans);
+      }
+    }
+  }
+  use_table = FALSE;
+
+  return err;
+}
+
+/* Returns TRUE if filename holds a table of the same grid */
+static int read_blowing_table(char *filename)
+{
+  FILE   *fp;
+  char    magic[8];
+  int     header[3];
+  double  range[4];
+  int     n;
+  int     ok;
+
+  if ((fp = fopen(filename, "rb")) == NULL)
+    return FALSE;
+
+  n = BT_NWIND*BT_NSHEAR*BT_N;
+  ok = (fread(magic, sizeof(char), 8, fp) == 8
+	&& memcmp(magic, BT_MAGIC, 8) == 0
+	&& fread(header, sizeof(int), 3, fp) == 3
+	&& header[0] == BT_VERSION && header[1] == BT_NWIND && header[2] == BT_NSHEAR
+	&& fread(range, sizeof(double), 4, fp) == 4
+	&& range[0] == BT_WINDMIN && range[1] == BT_WINDMAX
+	&& range[2] == BT_SHEARMIN && range[3] == BT_SHEARMAX
+	&& fread(blowing_table, sizeof(double), n, fp) == (size_t)n);
+  fclose(fp);
+
+#if VERBOSE
+  if (ok)
+    fprintf(stderr,"Read blowing snow table %s\n",filename);
+#endif
+
+  return ok;
+}
+
+/* Writes to a temporary file that is renamed when complete, so that
+   runs sharing the table never read a partly written file */
+static void write_blowing_table(char *filename)
+{
+  FILE   *fp;
+  char    tmpname[MAXSTRING+20];
+  char    magic[8] = BT_MAGIC;
+  int     header[3];
+  double  range[4];
+  int     n;
+  int     ok;
+
+  sprintf(tmpname, "%s.tmp%d", filename, (int)getpid());
+  if ((fp = fopen(tmpname, "wb")) == NULL) {
+    fprintf(stderr, "WARNING: Unable to open blowing snow table %s for writing.\n", tmpname);
+    return;
+  }
+
+  header[0] = BT_VERSION;
+  header[1] = BT_NWIND;
+  header[2] = BT_NSHEAR;
+  range[0]  = BT_WINDMIN;
+  range[1]  = BT_WINDMAX;
+  range[2]  = BT_SHEARMIN;
+  range[3]  = BT_SHEARMAX;
+  n = BT_NWIND*BT_NSHEAR*BT_N;
+  ok = (fwrite(magic, sizeof(char), 8, fp) == 8
+	&& fwrite(header, sizeof(int), 3, fp) == 3
+	&& fwrite(range, sizeof(double), 4, fp) == 4
+	&& fwrite(blowing_table, sizeof(double), n, fp) == (size_t)n);
+  if (fclose(fp) != 0)
+    ok = FALSE;
+
+  if (!ok || rename(tmpname, filename) != 0) {
+    fprintf(stderr, "WARNING: Unable to write blowing snow table %s.\n", filename);
+    unlink(tmpname);
+  }
+}
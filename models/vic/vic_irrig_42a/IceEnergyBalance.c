@@ -13,7 +13,6 @@
  * COMMENTS:     
  */
 
-#include <stdarg.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <vicNl.h>
@@ -27,9 +26,8 @@ static char vcid[] = "$Id$";
 
   Required     :
     double TSurf           - new estimate of effective surface temperature
-    va_list ap            - Argument list initialized by va_start().  For
-                            elements of list and order, see beginning of
-                            routine
+    void *params          - Pointer to the argument structure
+                            (ice_energy_bal_args_struct)
 
   Returns      :
     double RestTerm        - Rest term in the energy balance
@@ -57,16 +55,19 @@ static char vcid[] = "$Id$";
 	    blowing snow sublimation is calculated for lakes.		TJB
   2006-Sep-23 Replaced redundant STEFAN constant with STEFAN_B.  TJB
   2006-Nov-07 Removed LAKE_MODEL option. TJB
+  2026-Oct-18 Replaced the variable argument list with an argument
+	      structure passed through root_brent().
 
 *****************************************************************************/
-double IceEnergyBalance(double TSurf, va_list ap)
+double IceEnergyBalance(double TSurf, void *params)
 {
+  ice_energy_bal_args_struct *args = (ice_energy_bal_args_struct *) params;
 
   extern option_struct options;
 
   const char *Routine = "IceEnergyBalance";
 
-  /* start of list of arguments in variable argument list */
+  /* start of list of variables read from the argument structure */
 
   double Dt;                     /* Model time step (hours) */
   double Ra;                     /* Aerodynamic resistance (s/m) */
@@ -110,7 +111,7 @@ double IceEnergyBalance(double TSurf, va_list ap)
   double *SensibleHeat;		/* Sensible heat exchange at surface (W/m2) */
   double *LongRadOut;
 
-  /* end of list of arguments in variable argument list */
+  /* end of list of variables read from the argument structure */
 
   double Density;                /* Density of water/ice at TMean (kg/m3) */
   double EsSnow;                 /* saturated vapor pressure in the snow pack
@@ -129,54 +130,42 @@ double IceEnergyBalance(double TSurf, va_list ap)
   double SurfaceMassFlux;        /* Mass flux of water vapor to or from
                                     snow pack (kg/m2s) */
 
-  /* Assign the elements of the array to the appropriate variables.  The list
-     is traversed as if the elements are doubles, because:
-
-     In the variable-length part of variable-length argument lists, the old
-     ``default argument promotions'' apply: arguments of type double are
-     always promoted (widened) to type double, and types char and short int
-     are promoted to int. Therefore, it is never correct to invoke
-     va_arg(argp, double); instead you should always use va_arg(argp,
-     double). 
-
-     (quoted from the comp.lang.c FAQ list)
-     */
-  Dt                 = (double) va_arg(ap, double);
-  Ra                 = (double) va_arg(ap, double);
-  Ra_used            = (double *) va_arg(ap, double *);
-  Z                  = (double) va_arg(ap, double);
-  Displacement       = (double) va_arg(ap, double);
-  Z0                 = (double) va_arg(ap, double);
-  Wind               = (double) va_arg(ap, double);
-  ShortRad           = (double) va_arg(ap, double);
-  LongRadIn          = (double) va_arg(ap, double);
-  AirDens            = (double) va_arg(ap, double);
-  Lv                 = (double) va_arg(ap, double);
-  Tair               = (double) va_arg(ap, double);
-  Press              = (double) va_arg(ap, double);
-  Vpd                = (double) va_arg(ap, double);
-  EactAir            = (double) va_arg(ap, double);
-  Rain               = (double) va_arg(ap, double);
-  SweSurfaceLayer    = (double) va_arg(ap, double);
-  SurfaceLiquidWater = (double) va_arg(ap, double);
-  OldTSurf           = (double) va_arg(ap, double);
-  RefreezeEnergy     = (double *) va_arg(ap, double *);
-  vapor_flux         = (double *) va_arg(ap, double *);
-  blowing_flux       = (double *) va_arg(ap, double *);
-  surface_flux       = (double *) va_arg(ap, double *);
-  AdvectedEnergy     = (double *) va_arg(ap, double *);
-  DeltaColdContent   = (double) va_arg(ap, double );
-  Tfreeze            = (double) va_arg(ap, double);
-  AvgCond            = (double) va_arg(ap, double);
-  SWconducted        = (double) va_arg(ap, double);
-  SnowDepth          = (double) va_arg(ap, double);
-  SnowDensity        = (double) va_arg(ap, double);
-  SurfAttenuation    = (double) va_arg(ap, double);
-  qf                 = (double *) va_arg(ap, double *);
-  LatentHeat         = (double *) va_arg(ap, double *);
-  LatentHeatSub      = (double *) va_arg(ap, double *);
-  SensibleHeat       = (double *) va_arg(ap, double *);
-  LongRadOut         = (double *) va_arg(ap, double *);
+  Dt                 = args->Dt;
+  Ra                 = args->Ra;
+  Ra_used            = args->Ra_used;
+  Z                  = args->Z;
+  Displacement       = args->Displacement;
+  Z0                 = args->Z0;
+  Wind               = args->Wind;
+  ShortRad           = args->ShortRad;
+  LongRadIn          = args->LongRadIn;
+  AirDens            = args->AirDens;
+  Lv                 = args->Lv;
+  Tair               = args->Tair;
+  Press              = args->Press;
+  Vpd                = args->Vpd;
+  EactAir            = args->EactAir;
+  Rain               = args->Rain;
+  SweSurfaceLayer    = args->SweSurfaceLayer;
+  SurfaceLiquidWater = args->SurfaceLiquidWater;
+  OldTSurf           = args->OldTSurf;
+  RefreezeEnergy     = args->RefreezeEnergy;
+  vapor_flux         = args->vapor_flux;
+  blowing_flux       = args->blowing_flux;
+  surface_flux       = args->surface_flux;
+  AdvectedEnergy     = args->AdvectedEnergy;
+  DeltaColdContent   = args->DeltaColdContent;
+  Tfreeze            = args->Tfreeze;
+  AvgCond            = args->AvgCond;
+  SWconducted        = args->SWconducted;
+  SnowDepth          = args->SnowDepth;
+  SnowDensity        = args->SnowDensity;
+  SurfAttenuation    = args->SurfAttenuation;
+  qf                 = args->qf;
+  LatentHeat         = args->LatentHeat;
+  LatentHeatSub      = args->LatentHeatSub;
+  SensibleHeat       = args->SensibleHeat;
+  LongRadOut         = args->LongRadOut;
   
   /* Calculate active temp for energy balance as average of old and new  */
   
@@ -29,6 +29,10 @@
   2013-Jul-25 Added advect_carbon_storage().				TJB
   2013-Dec-26 Removed EXCESS_ICE option.				TJB
   2014-Mar-28 Removed DIST_PRCP option.					TJB
+  2026-Oct-18 IceEnergyBalance() takes an argument structure; removed
+	      CalcIcePackEnergyBalance() and ErrorIcePackEnergyBalance().
+  2026-Oct-18 Added temp_area_setup(), tridia_factor() and
+	      tridia_solve(); changed the argument list of temp_area().
 ******************************************************************************/
 
 //#ifndef LAKE_SET
@@ -79,20 +83,18 @@ void advect_snow_storage(double, double, double, snow_data_struct *);
 void alblake(double, double, double *, double *, float *, float *, double, double, 
 	     int, int *, double, double, char *, int, double);
 double calc_density(double);
-double CalcIcePackEnergyBalance(double Tsurf, ...);
 void colavg (double *, double *, double *, float, double *, int, double, double);
 float dragcoeff(float, double, double);
 void eddy (int, double, double * , double *, double *, double, int, double, double);
 void energycalc(double *, double *, int, double, double,double *, double *, double *);
-double ErrorIcePackEnergyBalance(double Tsurf, ...);
-double ErrorPrintIcePackEnergyBalance(double, va_list);
+double ErrorPrintIcePackEnergyBalance(double, ice_energy_bal_args_struct *, char *);
 int get_depth(lake_con_struct, double, double *);
 int get_sarea(lake_con_struct, double, double *);
 int get_volume(lake_con_struct, double, double *);
 void iceform (double *,double *,double ,double,double *,int, int, double, double, double *, double *, double *, double *, double *, double);
 void icerad(double,double ,double,double *, double *,double *);
 int ice_melt(double, double, double *, double, snow_data_struct *, lake_var_struct *, int, double, double, double, double, double, double, double, double, double, double, double, double, double, double, double *, double *, double *, double *, double *, double *, double *, double *, double *, double);
-double IceEnergyBalance(double, va_list);
+double IceEnergyBalance(double, void *);
 int initialize_lake(lake_var_struct *, lake_con_struct, soil_con_struct *, cell_data_struct *, double, int);
 int lakeice(double *, double, double, double, double, int, 
 	    double, double, double *, double, double, int, dmy_struct, double *, double *, double, double);
@@ -108,9 +110,12 @@ int solve_lake(double, double, double, double, double, double, double, double,
 		double, double, lake_var_struct *, lake_con_struct, 
 		soil_con_struct, int, int, double, dmy_struct, double);
 double specheat (double);
-void temp_area(double, double, double, double *, double *, double *, double *, int, double *, int, double, double, double*, double *, double *);
+void temp_area(lake_column_struct *, double, double *, double *, int, double *, int, double, double, double *, double *, double *);
+void temp_area_setup(double, double, double *, double *, double *, int, double *, int, double, double, double *, lake_column_struct *);
 void tracer_mixer(double *, int *, int, double*, int, double, double, double *);
 void tridia(int, double *, double *, double *, double *, double *);
+void tridia_factor(int, double *, double *, double *, double *, double *);
+void tridia_solve(int, double *, double *, double *, double *, double *);
 int water_balance (lake_var_struct *, lake_con_struct, int, all_vars_struct *, int, int, int, double, soil_con_struct, veg_con_struct);
 int  water_energy_balance(int, double*, double*, int, int, double, double, double, double, double, double, double, double, double, double, double, double, double, double *, double *, double *, double*, double *, double *, double *, double, double *, double *, double *, double *, double *, double);
 int water_under_ice(int, double,  double, double *, double *, double, int, double, double, double, double *, double *, double *, double *, int, double, double, double, double *);
@@ -13,7 +13,6 @@
  * COMMENTS:     
  */
 
-#include <stdarg.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <vicNl.h>
@@ -27,9 +26,8 @@ static char vcid[] = "$Id$";
 
   Required     :
     double TSurf           - new estimate of effective surface temperature
-    va_list ap            - Argument list initialized by va_start().  For
-                            elements of list and order, see beginning of
-                            routine
+    void *params          - Pointer to the argument structure
+                            (snowpack_energy_bal_args_struct)
 
   Returns      :
     double RestTerm        - Rest term in the energy balance
@@ -83,16 +81,19 @@ static char vcid[] = "$Id$";
 	      options.AERO_RESIST_CANSNOW.				TJB
   2009-Sep-19 Added Added ground flux computation consistent with 4.0.6.	TJB
   2013-Dec-27 Moved SPATIAL_SNOW from compile-time to run-time options.	TJB
+  2026-Oct-18 Replaced the variable argument list with an argument
+	      structure passed through root_brent().
 
 *****************************************************************************/
-double SnowPackEnergyBalance(double TSurf, va_list ap)
+double SnowPackEnergyBalance(double TSurf, void *params)
 {
+  snowpack_energy_bal_args_struct *args = (snowpack_energy_bal_args_struct *) params;
 
   extern option_struct options;
 
   const char *Routine = "SnowPackEnergyBalance";
 
-  /* Define Variable Argument List */
+  /* Define Variables Read from the Argument Structure */
 
   /* General Model Parameters */
   double Dt;                      /* Model time step (sec) */
@@ -165,64 +166,52 @@ double SnowPackEnergyBalance(double TSurf, va_list ap)
   double BlowingMassFlux;         /* Mass flux of water vapor from blowing snow. (kg/m2s) */
   double SurfaceMassFlux;         /* Mass flux of water vapor from pack snow. (kg/m2s) */
 
-  /* Assign the elements of the array to the appropriate variables.  The list
-     is traversed as if the elements are doubles, because:
-
-     In the variable-length part of variable-length argument lists, the old
-     ``default argument promotions'' apply: arguments of type double are
-     always promoted (widened) to type double, and types char and short int
-     are promoted to int. Therefore, it is never correct to invoke
-     va_arg(argp, double); instead you should always use va_arg(argp,
-     double). 
-
-     (quoted from the comp.lang.c FAQ list)
-     */
 
   /* General Model Parameters */
-  Dt           = (double) va_arg(ap, double);
-  Ra           = (double) va_arg(ap, double);
-  Ra_used      = (double *) va_arg(ap, double *);
+  Dt           = args->Dt;
+  Ra           = args->Ra;
+  Ra_used      = args->Ra_used;
 
   /* Vegetation Parameters */
-  Displacement = (double) va_arg(ap, double);
-  Z            = (double) va_arg(ap, double);
-  Z0           = (double *) va_arg(ap, double *);
+  Displacement = args->Displacement;
+  Z            = args->Z;
+  Z0           = args->Z0;
 
   /* Atmospheric Forcing Variables */
-  AirDens       = (double) va_arg(ap, double);
-  EactAir       = (double) va_arg(ap, double);
-  LongSnowIn    = (double) va_arg(ap, double);
-  Lv            = (double) va_arg(ap, double);
-  Press         = (double) va_arg(ap, double);
-  Rain          = (double) va_arg(ap, double);
-  NetShortUnder = (double) va_arg(ap, double);
-  Vpd           = (double) va_arg(ap, double);
-  Wind          = (double) va_arg(ap, double);
+  AirDens       = args->AirDens;
+  EactAir       = args->EactAir;
+  LongSnowIn    = args->LongSnowIn;
+  Lv            = args->Lv;
+  Press         = args->Press;
+  Rain          = args->Rain;
+  NetShortUnder = args->NetShortUnder;
+  Vpd           = args->Vpd;
+  Wind          = args->Wind;
 
   /* Snowpack Variables */
-  OldTSurf           = (double) va_arg(ap, double);
-  SnowCoverFract     = (double) va_arg(ap, double);
-  SnowDepth          = (double) va_arg(ap, double);
-  SnowDensity        = (double) va_arg(ap, double);
-  SurfaceLiquidWater = (double) va_arg(ap, double);
-  SweSurfaceLayer    = (double) va_arg(ap, double);
+  OldTSurf           = args->OldTSurf;
+  SnowCoverFract     = args->SnowCoverFract;
+  SnowDepth          = args->SnowDepth;
+  SnowDensity        = args->SnowDensity;
+  SurfaceLiquidWater = args->SurfaceLiquidWater;
+  SweSurfaceLayer    = args->SweSurfaceLayer;
 
   /* Energy Balance Components */
-  Tair = (double) va_arg(ap, double);
-  TGrnd   = (double) va_arg(ap, double);
-
-  AdvectedEnergy        = (double *) va_arg(ap, double *);
-  AdvectedSensibleHeat  = (double *)va_arg(ap, double *);
-  DeltaColdContent      = (double *) va_arg(ap, double *);
-  GroundFlux            = (double *) va_arg(ap, double *);
-  LatentHeat            = (double *) va_arg(ap, double *);
-  LatentHeatSub         = (double *) va_arg(ap, double *);
-  NetLongUnder          = (double *) va_arg(ap, double *);
-  RefreezeEnergy        = (double *) va_arg(ap, double *);
-  SensibleHeat          = (double *) va_arg(ap, double *);
-  vapor_flux            = (double *) va_arg(ap, double *);
-  blowing_flux          = (double *) va_arg(ap, double *); 
-  surface_flux          = (double *) va_arg(ap, double *);   
+  Tair = args->Tair;
+  TGrnd   = args->TGrnd;
+
+  AdvectedEnergy        = args->AdvectedEnergy;
+  AdvectedSensibleHeat  = args->AdvectedSensibleHeat;
+  DeltaColdContent      = args->DeltaColdContent;
+  GroundFlux            = args->GroundFlux;
+  LatentHeat            = args->LatentHeat;
+  LatentHeatSub         = args->LatentHeatSub;
+  NetLongUnder          = args->NetLongUnder;
+  RefreezeEnergy        = args->RefreezeEnergy;
+  SensibleHeat          = args->SensibleHeat;
+  vapor_flux            = args->vapor_flux;
+  blowing_flux          = args->blowing_flux; 
+  surface_flux          = args->surface_flux;   
 
   /* Calculate active temp for energy balance as average of old and new  */
   
@@ -18,6 +18,8 @@
 
 static char vcid[] = "$Id$";
 
+#define N_ATMOS_ARRAYS 17 /* double arrays in atmos_data_struct */
+
 /****************************************************************************/
 /*			       alloc_atmos()                                */
 /****************************************************************************/
@@ -35,72 +37,52 @@ void alloc_atmos(int nrecs, atmos_data_struct **atmos)
   2010-Sep-24 Renamed runoff_in to channel_in.				TJB
   2011-Nov-04 Added tskc.						TJB
   2013-Jul-25 Added Catm, coszen, fdir, and par.			TJB
+  2026-Oct-18 Each variable is now one array over all records and
+	      snow steps, and all of them share a single allocation;
+	      (*atmos)[i].var points to the NR+1 values of record i.
+	      The pointers of record 0 hold the start of the arrays,
+	      see free_atmos().
 
 *******************************************************************/
 {
   extern param_set_struct param_set;
 
-  int i;
+  int     i;
+  size_t  n;
+  double *block;
+  char   *flags;
 
   *atmos = (atmos_data_struct *) calloc(nrecs, sizeof(atmos_data_struct)); 
   if (*atmos == NULL)
     vicerror("Memory allocation error in alloc_atmos().");
 
+  n = (size_t)nrecs*(NR+1);
+  block = (double *) calloc(N_ATMOS_ARRAYS*n, sizeof(double));
+  if (block == NULL)
+    vicerror("Memory allocation error in alloc_atmos().");
+  flags = (char *) calloc(n, sizeof(char));
+  if (flags == NULL)
+    vicerror("Memory allocation error in alloc_atmos().");
+
   for (i = 0; i < nrecs; i++) {
-    (*atmos)[i].air_temp = (double *) calloc(NR+1, sizeof(double));
-    if ((*atmos)[i].air_temp == NULL)
-      vicerror("Memory allocation error in alloc_atmos().");
-    (*atmos)[i].Catm = (double *) calloc(NR+1, sizeof(double));
-    if ((*atmos)[i].Catm == NULL)
-      vicerror("Memory allocation error in alloc_atmos().");
-    (*atmos)[i].channel_in = (double *) calloc(NR+1, sizeof(double));	
-    if ((*atmos)[i].channel_in == NULL)
-      vicerror("Memory allocation error in alloc_atmos().");
-    (*atmos)[i].coszen = (double *) calloc(NR+1, sizeof(double));
-    if ((*atmos)[i].coszen == NULL)
-      vicerror("Memory allocation error in alloc_atmos().");
-    (*atmos)[i].density = (double *) calloc(NR+1, sizeof(double));	
-    if ((*atmos)[i].density == NULL)
-      vicerror("Memory allocation error in alloc_atmos().");
-    (*atmos)[i].fdir = (double *) calloc(NR+1, sizeof(double));
-    if ((*atmos)[i].fdir == NULL)
-      vicerror("Memory allocation error in alloc_atmos().");
-    (*atmos)[i].longwave = (double *) calloc(NR+1, sizeof(double));	
-    if ((*atmos)[i].longwave == NULL)
-      vicerror("Memory allocation error in alloc_atmos().");
-    (*atmos)[i].par = (double *) calloc(NR+1, sizeof(double));
-    if ((*atmos)[i].par == NULL)
-      vicerror("Memory allocation error in alloc_atmos().");
-    (*atmos)[i].prec = (double *) calloc(NR+1, sizeof(double));
-    if ((*atmos)[i].prec == NULL)
-      vicerror("Memory allocation error in alloc_atmos().");      
-    (*atmos)[i].pressure = (double *) calloc(NR+1, sizeof(double));
-    if ((*atmos)[i].pressure == NULL)
-      vicerror("Memory allocation error in alloc_atmos().");
-    (*atmos)[i].shortwave = (double *) calloc(NR+1, sizeof(double));	
-    if ((*atmos)[i].shortwave == NULL)
-      vicerror("Memory allocation error in alloc_atmos().");
-    (*atmos)[i].snowflag = (char *) calloc(NR+1, sizeof(char));	
-    if ((*atmos)[i].snowflag == NULL)
-      vicerror("Memory allocation error in alloc_atmos().");
-    (*atmos)[i].tskc = (double *) calloc(NR+1, sizeof(double));	
-    if ((*atmos)[i].tskc == NULL)
-      vicerror("Memory allocation error in alloc_atmos().");
-    (*atmos)[i].vp = (double *) calloc(NR+1, sizeof(double));	
-    if ((*atmos)[i].vp == NULL)
-      vicerror("Memory allocation error in alloc_atmos().");
-    (*atmos)[i].vpd = (double *) calloc(NR+1, sizeof(double));
-    if ((*atmos)[i].vpd == NULL)
-      vicerror("Memory allocation error in alloc_atmos().");
-    (*atmos)[i].wind = (double *) calloc(NR+1, sizeof(double));
-    if ((*atmos)[i].wind == NULL)
-      vicerror("Memory allocation error in alloc_atmos().");
-    (*atmos)[i].irr_run = (double *) calloc(NR+1, sizeof(double));
-    if ((*atmos)[i].irr_run == NULL)
-      vicerror("Memory allocation error in alloc_atmos().");
-    (*atmos)[i].irr_with = (double *) calloc(NR+1, sizeof(double));
-    if ((*atmos)[i].irr_with == NULL)
-      vicerror("Memory allocation error in alloc_atmos().");
+    (*atmos)[i].air_temp   = block +  0*n + i*(NR+1);
+    (*atmos)[i].Catm       = block +  1*n + i*(NR+1);
+    (*atmos)[i].channel_in = block +  2*n + i*(NR+1);
+    (*atmos)[i].coszen     = block +  3*n + i*(NR+1);
+    (*atmos)[i].density    = block +  4*n + i*(NR+1);
+    (*atmos)[i].fdir       = block +  5*n + i*(NR+1);
+    (*atmos)[i].longwave   = block +  6*n + i*(NR+1);
+    (*atmos)[i].par        = block +  7*n + i*(NR+1);
+    (*atmos)[i].prec       = block +  8*n + i*(NR+1);
+    (*atmos)[i].pressure   = block +  9*n + i*(NR+1);
+    (*atmos)[i].shortwave  = block + 10*n + i*(NR+1);
+    (*atmos)[i].tskc       = block + 11*n + i*(NR+1);
+    (*atmos)[i].vp         = block + 12*n + i*(NR+1);
+    (*atmos)[i].vpd        = block + 13*n + i*(NR+1);
+    (*atmos)[i].wind       = block + 14*n + i*(NR+1);
+    (*atmos)[i].irr_run    = block + 15*n + i*(NR+1);
+    (*atmos)[i].irr_with   = block + 16*n + i*(NR+1);
+    (*atmos)[i].snowflag   = flags + i*(NR+1);
   }    			
 
 }
@@ -122,32 +104,15 @@ void free_atmos(int nrecs, atmos_data_struct **atmos)
   2010-Sep-24 Renamed runoff_in to channel_in.				TJB
   2011-Nov-04 Added tskc.						TJB
   2013-Jul-25 Added Catm, coszen, fdir, and par.			TJB
+  2026-Oct-18 Frees the two blocks made by alloc_atmos().
 ***************************************************************************/
 {
-  int i;
-
   if (*atmos == NULL)
     return;
 
-  for (i = 0; i < nrecs; i++) {
-    free((*atmos)[i].air_temp);
-    free((*atmos)[i].Catm);
-    free((*atmos)[i].channel_in);
-    free((*atmos)[i].coszen);
-    free((*atmos)[i].density);
-    free((*atmos)[i].fdir);
-    free((*atmos)[i].longwave);
-    free((*atmos)[i].par);
-    free((*atmos)[i].prec);
-    free((*atmos)[i].pressure);
-    free((*atmos)[i].shortwave);
-    free((*atmos)[i].snowflag);
-    free((*atmos)[i].tskc);
-    free((*atmos)[i].vp);
-    free((*atmos)[i].vpd);
-    free((*atmos)[i].wind);
-    free((*atmos)[i].irr_run);
-    free((*atmos)[i].irr_with);
+  if (nrecs > 0) {
+    free((*atmos)[0].air_temp);
+    free((*atmos)[0].snowflag);
   }
 
   free(*atmos);
@@ -26,31 +26,39 @@ void alloc_veg_hist(int nrecs, int nveg, veg_hist_struct ***veg_hist)
 
   Modifications:
   2014-Apr-25 Added veg cover fraction.					TJB
+  2026-Oct-18 The records share one array of veg_hist_structs, and
+	      each variable is one array over all records, tiles and
+	      snow steps, all in a single allocation; see alloc_atmos().
 *******************************************************************/
 {
-  int i,j;
+  int     i,j;
+  size_t  n;
+  double *block;
+  double *val;
 
   (*veg_hist) = (veg_hist_struct **) calloc(nrecs, sizeof(veg_hist_struct *)); 
   if ((*veg_hist) == NULL)
     vicerror("Memory allocation error in alloc_veg_hist().");
+  if (nrecs == 0 || nveg == 0)
+    return;
+
+  (*veg_hist)[0] = (veg_hist_struct *) calloc((size_t)nrecs*nveg, sizeof(veg_hist_struct));
+  if ((*veg_hist)[0] == NULL)
+    vicerror("Memory allocation error in alloc_veg_hist().");
+
+  n = (size_t)nrecs*nveg*(NR+1);
+  block = (double *) calloc(4*n, sizeof(double));
+  if (block == NULL)
+    vicerror("Memory allocation error in alloc_veg_hist().");
 
   for (i = 0; i < nrecs; i++) {
-    (*veg_hist)[i] = (veg_hist_struct *) calloc(nveg, sizeof(veg_hist_struct));
-    if ((*veg_hist)[i] == NULL)
-      vicerror("Memory allocation error in alloc_veg_hist().");
+    (*veg_hist)[i] = (*veg_hist)[0] + i*nveg;
     for (j = 0; j < nveg; j++) {
-      (*veg_hist)[i][j].albedo = (double *) calloc(NR+1, sizeof(double));
-      if ((*veg_hist)[i][j].albedo == NULL)
-        vicerror("Memory allocation error in alloc_veg_hist().");
-      (*veg_hist)[i][j].crop_frac = (double *) calloc(NR+1, sizeof(double));
-      if ((*veg_hist)[i][j].crop_frac == NULL)
-        vicerror("Memory allocation error in alloc_veg_hist().");
-      (*veg_hist)[i][j].LAI = (double *) calloc(NR+1, sizeof(double));
-      if ((*veg_hist)[i][j].LAI == NULL)
-        vicerror("Memory allocation error in alloc_veg_hist().");
-      (*veg_hist)[i][j].vegcover = (double *) calloc(NR+1, sizeof(double));
-      if ((*veg_hist)[i][j].vegcover == NULL)
-        vicerror("Memory allocation error in alloc_veg_hist().");
+      val = block + ((size_t)i*nveg + j)*(NR+1);
+      (*veg_hist)[i][j].albedo    = val;
+      (*veg_hist)[i][j].crop_frac = val + n;
+      (*veg_hist)[i][j].LAI       = val + 2*n;
+      (*veg_hist)[i][j].vegcover  = val + 3*n;
     }
   }
 
@@ -63,21 +71,15 @@ void free_veg_hist(int nrecs, int nveg, veg_hist_struct ***veg_hist)
 /***************************************************************************
   Modifications:
   2014-Apr-25 Added veg cover fraction.					TJB
+  2026-Oct-18 Frees the blocks made by alloc_veg_hist().
 ***************************************************************************/
 {
-  int i,j;
-
   if (*veg_hist == NULL)
     return;
 
-  for (i = 0; i < nrecs; i++) {
-    for (j = 0; j < nveg; j++) {
-      free((*veg_hist)[i][j].albedo);
-      free((*veg_hist)[i][j].crop_frac);
-      free((*veg_hist)[i][j].LAI);
-      free((*veg_hist)[i][j].vegcover);
-    }
-    free((*veg_hist)[i]);
+  if (nrecs > 0 && nveg > 0) {
+    free((*veg_hist)[0][0].albedo);
+    free((*veg_hist)[0]);
   }
 
   free(*veg_hist);
@@ -0,0 +1,310 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <vicNl.h>
+
+/**********************************************************************
+  forcing_bench.c
+
+  Checks and times the ASCII branch of read_atmos_data(), which reads
+  the file in one block and converts the values with its own parser,
+  against read_ascii_ref() below, the fscanf()/fgets() loop it
+  replaced.  The test files are written to the current directory:
+
+  forcing_35y.txt    35 years of daily records (1970-2004) with six
+                     fields in the usual formats; read whole and after
+                     skipping 4000 lines
+  forcing_edge.txt   exponents, signs, "3.", ".5", -0, denormals,
+                     long mantissas, nan/inf, hexadecimal numbers, CRLF
+                     line ends, and tokens that are only partly numbers
+                     ("1e", "1e3e", "-", ".e3", "x")
+  forcing_bad.txt    a non-numeric token in the middle of a record
+  forcing_short.txt  a short file without a final newline
+
+  Every value must be bit-identical to the one read by fscanf().  The
+  time per file of both readers is printed for the 35-year file.
+
+  usage: forcing_bench [repetitions]
+  The exit status is 1 if a value differs.
+**********************************************************************/
+
+#define NFIELDS  6
+#define NYEARS   35
+#define NEXTRA   10
+
+static int field_types[NFIELDS] = { PREC, TMAX, TMIN, WIND, SHORTWAVE,
+				     LONGWAVE };
+
+static int    write_synthetic(char *);
+static int    write_edge(char *, int);
+static int    write_lines(char *, char **, int, int);
+static void   read_ascii_ref(FILE *, int, int, double **);
+static double **alloc_forcing(int);
+static void   free_forcing(double **);
+static int    compare(char *, int, int);
+static double read_time(char *, int, int, int, int);
+
+int main(int argc, char *argv[])
+{
+  extern param_set_struct param_set;
+  static char *bad[] = { "1.25 2 3 4 5 6", "1.25 2 3 4 5 6",
+			 "1 2 x 4 5 6", "1.25 2 3 4 5 6",
+			 "1.25 2 3 4 5 6" };
+  static char *shortf[] = { "0.5 -1.5e1 +2 3. .25 1E2",
+			    "7 8 9 10 11 12", "-0 -0.0 0 1e-3 2e+3 3" };
+  int  reps;
+  int  nyears;
+  int  nrecs;
+  int  i;
+  int  ndiffer;
+
+  reps = (argc > 1) ? atoi(argv[1]) : 20;
+  if (reps < 1) reps = 1;
+
+  param_set.N_TYPES[0]      = NFIELDS;
+  param_set.FORCE_DT[0]     = 24;
+  param_set.FORCE_FORMAT[0] = ASCII;
+  for (i = 0; i < NFIELDS; i++)
+    param_set.FORCE_INDEX[0][i] = field_types[i];
+
+  ndiffer = 0;
+  nyears = write_synthetic("forcing_35y.txt");
+  ndiffer += compare("forcing_35y.txt", nyears, 0);
+  ndiffer += compare("forcing_35y.txt", nyears - 4000, 4000);
+  nrecs = write_edge("forcing_edge.txt", 2000);
+  ndiffer += compare("forcing_edge.txt", nrecs, 0);
+  nrecs = write_lines("forcing_bad.txt", bad, 5, TRUE);
+  ndiffer += compare("forcing_bad.txt", nrecs, 0);
+  nrecs = write_lines("forcing_short.txt", shortf, 3, FALSE);
+  ndiffer += compare("forcing_short.txt", nrecs, 0);
+
+  printf("forcing_35y.txt, whole file: fscanf %.2f ms, read_atmos_data %.2f ms per file\n",
+	 read_time("forcing_35y.txt", nyears, 0, reps, TRUE),
+	 read_time("forcing_35y.txt", nyears, 0, reps, FALSE));
+  printf("forcing_35y.txt, after 4000 lines: fscanf %.2f ms, read_atmos_data %.2f ms per file\n",
+	 read_time("forcing_35y.txt", nyears - 4000, 4000, reps, TRUE),
+	 read_time("forcing_35y.txt", nyears - 4000, 4000, reps, FALSE));
+
+  return (ndiffer > 0);
+}
+
+/* writes NYEARS of daily records from 1970; returns the number of lines */
+static int write_synthetic(char *name)
+{
+  FILE *f;
+  int   year;
+  int   day;
+  int   ndays;
+  int   nrecs;
+  double tmax;
+
+  if ((f = fopen(name, "w")) == NULL)
+    nrerror("Unable to open the synthetic forcing file.");
+  srand48(35);
+  nrecs = 0;
+  for (year = 1970; year < 1970 + NYEARS; year++) {
+    ndays = (year % 4 == 0) ? 366 : 365;
+    for (day = 0; day < ndays; day++) {
+      tmax = 40 * drand48() - 10;
+      fprintf(f, "%.4f %.2f %.2f %.3f %.1f %.6f\n",
+	      (drand48() < 0.6) ? 0 : 40 * drand48(),
+	      tmax, tmax - 20 * drand48(), 15 * drand48(),
+	      400 * drand48(), 200 + 250 * drand48());
+      nrecs++;
+    }
+  }
+  fclose(f);
+
+  return nrecs;
+}
+
+/* writes nrecs lines of tokens that take the other paths of the
+   parser; returns nrecs */
+static int write_edge(char *name,
+		      int   nrecs)
+{
+  static char *tokens[] = { ".5", "3.", "+7", "-0", "-.5", "+0.0",
+			    "1e3", "-2.5E-3", "1.5e+22", "1e-30", "1e22",
+			    "1e23", "4.9e-324", "1.7976931348623157e308",
+			    "2.2250738585072014e-308", "0.000001",
+			    "99999999999999.9", "123456789012345678",
+			    "12345.678901234567", "0.1", "-1.0e-5",
+			    "1e", "5e+", "1.e-", "1ee", "1e3e", "1e99999",
+			    "1e-99999", "1.2.3", "-", "+", ".", "-.",
+			    "--", ".e3", "-e3", "0x1p3", "nan", "-nan",
+			    "inf", "-inf", "+infinity", "x" };
+  int   ntokens = sizeof(tokens) / sizeof(tokens[0]);
+  FILE *f;
+  int   rec;
+  int   i;
+
+  if ((f = fopen(name, "wb")) == NULL)
+    nrerror("Unable to open the edge case forcing file.");
+  srand48(1);
+  for (rec = 0; rec < nrecs; rec++) {
+    for (i = 0; i < NFIELDS; i++)
+      fprintf(f, "%s%s", tokens[(int)(ntokens * drand48())],
+	      (i < NFIELDS - 1) ? ((rec % 3) ? " " : "\t") : "");
+    fprintf(f, (rec % 5 == 4) ? "  \r\n" : "\n");
+  }
+  fclose(f);
+
+  return nrecs;
+}
+
+/* writes the given lines, the last one with or without a newline;
+   returns the number of lines */
+static int write_lines(char  *name,
+		       char **lines,
+		       int    nlines,
+		       int    final_newline)
+{
+  FILE *f;
+  int   i;
+
+  if ((f = fopen(name, "w")) == NULL)
+    nrerror("Unable to open the short forcing file.");
+  for (i = 0; i < nlines; i++)
+    fprintf(f, "%s%s", lines[i],
+	    (i < nlines - 1 || final_newline) ? "\n" : "");
+  fclose(f);
+
+  return nlines;
+}
+
+/* the ASCII branch of read_atmos_data() as it was before the file was
+   read in one block: one fscanf() per value and fgets() for the rest
+   of each line */
+static void read_ascii_ref(FILE    *infile,
+			   int      nrecs,
+			   int      skip_recs,
+			   double **forcing_data)
+{
+  char str[MAXSTRING+1];
+  int  rec;
+  int  i;
+
+  for (i = 0; i < skip_recs; i++) {
+    if (fgets(str, MAXSTRING, infile) == NULL)
+      nrerror("No data for the specified time period in the forcing file.  Model stopping...");
+  }
+
+  rec = 0;
+  while (!feof(infile) && rec < nrecs) {
+    for (i = 0; i < NFIELDS; i++)
+      fscanf(infile, "%lf", &forcing_data[field_types[i]][rec]);
+    fgets(str, MAXSTRING, infile);
+    rec++;
+  }
+}
+
+static double **alloc_forcing(int nrecs)
+{
+  double **data;
+  int      i;
+
+  data = (double **)calloc(N_FORCING_TYPES, sizeof(double *));
+  for (i = 0; data != NULL && i < N_FORCING_TYPES; i++)
+    if ((data[i] = (double *)calloc(nrecs + NEXTRA, sizeof(double))) == NULL)
+      data = NULL;
+  if (data == NULL)
+    nrerror("Memory allocation error in forcing_bench.");
+
+  return data;
+}
+
+static void free_forcing(double **data)
+{
+  int i;
+
+  for (i = 0; i < N_FORCING_TYPES; i++)
+    free(data[i]);
+  free(data);
+}
+
+/* reads the file with both readers and counts the values that are not
+   bit-identical */
+static int compare(char *name,
+		   int   nrecs,
+		   int   skip_recs)
+{
+  global_param_struct global_param;
+  FILE               *f;
+  double            **ref;
+  double            **data;
+  int                 ndiffer;
+  int                 rec;
+  int                 i;
+
+  memset(&global_param, 0, sizeof(global_param));
+  global_param.dt    = 24;
+  global_param.nrecs = nrecs;
+  ref  = alloc_forcing(nrecs);
+  data = alloc_forcing(nrecs);
+
+  if ((f = fopen(name, "r")) == NULL)
+    nrerror("Unable to open a test forcing file.");
+  read_ascii_ref(f, nrecs, skip_recs, ref);
+  fclose(f);
+  if ((f = fopen(name, "r")) == NULL)
+    nrerror("Unable to open a test forcing file.");
+  read_atmos_data(f, global_param, 0, skip_recs, data, NULL);
+  fclose(f);
+
+  ndiffer = 0;
+  for (i = 0; i < NFIELDS; i++) {
+    for (rec = 0; rec < nrecs + NEXTRA; rec++) {
+      if (memcmp(&ref[field_types[i]][rec], &data[field_types[i]][rec],
+		 sizeof(double)) != 0) {
+	if (ndiffer < 10)
+	  fprintf(stderr, "%s record %d field %d: %.17g instead of %.17g\n",
+		  name, rec, i, data[field_types[i]][rec],
+		  ref[field_types[i]][rec]);
+	ndiffer++;
+      }
+    }
+  }
+  printf("%s, %d records after %d lines: %d values differ\n", name,
+	 nrecs, skip_recs, ndiffer);
+
+  free_forcing(ref);
+  free_forcing(data);
+
+  return ndiffer;
+}
+
+/* cpu time in milliseconds to read the file once with read_ascii_ref()
+   (ref = TRUE) or read_atmos_data(), averaged over reps */
+static double read_time(char *name,
+			int   nrecs,
+			int   skip_recs,
+			int   reps,
+			int   ref)
+{
+  global_param_struct global_param;
+  FILE               *f;
+  double            **data;
+  clock_t             start;
+  int                 r;
+
+  memset(&global_param, 0, sizeof(global_param));
+  global_param.dt    = 24;
+  global_param.nrecs = nrecs;
+  data = alloc_forcing(nrecs);
+
+  start = clock();
+  for (r = 0; r < reps; r++) {
+    if ((f = fopen(name, "r")) == NULL)
+      nrerror("Unable to open a test forcing file.");
+    if (ref)
+      read_ascii_ref(f, nrecs, skip_recs, data);
+    else
+      read_atmos_data(f, global_param, 0, skip_recs, data, NULL);
+    fclose(f);
+  }
+
+  free_forcing(data);
+
+  return (double)(clock() - start) / CLOCKS_PER_SEC * 1e3 / reps;
+}
@@ -0,0 +1,217 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include <vicNl.h>
+
+/**********************************************************************
+  runoff_check.c
+
+  Checks runoff(), whose hourly drainage and baseflow are computed for
+  all frost areas of a tile by layer_drainage(), against runoff_ref()
+  (runoff_ref.c), the routine that advanced each frost area on its
+  own.  Both are run on the same random soil states, with Nfrost from
+  1 to 5, dt of 3 and 24 hours, with and without precipitation,
+  evaporation and ice.  Runoff, baseflow, asat and the moisture and
+  evaporation of every layer must agree within a relative tolerance
+  of TOLERANCE; the number of values that are not bit-identical is
+  also printed.  Then both routines are timed.
+
+  usage: runoff_check [ntrials] [ncalls]
+  The exit status is 1 if a value is outside the tolerance.
+**********************************************************************/
+
+#define TOLERANCE 1e-12
+#define NVALUES   (3 + 2 * MAX_LAYERS)
+
+int runoff_ref(cell_data_struct *, energy_bal_struct *, soil_con_struct *,
+	       double, double *, int, int, int, int, int);
+
+static double uniform(double, double);
+static void   random_state(soil_con_struct *, cell_data_struct *, int);
+static int    results(cell_data_struct *, double *);
+static double time_calls(int, soil_con_struct *, cell_data_struct *,
+			 energy_bal_struct *, int);
+
+int main(int argc, char *argv[])
+{
+  extern option_struct options;
+  soil_con_struct   *soil_con;
+  cell_data_struct  *cell_ref;
+  cell_data_struct  *cell;
+  energy_bal_struct *energy;
+  int                ntrials;
+  int                ncalls;
+  int                trial;
+  int                i;
+  int                n;
+  int                dt;
+  int                nfailed;
+  long               ndiffer;
+  double             ppt;
+  double             ref[NVALUES];
+  double             val[NVALUES];
+  double             diff;
+  double             maxdiff;
+
+  ntrials = (argc > 1) ? atoi(argv[1]) : 200000;
+  ncalls  = (argc > 2) ? atoi(argv[2]) : 100000;
+
+  soil_con = (soil_con_struct *)calloc(1, sizeof(soil_con_struct));
+  cell_ref = (cell_data_struct *)calloc(1, sizeof(cell_data_struct));
+  cell     = (cell_data_struct *)calloc(1, sizeof(cell_data_struct));
+  energy   = (energy_bal_struct *)calloc(1, sizeof(energy_bal_struct));
+  if (soil_con == NULL || cell_ref == NULL || cell == NULL || energy == NULL)
+    nrerror("Memory allocation error in runoff_check.");
+
+  options.Nlayer      = 3;
+  options.FULL_ENERGY = FALSE;
+  options.FROZEN_SOIL = FALSE;
+  srand48(1);
+
+  nfailed = 0;
+  ndiffer = 0;
+  maxdiff = 0;
+  for (trial = 0; trial < ntrials; trial++) {
+    options.Nfrost = 1 + trial % 5;
+    dt  = (trial % 2) ? 24 : 3;
+    ppt = (drand48() < 0.4) ? 0 : uniform(0, 80);
+    random_state(soil_con, cell_ref, options.Nfrost);
+    *cell = *cell_ref;
+
+    runoff_ref(cell_ref, energy, soil_con, ppt, soil_con->frost_fract, dt,
+	       3, 0, 0, 0);
+    runoff(cell, energy, soil_con, ppt, soil_con->frost_fract, dt,
+	   3, 0, 0, 0);
+
+    n = results(cell_ref, ref);
+    results(cell, val);
+    for (i = 0; i < n; i++) {
+      if (memcmp(&ref[i], &val[i], sizeof(double)) != 0) ndiffer++;
+      diff = fabs(val[i] - ref[i]) / (fabs(ref[i]) > 1 ? fabs(ref[i]) : 1);
+      if (diff > maxdiff) maxdiff = diff;
+      if (!(diff <= TOLERANCE)) {
+	if (nfailed < 10)
+	  fprintf(stderr, "trial %d value %d: %.17g instead of %.17g\n",
+		  trial, i, val[i], ref[i]);
+	nfailed++;
+      }
+    }
+  }
+  printf("%d random states: %d values outside the tolerance %g, %ld not bit-identical, largest relative difference %g\n",
+	 ntrials, nfailed, TOLERANCE, ndiffer, maxdiff);
+
+  if (ncalls > 0) {
+    for (n = 1; n <= 5; n += 4) {
+      options.Nfrost = n;
+      random_state(soil_con, cell_ref, n);
+      printf("Nfrost %d: runoff_ref %.3f us, runoff %.3f us per call\n", n,
+	     time_calls(TRUE, soil_con, cell_ref, energy, ncalls),
+	     time_calls(FALSE, soil_con, cell_ref, energy, ncalls));
+    }
+  }
+
+  free(soil_con);
+  free(cell_ref);
+  free(cell);
+  free(energy);
+
+  return (nfailed > 0);
+}
+
+/* uniform random number in [a, b) */
+static double uniform(double a,
+		      double b)
+{
+  return a + (b - a) * drand48();
+}
+
+/* random soil parameters and moisture state with Nfrost frost areas */
+static void random_state(soil_con_struct  *soil_con,
+			 cell_data_struct *cell,
+			 int               Nfrost)
+{
+  extern option_struct options;
+  int    lindex;
+  int    frost_area;
+  double resid;
+
+  for (lindex = 0; lindex < options.Nlayer; lindex++) {
+    soil_con->depth[lindex]       = uniform(0.1, 1.5);
+    soil_con->max_moist[lindex]   = soil_con->depth[lindex] * 1000.
+      * uniform(0.35, 0.5);
+    soil_con->resid_moist[lindex] = uniform(0, 0.05);
+    soil_con->Ksat[lindex]        = uniform(10, 1000);
+    soil_con->expt[lindex]        = uniform(4, 25);
+  }
+  soil_con->Dsmax       = uniform(1, 30);
+  soil_con->Ds          = uniform(0.001, 0.5);
+  soil_con->Ws          = uniform(0.5, 0.95);
+  soil_con->c           = 2;
+  soil_con->b_infilt    = uniform(0.01, 0.5);
+  soil_con->frost_slope = 1;
+  for (frost_area = 0; frost_area < Nfrost; frost_area++)
+    soil_con->frost_fract[frost_area] = 1.0 / Nfrost;
+
+  memset(cell, 0, sizeof(cell_data_struct));
+  for (lindex = 0; lindex < options.Nlayer; lindex++) {
+    resid = soil_con->resid_moist[lindex] * soil_con->depth[lindex] * 1000.;
+    cell->layer[lindex].moist = uniform(resid, soil_con->max_moist[lindex]);
+    cell->layer[lindex].evap  = (drand48() < 0.3) ? 0 : uniform(0, 2);
+    cell->layer[lindex].T     = uniform(-5, 10);
+    for (frost_area = 0; frost_area < Nfrost; frost_area++)
+      cell->layer[lindex].ice[frost_area] = (drand48() < 0.5) ? 0
+	: uniform(0, 0.5) * (cell->layer[lindex].moist - resid);
+  }
+}
+
+/* copies the values compared by the check; returns their number */
+static int results(cell_data_struct *cell,
+		   double           *values)
+{
+  extern option_struct options;
+  int lindex;
+  int n;
+
+  n = 0;
+  values[n++] = cell->runoff;
+  values[n++] = cell->baseflow;
+  values[n++] = cell->asat;
+  for (lindex = 0; lindex < options.Nlayer; lindex++) {
+    values[n++] = cell->layer[lindex].moist;
+    values[n++] = cell->layer[lindex].evap;
+  }
+
+  return n;
+}
+
+/* time per call in microseconds of runoff_ref() (ref = TRUE) or
+   runoff(), on copies of the same state */
+static double time_calls(int                ref,
+			 soil_con_struct   *soil_con,
+			 cell_data_struct  *state,
+			 energy_bal_struct *energy,
+			 int                ncalls)
+{
+  cell_data_struct *cell;
+  clock_t           start;
+  int               call;
+
+  cell  = (cell_data_struct *)malloc(sizeof(cell_data_struct));
+  if (cell == NULL)
+    nrerror("Memory allocation error in runoff_check.");
+  start = clock();
+  for (call = 0; call < ncalls; call++) {
+    *cell = *state;
+    if (ref)
+      runoff_ref(cell, energy, soil_con, 10., soil_con->frost_fract, 24,
+		 3, 0, 0, 0);
+    else
+      runoff(cell, energy, soil_con, 10., soil_con->frost_fract, 24,
+	     3, 0, 0, 0);
+  }
+  free(cell);
+
+  return (double)(clock() - start) / CLOCKS_PER_SEC * 1e6 / ncalls;
+}
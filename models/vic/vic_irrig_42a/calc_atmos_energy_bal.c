@@ -65,6 +65,10 @@ double calc_atmos_energy_bal(double  InOverSensible,
 	      of root_brent, error_print_atmos_energy_bal and
 	      solve_atmos_energy_bal.					TJB
   2013-Dec-26 Moved CLOSE_ENERGY from compile-time to run-time options.	TJB
+  2026-Oct-18 Pass the arguments of func_atmos_energy_bal() to root_brent()
+	      in an argument structure; removed solve_atmos_energy_bal(),
+	      error_calc_atmos_energy_bal() and the moist balance equivalents.
+  2026-Oct-18 Added call site argument to root_brent().
 ************************************************************************/
 
   extern option_struct options;
@@ -81,6 +85,8 @@ double calc_atmos_energy_bal(double  InOverSensible,
   double VP_upper;
   double gamma;
   char ErrorString[MAXSTRING];
+
+  atmos_energy_bal_args_struct args;
   
   F = 1;
 
@@ -102,6 +108,15 @@ double calc_atmos_energy_bal(double  InOverSensible,
 
   InLatent = (*LatentHeat) + (*LatentHeatSub);
 
+  // set arguments of the canopy air energy balance
+  args.LatentHeat    = InLatent;
+  args.NetRadiation  = NetRadiation;
+  args.Ra            = Ra;
+  args.Tair          = Tair;
+  args.atmos_density = atmos_density;
+  args.InSensible    = InSensible;
+  args.SensibleHeat  = SensibleHeat;
+
   /******************************
     Find Canopy Air Temperature
   ******************************/
@@ -116,10 +131,8 @@ double calc_atmos_energy_bal(double  InOverSensible,
     T_upper = (Tair) + CANOPY_DT;
 
     // iterate for canopy air temperature
-    Tcanopy = root_brent(T_lower, T_upper, ErrorString, func_atmos_energy_bal, 
-		         (*LatentHeat) + (*LatentHeatSub), 
-		         NetRadiation, Ra, Tair, atmos_density, InSensible, 
-		         SensibleHeat);
+    Tcanopy = root_brent(ROOT_CANOPY, T_lower, T_upper, ErrorString,
+			 func_atmos_energy_bal, &args);
 
     if ( Tcanopy <= -998 ) {
       if (options.TFALLBACK) {
@@ -129,11 +142,7 @@ double calc_atmos_energy_bal(double  InOverSensible,
       }
       else {
         // handle error flag from root brent
-        (*Error) = error_calc_atmos_energy_bal(Tcanopy, (*LatentHeat) 
-					       + (*LatentHeatSub), 
-					       NetRadiation, Ra, Tair, 
-					       atmos_density, InSensible, 
-					       SensibleHeat, ErrorString);
+        (*Error) = error_print_atmos_energy_bal(Tcanopy, &args, ErrorString);
         return ( ERROR );
       }
     }
@@ -144,9 +153,7 @@ double calc_atmos_energy_bal(double  InOverSensible,
   }
 
   // compute variables based on final temperature
-  (*Error) = solve_atmos_energy_bal(Tcanopy, (*LatentHeat) + (*LatentHeatSub), 
-				    NetRadiation, Ra, Tair, atmos_density, 
-				    InSensible, SensibleHeat);
+  (*Error) = func_atmos_energy_bal(Tcanopy, &args);
 
   /*****************************
     Find Canopy Vapor Pressure
@@ -159,20 +166,22 @@ double calc_atmos_energy_bal(double  InOverSensible,
 /*   gamma = svp_slope(Tair); */
 
   // iterate for canopy vapor pressure
-/*   (*VPcanopy) = root_brent(VP_lower, VP_upper, ErrorString, func_atmos_moist_bal,  */
-/* 			   InLatent, Lv, Ra, atmos_density, gamma, vp,  */
-/* 			   &AtmosLatent); */
+/*   moist_args.InLatentHeat  = InLatent; */
+/*   moist_args.Lv            = Lv; */
+/*   moist_args.Ra            = Ra; */
+/*   moist_args.atmos_density = atmos_density; */
+/*   moist_args.gamma         = gamma; */
+/*   moist_args.vp            = vp; */
+/*   moist_args.LatentHeat    = &AtmosLatent; */
+/*   (*VPcanopy) = root_brent(ROOT_CANOPY, VP_lower, VP_upper, ErrorString, func_atmos_moist_bal, */
+/* 			   &moist_args); */
 
 /*   if ( (*VPcanopy) <= -998 )  */
     // handle error flag from root brent
-/*     (*Error) = error_calc_atmos_moist_bal((*VPcanopy), InLatent,  */
-/* 					  Lv, Ra, atmos_density, gamma, vp,  */
-/* 					  &AtmosLatent, ErrorString); */
+/*     (*Error) = error_print_atmos_moist_bal((*VPcanopy), &moist_args, ErrorString); */
   
   // compute varaibles based on final vapor pressure
-/*   (*Error) = solve_atmos_moist_bal( (*VPcanopy), InLatent,  */
-/* 				    Lv, Ra, atmos_density, gamma, vp,  */
-/* 				    &AtmosLatent); */
+/*   (*Error) = func_atmos_moist_bal((*VPcanopy), &moist_args); */
 
   // compute vapor pressure deficit in canopy
 /*   (*VPDcanopy) = vpd + (*VPcanopy - vp); */
@@ -185,35 +194,9 @@ double calc_atmos_energy_bal(double  InOverSensible,
 
 }
 
-double solve_atmos_energy_bal(double Tcanopy, ...) {
-
-  va_list ap;
-
-  double error;
-
-  va_start(ap, Tcanopy);
-  error = func_atmos_energy_bal(Tcanopy, ap);
-  va_end(ap);
-
-  return error;
-
-}
-
-double error_calc_atmos_energy_bal(double Tcanopy, ...) {
-
-  va_list ap;
-
-  double error;
-
-  va_start(ap, Tcanopy);
-  error = error_print_atmos_energy_bal(Tcanopy, ap);
-  va_end(ap);
-
-  return error;
-
-}
-
-double error_print_atmos_energy_bal(double Tcanopy, va_list ap) {
+double error_print_atmos_energy_bal(double Tcanopy,
+				    atmos_energy_bal_args_struct *args,
+				    char *ErrorString) {
 
   double  LatentHeat;
   double  NetRadiation;
@@ -223,18 +206,16 @@ double error_print_atmos_energy_bal(double Tcanopy, va_list ap) {
   double  InSensible;
 
   double *SensibleHeat;
-  char *ErrorString;
  
-  // extract variables from va_arg
-  LatentHeat    = (double)  va_arg(ap, double);
-  NetRadiation  = (double)  va_arg(ap, double);
-  Ra            = (double)  va_arg(ap, double);
-  Tair          = (double)  va_arg(ap, double);
-  atmos_density = (double)  va_arg(ap, double);
-  InSensible    = (double)  va_arg(ap, double);
+  // extract variables from argument structure
+  LatentHeat    = args->LatentHeat;
+  NetRadiation  = args->NetRadiation;
+  Ra            = args->Ra;
+  Tair          = args->Tair;
+  atmos_density = args->atmos_density;
+  InSensible    = args->InSensible;
 
-  SensibleHeat  = (double *)va_arg(ap, double *);
-  ErrorString   = (char *)va_arg(ap, char *);
+  SensibleHeat  = args->SensibleHeat;
 
   // print variable values
   fprintf(stderr, "%s", ErrorString);
@@ -254,35 +235,9 @@ double error_print_atmos_energy_bal(double Tcanopy, va_list ap) {
     
 }
 
-double solve_atmos_moist_bal(double VPcanopy, ...) {
-
-  va_list ap;
-
-  double error;
-
-  va_start(ap, VPcanopy);
-  error = func_atmos_moist_bal(VPcanopy, ap);
-  va_end(ap);
-
-  return error;
-
-}
-
-double error_calc_atmos_moist_bal(double VPcanopy, ...) {
-
-  va_list ap;
-
-  double error;
-
-  va_start(ap, VPcanopy);
-  error = error_print_atmos_moist_bal(VPcanopy, ap);
-  va_end(ap);
-
-  return error;
-
-}
-
-double error_print_atmos_moist_bal(double VPcanopy, va_list ap) {
+double error_print_atmos_moist_bal(double VPcanopy,
+				   atmos_moist_bal_args_struct *args,
+				   char *ErrorString) {
 
  
   double  InLatent;
@@ -292,17 +247,15 @@ double error_print_atmos_moist_bal(double VPcanopy, va_list ap) {
   double  gamma;
   double  vp;
   double *AtmosLatent;
-  char *ErrorString;
-
-  // extract variables from va_arg
-  InLatent      = (double)  va_arg(ap, double);
-  Lv            = (double)  va_arg(ap, double);
-  Ra            = (double)  va_arg(ap, double);
-  atmos_density = (double)  va_arg(ap, double);
-  gamma         = (double)  va_arg(ap, double);
-  vp            = (double)  va_arg(ap, double);
-  AtmosLatent   = (double *)va_arg(ap, double *);
-  ErrorString   = (char *)  va_arg(ap, char *);
+
+  // extract variables from argument structure
+  InLatent      = args->InLatentHeat;
+  Lv            = args->Lv;
+  Ra            = args->Ra;
+  atmos_density = args->atmos_density;
+  gamma         = args->gamma;
+  vp            = args->vp;
+  AtmosLatent   = args->LatentHeat;
 
   // print variable values
   fprintf(stderr, "%s", ErrorString);
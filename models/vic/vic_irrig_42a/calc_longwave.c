@@ -37,6 +37,7 @@ void calc_longwave(double *longwave,
   /* See Bras, R. F. , "Hydrology, an introduction to hydrologic science",
      Addison-Wesley, 1990, p. 42-45 */
 
+  emissivity_clear = 0;
   if (options.LW_TYPE == LW_TVA) {
     emissivity_clear = 0.740 + 0.0049 * vp; // TVA (1972) - see Bras 2.35
   }
@@ -7,7 +7,8 @@ static char vcid[] = "$Id$";
 double calc_water_balance_error(int    rec,
 				double inflow,
 				double outflow,
-				double storage) {
+				double storage,
+				double last_storage) {
   /***************************************************************
   calc_water_balance_error  Keith Cherkauer        April 1998
 
@@ -16,9 +17,10 @@ double calc_water_balance_error(int    rec,
 
   Modifications:
   2007-Aug-22 Added error as return value.  JCA
+  2026-Oct-18 The storage of the previous record is passed in by the
+	      caller (save_data_struct) instead of being kept here.
 ***************************************************************/
 
-  static double last_storage;
   static double cum_error;
   static double max_error;
   static int    error_cnt;
@@ -27,7 +29,6 @@ double calc_water_balance_error(int    rec,
   double error;
 
   if(rec<0) {
-    last_storage = storage;
     cum_error    = 0.;
     max_error    = 0.;
     error_cnt    = 0;
@@ -53,7 +54,6 @@ double calc_water_balance_error(int    rec,
       fprintf(stderr,"Total Cumulative Water Error for Grid Cell = %.4f\n",
 	      cum_error);
     }
-    last_storage = storage;
 
     return(error);
   }
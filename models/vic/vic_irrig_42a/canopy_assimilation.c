@@ -39,7 +39,8 @@
 
   programmer: Ted Bohn
   date      : October 20, 2006
-  changes   :
+  changes   : 2026-Oct-18 All canopy layers are computed by one call to
+              photosynth_layers().
   references: 
 ********************************************************************************/
 
@@ -80,9 +81,9 @@ void canopy_assimilation(char    Ctype,
   int     cidx;
   double  dLAI;
   double *CiLayer;
-  double  AgrossLayer;
-  double  RdarkLayer;
-  double  RphotoLayer;
+  double *AgrossLayer;
+  double *RdarkLayer;
+  double *RphotoLayer;
   double  gc;                  /* 1/rs */
 
   /* calculate scale height based on average temperature in the column */
@@ -92,7 +93,10 @@ void canopy_assimilation(char    Ctype,
      temperature is equal air_temp */
   pz = PS_PM * exp(-(double)elevation/h);
 
-  CiLayer = (double*)calloc(options.Ncanopy,sizeof(double));
+  CiLayer = (double*)calloc(4*options.Ncanopy,sizeof(double));
+  AgrossLayer = CiLayer + options.Ncanopy;
+  RdarkLayer = AgrossLayer + options.Ncanopy;
+  RphotoLayer = RdarkLayer + options.Ncanopy;
 
   if (!strcasecmp(mode,"ci")) {
 
@@ -110,6 +114,24 @@ void canopy_assimilation(char    Ctype,
     else if (Ctype == PHOTO_C4)
       *Ci = FCI1C4 * Catm;
 
+    photosynth_layers(Ctype,
+                      MaxCarboxRate,
+                      MaxETransport,
+                      CO2Specificity,
+                      NscaleFactor,
+                      Tfoliage,
+                      SWdown/Epar, /* note: divide by Epar to convert from W/m2 to mol(photons)/m2s */
+                      aPAR,
+                      pz,
+                      Catm,
+                      mode,
+                      options.Ncanopy,
+                      rsLayer,
+                      CiLayer,
+                      RdarkLayer,
+                      RphotoLayer,
+                      AgrossLayer);
+
     /* Sum over canopy layers */
     *GPP    = 0.0;
     *Rdark  = 0.0;
@@ -117,31 +139,14 @@ void canopy_assimilation(char    Ctype,
     gc      = 0.0;
     for (cidx = 0; cidx < options.Ncanopy; cidx++) {
 
-      photosynth(Ctype,
-                 MaxCarboxRate,
-                 MaxETransport,
-                 CO2Specificity,
-                 NscaleFactor[cidx],
-                 Tfoliage,
-                 SWdown/Epar, /* note: divide by Epar to convert from W/m2 to mol(photons)/m2s */
-                 aPAR[cidx],
-                 pz,
-                 Catm,
-                 mode,
-                 &(rsLayer[cidx]),
-                 &(CiLayer[cidx]),
-                 &RdarkLayer,
-                 &RphotoLayer,
-                 &AgrossLayer);
-
       if (cidx > 0)
         dLAI = LAItotal * (CanopLayerBnd[cidx] - CanopLayerBnd[cidx-1]);
       else
         dLAI = LAItotal * CanopLayerBnd[cidx];
 
-      *GPP    += AgrossLayer * dLAI;
-      *Rdark  += RdarkLayer * dLAI;
-      *Rphoto += RphotoLayer * dLAI;
+      *GPP    += AgrossLayer[cidx] * dLAI;
+      *Rdark  += RdarkLayer[cidx] * dLAI;
+      *Rphoto += RphotoLayer[cidx] * dLAI;
       gc      += (1/rsLayer[cidx]) * dLAI;
 
     }
@@ -155,6 +160,24 @@ void canopy_assimilation(char    Ctype,
 
     /* Stomatal resistance given; compute assimilation, respiration, and leaf-internal CO2 */
 
+    photosynth_layers(Ctype,
+                      MaxCarboxRate,
+                      MaxETransport,
+                      CO2Specificity,
+                      NscaleFactor,
+                      Tfoliage,
+                      SWdown/Epar,
+                      aPAR,
+                      pz,
+                      Catm,
+                      mode,
+                      options.Ncanopy,
+                      rsLayer,
+                      CiLayer,
+                      RdarkLayer,
+                      RphotoLayer,
+                      AgrossLayer);
+
     /* Sum over canopy layers */
     *GPP    = 0.0;
     *Rdark  = 0.0;
@@ -162,31 +185,14 @@ void canopy_assimilation(char    Ctype,
     *Ci     = 0.0;
     for (cidx = 0; cidx < options.Ncanopy; cidx++) {
 
-      photosynth(Ctype,
-                 MaxCarboxRate,
-                 MaxETransport,
-                 CO2Specificity,
-                 NscaleFactor[cidx],
-                 Tfoliage,
-                 SWdown/Epar,
-                 aPAR[cidx],
-                 pz,
-                 Catm,
-                 mode,
-                 &(rsLayer[cidx]),
-                 &(CiLayer[cidx]),
-                 &RdarkLayer,
-                 &RphotoLayer,
-                 &AgrossLayer);
-
       if (cidx > 0)
         dLAI = LAItotal * (CanopLayerBnd[cidx] - CanopLayerBnd[cidx-1]);
       else
         dLAI = LAItotal * CanopLayerBnd[cidx];
 
-      *GPP    += AgrossLayer * dLAI;
-      *Rdark  += RdarkLayer * dLAI;
-      *Rphoto += RphotoLayer * dLAI;
+      *GPP    += AgrossLayer[cidx] * dLAI;
+      *Rdark  += RdarkLayer[cidx] * dLAI;
+      *Rphoto += RphotoLayer[cidx] * dLAI;
       *Ci     += CiLayer[cidx] * dLAI;
 
     }
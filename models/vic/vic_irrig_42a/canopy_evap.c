@@ -103,6 +103,8 @@ double canopy_evap(layer_data_struct *layer,
   2014-Apr-25 Switched LAI from veg_lib to veg_var.			TJB
   2014-May-05 Added logic to handle LAI = 0.				TJB
   2014-May-05 Replaced HUGE_RESIST with RSMAX.				TJB
+  2026-Oct-18 Options are read through OPT_* (see vicNl_def.h), so
+	      that specialized builds can fix them at compile time.
 **********************************************************************/ 
 
 {
@@ -126,7 +128,7 @@ double canopy_evap(layer_data_struct *layer,
   Evap = 0;
 
   /* Initialize variables */
-  for ( i = 0; i < options.Nlayer; i++ ) layerevap[i] = 0;
+  for ( i = 0; i < OPT_Nlayer; i++ ) layerevap[i] = 0;
   canopyevap = 0;
   throughfall = 0;
   tmp_Wdew = *Wdew;
@@ -196,7 +198,7 @@ double canopy_evap(layer_data_struct *layer,
   veg_var->throughfall = throughfall;
   veg_var->Wdew = tmp_Wdew;
   tmp_Evap = canopyevap;
-  for(i=0;i<options.Nlayer;i++) {
+  for(i=0;i<OPT_Nlayer;i++) {
     layer[i].evap  = layerevap[i];
     tmp_Evap          += layerevap[i];
   }
@@ -286,7 +288,7 @@ void transpiration(layer_data_struct *layer,
   /**************************************************
     Set ice content in all individual layers
     **************************************************/
-  for(i=0;i<options.Nlayer;i++){
+  for(i=0;i<OPT_Nlayer;i++){
     ice[i] = 0;
     for ( frost_area = 0; frost_area < options.Nfrost; frost_area++ ) {
       ice[i] += layer[i].ice[frost_area] * frost_fract[frost_area];
@@ -298,7 +300,7 @@ void transpiration(layer_data_struct *layer,
     **************************************************/
   moist1 = 0.0;
   Wcr1 = 0.0;  
-  for(i=0;i<options.Nlayer-1;i++){
+  for(i=0;i<OPT_Nlayer-1;i++){
     if(root[i] > 0.) {
       avail_moist[i] = 0;
       for ( frost_area = 0; frost_area < options.Nfrost; frost_area++ ) {
@@ -313,7 +315,7 @@ void transpiration(layer_data_struct *layer,
   /*****************************************
     Compute moisture content in lowest layer
     *****************************************/
-  i = options.Nlayer - 1;
+  i = OPT_Nlayer - 1;
   moist2 = 0;
   for ( frost_area = 0; frost_area < options.Nfrost; frost_area++ )
     moist2 += ((layer[i].moist - layer[i].ice[frost_area]) * frost_fract[frost_area]);
@@ -336,19 +338,19 @@ void transpiration(layer_data_struct *layer,
   ******************************************************************/
 
   if( options.SHARE_LAYER_MOIST &&
-      ( (moist1>=Wcr1 && moist2>=Wcr[options.Nlayer-1] && Wcr1>0.) ||
-        (moist1>=Wcr1 && (1-root[options.Nlayer-1])>= 0.5) ||
-        (moist2>=Wcr[options.Nlayer-1] && root[options.Nlayer-1]>=0.5) ) ) {
+      ( (moist1>=Wcr1 && moist2>=Wcr[OPT_Nlayer-1] && Wcr1>0.) ||
+        (moist1>=Wcr1 && (1-root[OPT_Nlayer-1])>= 0.5) ||
+        (moist2>=Wcr[OPT_Nlayer-1] && root[OPT_Nlayer-1]>=0.5) ) ) {
 
     gsm_inv=1.0;
 
     /* compute whole-canopy stomatal resistance */
-    if (!options.CARBON || options.RC_MODE == RC_JARVIS) {
+    if (!OPT_CARBON || options.RC_MODE == RC_JARVIS) {
       /* Jarvis scheme, using resistance factors from Wigmosta et al., 1994 */
       veg_var->rc = calc_rc(veg_lib[veg_class].rmin, net_short,
 		   veg_lib[veg_class].RGL, air_temp, vpd,
 			    veg_var->LAI, gsm_inv, FALSE,flag_irr);
-      if (options.CARBON) {
+      if (OPT_CARBON) {
         for (cidx=0; cidx<options.Ncanopy; cidx++) {
           if (veg_var->LAI > 0)
             veg_var->rsLayer[cidx] = veg_var->rc / veg_var->LAI;
@@ -374,7 +376,7 @@ void transpiration(layer_data_struct *layer,
     /** Note the indexing of the roots **/
     root_sum=1.0;
     spare_evap=0.0;
-    for(i=0;i<options.Nlayer;i++){
+    for(i=0;i<OPT_Nlayer;i++){
       if(avail_moist[i]>=Wcr[i]){
         layerevap[i]=evap*(double)root[i];
       }
@@ -394,7 +396,7 @@ void transpiration(layer_data_struct *layer,
 
     /** Assign excess evaporation to wetter layer **/
     if(spare_evap>0.0){
-      for(i=0;i<options.Nlayer;i++){
+      for(i=0;i<OPT_Nlayer;i++){
         if(avail_moist[i] >= Wcr[i]){
           layerevap[i] += (double)root[i]*spare_evap/root_sum;
         }
@@ -413,14 +415,14 @@ void transpiration(layer_data_struct *layer,
 
     /* Initialize conductances for aggregation over soil layers */
     gc =  0;
-    if (options.CARBON) {
+    if (OPT_CARBON) {
       gsLayer = (double *)calloc(options.Ncanopy, sizeof(double));
       for (cidx=0; cidx<options.Ncanopy; cidx++) {
         gsLayer[cidx] = 0;
       }
     }
 
-    for (i=0;i<options.Nlayer;i++) {
+    for (i=0;i<OPT_Nlayer;i++) {
 
       /** Set evaporation restriction factor **/
       if(avail_moist[i] >= Wcr[i])
@@ -433,12 +435,12 @@ void transpiration(layer_data_struct *layer,
       if(gsm_inv > 0.0){
 
         /* compute whole-canopy stomatal resistance */
-        if (!options.CARBON || options.RC_MODE == RC_JARVIS) {
+        if (!OPT_CARBON || options.RC_MODE == RC_JARVIS) {
           /* Jarvis scheme, using resistance factors from Wigmosta et al., 1994 */
           veg_var->rc = calc_rc(veg_lib[veg_class].rmin, net_short,
 		       veg_lib[veg_class].RGL, air_temp, vpd,
 				veg_var->LAI, gsm_inv, FALSE,flag_irr);
-          if (options.CARBON) {
+          if (OPT_CARBON) {
             for (cidx=0; cidx<options.Ncanopy; cidx++) {
               if (veg_var->LAI > 0)
                 veg_var->rsLayer[cidx] = veg_var->rc / veg_var->LAI;
@@ -465,7 +467,7 @@ void transpiration(layer_data_struct *layer,
         else
           gc += HUGE_RESIST;
 
-        if (options.CARBON) {
+        if (OPT_CARBON) {
           for (cidx=0; cidx<options.Ncanopy; cidx++) {
             if (veg_var->rsLayer[cidx] > 0)
               gsLayer[cidx] += 1/(veg_var->rsLayer[cidx]);
@@ -478,7 +480,7 @@ void transpiration(layer_data_struct *layer,
       else {
 	layerevap[i] = 0.0;
         gc += 0;
-        if (options.CARBON) {
+        if (OPT_CARBON) {
           for (cidx=0; cidx<options.Ncanopy; cidx++) {
             gsLayer[cidx] += 0;
           }
@@ -494,7 +496,7 @@ void transpiration(layer_data_struct *layer,
       veg_var->rc = HUGE_RESIST;
     if (veg_var->rc > RSMAX) veg_var->rc = RSMAX;
 
-    if (options.CARBON) {
+    if (OPT_CARBON) {
       for (cidx=0; cidx<options.Ncanopy; cidx++) {
         if (gsLayer[cidx] > 0)
           veg_var->rsLayer[cidx] = 1/gsLayer[cidx];
@@ -504,7 +506,7 @@ void transpiration(layer_data_struct *layer,
       }
     }
 
-    if (options.CARBON) free((char *)gsLayer);
+    if (OPT_CARBON) free((char *)gsLayer);
 
   }
 
@@ -512,7 +514,7 @@ void transpiration(layer_data_struct *layer,
     Check that evapotransipration does not cause soil moisture to 
     fall below wilting point.
   ****************************************************************/
-  for ( i = 0; i < options.Nlayer; i++ ) {
+  for ( i = 0; i < OPT_Nlayer; i++ ) {
     if ( ice[i] > 0 ) {
       if ( ice[i] >= Wpwp[i] ) {
 	// ice content greater than wilting point can use all unfrozen moist
@@ -27,6 +27,9 @@ void close_files(filep_struct         *filep,
 	      out_data_files structure.					TJB
   2006-Oct-16 Merged infiles and outfiles structs into filep_struct.	TJB
   2012-Jan-16 Removed LINK_DEBUG code					BN
+  2026-Oct-18 With SINGLE_OUTFILE, the output of the cell is appended
+	      to the file of all cells as one chunk; see
+	      close_single_outfiles().
 **********************************************************************/
 {
   extern option_struct options;
@@ -52,6 +55,66 @@ void close_files(filep_struct         *filep,
     *******************/
   for (filenum=0; filenum<options.Noutfiles; filenum++) {
     fclose(out_data_files[filenum].fh);
+    out_data_files[filenum].fh = NULL;
+    if(options.SINGLE_OUTFILE) {
+      write_outfile_chunk(&out_data_files[filenum]);
+      continue;
+    }
+    if(options.COMPRESS) compress_files(out_data_files[filenum].filename);
+  }
+
+}
+
+void write_outfile_chunk(out_data_file_struct *out_data_file)
+/**********************************************************************
+  write_outfile_chunk
+
+  Appends the output of one cell, collected in memory, to the file of
+  all cells (SINGLE_OUTFILE).  Each chunk is preceded by the name of
+  the cell and its size, in the format of the file: for ASCII files a
+  line "CELL <lat>_<lon> <bytes>", for binary files the name as 40
+  characters padded with '\0' and the size as an unsigned int.  The
+  chunk itself is what the file of the cell would contain.
+**********************************************************************/
+{
+  extern option_struct options;
+  char         name[40];
+  unsigned int nbytes;
+
+  if(out_data_file->block == NULL) return;
+
+  nbytes = (unsigned int)out_data_file->blocksize;
+  if(options.BINARY_OUTPUT) {
+    memset(name, 0, 40);
+    snprintf(name, sizeof(name), "%s", out_data_file->cellname);
+    fwrite(name, sizeof(char), 40, out_data_file->single_fh);
+    fwrite(&nbytes, sizeof(unsigned int), 1, out_data_file->single_fh);
+  }
+  else
+    fprintf(out_data_file->single_fh, "CELL %s %u\n",
+	    out_data_file->cellname, nbytes);
+  fwrite(out_data_file->block, sizeof(char), nbytes, out_data_file->single_fh);
+
+  free(out_data_file->block);
+  out_data_file->block = NULL;
+  out_data_file->blocksize = 0;
+}
+
+void close_single_outfiles(out_data_file_struct *out_data_files)
+/**********************************************************************
+  close_single_outfiles
+
+  Closes the files of all cells (SINGLE_OUTFILE) at the end of the
+  run, and compresses them if COMPRESS is set.
+**********************************************************************/
+{
+  extern option_struct options;
+  int filenum;
+
+  for (filenum=0; filenum<options.Noutfiles; filenum++) {
+    if(out_data_files[filenum].single_fh == NULL) continue;
+    fclose(out_data_files[filenum].single_fh);
+    out_data_files[filenum].single_fh = NULL;
     if(options.COMPRESS) compress_files(out_data_files[filenum].filename);
   }
 
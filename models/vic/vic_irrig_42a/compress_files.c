@@ -1,21 +1,80 @@
 #include <stdio.h>
 #include <strings.h>
+#include <string.h>
 #include <stdlib.h>
 #include <vicNl.h>
+#if VIC_ZLIB
+#include <unistd.h>
+#include <pthread.h>
+#include <zlib.h>
+#endif
 
 static char vcid[] = "$Id$";
 
+#if VIC_ZLIB
+#define ZLIB_CHUNK 262144  /* bytes read per gzwrite() */
+
+/* Files waiting to be compressed, in the order they were closed */
+typedef struct compress_job {
+  char                 name[MAXSTRING];
+  struct compress_job *next;
+} compress_job;
+
+static compress_job   *job_head = NULL;
+static compress_job   *job_tail = NULL;
+static pthread_t       worker;
+static pthread_mutex_t job_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t  job_cond = PTHREAD_COND_INITIALIZER;
+static char            worker_running = FALSE;
+static char            worker_stop = FALSE;
+
+static void *compress_worker(void *);
+static void gzip_file(char *);
+#endif
+
 void compress_files(char string[])
 /**********************************************************************
   compress_files.c	Keith Cherkauer		September 10, 1997
 
   This subroutine compresses the file "string" using a system call.
 
+  Modifications:
+  2026-Oct-18 With COMPRESS ZLIB the file is queued for a background
+	      thread that compresses it with zlib, giving the same
+	      "string.gz" as gzip; call finish_compression() before
+	      the model exits.
 **********************************************************************/
 {
+  extern option_struct options;
 
   char command[MAXSTRING];
 
+#if VIC_ZLIB
+  compress_job *job;
+
+  if (options.COMPRESS == COMPRESS_ZLIB) {
+    job = (compress_job *) malloc(sizeof(compress_job));
+    if (job == NULL)
+      nrerror("Memory allocation error in compress_files().");
+    strcpy(job->name, string);
+    job->next = NULL;
+
+    pthread_mutex_lock(&job_lock);
+    if (job_tail == NULL) job_head = job;
+    else job_tail->next = job;
+    job_tail = job;
+    if (!worker_running) {
+      worker_stop = FALSE;
+      if (pthread_create(&worker, NULL, compress_worker, NULL) != 0)
+        nrerror("Unable to start the compression thread.");
+      worker_running = TRUE;
+    }
+    pthread_cond_signal(&job_cond);
+    pthread_mutex_unlock(&job_lock);
+    return;
+  }
+#endif
+
   /** uncompress and open zipped file **/
 #if VERBOSE
   fprintf(stderr,"zipping \"%s\".\n",string);
@@ -25,3 +84,89 @@ void compress_files(char string[])
   system(command);
 
 }
+
+void finish_compression()
+/**********************************************************************
+  finish_compression
+
+  Waits until all files queued by compress_files() are compressed.
+**********************************************************************/
+{
+#if VIC_ZLIB
+  if (!worker_running)
+    return;
+
+  pthread_mutex_lock(&job_lock);
+  worker_stop = TRUE;
+  pthread_cond_signal(&job_cond);
+  pthread_mutex_unlock(&job_lock);
+
+  pthread_join(worker, NULL);
+  worker_running = FALSE;
+#endif
+}
+
+#if VIC_ZLIB
+static void *compress_worker(void *arg)
+{
+  compress_job *job;
+
+  while (TRUE) {
+    pthread_mutex_lock(&job_lock);
+    while (job_head == NULL && !worker_stop)
+      pthread_cond_wait(&job_cond, &job_lock);
+    job = job_head;
+    if (job != NULL) {
+      job_head = job->next;
+      if (job_head == NULL) job_tail = NULL;
+    }
+    pthread_mutex_unlock(&job_lock);
+
+    if (job == NULL)
+      return NULL;
+
+    gzip_file(job->name);
+    free(job);
+  }
+}
+
+/* Replaces the file "name" by "name.gz", like gzip -f */
+static void gzip_file(char *name)
+{
+  char    zipname[MAXSTRING+3];
+  char   *buffer;
+  FILE   *in;
+  gzFile  out;
+  size_t  n;
+  int     ok;
+
+#if VERBOSE
+  fprintf(stderr,"zipping \"%s\".\n",name);
+#endif
+
+  if ((in = fopen(name, "rb")) == NULL) {
+    fprintf(stderr, "WARNING: Unable to open \"%s\" for compression.\n", name);
+    return;
+  }
+  sprintf(zipname, "%s.gz", name);
+  if ((out = gzopen(zipname, "wb")) == NULL) {
+    fprintf(stderr, "WARNING: Unable to open \"%s\" for writing.\n", zipname);
+    fclose(in);
+    return;
+  }
+
+  buffer = (char *) malloc(ZLIB_CHUNK);
+  ok = (buffer != NULL);
+  while (ok && (n = fread(buffer, 1, ZLIB_CHUNK, in)) > 0)
+    ok = (gzwrite(out, buffer, (unsigned) n) == (int) n);
+  free(buffer);
+  fclose(in);
+
+  if (gzclose(out) != Z_OK || !ok) {
+    fprintf(stderr, "WARNING: Compression of \"%s\" failed; the file is left uncompressed.\n", name);
+    unlink(zipname);
+    return;
+  }
+  unlink(name);
+}
+#endif
@@ -24,10 +24,12 @@ void compute_pot_evap(int veg_class,
 
   modifications:
   2009-Aug-21 Fixed bug in assignment of albedo for natural vegetation.	TJB
+  2026-Oct-18 Types that are not written (options.PET_OUT) are set to 0.
 
 ****************************************************************************/
 {
   extern veg_lib_struct *veg_lib;
+  extern option_struct options;
   extern char ref_veg_ref_crop[];
 
   int NVegLibTypes;
@@ -50,6 +52,8 @@ void compute_pot_evap(int veg_class,
   ************************************************/
 
   NVegLibTypes = veg_lib[0].NVegLibTypes;
+  net_short = 0;
+  flag_irr = FALSE;
   for (i=0; i<N_PET_TYPES; i++) {
     if (i < N_PET_TYPES_NON_NAT) {
       rs = veg_lib[NVegLibTypes+i].rmin;
@@ -67,6 +71,12 @@ void compute_pot_evap(int veg_class,
       albedo = veg_lib[veg_class].albedo[dmy[rec].month-1];
       flag_irr = veg_lib[veg_class].irr_active[dmy[rec].month-1];
     }
+    if (!options.PET_OUT[i]) {
+      /* not written; net_short is still needed by calc_rc() of the next type */
+      net_short = (1.0 - albedo) * shortwave;
+      pot_evap[i] = 0;
+      continue;
+    }
     gsm_inv = 1.0;
     ref_crop = ref_veg_ref_crop[i];
     rc = calc_rc(rs, net_short, RGL, tair, vpd, lai, gsm_inv, ref_crop,flag_irr);
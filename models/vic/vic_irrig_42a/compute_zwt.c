@@ -18,6 +18,8 @@ double compute_zwt(soil_con_struct  *soil_con,
   2011-Mar-01 Simplified this function and added wrap_compute_zwt() to
 	      call it.							TJB
   2012-Jan-16 Removed LINK_DEBUG code					BN
+  2026-Oct-18 Options are read through OPT_* (see vicNl_def.h), so
+	      that specialized builds can fix them at compile time.
 ****************************************************************************/
 
 {
@@ -75,25 +77,25 @@ void wrap_compute_zwt(soil_con_struct  *soil_con,
 
   /** Compute total soil column depth **/
   total_depth = 0;
-  for (lindex=0; lindex<options.Nlayer; lindex++) {
+  for (lindex=0; lindex<OPT_Nlayer; lindex++) {
     total_depth += soil_con->depth[lindex];
   }
 
   /** Compute each layer's zwt using soil moisture v zwt curve **/
-  for (lindex=0; lindex<options.Nlayer; lindex++) {
+  for (lindex=0; lindex<OPT_Nlayer; lindex++) {
     cell->layer[lindex].zwt = compute_zwt(soil_con, lindex, cell->layer[lindex].moist);
   }
-  if (cell->layer[options.Nlayer-1].zwt == 999) cell->layer[options.Nlayer-1].zwt = -total_depth*100; // in cm
+  if (cell->layer[OPT_Nlayer-1].zwt == 999) cell->layer[OPT_Nlayer-1].zwt = -total_depth*100; // in cm
 
   /** Compute total soil column's zwt; this will be the zwt of the lowest layer that isn't completely saturated **/
-  lindex = options.Nlayer-1;
+  lindex = OPT_Nlayer-1;
   tmp_depth = total_depth;
   while (lindex>=0 && soil_con->max_moist[lindex]-cell->layer[lindex].moist<=SMALL) {
     tmp_depth -= soil_con->depth[lindex];
     lindex--;
   }
   if (lindex < 0) cell->zwt = 0;
-  else if (lindex < options.Nlayer-1) {
+  else if (lindex < OPT_Nlayer-1) {
     if (cell->layer[lindex].zwt != 999)
       cell->zwt = cell->layer[lindex].zwt;
     else
@@ -104,10 +106,10 @@ void wrap_compute_zwt(soil_con_struct  *soil_con,
 
   /** Compute total soil column's zwt_lumped; this will be the zwt of all N layers lumped together. **/
   tmp_moist = 0;
-  for (lindex=0; lindex<options.Nlayer; lindex++) {
+  for (lindex=0; lindex<OPT_Nlayer; lindex++) {
     tmp_moist += cell->layer[lindex].moist;
   }
-  cell->zwt_lumped = compute_zwt(soil_con, options.Nlayer+1, tmp_moist);
+  cell->zwt_lumped = compute_zwt(soil_con, OPT_Nlayer+1, tmp_moist);
   if (cell->zwt_lumped == 999) cell->zwt_lumped = -total_depth*100; // in cm;
 
 }
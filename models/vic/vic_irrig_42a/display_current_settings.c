@@ -67,6 +67,16 @@ void display_current_settings(int                 mode,
   2014-Mar-28 Removed DIST_PRCP option.					TJB
   2014-Apr-25 Added LAI_SRC, VEGPARAM_ALB, and ALB_SRC options.		TJB
   2014-Apr-25 Added VEGPARAM_VEGCOVER and VEGCOVER_SRC options.		TJB
+  2026-Oct-18 Added ROOT_WARMSTART option.
+  2026-Oct-18 Added ROOT_STATS option.
+  2026-Oct-18 Added IMPLICIT_FB option.
+  2026-Oct-18 Added CROPFRAC_COLLAPSE option.
+  2026-Oct-18 Added INIT_CHECKPOINT and SAVE_CHECKPOINT options.
+  2026-Oct-18 Added SINGLE_OUTFILE option and COMPRESS ZLIB.
+  2026-Oct-18 Added FORCE_CACHE option.
+  2026-Oct-18 Added ADAPT_SNOW_STEP option.
+  2026-Oct-18 Added BLOWING_TABLE option.
+  2026-Oct-18 Print the options fixed at compile time (VIC_SPEC).
 
 **********************************************************************/
 {
@@ -97,6 +107,12 @@ void display_current_settings(int                 mode,
   fprintf(stderr,"VERBOSE\t\t\tFALSE\n");
 #endif
 
+#ifdef VIC_SPEC
+  fprintf(stderr,"\n");
+  fprintf(stderr,"Specialized Build:\n");
+  fprintf(stderr,"VIC_SPEC\t\t%s\n",VIC_SPEC);
+#endif
+
   fprintf(stderr,"\n");
   fprintf(stderr,"Maximum Array Sizes:\n");
   fprintf(stderr,"MAX_BANDS\t\t%2d\n",MAX_BANDS);
@@ -138,6 +154,10 @@ void display_current_settings(int                 mode,
   fprintf(stderr,"RESOLUTION\t\t%f\n",global->resolution);
   fprintf(stderr,"TIME_STEP\t\t%d\n",global->dt);
   fprintf(stderr,"SNOW_STEP\t\t%d\n",options.SNOW_STEP);
+  if (options.ADAPT_SNOW_STEP)
+    fprintf(stderr,"ADAPT_SNOW_STEP\t\tTRUE\n");
+  else
+    fprintf(stderr,"ADAPT_SNOW_STEP\t\tFALSE\n");
   fprintf(stderr,"STARTYEAR\t\t%d\n",global->startyear);
   fprintf(stderr,"STARTMONTH\t\t%d\n",global->startmonth);
   fprintf(stderr,"STARTDAY\t\t%d\n",global->startday);
@@ -164,6 +184,10 @@ void display_current_settings(int                 mode,
     fprintf(stderr,"BLOWING\t\t\tTRUE\n");
   else
     fprintf(stderr,"BLOWING\t\t\tFALSE\n");
+  if (options.BLOWING_TABLE)
+    fprintf(stderr,"BLOWING_TABLE\t\tTRUE\t%s\n",names->blowing_table);
+  else
+    fprintf(stderr,"BLOWING_TABLE\t\tFALSE\n");
   if (options.CLOSE_ENERGY)
     fprintf(stderr,"CLOSE_ENERGY\t\t\tTRUE\n");
   else
@@ -184,6 +208,10 @@ void display_current_settings(int                 mode,
     fprintf(stderr,"CROPFRAC\t\tTRUE\n");
   else
     fprintf(stderr,"CROPFRAC\t\tFALSE\n");
+  if (options.CROPFRAC_COLLAPSE)
+    fprintf(stderr,"CROPFRAC_COLLAPSE\tTRUE\n");
+  else
+    fprintf(stderr,"CROPFRAC_COLLAPSE\tFALSE\n");
   if (options.EXP_TRANS)
     fprintf(stderr,"EXP_TRANS\t\tTRUE\n");
   else
@@ -228,6 +256,7 @@ void display_current_settings(int                 mode,
     fprintf(stderr,"IMPLICIT\t\tTRUE\n");
   else
     fprintf(stderr,"IMPLICIT\t\tFALSE\n");
+  fprintf(stderr,"IMPLICIT_FB\t\t%d\n",options.IMPLICIT_FB);
   if (options.NOFLUX)
     fprintf(stderr,"NOFLUX\t\t\tTRUE\n");
   else
@@ -248,6 +277,14 @@ void display_current_settings(int                 mode,
     fprintf(stderr,"QUICK_SOLVE\t\tTRUE\n");
   else
     fprintf(stderr,"QUICK_SOLVE\t\tFALSE\n");
+  if (options.ROOT_WARMSTART)
+    fprintf(stderr,"ROOT_WARMSTART\t\tTRUE\n");
+  else
+    fprintf(stderr,"ROOT_WARMSTART\t\tFALSE\n");
+  if (options.ROOT_STATS)
+    fprintf(stderr,"ROOT_STATS\t\tTRUE\n");
+  else
+    fprintf(stderr,"ROOT_STATS\t\tFALSE\n");
   if (options.SPATIAL_FROST == TRUE) {
     fprintf(stderr,"SPATIAL_FROST\t\tTRUE\n");
     fprintf(stderr,"Nfrost\t\t%d\n",options.Nfrost);
@@ -321,6 +358,10 @@ void display_current_settings(int                 mode,
     fprintf(stderr,"ALMA_INPUT\t\tTRUE\n");
   else
     fprintf(stderr,"ALMA_INPUT\t\tFALSE\n");
+  if (options.FORCE_CACHE)
+    fprintf(stderr,"FORCE_CACHE\t\t%s\n",param_set.FORCE_CACHE_PFX);
+  else
+    fprintf(stderr,"FORCE_CACHE\t\tFALSE\n");
 
   fprintf(stderr,"\n");
   fprintf(stderr,"Input Soil Data:\n");
@@ -433,6 +474,17 @@ void display_current_settings(int                 mode,
     fprintf(stderr,"SAVE_STATE\t\tFALSE\n");
   }
 
+  fprintf(stderr,"\n");
+  fprintf(stderr,"Checkpoint Files:\n");
+  if (options.INIT_CHECKPOINT)
+    fprintf(stderr,"INIT_CHECKPOINT\t\tTRUE\t%s\n",names->init_checkpoint);
+  else
+    fprintf(stderr,"INIT_CHECKPOINT\t\tFALSE\n");
+  if (options.SAVE_CHECKPOINT)
+    fprintf(stderr,"CHECKPOINT\t\t%s\n",names->checkpoint);
+  else
+    fprintf(stderr,"CHECKPOINT\t\tFALSE\n");
+
   fprintf(stderr,"\n");
   fprintf(stderr,"Output Data:\n");
   fprintf(stderr,"Result dir:\t\t%s\n",names->result_dir);
@@ -445,7 +497,9 @@ void display_current_settings(int                 mode,
     fprintf(stderr,"BINARY_OUTPUT\t\tTRUE\n");
   else
     fprintf(stderr,"BINARY_OUTPUT\t\tFALSE\n");
-  if (options.COMPRESS)
+  if (options.COMPRESS == COMPRESS_ZLIB)
+    fprintf(stderr,"COMPRESS\t\tZLIB\n");
+  else if (options.COMPRESS)
     fprintf(stderr,"COMPRESS\t\tTRUE\n");
   else
     fprintf(stderr,"COMPRESS\t\tFALSE\n");
@@ -461,6 +515,10 @@ void display_current_settings(int                 mode,
     fprintf(stderr,"PRT_HEADER\t\tTRUE\n");
   else
     fprintf(stderr,"PRT_HEADER\t\tFALSE\n");
+  if (options.SINGLE_OUTFILE)
+    fprintf(stderr,"SINGLE_OUTFILE\t\tTRUE\n");
+  else
+    fprintf(stderr,"SINGLE_OUTFILE\t\tFALSE\n");
   if (options.PRT_SNOW_BAND)
     fprintf(stderr,"PRT_SNOW_BAND\t\tTRUE\n");
   else
@@ -2,10 +2,15 @@
 #include <stdlib.h>
 #include <strings.h>
 #include <vicNl.h>
-#include <stdarg.h>
 
 #define MAXIT 1000
 
+/* node states of the last fda_heat_eqn() call, used by fda_heat_jac() */
+static double ice_new[MAX_NODES], Cs_new[MAX_NODES], kappa_new[MAX_NODES];
+static double DT[MAX_NODES], DT_up[MAX_NODES], DT_down[MAX_NODES];
+static double Dkappa[MAX_NODES];
+static double dice[MAX_NODES], dkappa[MAX_NODES], dCs[MAX_NODES];
+
 static char vcid[] = "$Id$";
 
 int calc_layer_average_thermal_props(energy_bal_struct *energy,
@@ -289,31 +294,91 @@ int solve_T_profile_implicit(double *T,                           // update
   2012-Jan-16 Removed LINK_DEBUG code					BN
   2013-Dec-26 Removed EXCESS_ICE option.				TJB
   2014-Jan-14 Modified cold nose hack to also cover warm nose case.
+  2026-Oct-18 Set up fda_heat_eqn() through heat_eqn_args_struct instead
+	      of a variable argument list.
   **********************************************************************/
   
   extern option_struct options;
   int  n, Error;
-  double res[MAX_NODES];
-  void (*vecfunc)(double *, double *, int, int, ...);
   int j;
+  int i, lidx;
+  double Lsum;
+  char PAST_BOTTOM;
+  heat_eqn_args_struct args;
 
   if(FIRST_SOLN[0]) 
     FIRST_SOLN[0] = FALSE;
   
-  // initialize fda_heat_eqn:
+  // set up fda_heat_eqn:
   // pass model parameters, initial states, and soil parameters
-  // it MUST be initialized before Newton-Raphson searching  
+  // it MUST be set up before Newton-Raphson searching  
   if(!NOFLUX)
     n = Nnodes-2;
   else
     n = Nnodes-1;
   
-  fda_heat_eqn(&T[1], res, n, 1, deltat, FS_ACTIVE, NOFLUX, EXP_TRANS, T0, moist, ice, kappa, Cs, max_moist, bubble, expt, 
-	       alpha, beta, gamma, Zsum, Dp, bulk_dens_min, soil_dens_min, quartz, bulk_density, soil_density, organic, depth, options.Nlayer);
-  
+  args.deltat        = deltat;
+  args.FS_ACTIVE     = FS_ACTIVE;
+  args.NOFLUX        = NOFLUX;
+  args.EXP_TRANS     = EXP_TRANS;
+  args.T0            = T0;
+  args.moist         = moist;
+  args.ice           = ice;
+  args.kappa         = kappa;
+  args.Cs            = Cs;
+  args.max_moist     = max_moist;
+  args.bubble        = bubble;
+  args.expt          = expt;
+  args.alpha         = alpha;
+  args.beta          = beta;
+  args.gamma         = gamma;
+  args.Zsum          = Zsum;
+  args.Dp            = Dp;
+  args.bulk_dens_min = bulk_dens_min;
+  args.soil_dens_min = soil_dens_min;
+  args.quartz        = quartz;
+  args.bulk_density  = bulk_density;
+  args.soil_density  = soil_density;
+  args.organic       = organic;
+  args.depth         = depth;
+  args.Nlayers       = options.Nlayer;
+
+  if(EXP_TRANS){
+    if(!NOFLUX)
+      args.Bexp = logf(Dp+1.)/(double)(n+1); 
+    else
+      args.Bexp = logf(Dp+1.)/(double)(n);
+  }    
+  else
+    args.Bexp = 0;
+
+  args.Ts = T0[0];
+  if(!NOFLUX)
+    args.Tb = T0[n+1];
+  else
+    args.Tb = T0[n];
+
+  // soil layer whose properties are used for each node
+  lidx = 0;
+  Lsum = 0.;
+  PAST_BOTTOM = FALSE;
+  for (i=0; i<n+1; i++) {
+    args.lidx[i] = lidx;
+    if(Zsum[i] > Lsum + depth[lidx] && !PAST_BOTTOM) {
+      Lsum += depth[lidx];
+      lidx++;
+      if( lidx == options.Nlayer ) {
+	PAST_BOTTOM = TRUE;
+	lidx = options.Nlayer-1;
+      }
+    }
+  }
+
+  for (i=0; i<n; i++) 
+    T[i+1] = T0[i+1];    
+
   // modified Newton-Raphson to solve for new T
-  vecfunc = &(fda_heat_eqn);
-  Error = newt_raph(vecfunc, &T[1], n);
+  Error = newt_raph(&T[1], n, &args);
  
   // update temperature boundaries
   if(Error == 0 ){
@@ -394,6 +459,10 @@ int calc_soil_thermal_fluxes(int     Nnodes,
   2013-Dec-27 Moved SPATIAL_FROST to options_struct.			TJB
   2013-Dec-27 Removed QUICK_FS option.					TJB
   2014-Mar-28 Modified cold nose hack to also cover warm nose case.	TJB
+  2026-Oct-18 Pass the arguments of soil_thermal_eqn() to root_brent() in an
+	      argument structure; removed error_solve_T_profile().
+  2026-Oct-18 Solve for the node temperatures with root_brent_warm(),
+	      starting from the previous iterate.
   **********************************************************************/
 
   /** Eventually the nodal ice contents will also have to be updated **/
@@ -410,6 +479,7 @@ int calc_soil_thermal_fluxes(int     Nnodes,
   double oldT;
   char ErrorString[MAXSTRING];
   double Tlast[MAX_NODES];
+  soil_thermal_args_struct args;
 
   Error = 0;
   Done = FALSE;
@@ -440,12 +510,24 @@ int calc_soil_thermal_fluxes(int     Nnodes,
 	  T[j] = (A[j]*T0[j]+B[j]*(T[j+1]-T[j-1])+C[j]*(T[j+1]+T[j-1])-D[j]*(T[j+1]-T[j-1])+E[j]*(0.-ice[j]))/(A[j]+2.*C[j]);
       }
       else {
-	T[j] = root_brent(T0[j]-(SOIL_DT), T0[j]+(SOIL_DT),
-			  ErrorString, soil_thermal_eqn, 
-			  T[j+1], T[j-1], T0[j], moist[j], max_moist[j], 
-			  bubble[j], expt[j], 
-			  ice[j], gamma[j-1], 
-			  A[j], B[j], C[j], D[j], E[j], EXP_TRANS, j);
+	args.TL        = T[j+1];
+	args.TU        = T[j-1];
+	args.T0        = T0[j];
+	args.moist     = moist[j];
+	args.max_moist = max_moist[j];
+	args.bubble    = bubble[j];
+	args.expt      = expt[j];
+	args.ice0      = ice[j];
+	args.gamma     = gamma[j-1];
+	args.A         = A[j];
+	args.B         = B[j];
+	args.C         = C[j];
+	args.D         = D[j];
+	args.E         = E[j];
+	args.EXP_TRANS = EXP_TRANS;
+	args.node      = j;
+	T[j] = root_brent_warm(ROOT_SOIL, T[j], T0[j]-(SOIL_DT), T0[j]+(SOIL_DT),
+			       ErrorString, soil_thermal_eqn, &args);
 	if(T[j] <= -998 ) {
           if (options.TFALLBACK) {
             T[j] = T0[j];
@@ -453,10 +535,7 @@ int calc_soil_thermal_fluxes(int     Nnodes,
             Tfbcount[j]++;
           }
           else {
-	    error_solve_T_profile(T[j], T[j+1], T[j-1], T0[j], moist[j], 
-				  max_moist[j], bubble[j], expt[j], ice[j], 
-				  gamma[j-1], A[j], B[j], C[j], D[j], 
-				  E[j], ErrorString);
+	    error_print_solve_T_profile(T[j], &args, ErrorString);
             return ( ERROR );
 	  }
 	}
@@ -478,14 +557,25 @@ int calc_soil_thermal_fluxes(int     Nnodes,
 	  T[j] = (A[j]*T0[j]+B[j]*(T[j]-T[j-1])+C[j]*(T[j]+T[j-1])-D[j]*(T[j]-T[j-1])+E[j]*(0.-ice[j]))/(A[j]+2.*C[j]);
       }
       else {
-	T[Nnodes-1] = root_brent(T0[Nnodes-1]-SOIL_DT, T0[Nnodes-1]+SOIL_DT,
-				 ErrorString, soil_thermal_eqn, T[Nnodes-1],
-				 T[Nnodes-2], T0[Nnodes-1], 
-				 moist[Nnodes-1], max_moist[Nnodes-1], 
-				 bubble[j], expt[Nnodes-1], 
-				 ice[Nnodes-1], 
-				 gamma[Nnodes-2], 
-				 A[j], B[j], C[j], D[j], E[j], EXP_TRANS, j);
+	args.TL        = T[Nnodes-1];
+	args.TU        = T[Nnodes-2];
+	args.T0        = T0[Nnodes-1];
+	args.moist     = moist[Nnodes-1];
+	args.max_moist = max_moist[Nnodes-1];
+	args.bubble    = bubble[j];
+	args.expt      = expt[Nnodes-1];
+	args.ice0      = ice[Nnodes-1];
+	args.gamma     = gamma[Nnodes-2];
+	args.A         = A[j];
+	args.B         = B[j];
+	args.C         = C[j];
+	args.D         = D[j];
+	args.E         = E[j];
+	args.EXP_TRANS = EXP_TRANS;
+	args.node      = j;
+	T[Nnodes-1] = root_brent_warm(ROOT_SOIL, T[Nnodes-1],
+				      T0[Nnodes-1]-SOIL_DT, T0[Nnodes-1]+SOIL_DT,
+				      ErrorString, soil_thermal_eqn, &args);
 	if(T[j] <= -998 ) {
           if (options.TFALLBACK) {
             T[j] = T0[j];
@@ -493,13 +583,7 @@ int calc_soil_thermal_fluxes(int     Nnodes,
             Tfbcount[j]++;
           }
           else {
-	    error_solve_T_profile(T[Nnodes-1], T[Nnodes-1],
-				  T[Nnodes-2], T0[Nnodes-1], 
-				  moist[Nnodes-1], max_moist[Nnodes-1], 
-				  bubble[Nnodes-1], 
-				  expt[Nnodes-1], ice[Nnodes-1], 
-				  gamma[Nnodes-2], 
-				  A[j], B[j], C[j], D[j], E[j], ErrorString);
+	    error_print_solve_T_profile(T[Nnodes-1], &args, ErrorString);
             return ( ERROR );
           }
         }
@@ -553,21 +637,8 @@ int calc_soil_thermal_fluxes(int     Nnodes,
 
 }
 
-double error_solve_T_profile (double Tj, ...) {
-
-  va_list ap;
-
-  double error;
-
-  va_start(ap,Tj);
-  error = error_print_solve_T_profile(Tj, ap);
-  va_end(ap);
-
-  return error;
-
-}
-
-double error_print_solve_T_profile(double T, va_list ap) {
+double error_print_solve_T_profile(double T, soil_thermal_args_struct *args,
+				   char *ErrorString) {
 
   double TL;
   double TU;
@@ -583,23 +654,21 @@ double error_print_solve_T_profile(double T, va_list ap) {
   double C;
   double D;
   double E;
-  char *ErrorString;
-
-  TL        = (double) va_arg(ap, double);
-  TU        = (double) va_arg(ap, double);
-  T0        = (double) va_arg(ap, double);
-  moist     = (double) va_arg(ap, double);
-  max_moist = (double) va_arg(ap, double);
-  bubble    = (double) va_arg(ap, double);
-  expt      = (double) va_arg(ap, double);
-  ice0      = (double) va_arg(ap, double);
-  gamma     = (double) va_arg(ap, double);
-  A         = (double) va_arg(ap, double);
-  B         = (double) va_arg(ap, double);
-  C         = (double) va_arg(ap, double);
-  D         = (double) va_arg(ap, double);
-  E         = (double) va_arg(ap, double);
-  ErrorString = (char *) va_arg(ap, char *);
+
+  TL        = args->TL;
+  TU        = args->TU;
+  T0        = args->T0;
+  moist     = args->moist;
+  max_moist = args->max_moist;
+  bubble    = args->bubble;
+  expt      = args->expt;
+  ice0      = args->ice0;
+  gamma     = args->gamma;
+  A         = args->A;
+  B         = args->B;
+  C         = args->C;
+  D         = args->D;
+  E         = args->E;
   
   fprintf(stderr, "%s", ErrorString);
   fprintf(stderr, "ERROR: solve_T_profile failed to converge to a solution in root_brent.  Variable values will be dumped to the screen, check for invalid values.\n");
@@ -629,7 +698,7 @@ double error_print_solve_T_profile(double T, va_list ap) {
 
 
 
-void fda_heat_eqn(double T_2[], double res[], int n, int init, ...)
+void fda_heat_eqn(double T_2[], double res[], int n, heat_eqn_args_struct *args)
 {
   /**********************************************************************
   Heat Equation for implicit scheme (used to calculate residual of the heat equation)
@@ -657,305 +726,224 @@ void fda_heat_eqn(double T_2[], double res[], int n, int init, ...)
 	      now all nodes are checked and corrected if necessary.		TJB
   2013-Jan-08 Excluded bottom node from check in cold nose fix.			TJB
   2013-Dec-26 Removed EXCESS_ICE option.				TJB
+  2026-Oct-18 Pass the model parameters in an argument structure instead
+	      of a va_list; the soil layer of each node is set up once by
+	      solve_T_profile_implicit().  Removed the evaluation of single
+	      nodes, which was only used by the finite difference Jacobian.
+	      The node ice contents and properties of the last call are kept
+	      for fda_heat_jac().
   **********************************************************************/
     
-  static double  deltat;
-  static int     FS_ACTIVE;
-  static int     NOFLUX;
-  static int     EXP_TRANS;
-  static double *T0;
-  static double *moist;
-  static double *ice;
-  static double *kappa;
-  static double *Cs;
-  static double *max_moist;
-  static double *bubble;
-  static double *expt;
-  static double *alpha;
-  static double *beta;
-  static double *gamma;
-  static double *Zsum;
-  static double Dp;
-  static double *bulk_dens_min;
-  static double *soil_dens_min;
-  static double *quartz;
-  static double *bulk_density;
-  static double *soil_density;
-  static double *organic;
-  static double *depth;
-  static int Nlayers;
-  
-  // variables used to calculate residual of the heat equation
-  // defined here
-  static double Ts;
-  static double Tb;
-  
-  // locally used variables
-  static double ice_new[MAX_NODES], Cs_new[MAX_NODES], kappa_new[MAX_NODES];
-  static double DT[MAX_NODES],DT_down[MAX_NODES],DT_up[MAX_NODES],T_up[MAX_NODES];
-  static double Dkappa[MAX_NODES];
-  static double Bexp;
-  char PAST_BOTTOM;
-  double storage_term, flux_term, phase_term, flux_term1, flux_term2;
-  double Lsum;
-  int i, lidx;
-  int focus, left, right;
-  
-  // argument list handling
-  va_list arg_addr;
-
-  // initialize variables if init==1  
-  if (init==1) {
-    va_start(arg_addr, init);
-    deltat     = va_arg(arg_addr, double);
-    FS_ACTIVE  = va_arg(arg_addr, int);
-    NOFLUX     = va_arg(arg_addr, int);
-    EXP_TRANS  = va_arg(arg_addr, int);
-    T0         = va_arg(arg_addr, double *);
-    moist      = va_arg(arg_addr, double *);
-    ice        = va_arg(arg_addr, double *);
-    kappa      = va_arg(arg_addr, double *);
-    Cs         = va_arg(arg_addr, double *);
-    max_moist  = va_arg(arg_addr, double *);
-    bubble     = va_arg(arg_addr, double *);
-    expt       = va_arg(arg_addr, double *);
-    alpha      = va_arg(arg_addr, double *);
-    beta       = va_arg(arg_addr, double *);
-    gamma      = va_arg(arg_addr, double *);
-    Zsum       = va_arg(arg_addr, double *);
-    Dp         = va_arg(arg_addr, double);
-    bulk_dens_min = va_arg(arg_addr, double *);
-    soil_dens_min = va_arg(arg_addr, double *);
-    quartz     = va_arg(arg_addr, double *);
-    bulk_density = va_arg(arg_addr, double *);
-    soil_density = va_arg(arg_addr, double *);
-    organic    = va_arg(arg_addr, double *);
-    depth      = va_arg(arg_addr, double *);
-    Nlayers    = va_arg(arg_addr, int);
-    
-    if(EXP_TRANS){
-      if(!NOFLUX)
-	Bexp = logf(Dp+1.)/(double)(n+1); 
-      else
-	Bexp = logf(Dp+1.)/(double)(n);
-    }    
+  double  deltat    = args->deltat;
+  int     NOFLUX    = args->NOFLUX;
+  int     EXP_TRANS = args->EXP_TRANS;
+  double *T0        = args->T0;
+  double *moist     = args->moist;
+  double *ice       = args->ice;
+  double *kappa     = args->kappa;
+  double *Cs        = args->Cs;
+  double *max_moist = args->max_moist;
+  double *bubble    = args->bubble;
+  double *expt      = args->expt;
+  double *alpha     = args->alpha;
+  double *beta      = args->beta;
+  double *gamma     = args->gamma;
+  double *Zsum      = args->Zsum;
+  double  Bexp      = args->Bexp;
+  double  Ts        = args->Ts;
+  double  Tb        = args->Tb;
+  double  storage_term, flux_term, phase_term, flux_term1, flux_term2;
+  int     i, lidx;
+
+  for (i=0; i<n+1; i++) {
+    kappa_new[i]=kappa[i];
+    if(i>=1) {  //all but surface node
+      // update ice contents
+      if (T_2[i-1]<0) {
+	ice_new[i] = moist[i] - maximum_unfrozen_water(T_2[i-1], 
+						       max_moist[i], bubble[i], expt[i]);
+	if (ice_new[i]<0) ice_new[i]=0;
+      }
+      else ice_new[i] = 0;
+      Cs_new[i]=Cs[i];
 
-    Ts = T0[0];
-    if(!NOFLUX)
-      Tb = T0[n+1];
-    else
-      Tb = T0[n];
-    for (i=0; i<n; i++) 
-      T_2[i] = T0[i+1];    
-  }
-  
-  // calculate residuals if init==0
-  else {
-    // get the range of columns to calculate
-    va_start(arg_addr, init);
-    focus = va_arg(arg_addr, int);
-    
-    // calculate all entries if focus == -1
-    if (focus==-1) {
-      
-      lidx = 0;
-      Lsum = 0.;
-      PAST_BOTTOM = FALSE;
-
-      for (i=0; i<n+1; i++) {
-	kappa_new[i]=kappa[i];
-	if(i>=1) {  //all but surface node
-	  // update ice contents
-	  if (T_2[i-1]<0) {
-	    ice_new[i] = moist[i] - maximum_unfrozen_water(T_2[i-1], 
-							   max_moist[i], bubble[i], expt[i]);
-	    if (ice_new[i]<0) ice_new[i]=0;
-	  }
-	  else ice_new[i] = 0;
-	  Cs_new[i]=Cs[i];
-
-	  // update other states due to ice content change
-	  /***********************************************/
-	  if (ice_new[i]!=ice[i]) {
-	    kappa_new[i] = soil_conductivity(moist[i], moist[i] - ice_new[i],
-					     soil_dens_min[lidx], bulk_dens_min[lidx], quartz[lidx],
-					     soil_density[lidx], bulk_density[lidx], organic[lidx]);
-	    Cs_new[i] = volumetric_heat_capacity(bulk_density[lidx]/soil_density[lidx], moist[i]-ice_new[i], ice_new[i], organic[lidx]);
-	  }
-	  /************************************************/	  
-	}
-	
-	if(Zsum[i] > Lsum + depth[lidx] && !PAST_BOTTOM) {
-	  Lsum += depth[lidx];
-	  lidx++;
-	  if( lidx == Nlayers ) {
-	    PAST_BOTTOM = TRUE;
-	    lidx = Nlayers-1;
-	  }
-	}
+      // update other states due to ice content change
+      /***********************************************/
+      if (ice_new[i]!=ice[i]) {
+	lidx = args->lidx[i];
+	kappa_new[i] = soil_conductivity(moist[i], moist[i] - ice_new[i],
+					 args->soil_dens_min[lidx], args->bulk_dens_min[lidx], args->quartz[lidx],
+					 args->soil_density[lidx], args->bulk_density[lidx], args->organic[lidx]);
+	Cs_new[i] = volumetric_heat_capacity(args->bulk_density[lidx]/args->soil_density[lidx], moist[i]-ice_new[i], ice_new[i], args->organic[lidx]);
       }
+      /************************************************/	  
+    }
+  }
       
-      // constants used in fda equation
-      for (i=0; i<n; i++) {
-	if (i==0) {
-	  DT[i]=T_2[i+1]-Ts;
-	  DT_up[i]=T_2[i]-Ts;
-	  DT_down[i]=T_2[i+1]-T_2[i];
-	  T_up[i]=Ts;
-	}
-	else if (i==n-1) {
-	  DT[i]=Tb-T_2[i-1];
-	  DT_up[i]=T_2[i]-T_2[i-1];
-	  DT_down[i]=Tb-T_2[i];
-	  T_up[i]=T_2[i-1];
-	}
-	else {
-	  DT[i]=T_2[i+1]-T_2[i-1];
-	  DT_up[i]=T_2[i]-T_2[i-1];
-	  DT_down[i]=T_2[i+1]-T_2[i];
-	  T_up[i]=T_2[i-1];
-	}
-	if(i<n-1)
-	  Dkappa[i]=kappa_new[i+2]-kappa_new[i];
-	else
-	  if(!NOFLUX)
-	    Dkappa[i]=kappa_new[i+2]-kappa_new[i];
-	  else
-	    Dkappa[i]=kappa_new[i+1]-kappa_new[i];
-      }
+  // constants used in fda equation
+  for (i=0; i<n; i++) {
+    if (i==0) {
+      DT[i]=T_2[i+1]-Ts;
+      DT_up[i]=T_2[i]-Ts;
+      DT_down[i]=T_2[i+1]-T_2[i];
+    }
+    else if (i==n-1) {
+      DT[i]=Tb-T_2[i-1];
+      DT_up[i]=T_2[i]-T_2[i-1];
+      DT_down[i]=Tb-T_2[i];
+    }
+    else {
+      DT[i]=T_2[i+1]-T_2[i-1];
+      DT_up[i]=T_2[i]-T_2[i-1];
+      DT_down[i]=T_2[i+1]-T_2[i];
+    }
+    if(i<n-1)
+      Dkappa[i]=kappa_new[i+2]-kappa_new[i];
+    else
+      if(!NOFLUX)
+	Dkappa[i]=kappa_new[i+2]-kappa_new[i];
+      else
+	Dkappa[i]=kappa_new[i+1]-kappa_new[i];
+  }
       
-      for (i=0; i<n; i++) {
-	storage_term = Cs_new[i+1]*(T_2[i] - T0[i+1])/deltat + T_2[i]*(Cs_new[i+1]-Cs[i+1])/deltat;
-	if(!EXP_TRANS) {
-	  flux_term1 = Dkappa[i]/alpha[i]*DT[i]/alpha[i];
-	  flux_term2 = kappa_new[i+1]*(DT_down[i]/gamma[i]-DT_up[i]/beta[i])/(0.5*alpha[i]);
-	}
-	else { //grid transformation
-	  flux_term1 = Dkappa[i]/2.*DT[i]/2./(Bexp*(Zsum[i+1]+1.))/(Bexp*(Zsum[i+1]+1.));
-	  flux_term2 = kappa_new[i+1]*((DT_down[i]-DT_up[i])/(Bexp*(Zsum[i+1]+1.))/(Bexp*(Zsum[i+1]+1.))  -  DT[i]/2./(Bexp*(Zsum[i+1]+1.)*(Zsum[i+1]+1.)));
-	}
-	//inelegant fix for "cold nose" problem - when a very cold node skates off to
-	//much colder and breaks the second law of thermodynamics (because
-	//flux_term1 exceeds flux_term2 in absolute magnitude) - therefore, don't let
-	//that node get any colder.  This only seems to happen in the first and
-	//second near-surface nodes.
-//	if (i<n-1) {
-//	  if(fabs(DT[i])>5. && (T_2[i]<T_2[i+1] && T_2[i]<T_up[i])){//cold nose
-//	    if((flux_term1<0 && flux_term2>0) && fabs(flux_term1)>fabs(flux_term2)){
-//	      flux_term1 = 0;
+  for (i=0; i<n; i++) {
+    storage_term = Cs_new[i+1]*(T_2[i] - T0[i+1])/deltat + T_2[i]*(Cs_new[i+1]-Cs[i+1])/deltat;
+    if(!EXP_TRANS) {
+      flux_term1 = Dkappa[i]/alpha[i]*DT[i]/alpha[i];
+      flux_term2 = kappa_new[i+1]*(DT_down[i]/gamma[i]-DT_up[i]/beta[i])/(0.5*alpha[i]);
+    }
+    else { //grid transformation
+      flux_term1 = Dkappa[i]/2.*DT[i]/2./(Bexp*(Zsum[i+1]+1.))/(Bexp*(Zsum[i+1]+1.));
+      flux_term2 = kappa_new[i+1]*((DT_down[i]-DT_up[i])/(Bexp*(Zsum[i+1]+1.))/(Bexp*(Zsum[i+1]+1.))  -  DT[i]/2./(Bexp*(Zsum[i+1]+1.)*(Zsum[i+1]+1.)));
+    }
+    //inelegant fix for "cold nose" problem - when a very cold node skates off to
+    //much colder and breaks the second law of thermodynamics (because
+    //flux_term1 exceeds flux_term2 in absolute magnitude) - therefore, don't let
+    //that node get any colder.  This only seems to happen in the first and
+    //second near-surface nodes.
+//    if (i<n-1) {
+//      if(fabs(DT[i])>5. && (T_2[i]<T_2[i+1] && T_2[i]<T_up[i])){//cold nose
+//	if((flux_term1<0 && flux_term2>0) && fabs(flux_term1)>fabs(flux_term2)){
+//	  flux_term1 = 0;
 //#if VERBOSE
-//	      fprintf(stderr,"WARNING: resetting thermal flux term in soil heat solution to zero for node %d.\nT[i]=%.2f T[i-1]=%.2f T[i+1]=%.2f flux_term1=%.2f flux_term2=%.2f\n",i+1,T_2[i],T_up[i],T_2[i+1],flux_term1,flux_term2);
+//	  fprintf(stderr,"WARNING: resetting thermal flux term in soil heat solution to zero for node %d.\nT[i]=%.2f T[i-1]=%.2f T[i+1]=%.2f flux_term1=%.2f flux_term2=%.2f\n",i+1,T_2[i],T_up[i],T_2[i+1],flux_term1,flux_term2);
 //#endif
-//	    }
-//	  }
 //	}
-	flux_term = flux_term1+flux_term2;
-	phase_term   = ice_density*Lf * (ice_new[i+1] - ice[i+1])/deltat;
-        res[i] = flux_term + phase_term - storage_term;
+//      }
+//    }
+    flux_term = flux_term1+flux_term2;
+    phase_term   = ice_density*Lf * (ice_new[i+1] - ice[i+1])/deltat;
+    res[i] = flux_term + phase_term - storage_term;
+  }
+
+}
+
+
+
+void fda_heat_jac(double T_2[], double a[], double b[], double c[], int n,
+		  heat_eqn_args_struct *args)
+{
+  /**********************************************************************
+  Tridiagonal Jacobian of the residual computed by fda_heat_eqn(), used
+  by newt_raph().  Must be called after fda_heat_eqn() with the same T_2.
+
+  a[i], b[i] and c[i] are the derivatives of res[i] with respect to
+  T_2[i-1], T_2[i] and T_2[i+1].  The ice content of a node, and with it
+  its conductivity and heat capacity, depends on the temperature of the
+  node only; these slopes are computed analytically from
+  maximum_unfrozen_water_dT() and soil_conductivity_dWu().  Residuals
+  depend linearly on the neighbouring temperatures otherwise.
+
+  Replaces fdjac3(), which approximated the Jacobian by forward
+  differences with one residual evaluation per node.
+
+  Modifications:
+  **********************************************************************/
+
+  double  deltat    = args->deltat;
+  int     NOFLUX    = args->NOFLUX;
+  int     EXP_TRANS = args->EXP_TRANS;
+  double *T0        = args->T0;
+  double *moist     = args->moist;
+  double *Cs        = args->Cs;
+  double *alpha     = args->alpha;
+  double *beta      = args->beta;
+  double *gamma     = args->gamma;
+  double *Zsum      = args->Zsum;
+  double  Bexp      = args->Bexp;
+  double  dCs_dice;
+  double  dWu_dT, z2, zb;
+  double  f1, g_up, g_dn, g_self, Gsum;
+  double  Tup, Tdown, DTi, Dk;
+  int     i, j, lidx;
+
+  // Cs is linear in the ice content at constant total moisture
+  dCs_dice = volumetric_heat_capacity(0., -1., 1., 0.) - volumetric_heat_capacity(0., 0., 0., 0.);
+
+  // slopes of the node ice contents and properties; the surface and
+  // bottom boundary temperatures are fixed
+  for (j=0; j<n+1; j++) {
+    dice[j] = 0;
+    dkappa[j] = 0;
+    dCs[j] = 0;
+  }
+  for (j=1; j<n+1; j++) {
+    if (ice_new[j] > 0) {
+      dWu_dT = maximum_unfrozen_water_dT(T_2[j-1], args->max_moist[j], args->bubble[j], args->expt[j]);
+      if (dWu_dT != 0) {
+	lidx = args->lidx[j];
+	dice[j] = -dWu_dT;
+	dkappa[j] = dWu_dT * soil_conductivity_dWu(moist[j], moist[j] - ice_new[j],
+						args->soil_dens_min[lidx], args->bulk_dens_min[lidx], args->quartz[lidx],
+						args->soil_density[lidx], args->bulk_density[lidx], args->organic[lidx]);
+	dCs[j] = dCs_dice * dice[j];
       }
     }
-    
-    // only calculate entries focus-1, focus, and focus+1 if focus has a value>=0
+  }
+
+  for (i=0; i<n; i++) {
+    j = i+1;
+    Tup = (i==0) ? args->Ts : T_2[i-1];
+    Tdown = (i==n-1) ? args->Tb : T_2[i+1];
+    DTi = Tdown - Tup;
+    Dk = Dkappa[i];
+
+    // flux_term1 = f1*Dkappa*DT, flux_term2 = kappa*Gsum with Gsum linear in the
+    // temperatures of the node and its neighbours
+    if(!EXP_TRANS) {
+      f1 = 1./(alpha[i]*alpha[i]);
+      g_up = 1./beta[i]/(0.5*alpha[i]);
+      g_dn = 1./gamma[i]/(0.5*alpha[i]);
+      g_self = -g_up-g_dn;
+    }
     else {
-      if (focus==0)    left=0;   else  left=focus-1;
-      if (focus==n-1) right=n-1; else right=focus+1;
-
-      // update ice content for node focus and its adjacents
-      for (i=left; i<=right; i++) {
-	if (T_2[i]<0) {
-	  ice_new[i+1] = moist[i+1] - maximum_unfrozen_water(T_2[i], 
-							     max_moist[i+1], bubble[i+1], expt[i+1]);
-	  if (ice_new[i+1]<0) ice_new[i+1]=0;
-	}
-	else ice_new[i+1]=0;
-      }
-      
-      // update other parameters due to ice content change
-      /********************************************************/
-      lidx = 0;
-      Lsum = 0.;
-      PAST_BOTTOM = FALSE;
-      for (i=0; i<=right+1; i++) {
-	if(i>=left+1) {
-	  if (ice_new[i]!=ice[i]) {
-	    kappa_new[i] = soil_conductivity(moist[i], moist[i] - ice_new[i],
-					     soil_dens_min[lidx], bulk_dens_min[lidx], quartz[lidx],
-					     soil_density[lidx], bulk_density[lidx], organic[lidx]);
-	    Cs_new[i] = volumetric_heat_capacity(bulk_density[lidx]/soil_density[lidx], moist[i]-ice_new[i], ice_new[i], organic[lidx]);
-	  }
-	}
-	if(Zsum[i] > Lsum + depth[lidx] && !PAST_BOTTOM) {
-	  Lsum += depth[lidx];
-	  lidx++;
-	  if( lidx == Nlayers ) {
-	    PAST_BOTTOM = TRUE;
-	    lidx = Nlayers-1;
-	  }
-	}
-      }
-      /*********************************************************/
-      
-      // update other states due to ice content change
-      for (i=left; i<=right; i++) {
-	if (i==0) {
-	  DT[i]=T_2[i+1]-Ts;
-	  DT_up[i]=T_2[i]-Ts;
-	  DT_down[i]=T_2[i+1]-T_2[i];
-	  T_up[i]=Ts;
-	}
-	else if (i==n-1) {
-	  DT[i]=Tb-T_2[i-1];
-	  DT_up[i]=T_2[i]-T_2[i-1];
-	  DT_down[i]=Tb-T_2[i];
-	  T_up[i]=T_2[i-1];
-	}
-	else {
-	  DT[i]=T_2[i+1]-T_2[i-1];
-	  DT_up[i]=T_2[i]-T_2[i-1];
-	  DT_down[i]=T_2[i+1]-T_2[i];
-	  T_up[i]=T_2[i-1];
-	}
-	//update Dkappa due to ice content change
-	/*******************************************/
-	if(i<n-1)
-	  Dkappa[i]=kappa_new[i+2]-kappa_new[i];
-	else
-	  if(!NOFLUX)
-	    Dkappa[i]=kappa_new[i+2]-kappa_new[i];
-	  else
-	    Dkappa[i]=kappa_new[i+1]-kappa_new[i];
-	/********************************************/
-      }
-      
-      for (i=left; i<=right; i++) {
-	storage_term = Cs_new[i+1]*(T_2[i] - T0[i+1])/deltat + T_2[i]*(Cs_new[i+1]-Cs[i+1])/deltat;
-	if(!EXP_TRANS) {
-	  flux_term1 = Dkappa[i]/alpha[i]*DT[i]/alpha[i];
-	  flux_term2 = kappa_new[i+1]*(DT_down[i]/gamma[i]-DT_up[i]/beta[i])/(0.5*alpha[i]);
-	}
-	else { //grid transformation
-	  flux_term1 = Dkappa[i]/2.*DT[i]/2./(Bexp*(Zsum[i+1]+1.))/(Bexp*(Zsum[i+1]+1.));
-	  flux_term2 = kappa_new[i+1]*((DT_down[i]-DT_up[i])/(Bexp*(Zsum[i+1]+1.))/(Bexp*(Zsum[i+1]+1.))  -  DT[i]/2./(Bexp*(Zsum[i+1]+1.)*(Zsum[i+1]+1.)));
-	}
-	//inelegant fix for "cold nose" problem - when a very cold node skates off to
-	//much colder and breaks the second law of thermodynamics (because
-	//flux_term1 exceeds flux_term2 in absolute magnitude) - therefore, don't let
-	//that node get any colder.  This only seems to happen in the first and
-	//second near-surface nodes.
-//	if (i<n-1) {
-//	  if(fabs(DT[i])>5. && (T_2[i]<T_2[i+1] && T_2[i]<T_up[i])){//cold nose
-//	    if((flux_term1<0 && flux_term2>0) && fabs(flux_term1)>fabs(flux_term2)){
-//	      flux_term1 = 0;
-//#if VERBOSE
-//	      fprintf(stderr,"WARNING: resetting thermal flux term in soil heat solution to zero for node %d.\nT[i]=%.2f T[i-1]=%.2f T[i+1]=%.2f flux_term1=%.2f flux_term2=%.2f\n",i+1,T_2[i],T_up[i],T_2[i+1],flux_term1,flux_term2);
-//#endif
-//	    }
-//	  }
-	flux_term = flux_term1+flux_term2;
-	phase_term   = ice_density*Lf * (ice_new[i+1] - ice[i+1]) / deltat;
-        res[i] = flux_term + phase_term - storage_term;
-      }
-    } // end of calculation of focus node only
-  } // end of non-init
-  
+      zb = Bexp*(Zsum[j]+1.);
+      z2 = 1./(zb*zb);
+      f1 = 0.25*z2;
+      g_up = z2 + 0.5/(Bexp*(Zsum[j]+1.)*(Zsum[j]+1.));
+      g_dn = z2 - 0.5/(Bexp*(Zsum[j]+1.)*(Zsum[j]+1.));
+      g_self = -2.*z2;
+    }
+    Gsum = g_up*Tup + g_self*T_2[i] + g_dn*Tdown;
+
+    // node itself: conductivity, phase change and storage terms
+    b[i] = dkappa[j]*Gsum + kappa_new[j]*g_self
+      + ice_density*Lf*dice[j]/deltat
+      - (dCs[j]*(T_2[i]-T0[j]) + Cs_new[j] + (Cs_new[j]-Cs[j]) + T_2[i]*dCs[j])/deltat;
+    if (i==n-1 && NOFLUX)
+      b[i] += f1*dkappa[j]*DTi;
+
+    // node above
+    if (i>0)
+      a[i] = f1*(-dkappa[j-1]*DTi - Dk) + kappa_new[j]*g_up;
+    else
+      a[i] = 0;
+
+    // node below
+    if (i<n-1)
+      c[i] = f1*(dkappa[j+1]*DTi + Dk) + kappa_new[j]*g_dn;
+    else
+      c[i] = 0;
+  }
+
 }
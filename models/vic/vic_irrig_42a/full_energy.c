@@ -58,12 +58,12 @@ int  full_energy(int                  gridcell,
   2007-Nov-06 Added veg_con to parameter list of lakemain().  Replaced
 	      lake.fraci with lake.areai.					LCB via TJB
   2008-Jan-23 Changed ice0 from a scalar to an array.  Previously,
-	      when options.SNOW_BAND > 1, the value of ice0 computed
+	      when OPT_SNOW_BAND > 1, the value of ice0 computed
 	      for earlier bands was always overwritten by the value
 	      of ice0 computed for the final band (even if the final
 	      band had 0 area).							JS via TJB
   2008-May-05 Changed moist from a scalar to an array (moist0).  Previously,
-	      when options.SNOW_BAND > 1, the value of moist computed
+	      when OPT_SNOW_BAND > 1, the value of moist computed
 	      for earlier bands was always overwritten by the value
 	      of moist computed for the final band (even if the final
 	      band had 0 area).							KAC via TJB
@@ -114,6 +114,20 @@ int  full_energy(int                  gridcell,
   2014-Mar-28 Removed DIST_PRCP option.						TJB
   2014-Apr-25 Added non-climatological veg params.				TJB
   2014-Apr-25 Added partial vegcover fraction.					TJB
+  2026-Oct-18 Aerodynamic resistances are only computed for the types of
+	      potential evap that are written (options.PET_OUT).
+  2026-Oct-18 With options.CROPFRAC_COLLAPSE, the fallow sub-tile of a
+	      crop tile is not solved while the crop fraction is 1.
+  2026-Oct-18 Crop sub-tiles are blended by veg_con.crop_frac_idx
+	      rather than always sub-tiles 0 and 1; the harmonic means
+	      of rc and aero_resist leave out a fallow sub-tile without
+	      area.
+  2026-Oct-18 Options are read through OPT_* (see vicNl_def.h), so
+	      that specialized builds can fix them at compile time.
+  2026-Oct-18 Fixed the blending of the crop sub-tiles' thermal node
+	      states: all nodes are blended (the loop used the stale
+	      layer index), heat capacity goes to Cs_node, and the
+	      freezing/thawing front depths are blended over MAX_FRONTS.
 
 **********************************************************************/
 {
@@ -187,6 +201,7 @@ int  full_energy(int                  gridcell,
   double                 rainprec;
   int                    cidx;
   int                    cridx;
+  int                    fidx;
   double                 tmp_double;
   int                    index;
   int                    frost_area;
@@ -215,7 +230,7 @@ int  full_energy(int                  gridcell,
   snow    = all_vars->snow;
   veg_var = all_vars->veg_var;
 
-  Nbands = options.SNOW_BAND;
+  Nbands = OPT_SNOW_BAND;
 
   /* Set number of vegetation types */
   Nveg      = veg_con[0].vegetat_type_num;
@@ -238,7 +253,7 @@ int  full_energy(int                  gridcell,
   atmos->out_snow = 0;
 
   // Crop fraction
-  if (options.CROPFRAC) { //true or false set in global file, default=false
+  if (OPT_CROPFRAC) { //true or false set in global file, default=false
 
     if (rec >= 0) {
       for(iveg = 0; iveg < Nveg; iveg++){
@@ -258,6 +273,7 @@ int  full_energy(int                  gridcell,
  
 	if (veg_con[iveg].crop_frac_active) {
 	  veg_class = veg_con[iveg].veg_class;
+	  fidx = veg_con[iveg].crop_frac_idx;
 	  for ( band = 0; band < Nbands; band++ ) {
 	    if (rec == 0)
 	      old_crop_frac = veg_hist[rec][iveg].crop_frac[0];
@@ -269,16 +285,25 @@ int  full_energy(int                  gridcell,
 	    //fprintf(stderr,"full_energy berit rec %d init veg_class %d old_crop_frac %f new_crop_frac %f\n",rec,veg_class,old_crop_frac,new_crop_frac); 
 	    moistlayer=moisttotal1=moisttotal2=0.;
 	    if (new_crop_frac != old_crop_frac) {
+	      if (options.CROPFRAC_COLLAPSE && old_crop_frac == 1) {
+		// The fallow sub-tile has not been solved while it had no
+		// area; start it from the state of the crop sub-tile
+		tmp_double = all_vars_crop->snow[fidx][band].snow_canopy;
+		all_vars_crop->cell[fidx][band] = all_vars_crop->cell[fidx+1][band];
+		all_vars_crop->energy[fidx][band] = all_vars_crop->energy[fidx+1][band];
+		all_vars_crop->snow[fidx][band] = all_vars_crop->snow[fidx+1][band];
+		all_vars_crop->snow[fidx][band].snow_canopy = tmp_double;
+	      }
 	      // The portion that grows needs to assimilate state variables
 	      // from the portion that shrinks; canopy storages need to be rescaled
 	      if (new_crop_frac > old_crop_frac) { // crop fraction is growing
-		for(lidx=0;lidx<options.Nlayer;lidx++) {
-		  moistlayer=all_vars_crop->cell[0][band].layer[lidx].moist*(1-old_crop_frac)+all_vars_crop->cell[1][band].layer[lidx].moist*old_crop_frac;
+		for(lidx=0;lidx<OPT_Nlayer;lidx++) {
+		  moistlayer=all_vars_crop->cell[fidx][band].layer[lidx].moist*(1-old_crop_frac)+all_vars_crop->cell[fidx+1][band].layer[lidx].moist*old_crop_frac;
 		  moisttotal1+=moistlayer;
 		  //fprintf(stderr,"full_energy moist old fallow %f crop %f total1 %f incl noncrop %f\n",all_vars_crop->cell[0][band].layer[lidx].moist,all_vars_crop->cell[1][band].layer[lidx].moist,moisttotal1,moisttotal1*0.5+moistnoncrop*0.5);
-		  all_vars_crop->cell[1][band].layer[lidx].moist = (all_vars_crop->cell[1][band].layer[lidx].moist*old_crop_frac+all_vars_crop->cell[0][band].layer[lidx].moist*(new_crop_frac-old_crop_frac))/new_crop_frac;
-		  all_vars_crop->cell[0][band].layer[lidx].moist = all_vars_crop->cell[0][band].layer[lidx].moist;
-		  moistlayer=all_vars_crop->cell[0][band].layer[lidx].moist*(1-new_crop_frac)+all_vars_crop->cell[1][band].layer[lidx].moist*new_crop_frac;
+		  all_vars_crop->cell[fidx+1][band].layer[lidx].moist = (all_vars_crop->cell[fidx+1][band].layer[lidx].moist*old_crop_frac+all_vars_crop->cell[fidx][band].layer[lidx].moist*(new_crop_frac-old_crop_frac))/new_crop_frac;
+		  all_vars_crop->cell[fidx][band].layer[lidx].moist = all_vars_crop->cell[fidx][band].layer[lidx].moist;
+		  moistlayer=all_vars_crop->cell[fidx][band].layer[lidx].moist*(1-new_crop_frac)+all_vars_crop->cell[fidx+1][band].layer[lidx].moist*new_crop_frac;
 		  moisttotal2+=moistlayer;
 		  //fprintf(stderr,"full_energy moist new fallow %f crop %f total2 %f diff %f incl noncrop %f\n",all_vars_crop->cell[0][band].layer[lidx].moist,all_vars_crop->cell[1][band].layer[lidx].moist,moisttotal2,moisttotal2-moisttotal1,moisttotal1*0.5+moistnoncrop*0.5);
 		  //all_vars_crop->snow[1][band].swq=(all_vars_crop->snow[1][band].swq*old_crop_frac+all_vars_crop->snow[0][band].swq*(new_crop_frac-old_crop_frac))/new_crop_frac;
@@ -286,12 +311,12 @@ int  full_energy(int                  gridcell,
 		}
 	      }
 	      else { // fallow fraction is growing
-		for(lidx=0;lidx<options.Nlayer;lidx++) {
-		  all_vars_crop->cell[0][band].layer[lidx].moist = (all_vars_crop->cell[0][band].layer[lidx].moist*(1-old_crop_frac)+all_vars_crop->cell[1][band].layer[lidx].moist*(old_crop_frac-new_crop_frac))/(1-new_crop_frac);
+		for(lidx=0;lidx<OPT_Nlayer;lidx++) {
+		  all_vars_crop->cell[fidx][band].layer[lidx].moist = (all_vars_crop->cell[fidx][band].layer[lidx].moist*(1-old_crop_frac)+all_vars_crop->cell[fidx+1][band].layer[lidx].moist*(old_crop_frac-new_crop_frac))/(1-new_crop_frac);
 		}
 	      }
-	      all_vars_crop->veg_var[1][band].Wdew *= old_crop_frac/new_crop_frac;
-	      all_vars_crop->snow[1][band].snow_canopy *= old_crop_frac/new_crop_frac;
+	      all_vars_crop->veg_var[fidx+1][band].Wdew *= old_crop_frac/new_crop_frac;
+	      all_vars_crop->snow[fidx+1][band].snow_canopy *= old_crop_frac/new_crop_frac;
 	    }
 	    veg_var[iveg][band].crop_frac = new_crop_frac;
 	  }
@@ -315,7 +340,7 @@ int  full_energy(int                  gridcell,
  	//fprintf(stderr,"vegcover %f albedo %f lai %f\n",veg_var[iveg][band].vegcover,veg_var[iveg][band].albedo,veg_var[iveg][band].LAI);
        veg_var[iveg][band].Wdmax = veg_var[iveg][band].LAI*LAI_WATER_FACTOR;
         // Handle crop tiles (fallow and crop sub-tiles)
-        if (options.CROPFRAC && veg_con[iveg].crop_frac_active) {
+        if (OPT_CROPFRAC && veg_con[iveg].crop_frac_active) {
           for (cridx=veg_con[iveg].crop_frac_idx; cridx<veg_con[iveg].crop_frac_idx+2; cridx++) {
             if (cridx % 2 == 0) { //fallow part 
               all_vars_crop->veg_var[cridx][band].vegcover = MIN_VEGCOVER;
@@ -356,7 +381,7 @@ int  full_energy(int                  gridcell,
     Based on upper layer soil moisture.
   ******************************************/
   irrig = 0;
-  if (options.IRRIGATION) {
+  if (OPT_IRRIGATION) {
 
     if (rec >= 0) {
       for(iveg = 0; iveg < Nveg; iveg++){
@@ -378,7 +403,7 @@ int  full_energy(int                  gridcell,
 	  cell[iveg][band].irr_extract=0; //ingjerd added, for initializing. needed, or maybe not? 
 	  veg_class = veg_con[iveg].veg_class; //ingjerd added, m vel vre med?
 	  veg_var[iveg][band].irrig=0.; //ingjerd added for initialization. hm... not sure about this!
-	  if (options.CROPFRAC  && veg_con[iveg].crop_frac_active)
+	  if (OPT_CROPFRAC  && veg_con[iveg].crop_frac_active)
 	    all_vars_crop->veg_var[veg_con[iveg].crop_frac_idx+1][band].irrig=0.; //ingjerd added for initialization. hm... not sure about this!
 	  //fprintf(stderr,"rec %d sven iveg %d band %d estimating irrigation demand if needed, irrig %f vegvarirrig %f irractive %d\n",rec,iveg,band,irrig,veg_var[iveg][band].irrig,veg_lib[veg_class].irr_active[dmy[rec].month-1]);
 
@@ -389,7 +414,7 @@ int  full_energy(int                  gridcell,
 	      
               thresh_idx = 0;
               target_idx = 0;
-              if (options.CROPFRAC && veg_con[iveg].crop_frac_active) {
+              if (OPT_CROPFRAC && veg_con[iveg].crop_frac_active) {
 	        moistfract=all_vars_crop->cell[veg_con[iveg].crop_frac_idx+1][band].layer[target_idx].moist;  
 	      }
               else if (veg_con[iveg].crop_frac_active)
@@ -412,7 +437,7 @@ int  full_energy(int                  gridcell,
                if (irr_sm_target > soil_con->max_moist[target_idx])
                 irr_sm_target = soil_con->max_moist[target_idx];
 	       //fprintf(stderr,"full_energy B thresh_idx %d target_idx %d thresh %f target %f\n",thresh_idx,target_idx,irr_sm_thresh,irr_sm_target);
-              if (options.CROPFRAC && veg_con[iveg].crop_frac_active) {
+              if (OPT_CROPFRAC && veg_con[iveg].crop_frac_active) {
                 if (moistfract < irr_sm_thresh)
                   all_vars_crop->veg_var[veg_con[iveg].crop_frac_idx+1][band].irr_apply = TRUE;
                 else if (moistfract >= irr_sm_target)
@@ -426,7 +451,7 @@ int  full_energy(int                  gridcell,
                   veg_var[iveg][band].irr_apply = FALSE;
              }
 	      
-              if(options.CROPFRAC && veg_con[iveg].crop_frac_active) { 
+              if(OPT_CROPFRAC && veg_con[iveg].crop_frac_active) { 
                 irrig_est = (soil_con->max_moist[0]-all_vars_crop->cell[veg_con[iveg].crop_frac_idx+1][band].layer[target_idx].moist);
                 if (all_vars_crop->veg_var[veg_con[iveg].crop_frac_idx+1][band].irr_apply && atmos->prec[NR]<irrig_est)
                   all_vars_crop->veg_var[veg_con[iveg].crop_frac_idx+1][band].irrig = irrig_est-atmos->prec[NR];
@@ -488,13 +513,24 @@ int  full_energy(int                  gridcell,
        }*/
   
 
-      if(options.CROPFRAC && veg_con[iveg].crop_frac_active) { 
+      if(OPT_CROPFRAC && veg_con[iveg].crop_frac_active) { 
 
+      fidx = veg_con[iveg].crop_frac_idx;
  
       for (cridx=veg_con[iveg].crop_frac_idx; cridx<veg_con[iveg].crop_frac_idx+2; cridx++) {
 
       Cv = veg_con[iveg].Cv;
-      Nbands = options.SNOW_BAND;
+      Nbands = OPT_SNOW_BAND;
+
+      /** Skip the fallow sub-tile if it has no area in any band; its
+          weight in the tile averages below is then zero **/
+      if (options.CROPFRAC_COLLAPSE && cridx == fidx) {
+        for (band = 0; band < Nbands; band++)
+          if (soil_con->AreaFract[band] > 0 && veg_var[iveg][band].crop_frac < 1)
+            break;
+        if (band == Nbands)
+          continue;
+      }
 
       /** Lake-specific processing **/
       if (veg_con[iveg].LAKE) {
@@ -574,7 +610,7 @@ int  full_energy(int                  gridcell,
                    * exp(-veg_lib[veg_class].rad_atten * all_vars_crop->veg_var[cridx][0].LAI);
 
       /* Initialize soil thermal properties for the top two layers */
-      prepare_full_energy(cridx, Nveg, options.Nnode, all_vars_crop, soil_con, moist0, ice0);
+      prepare_full_energy(cridx, Nveg, OPT_Nnode, all_vars_crop, soil_con, moist0, ice0);
 
       /** Compute Bare (free of snow) Albedo **/
       bare_albedo = all_vars_crop->veg_var[cridx][0].albedo;
@@ -589,6 +625,9 @@ int  full_energy(int                  gridcell,
       /* Current veg will be last */
       for (p=0; p<N_PET_TYPES+1; p++) {
 
+        /* Skip types of potential evap that are not written */
+        if (p < N_PET_TYPES && !options.PET_OUT[p]) continue;
+
         /* Initialize wind speeds */
         tmp_wind[0] = atmos->wind[NR];
         tmp_wind[1] = -999.;
@@ -647,7 +686,7 @@ int  full_energy(int                  gridcell,
       /******************************
         Compute nitrogen scaling factors and initialize other veg vars
       ******************************/
-      if (options.CARBON && iveg < Nveg) {
+      if (OPT_CARBON && iveg < Nveg) {
 	for(band=0; band<Nbands; band++) {
           for (cidx=0; cidx<options.Ncanopy; cidx++) {
             all_vars_crop->veg_var[cridx][band].rsLayer[cidx] = HUGE_RESIST;
@@ -686,7 +725,7 @@ int  full_energy(int                  gridcell,
 	    all_vars_crop->cell[cridx][band].pot_evap[p] = 0;
 
           // Limit irrigation to available water
-          if(options.IRRIGATION && veg_lib[veg_class].irr_active[dmy[rec].month-1] && (!options.CROPFRAC || cridx % 2 == 1) && !options.IRR_FREE && atmos->air_temp[NR]>7) { 
+          if(OPT_IRRIGATION && veg_lib[veg_class].irr_active[dmy[rec].month-1] && (!OPT_CROPFRAC || cridx % 2 == 1) && !options.IRR_FREE && atmos->air_temp[NR]>7) { 
 
 	    //fprintf(stderr,"full_energy C2 crop_active rec %d iveg %d cridx %d irrig %f allvarscropirrig %f moist %f\n",rec,iveg,cridx,irrig,all_vars_crop->veg_var[cridx][band].irrig,all_vars_crop->cell[1][band].layer[0].moist); //still cell average
 	    all_vars_crop->veg_var[cridx][band].irrig = 0.; //initialize
@@ -753,7 +792,7 @@ int  full_energy(int                  gridcell,
 				     ref_height, roughness, 
 				     &snow_inflow[band], 
 				     tmp_wind, veg_con[iveg].root, Nbands, 
-				     options.Nlayer, Nveg, band, dp, iveg, rec, veg_class, 
+				     OPT_Nlayer, Nveg, band, dp, iveg, rec, veg_class, 
 				     atmos, dmy, &(all_vars_crop->energy[cridx][band]), gp, 
 				     &(all_vars_crop->cell[cridx][band]),
 				     &(all_vars_crop->snow[cridx][band]), 
@@ -774,13 +813,13 @@ int  full_energy(int                  gridcell,
           ********************************************************/
           all_vars_crop->cell[cridx][band].rootmoist = 0;
           all_vars_crop->cell[cridx][band].wetness = 0;
-          for(lidx=0;lidx<options.Nlayer;lidx++) {
+          for(lidx=0;lidx<OPT_Nlayer;lidx++) {
             if (veg_con->root[lidx] > 0) {
               all_vars_crop->cell[cridx][band].rootmoist += all_vars_crop->cell[cridx][band].layer[lidx].moist;
             }
 	    all_vars_crop->cell[cridx][band].wetness += (all_vars_crop->cell[cridx][band].layer[lidx].moist - soil_con->Wpwp[lidx])/(soil_con->porosity[lidx]*soil_con->depth[lidx]*1000 - soil_con->Wpwp[lidx]);
           }
-          all_vars_crop->cell[cridx][band].wetness /= options.Nlayer;
+          all_vars_crop->cell[cridx][band].wetness /= OPT_Nlayer;
 
 	} /** End non-zero area band **/
 
@@ -801,204 +840,212 @@ int  full_energy(int                  gridcell,
 	  //fprintf(stderr,"full_energy rec %d da begynner vi med backtracking iveg %d fract %f crop_frac %f irrig %f irrig_wish %f\n",rec,iveg,soil_con->AreaFract[band],veg_var[iveg][band].crop_frac,all_vars_crop->veg_var[0][band].irrig,irrig);	  
 
 	  //ingjerd added the below sentence, for wb tracking with irrigation and crop_frac included . more is needed?*/
-	  veg_var[iveg][band].irrig=all_vars_crop->veg_var[1][band].irrig*veg_var[iveg][band].crop_frac;
+	  veg_var[iveg][band].irrig=all_vars_crop->veg_var[fidx+1][band].irrig*veg_var[iveg][band].crop_frac;
 
 	  //fprintf(stderr,"full_energy E ingjerd rec %d iveg %d veg_var.irrig %f allvars.irrig %f\n",rec,iveg,veg_var[iveg][band].irrig,all_vars_crop->veg_var[0][band].irrig);
 	  //fprintf(stderr,"full_energy F ingjerd moist0 %f \n",all_vars_crop->cell[1][band].layer[0].moist);
 
 	  // Copy veg_var state data
-	  veg_var[iveg][band].Wdew = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->veg_var[0][band].Wdew + veg_var[iveg][band].crop_frac*all_vars_crop->veg_var[1][band].Wdew;
-	  if (options.CARBON) {
+	  veg_var[iveg][band].Wdew = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->veg_var[fidx][band].Wdew + veg_var[iveg][band].crop_frac*all_vars_crop->veg_var[fidx+1][band].Wdew;
+	  if (OPT_CARBON) {
 	    for (cidx=0; cidx<options.Ncanopy; cidx++) {
-	      veg_var[iveg][band].NscaleFactor[cidx] = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->veg_var[0][band].NscaleFactor[cidx] + veg_var[iveg][band].crop_frac*all_vars_crop->veg_var[1][band].NscaleFactor[cidx];
-	      veg_var[iveg][band].aPARLayer[cidx] = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->veg_var[0][band].aPARLayer[cidx] + veg_var[iveg][band].crop_frac*all_vars_crop->veg_var[1][band].aPARLayer[cidx];
-	      veg_var[iveg][band].CiLayer[cidx] = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->veg_var[0][band].CiLayer[cidx] + veg_var[iveg][band].crop_frac*all_vars_crop->veg_var[1][band].CiLayer[cidx];
-	      veg_var[iveg][band].rsLayer[cidx] = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->veg_var[0][band].rsLayer[cidx] + veg_var[iveg][band].crop_frac*all_vars_crop->veg_var[1][band].rsLayer[cidx];
+	      veg_var[iveg][band].NscaleFactor[cidx] = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->veg_var[fidx][band].NscaleFactor[cidx] + veg_var[iveg][band].crop_frac*all_vars_crop->veg_var[fidx+1][band].NscaleFactor[cidx];
+	      veg_var[iveg][band].aPARLayer[cidx] = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->veg_var[fidx][band].aPARLayer[cidx] + veg_var[iveg][band].crop_frac*all_vars_crop->veg_var[fidx+1][band].aPARLayer[cidx];
+	      veg_var[iveg][band].CiLayer[cidx] = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->veg_var[fidx][band].CiLayer[cidx] + veg_var[iveg][band].crop_frac*all_vars_crop->veg_var[fidx+1][band].CiLayer[cidx];
+	      veg_var[iveg][band].rsLayer[cidx] = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->veg_var[fidx][band].rsLayer[cidx] + veg_var[iveg][band].crop_frac*all_vars_crop->veg_var[fidx+1][band].rsLayer[cidx];
 	    }
 	  }
-	  veg_var[iveg][band].Ci = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->veg_var[0][band].Ci + veg_var[iveg][band].crop_frac*all_vars_crop->veg_var[1][band].Ci;
-	  tmp_double = (1-veg_var[iveg][band].crop_frac)/all_vars_crop->veg_var[0][band].rc + veg_var[iveg][band].crop_frac/all_vars_crop->veg_var[1][band].rc;
+	  veg_var[iveg][band].Ci = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->veg_var[fidx][band].Ci + veg_var[iveg][band].crop_frac*all_vars_crop->veg_var[fidx+1][band].Ci;
+	  // The fallow sub-tile is left out while it has no area; it may
+	  // not have been solved (CROPFRAC_COLLAPSE)
+	  tmp_double = veg_var[iveg][band].crop_frac/all_vars_crop->veg_var[fidx+1][band].rc;
+	  if (veg_var[iveg][band].crop_frac < 1)
+	    tmp_double += (1-veg_var[iveg][band].crop_frac)/all_vars_crop->veg_var[fidx][band].rc;
 	  veg_var[iveg][band].rc = 1/tmp_double;
-	  veg_var[iveg][band].NPPfactor = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->veg_var[0][band].NPPfactor + veg_var[iveg][band].crop_frac*all_vars_crop->veg_var[1][band].NPPfactor;
-	  veg_var[iveg][band].AnnualNPP = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->veg_var[0][band].AnnualNPP + veg_var[iveg][band].crop_frac*all_vars_crop->veg_var[1][band].AnnualNPP;
-	  veg_var[iveg][band].AnnualNPPPrev = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->veg_var[0][band].AnnualNPPPrev + veg_var[iveg][band].crop_frac*all_vars_crop->veg_var[1][band].AnnualNPPPrev;
+	  veg_var[iveg][band].NPPfactor = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->veg_var[fidx][band].NPPfactor + veg_var[iveg][band].crop_frac*all_vars_crop->veg_var[fidx+1][band].NPPfactor;
+	  veg_var[iveg][band].AnnualNPP = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->veg_var[fidx][band].AnnualNPP + veg_var[iveg][band].crop_frac*all_vars_crop->veg_var[fidx+1][band].AnnualNPP;
+	  veg_var[iveg][band].AnnualNPPPrev = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->veg_var[fidx][band].AnnualNPPPrev + veg_var[iveg][band].crop_frac*all_vars_crop->veg_var[fidx+1][band].AnnualNPPPrev;
 	  
 	  // Copy veg_var flux data
-	  veg_var[iveg][band].canopyevap = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->veg_var[0][band].canopyevap + veg_var[iveg][band].crop_frac*all_vars_crop->veg_var[1][band].canopyevap;
-	  veg_var[iveg][band].throughfall = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->veg_var[0][band].throughfall + veg_var[iveg][band].crop_frac*all_vars_crop->veg_var[1][band].throughfall;
-	  veg_var[iveg][band].aPAR = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->veg_var[0][band].aPAR + veg_var[iveg][band].crop_frac*all_vars_crop->veg_var[1][band].aPAR;
-	  veg_var[iveg][band].GPP = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->veg_var[0][band].GPP + veg_var[iveg][band].crop_frac*all_vars_crop->veg_var[1][band].GPP;
-	  veg_var[iveg][band].Rphoto = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->veg_var[0][band].Rphoto + veg_var[iveg][band].crop_frac*all_vars_crop->veg_var[1][band].Rphoto;
-	  veg_var[iveg][band].Rdark = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->veg_var[0][band].Rdark + veg_var[iveg][band].crop_frac*all_vars_crop->veg_var[1][band].Rdark;
-	  veg_var[iveg][band].Rmaint = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->veg_var[0][band].Rmaint + veg_var[iveg][band].crop_frac*all_vars_crop->veg_var[1][band].Rmaint;
-	  veg_var[iveg][band].Rgrowth = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->veg_var[0][band].Rgrowth + veg_var[iveg][band].crop_frac*all_vars_crop->veg_var[1][band].Rgrowth;
-	  veg_var[iveg][band].Raut = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->veg_var[0][band].Raut + veg_var[iveg][band].crop_frac*all_vars_crop->veg_var[1][band].Raut;
-	  veg_var[iveg][band].NPP = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->veg_var[0][band].NPP + veg_var[iveg][band].crop_frac*all_vars_crop->veg_var[1][band].NPP;
-	  veg_var[iveg][band].Litterfall = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->veg_var[0][band].Litterfall + veg_var[iveg][band].crop_frac*all_vars_crop->veg_var[1][band].Litterfall;
+	  veg_var[iveg][band].canopyevap = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->veg_var[fidx][band].canopyevap + veg_var[iveg][band].crop_frac*all_vars_crop->veg_var[fidx+1][band].canopyevap;
+	  veg_var[iveg][band].throughfall = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->veg_var[fidx][band].throughfall + veg_var[iveg][band].crop_frac*all_vars_crop->veg_var[fidx+1][band].throughfall;
+	  veg_var[iveg][band].aPAR = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->veg_var[fidx][band].aPAR + veg_var[iveg][band].crop_frac*all_vars_crop->veg_var[fidx+1][band].aPAR;
+	  veg_var[iveg][band].GPP = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->veg_var[fidx][band].GPP + veg_var[iveg][band].crop_frac*all_vars_crop->veg_var[fidx+1][band].GPP;
+	  veg_var[iveg][band].Rphoto = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->veg_var[fidx][band].Rphoto + veg_var[iveg][band].crop_frac*all_vars_crop->veg_var[fidx+1][band].Rphoto;
+	  veg_var[iveg][band].Rdark = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->veg_var[fidx][band].Rdark + veg_var[iveg][band].crop_frac*all_vars_crop->veg_var[fidx+1][band].Rdark;
+	  veg_var[iveg][band].Rmaint = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->veg_var[fidx][band].Rmaint + veg_var[iveg][band].crop_frac*all_vars_crop->veg_var[fidx+1][band].Rmaint;
+	  veg_var[iveg][band].Rgrowth = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->veg_var[fidx][band].Rgrowth + veg_var[iveg][band].crop_frac*all_vars_crop->veg_var[fidx+1][band].Rgrowth;
+	  veg_var[iveg][band].Raut = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->veg_var[fidx][band].Raut + veg_var[iveg][band].crop_frac*all_vars_crop->veg_var[fidx+1][band].Raut;
+	  veg_var[iveg][band].NPP = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->veg_var[fidx][band].NPP + veg_var[iveg][band].crop_frac*all_vars_crop->veg_var[fidx+1][band].NPP;
+	  veg_var[iveg][band].Litterfall = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->veg_var[fidx][band].Litterfall + veg_var[iveg][band].crop_frac*all_vars_crop->veg_var[fidx+1][band].Litterfall;
 
 	  // Copy cell state data
 	  for (cidx=0; cidx<2; cidx++) {
-	    tmp_double = (1-veg_var[iveg][band].crop_frac)/all_vars_crop->cell[0][band].aero_resist[cidx] + veg_var[iveg][band].crop_frac/all_vars_crop->cell[1][band].aero_resist[cidx];
+	    tmp_double = veg_var[iveg][band].crop_frac/all_vars_crop->cell[fidx+1][band].aero_resist[cidx];
+	    if (veg_var[iveg][band].crop_frac < 1)
+	      tmp_double += (1-veg_var[iveg][band].crop_frac)/all_vars_crop->cell[fidx][band].aero_resist[cidx];
 	    cell[iveg][band].aero_resist[cidx] = 1/tmp_double;
 	  }
 
-	  cell[iveg][band].asat = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->cell[0][band].asat + veg_var[iveg][band].crop_frac*all_vars_crop->cell[1][band].asat;
-	  cell[iveg][band].CLitter = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->cell[0][band].CLitter + veg_var[iveg][band].crop_frac*all_vars_crop->cell[1][band].CLitter;
-	  cell[iveg][band].CInter = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->cell[0][band].CInter + veg_var[iveg][band].crop_frac*all_vars_crop->cell[1][band].CInter;
-	  cell[iveg][band].CSlow = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->cell[0][band].CSlow + veg_var[iveg][band].crop_frac*all_vars_crop->cell[1][band].CSlow;
+	  cell[iveg][band].asat = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->cell[fidx][band].asat + veg_var[iveg][band].crop_frac*all_vars_crop->cell[fidx+1][band].asat;
+	  cell[iveg][band].CLitter = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->cell[fidx][band].CLitter + veg_var[iveg][band].crop_frac*all_vars_crop->cell[fidx+1][band].CLitter;
+	  cell[iveg][band].CInter = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->cell[fidx][band].CInter + veg_var[iveg][band].crop_frac*all_vars_crop->cell[fidx+1][band].CInter;
+	  cell[iveg][band].CSlow = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->cell[fidx][band].CSlow + veg_var[iveg][band].crop_frac*all_vars_crop->cell[fidx+1][band].CSlow;
 
-	  for ( lidx = 0; lidx < options.Nlayer; lidx++ ) {
-	    cell[iveg][band].layer[lidx].bare_evap_frac = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->cell[0][band].layer[lidx].bare_evap_frac + veg_var[iveg][band].crop_frac*all_vars_crop->cell[1][band].layer[lidx].bare_evap_frac;
+	  for ( lidx = 0; lidx < OPT_Nlayer; lidx++ ) {
+	    cell[iveg][band].layer[lidx].bare_evap_frac = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->cell[fidx][band].layer[lidx].bare_evap_frac + veg_var[iveg][band].crop_frac*all_vars_crop->cell[fidx+1][band].layer[lidx].bare_evap_frac;
 
-	    cell[iveg][band].layer[lidx].Cs = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->cell[0][band].layer[lidx].Cs + veg_var[iveg][band].crop_frac*all_vars_crop->cell[1][band].layer[lidx].Cs;
+	    cell[iveg][band].layer[lidx].Cs = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->cell[fidx][band].layer[lidx].Cs + veg_var[iveg][band].crop_frac*all_vars_crop->cell[fidx+1][band].layer[lidx].Cs;
 
-	    cell[iveg][band].layer[lidx].kappa = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->cell[0][band].layer[lidx].kappa + veg_var[iveg][band].crop_frac*all_vars_crop->cell[1][band].layer[lidx].kappa;
+	    cell[iveg][band].layer[lidx].kappa = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->cell[fidx][band].layer[lidx].kappa + veg_var[iveg][band].crop_frac*all_vars_crop->cell[fidx+1][band].layer[lidx].kappa;
 
 	    for ( frost_area = 0; frost_area < options.Nfrost; frost_area++ )
-	      cell[iveg][band].layer[lidx].ice[frost_area] = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->cell[0][band].layer[lidx].ice[frost_area] + veg_var[iveg][band].crop_frac*all_vars_crop->cell[1][band].layer[lidx].ice[frost_area];
+	      cell[iveg][band].layer[lidx].ice[frost_area] = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->cell[fidx][band].layer[lidx].ice[frost_area] + veg_var[iveg][band].crop_frac*all_vars_crop->cell[fidx+1][band].layer[lidx].ice[frost_area];
 
 	    //fprintf(stderr,"\nfull_energy rec %d debugging... lidx %d irrig_wish %f moist %f\n",rec,lidx,irrig,cell[3][0].layer[0].moist);
 	    //fprintf(stderr,"\nfull_energy rec %d debugging... lidx %d allvarmoist1 %f 2 %f\n",rec,lidx,all_vars_crop->cell[0][band].layer[lidx].moist,all_vars_crop->cell[1][band].layer[lidx].moist);
 
-	    cell[iveg][band].layer[lidx].moist = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->cell[0][band].layer[lidx].moist + veg_var[iveg][band].crop_frac*all_vars_crop->cell[1][band].layer[lidx].moist;
+	    cell[iveg][band].layer[lidx].moist = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->cell[fidx][band].layer[lidx].moist + veg_var[iveg][band].crop_frac*all_vars_crop->cell[fidx+1][band].layer[lidx].moist;
 
 	    //fprintf(stderr,"\nfull_energy rec %d debugging... irrig_wish %f moist %f\n",rec,irrig,cell[3][0].layer[0].moist);
 
-	    cell[iveg][band].layer[lidx].phi = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->cell[0][band].layer[lidx].phi + veg_var[iveg][band].crop_frac*all_vars_crop->cell[1][band].layer[lidx].phi;
+	    cell[iveg][band].layer[lidx].phi = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->cell[fidx][band].layer[lidx].phi + veg_var[iveg][band].crop_frac*all_vars_crop->cell[fidx+1][band].layer[lidx].phi;
 
-	    cell[iveg][band].layer[lidx].zwt = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->cell[0][band].layer[lidx].zwt + veg_var[iveg][band].crop_frac*all_vars_crop->cell[1][band].layer[lidx].zwt;
+	    cell[iveg][band].layer[lidx].zwt = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->cell[fidx][band].layer[lidx].zwt + veg_var[iveg][band].crop_frac*all_vars_crop->cell[fidx+1][band].layer[lidx].zwt;
 
-	    cell[iveg][band].layer[lidx].T = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->cell[0][band].layer[lidx].T + veg_var[iveg][band].crop_frac*all_vars_crop->cell[1][band].layer[lidx].T;
+	    cell[iveg][band].layer[lidx].T = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->cell[fidx][band].layer[lidx].T + veg_var[iveg][band].crop_frac*all_vars_crop->cell[fidx+1][band].layer[lidx].T;
 	  }
    
 	  // Copy cell flux data
-	  cell[iveg][band].baseflow = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->cell[0][band].baseflow + veg_var[iveg][band].crop_frac*all_vars_crop->cell[1][band].baseflow;
-	  for ( lidx = 0; lidx < options.Nlayer; lidx++ ) {
-	    cell[iveg][band].layer[lidx].evap = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->cell[0][band].layer[lidx].evap + veg_var[iveg][band].crop_frac*all_vars_crop->cell[1][band].layer[lidx].evap;
+	  cell[iveg][band].baseflow = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->cell[fidx][band].baseflow + veg_var[iveg][band].crop_frac*all_vars_crop->cell[fidx+1][band].baseflow;
+	  for ( lidx = 0; lidx < OPT_Nlayer; lidx++ ) {
+	    cell[iveg][band].layer[lidx].evap = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->cell[fidx][band].layer[lidx].evap + veg_var[iveg][band].crop_frac*all_vars_crop->cell[fidx+1][band].layer[lidx].evap;
 	  }
-	  cell[iveg][band].inflow = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->cell[0][band].inflow + veg_var[iveg][band].crop_frac*all_vars_crop->cell[1][band].inflow;
+	  cell[iveg][band].inflow = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->cell[fidx][band].inflow + veg_var[iveg][band].crop_frac*all_vars_crop->cell[fidx+1][band].inflow;
 	  for ( cidx = 0; cidx < N_PET_TYPES; cidx++ ) {
-	    cell[iveg][band].pot_evap[cidx] = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->cell[0][band].pot_evap[cidx] + veg_var[iveg][band].crop_frac*all_vars_crop->cell[1][band].pot_evap[cidx];
+	    cell[iveg][band].pot_evap[cidx] = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->cell[fidx][band].pot_evap[cidx] + veg_var[iveg][band].crop_frac*all_vars_crop->cell[fidx+1][band].pot_evap[cidx];
 	  }
-	  cell[iveg][band].runoff = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->cell[0][band].runoff + veg_var[iveg][band].crop_frac*all_vars_crop->cell[1][band].runoff;
-	  cell[iveg][band].RhLitter = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->cell[0][band].RhLitter + veg_var[iveg][band].crop_frac*all_vars_crop->cell[1][band].RhLitter;
-	  cell[iveg][band].RhLitter2Atm = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->cell[0][band].RhLitter2Atm + veg_var[iveg][band].crop_frac*all_vars_crop->cell[1][band].RhLitter2Atm;
-	  cell[iveg][band].RhInter = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->cell[0][band].RhInter + veg_var[iveg][band].crop_frac*all_vars_crop->cell[1][band].RhInter;
-	  cell[iveg][band].RhSlow = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->cell[0][band].RhSlow + veg_var[iveg][band].crop_frac*all_vars_crop->cell[1][band].RhSlow;
-	  cell[iveg][band].RhTot = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->cell[0][band].RhTot + veg_var[iveg][band].crop_frac*all_vars_crop->cell[1][band].RhTot;
-	  cell[iveg][band].rootmoist = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->cell[0][band].rootmoist + veg_var[iveg][band].crop_frac*all_vars_crop->cell[1][band].rootmoist;
-	  cell[iveg][band].wetness = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->cell[0][band].wetness + veg_var[iveg][band].crop_frac*all_vars_crop->cell[1][band].wetness;
-	  cell[iveg][band].zwt = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->cell[0][band].zwt + veg_var[iveg][band].crop_frac*all_vars_crop->cell[1][band].zwt;
-	  cell[iveg][band].zwt_lumped = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->cell[0][band].zwt_lumped + veg_var[iveg][band].crop_frac*all_vars_crop->cell[1][band].zwt_lumped;
+	  cell[iveg][band].runoff = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->cell[fidx][band].runoff + veg_var[iveg][band].crop_frac*all_vars_crop->cell[fidx+1][band].runoff;
+	  cell[iveg][band].RhLitter = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->cell[fidx][band].RhLitter + veg_var[iveg][band].crop_frac*all_vars_crop->cell[fidx+1][band].RhLitter;
+	  cell[iveg][band].RhLitter2Atm = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->cell[fidx][band].RhLitter2Atm + veg_var[iveg][band].crop_frac*all_vars_crop->cell[fidx+1][band].RhLitter2Atm;
+	  cell[iveg][band].RhInter = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->cell[fidx][band].RhInter + veg_var[iveg][band].crop_frac*all_vars_crop->cell[fidx+1][band].RhInter;
+	  cell[iveg][band].RhSlow = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->cell[fidx][band].RhSlow + veg_var[iveg][band].crop_frac*all_vars_crop->cell[fidx+1][band].RhSlow;
+	  cell[iveg][band].RhTot = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->cell[fidx][band].RhTot + veg_var[iveg][band].crop_frac*all_vars_crop->cell[fidx+1][band].RhTot;
+	  cell[iveg][band].rootmoist = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->cell[fidx][band].rootmoist + veg_var[iveg][band].crop_frac*all_vars_crop->cell[fidx+1][band].rootmoist;
+	  cell[iveg][band].wetness = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->cell[fidx][band].wetness + veg_var[iveg][band].crop_frac*all_vars_crop->cell[fidx+1][band].wetness;
+	  cell[iveg][band].zwt = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->cell[fidx][band].zwt + veg_var[iveg][band].crop_frac*all_vars_crop->cell[fidx+1][band].zwt;
+	  cell[iveg][band].zwt_lumped = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->cell[fidx][band].zwt_lumped + veg_var[iveg][band].crop_frac*all_vars_crop->cell[fidx+1][band].zwt_lumped;
 	  
 	  // Copy snow state data
-	  snow[iveg][band].albedo = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->snow[0][band].albedo + veg_var[iveg][band].crop_frac*all_vars_crop->snow[1][band].albedo;
-	  snow[iveg][band].canopy_albedo = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->snow[0][band].canopy_albedo + veg_var[iveg][band].crop_frac*all_vars_crop->snow[1][band].canopy_albedo;
-	  snow[iveg][band].coldcontent = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->snow[0][band].coldcontent + veg_var[iveg][band].crop_frac*all_vars_crop->snow[1][band].coldcontent;
-	  snow[iveg][band].coverage = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->snow[0][band].coverage + veg_var[iveg][band].crop_frac*all_vars_crop->snow[1][band].coverage;
-	  snow[iveg][band].density = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->snow[0][band].density + veg_var[iveg][band].crop_frac*all_vars_crop->snow[1][band].density;
-	  snow[iveg][band].depth = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->snow[0][band].depth + veg_var[iveg][band].crop_frac*all_vars_crop->snow[1][band].depth;
-	  snow[iveg][band].last_snow = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->snow[0][band].last_snow + veg_var[iveg][band].crop_frac*all_vars_crop->snow[1][band].last_snow;
-	  snow[iveg][band].max_snow_depth = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->snow[0][band].max_snow_depth + veg_var[iveg][band].crop_frac*all_vars_crop->snow[1][band].max_snow_depth;
-	  snow[iveg][band].MELTING = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->snow[0][band].MELTING + veg_var[iveg][band].crop_frac*all_vars_crop->snow[1][band].MELTING;
-	  snow[iveg][band].pack_temp = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->snow[0][band].pack_temp + veg_var[iveg][band].crop_frac*all_vars_crop->snow[1][band].pack_temp;
-	  snow[iveg][band].pack_water = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->snow[0][band].pack_water + veg_var[iveg][band].crop_frac*all_vars_crop->snow[1][band].pack_water;
-	  snow[iveg][band].snow = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->snow[0][band].snow + veg_var[iveg][band].crop_frac*all_vars_crop->snow[1][band].snow;
-	  snow[iveg][band].snow_canopy = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->snow[0][band].snow_canopy + veg_var[iveg][band].crop_frac*all_vars_crop->snow[1][band].snow_canopy;
-	  snow[iveg][band].store_coverage = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->snow[0][band].store_coverage + veg_var[iveg][band].crop_frac*all_vars_crop->snow[1][band].store_coverage;
-	  snow[iveg][band].store_snow = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->snow[0][band].store_snow + veg_var[iveg][band].crop_frac*all_vars_crop->snow[1][band].store_snow;
-	  snow[iveg][band].store_swq = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->snow[0][band].store_swq + veg_var[iveg][band].crop_frac*all_vars_crop->snow[1][band].store_swq;
-	  snow[iveg][band].surf_temp = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->snow[0][band].surf_temp + veg_var[iveg][band].crop_frac*all_vars_crop->snow[1][band].surf_temp;
-	  snow[iveg][band].surf_temp_fbcount = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->snow[0][band].surf_temp_fbcount + veg_var[iveg][band].crop_frac*all_vars_crop->snow[1][band].surf_temp_fbcount;
-	  snow[iveg][band].surf_temp_fbflag = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->snow[0][band].surf_temp_fbflag + veg_var[iveg][band].crop_frac*all_vars_crop->snow[1][band].surf_temp_fbflag;
-	  snow[iveg][band].surf_water = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->snow[0][band].surf_water + veg_var[iveg][band].crop_frac*all_vars_crop->snow[1][band].surf_water;
-	  snow[iveg][band].swq = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->snow[0][band].swq + veg_var[iveg][band].crop_frac*all_vars_crop->snow[1][band].swq;
-	  snow[iveg][band].snow_distrib_slope = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->snow[0][band].snow_distrib_slope + veg_var[iveg][band].crop_frac*all_vars_crop->snow[1][band].snow_distrib_slope;
-	  snow[iveg][band].tmp_int_storage = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->snow[0][band].tmp_int_storage + veg_var[iveg][band].crop_frac*all_vars_crop->snow[1][band].tmp_int_storage;
+	  snow[iveg][band].albedo = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->snow[fidx][band].albedo + veg_var[iveg][band].crop_frac*all_vars_crop->snow[fidx+1][band].albedo;
+	  snow[iveg][band].canopy_albedo = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->snow[fidx][band].canopy_albedo + veg_var[iveg][band].crop_frac*all_vars_crop->snow[fidx+1][band].canopy_albedo;
+	  snow[iveg][band].coldcontent = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->snow[fidx][band].coldcontent + veg_var[iveg][band].crop_frac*all_vars_crop->snow[fidx+1][band].coldcontent;
+	  snow[iveg][band].coverage = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->snow[fidx][band].coverage + veg_var[iveg][band].crop_frac*all_vars_crop->snow[fidx+1][band].coverage;
+	  snow[iveg][band].density = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->snow[fidx][band].density + veg_var[iveg][band].crop_frac*all_vars_crop->snow[fidx+1][band].density;
+	  snow[iveg][band].depth = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->snow[fidx][band].depth + veg_var[iveg][band].crop_frac*all_vars_crop->snow[fidx+1][band].depth;
+	  snow[iveg][band].last_snow = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->snow[fidx][band].last_snow + veg_var[iveg][band].crop_frac*all_vars_crop->snow[fidx+1][band].last_snow;
+	  snow[iveg][band].max_snow_depth = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->snow[fidx][band].max_snow_depth + veg_var[iveg][band].crop_frac*all_vars_crop->snow[fidx+1][band].max_snow_depth;
+	  snow[iveg][band].MELTING = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->snow[fidx][band].MELTING + veg_var[iveg][band].crop_frac*all_vars_crop->snow[fidx+1][band].MELTING;
+	  snow[iveg][band].pack_temp = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->snow[fidx][band].pack_temp + veg_var[iveg][band].crop_frac*all_vars_crop->snow[fidx+1][band].pack_temp;
+	  snow[iveg][band].pack_water = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->snow[fidx][band].pack_water + veg_var[iveg][band].crop_frac*all_vars_crop->snow[fidx+1][band].pack_water;
+	  snow[iveg][band].snow = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->snow[fidx][band].snow + veg_var[iveg][band].crop_frac*all_vars_crop->snow[fidx+1][band].snow;
+	  snow[iveg][band].snow_canopy = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->snow[fidx][band].snow_canopy + veg_var[iveg][band].crop_frac*all_vars_crop->snow[fidx+1][band].snow_canopy;
+	  snow[iveg][band].store_coverage = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->snow[fidx][band].store_coverage + veg_var[iveg][band].crop_frac*all_vars_crop->snow[fidx+1][band].store_coverage;
+	  snow[iveg][band].store_snow = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->snow[fidx][band].store_snow + veg_var[iveg][band].crop_frac*all_vars_crop->snow[fidx+1][band].store_snow;
+	  snow[iveg][band].store_swq = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->snow[fidx][band].store_swq + veg_var[iveg][band].crop_frac*all_vars_crop->snow[fidx+1][band].store_swq;
+	  snow[iveg][band].surf_temp = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->snow[fidx][band].surf_temp + veg_var[iveg][band].crop_frac*all_vars_crop->snow[fidx+1][band].surf_temp;
+	  snow[iveg][band].surf_temp_fbcount = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->snow[fidx][band].surf_temp_fbcount + veg_var[iveg][band].crop_frac*all_vars_crop->snow[fidx+1][band].surf_temp_fbcount;
+	  snow[iveg][band].surf_temp_fbflag = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->snow[fidx][band].surf_temp_fbflag + veg_var[iveg][band].crop_frac*all_vars_crop->snow[fidx+1][band].surf_temp_fbflag;
+	  snow[iveg][band].surf_water = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->snow[fidx][band].surf_water + veg_var[iveg][band].crop_frac*all_vars_crop->snow[fidx+1][band].surf_water;
+	  snow[iveg][band].swq = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->snow[fidx][band].swq + veg_var[iveg][band].crop_frac*all_vars_crop->snow[fidx+1][band].swq;
+	  snow[iveg][band].snow_distrib_slope = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->snow[fidx][band].snow_distrib_slope + veg_var[iveg][band].crop_frac*all_vars_crop->snow[fidx+1][band].snow_distrib_slope;
+	  snow[iveg][band].tmp_int_storage = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->snow[fidx][band].tmp_int_storage + veg_var[iveg][band].crop_frac*all_vars_crop->snow[fidx+1][band].tmp_int_storage;
 	  
 	  // Copy snow flux data
-	  snow[iveg][band].blowing_flux = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->snow[0][band].blowing_flux + veg_var[iveg][band].crop_frac*all_vars_crop->snow[1][band].blowing_flux;
-	  snow[iveg][band].canopy_vapor_flux = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->snow[0][band].canopy_vapor_flux + veg_var[iveg][band].crop_frac*all_vars_crop->snow[1][band].canopy_vapor_flux;
-	  snow[iveg][band].mass_error = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->snow[0][band].mass_error + veg_var[iveg][band].crop_frac*all_vars_crop->snow[1][band].mass_error;
-	  snow[iveg][band].melt = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->snow[0][band].melt + veg_var[iveg][band].crop_frac*all_vars_crop->snow[1][band].melt;
-	  snow[iveg][band].Qnet = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->snow[0][band].Qnet + veg_var[iveg][band].crop_frac*all_vars_crop->snow[1][band].Qnet;
-	  snow[iveg][band].surface_flux = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->snow[0][band].surface_flux + veg_var[iveg][band].crop_frac*all_vars_crop->snow[1][band].surface_flux;
-	  snow[iveg][band].transport = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->snow[0][band].transport + veg_var[iveg][band].crop_frac*all_vars_crop->snow[1][band].transport;
-	  snow[iveg][band].vapor_flux = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->snow[0][band].vapor_flux + veg_var[iveg][band].crop_frac*all_vars_crop->snow[1][band].vapor_flux;
+	  snow[iveg][band].blowing_flux = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->snow[fidx][band].blowing_flux + veg_var[iveg][band].crop_frac*all_vars_crop->snow[fidx+1][band].blowing_flux;
+	  snow[iveg][band].canopy_vapor_flux = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->snow[fidx][band].canopy_vapor_flux + veg_var[iveg][band].crop_frac*all_vars_crop->snow[fidx+1][band].canopy_vapor_flux;
+	  snow[iveg][band].mass_error = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->snow[fidx][band].mass_error + veg_var[iveg][band].crop_frac*all_vars_crop->snow[fidx+1][band].mass_error;
+	  snow[iveg][band].melt = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->snow[fidx][band].melt + veg_var[iveg][band].crop_frac*all_vars_crop->snow[fidx+1][band].melt;
+	  snow[iveg][band].Qnet = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->snow[fidx][band].Qnet + veg_var[iveg][band].crop_frac*all_vars_crop->snow[fidx+1][band].Qnet;
+	  snow[iveg][band].surface_flux = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->snow[fidx][band].surface_flux + veg_var[iveg][band].crop_frac*all_vars_crop->snow[fidx+1][band].surface_flux;
+	  snow[iveg][band].transport = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->snow[fidx][band].transport + veg_var[iveg][band].crop_frac*all_vars_crop->snow[fidx+1][band].transport;
+	  snow[iveg][band].vapor_flux = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->snow[fidx][band].vapor_flux + veg_var[iveg][band].crop_frac*all_vars_crop->snow[fidx+1][band].vapor_flux;
 	  
 	  // Copy energy state data
-	  energy[iveg][band].AlbedoLake = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->energy[0][band].AlbedoLake + veg_var[iveg][band].crop_frac*all_vars_crop->energy[1][band].AlbedoLake;
-	  energy[iveg][band].AlbedoOver = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->energy[0][band].AlbedoOver + veg_var[iveg][band].crop_frac*all_vars_crop->energy[1][band].AlbedoOver;
-	  energy[iveg][band].AlbedoUnder = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->energy[0][band].AlbedoUnder + veg_var[iveg][band].crop_frac*all_vars_crop->energy[1][band].AlbedoUnder;
-	  energy[iveg][band].frozen = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->energy[0][band].frozen + veg_var[iveg][band].crop_frac*all_vars_crop->energy[1][band].frozen;
-	  energy[iveg][band].Nfrost = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->energy[0][band].Nfrost + veg_var[iveg][band].crop_frac*all_vars_crop->energy[1][band].Nfrost;
-	  energy[iveg][band].Nthaw = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->energy[0][band].Nthaw + veg_var[iveg][band].crop_frac*all_vars_crop->energy[1][band].Nthaw;
-	  energy[iveg][band].T1_index = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->energy[0][band].T1_index + veg_var[iveg][band].crop_frac*all_vars_crop->energy[1][band].T1_index;
-	  energy[iveg][band].Tcanopy = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->energy[0][band].Tcanopy + veg_var[iveg][band].crop_frac*all_vars_crop->energy[1][band].Tcanopy;
-	  energy[iveg][band].Tcanopy_fbcount = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->energy[0][band].Tcanopy_fbcount + veg_var[iveg][band].crop_frac*all_vars_crop->energy[1][band].Tcanopy_fbcount;
-	  energy[iveg][band].Tcanopy_fbflag = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->energy[0][band].Tcanopy_fbflag + veg_var[iveg][band].crop_frac*all_vars_crop->energy[1][band].Tcanopy_fbflag;
-	  energy[iveg][band].Tfoliage = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->energy[0][band].Tfoliage + veg_var[iveg][band].crop_frac*all_vars_crop->energy[1][band].Tfoliage;
-	  energy[iveg][band].Tfoliage_fbcount = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->energy[0][band].Tfoliage_fbcount + veg_var[iveg][band].crop_frac*all_vars_crop->energy[1][band].Tfoliage_fbcount;
-	  energy[iveg][band].Tfoliage_fbflag = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->energy[0][band].Tfoliage_fbflag + veg_var[iveg][band].crop_frac*all_vars_crop->energy[1][band].Tfoliage_fbflag;
-	  energy[iveg][band].Tsurf = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->energy[0][band].Tsurf + veg_var[iveg][band].crop_frac*all_vars_crop->energy[1][band].Tsurf;
-	  energy[iveg][band].Tsurf_fbcount = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->energy[0][band].Tsurf_fbcount + veg_var[iveg][band].crop_frac*all_vars_crop->energy[1][band].Tsurf_fbcount;
-	  energy[iveg][band].Tsurf_fbflag = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->energy[0][band].Tsurf_fbflag + veg_var[iveg][band].crop_frac*all_vars_crop->energy[1][band].Tsurf_fbflag;
-	  energy[iveg][band].unfrozen = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->energy[0][band].unfrozen + veg_var[iveg][band].crop_frac*all_vars_crop->energy[1][band].unfrozen;
+	  energy[iveg][band].AlbedoLake = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->energy[fidx][band].AlbedoLake + veg_var[iveg][band].crop_frac*all_vars_crop->energy[fidx+1][band].AlbedoLake;
+	  energy[iveg][band].AlbedoOver = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->energy[fidx][band].AlbedoOver + veg_var[iveg][band].crop_frac*all_vars_crop->energy[fidx+1][band].AlbedoOver;
+	  energy[iveg][band].AlbedoUnder = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->energy[fidx][band].AlbedoUnder + veg_var[iveg][band].crop_frac*all_vars_crop->energy[fidx+1][band].AlbedoUnder;
+	  energy[iveg][band].frozen = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->energy[fidx][band].frozen + veg_var[iveg][band].crop_frac*all_vars_crop->energy[fidx+1][band].frozen;
+	  energy[iveg][band].Nfrost = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->energy[fidx][band].Nfrost + veg_var[iveg][band].crop_frac*all_vars_crop->energy[fidx+1][band].Nfrost;
+	  energy[iveg][band].Nthaw = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->energy[fidx][band].Nthaw + veg_var[iveg][band].crop_frac*all_vars_crop->energy[fidx+1][band].Nthaw;
+	  energy[iveg][band].T1_index = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->energy[fidx][band].T1_index + veg_var[iveg][band].crop_frac*all_vars_crop->energy[fidx+1][band].T1_index;
+	  energy[iveg][band].Tcanopy = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->energy[fidx][band].Tcanopy + veg_var[iveg][band].crop_frac*all_vars_crop->energy[fidx+1][band].Tcanopy;
+	  energy[iveg][band].Tcanopy_fbcount = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->energy[fidx][band].Tcanopy_fbcount + veg_var[iveg][band].crop_frac*all_vars_crop->energy[fidx+1][band].Tcanopy_fbcount;
+	  energy[iveg][band].Tcanopy_fbflag = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->energy[fidx][band].Tcanopy_fbflag + veg_var[iveg][band].crop_frac*all_vars_crop->energy[fidx+1][band].Tcanopy_fbflag;
+	  energy[iveg][band].Tfoliage = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->energy[fidx][band].Tfoliage + veg_var[iveg][band].crop_frac*all_vars_crop->energy[fidx+1][band].Tfoliage;
+	  energy[iveg][band].Tfoliage_fbcount = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->energy[fidx][band].Tfoliage_fbcount + veg_var[iveg][band].crop_frac*all_vars_crop->energy[fidx+1][band].Tfoliage_fbcount;
+	  energy[iveg][band].Tfoliage_fbflag = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->energy[fidx][band].Tfoliage_fbflag + veg_var[iveg][band].crop_frac*all_vars_crop->energy[fidx+1][band].Tfoliage_fbflag;
+	  energy[iveg][band].Tsurf = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->energy[fidx][band].Tsurf + veg_var[iveg][band].crop_frac*all_vars_crop->energy[fidx+1][band].Tsurf;
+	  energy[iveg][band].Tsurf_fbcount = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->energy[fidx][band].Tsurf_fbcount + veg_var[iveg][band].crop_frac*all_vars_crop->energy[fidx+1][band].Tsurf_fbcount;
+	  energy[iveg][band].Tsurf_fbflag = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->energy[fidx][band].Tsurf_fbflag + veg_var[iveg][band].crop_frac*all_vars_crop->energy[fidx+1][band].Tsurf_fbflag;
+	  energy[iveg][band].unfrozen = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->energy[fidx][band].unfrozen + veg_var[iveg][band].crop_frac*all_vars_crop->energy[fidx+1][band].unfrozen;
 	  for (lidx=0; lidx<2; lidx++) {
-	    energy[iveg][band].Cs[lidx] = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->energy[0][band].Cs[lidx] + veg_var[iveg][band].crop_frac*all_vars_crop->energy[1][band].Cs[lidx];
-	    energy[iveg][band].kappa[lidx] = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->energy[0][band].kappa[lidx] + veg_var[iveg][band].crop_frac*all_vars_crop->energy[1][band].kappa[lidx];
+	    energy[iveg][band].Cs[lidx] = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->energy[fidx][band].Cs[lidx] + veg_var[iveg][band].crop_frac*all_vars_crop->energy[fidx+1][band].Cs[lidx];
+	    energy[iveg][band].kappa[lidx] = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->energy[fidx][band].kappa[lidx] + veg_var[iveg][band].crop_frac*all_vars_crop->energy[fidx+1][band].kappa[lidx];
+	  }
+	  for (index=0; index<OPT_Nnode; index++) {
+	    energy[iveg][band].Cs_node[index] = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->energy[fidx][band].Cs_node[index] + veg_var[iveg][band].crop_frac*all_vars_crop->energy[fidx+1][band].Cs_node[index];
+	    energy[iveg][band].ice[index] = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->energy[fidx][band].ice[index] + veg_var[iveg][band].crop_frac*all_vars_crop->energy[fidx+1][band].ice[index];
+	    energy[iveg][band].kappa_node[index] = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->energy[fidx][band].kappa_node[index] + veg_var[iveg][band].crop_frac*all_vars_crop->energy[fidx+1][band].kappa_node[index];
+	    energy[iveg][band].moist[index] = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->energy[fidx][band].moist[index] + veg_var[iveg][band].crop_frac*all_vars_crop->energy[fidx+1][band].moist[index];
+	    energy[iveg][band].T[index] = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->energy[fidx][band].T[index] + veg_var[iveg][band].crop_frac*all_vars_crop->energy[fidx+1][band].T[index];
+	    energy[iveg][band].T_fbcount[index] = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->energy[fidx][band].T_fbcount[index] + veg_var[iveg][band].crop_frac*all_vars_crop->energy[fidx+1][band].T_fbcount[index];
+	    energy[iveg][band].T_fbflag[index] = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->energy[fidx][band].T_fbflag[index] + veg_var[iveg][band].crop_frac*all_vars_crop->energy[fidx+1][band].T_fbflag[index];
 	  }
-	  for (index=0; index<options.Nnode; index++) {
-	    energy[iveg][band].Cs[lidx] = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->energy[0][band].Cs[lidx] + veg_var[iveg][band].crop_frac*all_vars_crop->energy[1][band].Cs[lidx];
-	    energy[iveg][band].fdepth[lidx] = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->energy[0][band].fdepth[lidx] + veg_var[iveg][band].crop_frac*all_vars_crop->energy[1][band].fdepth[lidx];
-	    energy[iveg][band].ice[lidx] = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->energy[0][band].ice[lidx] + veg_var[iveg][band].crop_frac*all_vars_crop->energy[1][band].ice[lidx];
-	    energy[iveg][band].kappa_node[lidx] = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->energy[0][band].kappa_node[lidx] + veg_var[iveg][band].crop_frac*all_vars_crop->energy[1][band].kappa_node[lidx];
-	    energy[iveg][band].moist[lidx] = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->energy[0][band].moist[lidx] + veg_var[iveg][band].crop_frac*all_vars_crop->energy[1][band].moist[lidx];
-	    energy[iveg][band].T[lidx] = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->energy[0][band].T[lidx] + veg_var[iveg][band].crop_frac*all_vars_crop->energy[1][band].T[lidx];
-	    energy[iveg][band].T_fbcount[lidx] = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->energy[0][band].T_fbcount[lidx] + veg_var[iveg][band].crop_frac*all_vars_crop->energy[1][band].T_fbcount[lidx];
-	    energy[iveg][band].T_fbflag[lidx] = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->energy[0][band].T_fbflag[lidx] + veg_var[iveg][band].crop_frac*all_vars_crop->energy[1][band].T_fbflag[lidx];
-	    energy[iveg][band].tdepth[lidx] = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->energy[0][band].tdepth[lidx] + veg_var[iveg][band].crop_frac*all_vars_crop->energy[1][band].tdepth[lidx];
+	  for (index=0; index<MAX_FRONTS; index++) {
+	    energy[iveg][band].fdepth[index] = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->energy[fidx][band].fdepth[index] + veg_var[iveg][band].crop_frac*all_vars_crop->energy[fidx+1][band].fdepth[index];
+	    energy[iveg][band].tdepth[index] = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->energy[fidx][band].tdepth[index] + veg_var[iveg][band].crop_frac*all_vars_crop->energy[fidx+1][band].tdepth[index];
 	  }
 	  
 	  // Copy energy flux data
-	  energy[iveg][band].advected_sensible = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->energy[0][band].advected_sensible + veg_var[iveg][band].crop_frac*all_vars_crop->energy[1][band].advected_sensible;
-	  energy[iveg][band].advection = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->energy[0][band].advection + veg_var[iveg][band].crop_frac*all_vars_crop->energy[1][band].advection;
-	  energy[iveg][band].AtmosError = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->energy[0][band].AtmosError + veg_var[iveg][band].crop_frac*all_vars_crop->energy[1][band].AtmosError;
-	  energy[iveg][band].AtmosLatent = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->energy[0][band].AtmosLatent + veg_var[iveg][band].crop_frac*all_vars_crop->energy[1][band].AtmosLatent;
-	  energy[iveg][band].AtmosLatentSub = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->energy[0][band].AtmosLatentSub + veg_var[iveg][band].crop_frac*all_vars_crop->energy[1][band].AtmosLatentSub;
-	  energy[iveg][band].AtmosSensible = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->energy[0][band].AtmosSensible + veg_var[iveg][band].crop_frac*all_vars_crop->energy[1][band].AtmosSensible;
-	  energy[iveg][band].canopy_advection = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->energy[0][band].canopy_advection + veg_var[iveg][band].crop_frac*all_vars_crop->energy[1][band].canopy_advection;
-	  energy[iveg][band].canopy_latent = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->energy[0][band].canopy_latent + veg_var[iveg][band].crop_frac*all_vars_crop->energy[1][band].canopy_latent;
-	  energy[iveg][band].canopy_latent_sub = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->energy[0][band].canopy_latent_sub + veg_var[iveg][band].crop_frac*all_vars_crop->energy[1][band].canopy_latent_sub;
-	  energy[iveg][band].canopy_refreeze = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->energy[0][band].canopy_refreeze + veg_var[iveg][band].crop_frac*all_vars_crop->energy[1][band].canopy_refreeze;
-	  energy[iveg][band].canopy_sensible = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->energy[0][band].canopy_sensible + veg_var[iveg][band].crop_frac*all_vars_crop->energy[1][band].canopy_sensible;
-	  energy[iveg][band].deltaCC = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->energy[0][band].deltaCC + veg_var[iveg][band].crop_frac*all_vars_crop->energy[1][band].deltaCC;
-	  energy[iveg][band].deltaH = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->energy[0][band].deltaH + veg_var[iveg][band].crop_frac*all_vars_crop->energy[1][band].deltaH;
-	  energy[iveg][band].error = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->energy[0][band].error + veg_var[iveg][band].crop_frac*all_vars_crop->energy[1][band].error;
-	  energy[iveg][band].fusion = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->energy[0][band].fusion + veg_var[iveg][band].crop_frac*all_vars_crop->energy[1][band].fusion;
-	  energy[iveg][band].grnd_flux = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->energy[0][band].grnd_flux + veg_var[iveg][band].crop_frac*all_vars_crop->energy[1][band].grnd_flux;
-	  energy[iveg][band].latent = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->energy[0][band].latent + veg_var[iveg][band].crop_frac*all_vars_crop->energy[1][band].latent;
-	  energy[iveg][band].latent_sub = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->energy[0][band].latent_sub + veg_var[iveg][band].crop_frac*all_vars_crop->energy[1][band].latent_sub;
-	  energy[iveg][band].longwave = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->energy[0][band].longwave + veg_var[iveg][band].crop_frac*all_vars_crop->energy[1][band].longwave;
-	  energy[iveg][band].LongOverIn = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->energy[0][band].LongOverIn + veg_var[iveg][band].crop_frac*all_vars_crop->energy[1][band].LongOverIn;
-	  energy[iveg][band].LongUnderIn = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->energy[0][band].LongUnderIn + veg_var[iveg][band].crop_frac*all_vars_crop->energy[1][band].LongUnderIn;
-	  energy[iveg][band].LongUnderOut = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->energy[0][band].LongUnderOut + veg_var[iveg][band].crop_frac*all_vars_crop->energy[1][band].LongUnderOut;
-	  energy[iveg][band].melt_energy = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->energy[0][band].melt_energy + veg_var[iveg][band].crop_frac*all_vars_crop->energy[1][band].melt_energy;
-	  energy[iveg][band].NetLongAtmos = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->energy[0][band].NetLongAtmos + veg_var[iveg][band].crop_frac*all_vars_crop->energy[1][band].NetLongAtmos;
-	  energy[iveg][band].NetLongOver = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->energy[0][band].NetLongOver + veg_var[iveg][band].crop_frac*all_vars_crop->energy[1][band].NetLongOver;
-	  energy[iveg][band].NetLongUnder = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->energy[0][band].NetLongUnder + veg_var[iveg][band].crop_frac*all_vars_crop->energy[1][band].NetLongUnder;
-	  energy[iveg][band].NetShortAtmos = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->energy[0][band].NetShortAtmos + veg_var[iveg][band].crop_frac*all_vars_crop->energy[1][band].NetShortAtmos;
-	  energy[iveg][band].NetShortGrnd = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->energy[0][band].NetShortGrnd + veg_var[iveg][band].crop_frac*all_vars_crop->energy[1][band].NetShortGrnd;
-	  energy[iveg][band].NetShortOver = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->energy[0][band].NetShortOver + veg_var[iveg][band].crop_frac*all_vars_crop->energy[1][band].NetShortOver;
-	  energy[iveg][band].NetShortUnder = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->energy[0][band].NetShortUnder + veg_var[iveg][band].crop_frac*all_vars_crop->energy[1][band].NetShortUnder;
-	  energy[iveg][band].out_long_canopy = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->energy[0][band].out_long_canopy + veg_var[iveg][band].crop_frac*all_vars_crop->energy[1][band].out_long_canopy;
-	  energy[iveg][band].out_long_surface = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->energy[0][band].out_long_surface + veg_var[iveg][band].crop_frac*all_vars_crop->energy[1][band].out_long_surface;
-	  energy[iveg][band].refreeze_energy = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->energy[0][band].refreeze_energy + veg_var[iveg][band].crop_frac*all_vars_crop->energy[1][band].refreeze_energy;
-	  energy[iveg][band].sensible = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->energy[0][band].sensible + veg_var[iveg][band].crop_frac*all_vars_crop->energy[1][band].sensible;
-	  energy[iveg][band].shortwave = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->energy[0][band].shortwave + veg_var[iveg][band].crop_frac*all_vars_crop->energy[1][band].shortwave;
-	  energy[iveg][band].ShortOverIn = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->energy[0][band].ShortOverIn + veg_var[iveg][band].crop_frac*all_vars_crop->energy[1][band].ShortOverIn;
-	  energy[iveg][band].ShortUnderIn = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->energy[0][band].ShortUnderIn + veg_var[iveg][band].crop_frac*all_vars_crop->energy[1][band].ShortUnderIn;
-	  energy[iveg][band].snow_flux = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->energy[0][band].snow_flux + veg_var[iveg][band].crop_frac*all_vars_crop->energy[1][band].snow_flux;
+	  energy[iveg][band].advected_sensible = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->energy[fidx][band].advected_sensible + veg_var[iveg][band].crop_frac*all_vars_crop->energy[fidx+1][band].advected_sensible;
+	  energy[iveg][band].advection = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->energy[fidx][band].advection + veg_var[iveg][band].crop_frac*all_vars_crop->energy[fidx+1][band].advection;
+	  energy[iveg][band].AtmosError = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->energy[fidx][band].AtmosError + veg_var[iveg][band].crop_frac*all_vars_crop->energy[fidx+1][band].AtmosError;
+	  energy[iveg][band].AtmosLatent = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->energy[fidx][band].AtmosLatent + veg_var[iveg][band].crop_frac*all_vars_crop->energy[fidx+1][band].AtmosLatent;
+	  energy[iveg][band].AtmosLatentSub = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->energy[fidx][band].AtmosLatentSub + veg_var[iveg][band].crop_frac*all_vars_crop->energy[fidx+1][band].AtmosLatentSub;
+	  energy[iveg][band].AtmosSensible = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->energy[fidx][band].AtmosSensible + veg_var[iveg][band].crop_frac*all_vars_crop->energy[fidx+1][band].AtmosSensible;
+	  energy[iveg][band].canopy_advection = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->energy[fidx][band].canopy_advection + veg_var[iveg][band].crop_frac*all_vars_crop->energy[fidx+1][band].canopy_advection;
+	  energy[iveg][band].canopy_latent = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->energy[fidx][band].canopy_latent + veg_var[iveg][band].crop_frac*all_vars_crop->energy[fidx+1][band].canopy_latent;
+	  energy[iveg][band].canopy_latent_sub = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->energy[fidx][band].canopy_latent_sub + veg_var[iveg][band].crop_frac*all_vars_crop->energy[fidx+1][band].canopy_latent_sub;
+	  energy[iveg][band].canopy_refreeze = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->energy[fidx][band].canopy_refreeze + veg_var[iveg][band].crop_frac*all_vars_crop->energy[fidx+1][band].canopy_refreeze;
+	  energy[iveg][band].canopy_sensible = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->energy[fidx][band].canopy_sensible + veg_var[iveg][band].crop_frac*all_vars_crop->energy[fidx+1][band].canopy_sensible;
+	  energy[iveg][band].deltaCC = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->energy[fidx][band].deltaCC + veg_var[iveg][band].crop_frac*all_vars_crop->energy[fidx+1][band].deltaCC;
+	  energy[iveg][band].deltaH = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->energy[fidx][band].deltaH + veg_var[iveg][band].crop_frac*all_vars_crop->energy[fidx+1][band].deltaH;
+	  energy[iveg][band].error = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->energy[fidx][band].error + veg_var[iveg][band].crop_frac*all_vars_crop->energy[fidx+1][band].error;
+	  energy[iveg][band].fusion = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->energy[fidx][band].fusion + veg_var[iveg][band].crop_frac*all_vars_crop->energy[fidx+1][band].fusion;
+	  energy[iveg][band].grnd_flux = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->energy[fidx][band].grnd_flux + veg_var[iveg][band].crop_frac*all_vars_crop->energy[fidx+1][band].grnd_flux;
+	  energy[iveg][band].latent = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->energy[fidx][band].latent + veg_var[iveg][band].crop_frac*all_vars_crop->energy[fidx+1][band].latent;
+	  energy[iveg][band].latent_sub = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->energy[fidx][band].latent_sub + veg_var[iveg][band].crop_frac*all_vars_crop->energy[fidx+1][band].latent_sub;
+	  energy[iveg][band].longwave = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->energy[fidx][band].longwave + veg_var[iveg][band].crop_frac*all_vars_crop->energy[fidx+1][band].longwave;
+	  energy[iveg][band].LongOverIn = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->energy[fidx][band].LongOverIn + veg_var[iveg][band].crop_frac*all_vars_crop->energy[fidx+1][band].LongOverIn;
+	  energy[iveg][band].LongUnderIn = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->energy[fidx][band].LongUnderIn + veg_var[iveg][band].crop_frac*all_vars_crop->energy[fidx+1][band].LongUnderIn;
+	  energy[iveg][band].LongUnderOut = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->energy[fidx][band].LongUnderOut + veg_var[iveg][band].crop_frac*all_vars_crop->energy[fidx+1][band].LongUnderOut;
+	  energy[iveg][band].melt_energy = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->energy[fidx][band].melt_energy + veg_var[iveg][band].crop_frac*all_vars_crop->energy[fidx+1][band].melt_energy;
+	  energy[iveg][band].NetLongAtmos = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->energy[fidx][band].NetLongAtmos + veg_var[iveg][band].crop_frac*all_vars_crop->energy[fidx+1][band].NetLongAtmos;
+	  energy[iveg][band].NetLongOver = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->energy[fidx][band].NetLongOver + veg_var[iveg][band].crop_frac*all_vars_crop->energy[fidx+1][band].NetLongOver;
+	  energy[iveg][band].NetLongUnder = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->energy[fidx][band].NetLongUnder + veg_var[iveg][band].crop_frac*all_vars_crop->energy[fidx+1][band].NetLongUnder;
+	  energy[iveg][band].NetShortAtmos = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->energy[fidx][band].NetShortAtmos + veg_var[iveg][band].crop_frac*all_vars_crop->energy[fidx+1][band].NetShortAtmos;
+	  energy[iveg][band].NetShortGrnd = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->energy[fidx][band].NetShortGrnd + veg_var[iveg][band].crop_frac*all_vars_crop->energy[fidx+1][band].NetShortGrnd;
+	  energy[iveg][band].NetShortOver = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->energy[fidx][band].NetShortOver + veg_var[iveg][band].crop_frac*all_vars_crop->energy[fidx+1][band].NetShortOver;
+	  energy[iveg][band].NetShortUnder = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->energy[fidx][band].NetShortUnder + veg_var[iveg][band].crop_frac*all_vars_crop->energy[fidx+1][band].NetShortUnder;
+	  energy[iveg][band].out_long_canopy = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->energy[fidx][band].out_long_canopy + veg_var[iveg][band].crop_frac*all_vars_crop->energy[fidx+1][band].out_long_canopy;
+	  energy[iveg][band].out_long_surface = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->energy[fidx][band].out_long_surface + veg_var[iveg][band].crop_frac*all_vars_crop->energy[fidx+1][band].out_long_surface;
+	  energy[iveg][band].refreeze_energy = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->energy[fidx][band].refreeze_energy + veg_var[iveg][band].crop_frac*all_vars_crop->energy[fidx+1][band].refreeze_energy;
+	  energy[iveg][band].sensible = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->energy[fidx][band].sensible + veg_var[iveg][band].crop_frac*all_vars_crop->energy[fidx+1][band].sensible;
+	  energy[iveg][band].shortwave = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->energy[fidx][band].shortwave + veg_var[iveg][band].crop_frac*all_vars_crop->energy[fidx+1][band].shortwave;
+	  energy[iveg][band].ShortOverIn = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->energy[fidx][band].ShortOverIn + veg_var[iveg][band].crop_frac*all_vars_crop->energy[fidx+1][band].ShortOverIn;
+	  energy[iveg][band].ShortUnderIn = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->energy[fidx][band].ShortUnderIn + veg_var[iveg][band].crop_frac*all_vars_crop->energy[fidx+1][band].ShortUnderIn;
+	  energy[iveg][band].snow_flux = (1-veg_var[iveg][band].crop_frac)*all_vars_crop->energy[fidx][band].snow_flux + veg_var[iveg][band].crop_frac*all_vars_crop->energy[fidx+1][band].snow_flux;
 	  
 	  
         }
@@ -1015,7 +1062,7 @@ int  full_energy(int                  gridcell,
 
 
       Cv = veg_con[iveg].Cv;
-      Nbands = options.SNOW_BAND;
+      Nbands = OPT_SNOW_BAND;
 
       /** Lake-specific processing **/
       if (veg_con[iveg].LAKE) {
@@ -1086,7 +1133,7 @@ int  full_energy(int                  gridcell,
                    * exp(-veg_lib[veg_class].rad_atten * veg_var[iveg][0].LAI);
 
       /* Initialize soil thermal properties for the top two layers */
-      prepare_full_energy(iveg, Nveg, options.Nnode, all_vars, soil_con, moist0, ice0);
+      prepare_full_energy(iveg, Nveg, OPT_Nnode, all_vars, soil_con, moist0, ice0);
 
       /** Compute Bare (free of snow) Albedo **/
       if (iveg!=Nveg){
@@ -1106,6 +1153,9 @@ int  full_energy(int                  gridcell,
       /* Current veg will be last */
       for (p=0; p<N_PET_TYPES+1; p++) {
 
+        /* Skip types of potential evap that are not written */
+        if (p < N_PET_TYPES && !options.PET_OUT[p]) continue;
+
         /* Initialize wind speeds */
         tmp_wind[0] = atmos->wind[NR];
         tmp_wind[1] = -999.;
@@ -1157,7 +1207,7 @@ int  full_energy(int                  gridcell,
       /******************************
         Compute nitrogen scaling factors and initialize other veg vars
       ******************************/
-      if (options.CARBON && iveg < Nveg) {
+      if (OPT_CARBON && iveg < Nveg) {
 	for(band=0; band<Nbands; band++) {
           for (cidx=0; cidx<options.Ncanopy; cidx++) {
             veg_var[iveg][band].rsLayer[cidx] = HUGE_RESIST;
@@ -1196,7 +1246,7 @@ int  full_energy(int                  gridcell,
 	    cell[iveg][band].pot_evap[p] = 0;
 
           // Limit irrigation to available water
-          if(options.IRRIGATION && veg_lib[veg_class].irr_active[dmy[rec].month-1] && !options.IRR_FREE) { 
+          if(OPT_IRRIGATION && veg_lib[veg_class].irr_active[dmy[rec].month-1] && !options.IRR_FREE) { 
  	    if(irrig>(atmos->irr_run[NR]+atmos->irr_with[NR]) && atmos->air_temp[NR]>7)
 	    veg_var[iveg][band].irrig *= (atmos->irr_run[NR]+atmos->irr_with[NR])/irrig; 
           }
@@ -1212,7 +1262,7 @@ int  full_energy(int                  gridcell,
 				     ref_height, roughness, 
 				     &snow_inflow[band], 
 				     tmp_wind, veg_con[iveg].root, Nbands, 
-				     options.Nlayer, Nveg, band, dp, iveg, rec, veg_class, 
+				     OPT_Nlayer, Nveg, band, dp, iveg, rec, veg_class, 
 				     atmos, dmy, &(energy[iveg][band]), gp, 
 				     &(cell[iveg][band]),
 				     &(snow[iveg][band]), 
@@ -1230,13 +1280,13 @@ int  full_energy(int                  gridcell,
           ********************************************************/
           cell[iveg][band].rootmoist = 0;
           cell[iveg][band].wetness = 0;
-          for(lidx=0;lidx<options.Nlayer;lidx++) {
+          for(lidx=0;lidx<OPT_Nlayer;lidx++) {
             if (veg_con->root[lidx] > 0) {
               cell[iveg][band].rootmoist += cell[iveg][band].layer[lidx].moist;
             }
 	    cell[iveg][band].wetness += (cell[iveg][band].layer[lidx].moist - soil_con->Wpwp[lidx])/(soil_con->porosity[lidx]*soil_con->depth[lidx]*1000 - soil_con->Wpwp[lidx]);
           }
-          cell[iveg][band].wetness /= options.Nlayer;
+          cell[iveg][band].wetness /= OPT_Nlayer;
 
 	} /** End non-zero area band **/
       } /** End Loop Through Elevation Bands **/
@@ -1253,7 +1303,7 @@ int  full_energy(int                  gridcell,
     for(iveg = 0; iveg < Nveg; iveg++){
       for ( band = 0; band < Nbands; band++ ) {
       // Handle non-crop tiles 
-	if (!options.CROPFRAC || !veg_con[iveg].crop_frac_active) {
+	if (!OPT_CROPFRAC || !veg_con[iveg].crop_frac_active) {
           veg_var[iveg][band].LAI *= veg_var[iveg][band].vegcover;
           veg_var[iveg][band].Wdmax *= veg_var[iveg][band].vegcover;
 	}
@@ -1272,7 +1322,7 @@ int  full_energy(int                  gridcell,
 
   /** Compute total runoff and baseflow for all vegetation types
       within each snowband. **/
-  if ( options.LAKES && lake_con->lake_idx >= 0 ) {
+  if ( OPT_LAKES && lake_con->lake_idx >= 0 ) {
 
     wetland_runoff = wetland_baseflow = 0;
     sum_runoff = sum_baseflow = 0;
@@ -1284,7 +1334,7 @@ int  full_energy(int                  gridcell,
       if (veg_con[iveg].Cv  > 0.) {
 
 	Cv = veg_con[iveg].Cv;
-        Nbands = options.SNOW_BAND;
+        Nbands = OPT_SNOW_BAND;
         if (veg_con[iveg].LAKE) {
           Cv *= (1-lakefrac);
           Nbands = 1;
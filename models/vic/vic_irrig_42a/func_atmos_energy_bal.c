@@ -5,13 +5,18 @@
 
 static char vcid[] = "$Id$";
 
-double func_atmos_energy_bal(double Tcanopy, va_list ap) {
+double func_atmos_energy_bal(double Tcanopy, void *params) {
 /**********************************************************************
   func_atmos_energy_bal.c      Keith Cherkauer        February 6, 2001
 
   This routine solves the atmospheric exchange energy balance.
 
+  Modifications:
+  2026-Oct-18 Replaced the variable argument list with an argument
+	      structure passed through root_brent().
+
 **********************************************************************/
+  atmos_energy_bal_args_struct *args = (atmos_energy_bal_args_struct *) params;
 
   double  LatentHeat;
   double  NetRadiation;
@@ -25,15 +30,15 @@ double func_atmos_energy_bal(double Tcanopy, va_list ap) {
   // internal routine variables
   double  Error;
 
-  // extract variables from va_arg
-  LatentHeat    = (double)  va_arg(ap, double);
-  NetRadiation  = (double)  va_arg(ap, double);
-  Ra            = (double)  va_arg(ap, double);
-  Tair          = (double)  va_arg(ap, double);
-  atmos_density = (double)  va_arg(ap, double);
-  InSensible    = (double)  va_arg(ap, double);
+  // extract variables from argument structure
+  LatentHeat    = args->LatentHeat;
+  NetRadiation  = args->NetRadiation;
+  Ra            = args->Ra;
+  Tair          = args->Tair;
+  atmos_density = args->atmos_density;
+  InSensible    = args->InSensible;
 
-  SensibleHeat  = (double *)va_arg(ap, double *);
+  SensibleHeat  = args->SensibleHeat;
 
   // compute sensible heat flux between canopy and atmosphere
   (*SensibleHeat) = atmos_density * Cp * (Tair - Tcanopy) / Ra;
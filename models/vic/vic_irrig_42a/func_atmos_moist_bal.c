@@ -5,13 +5,18 @@
 
 static char vcid[] = "$Id$";
 
-double func_atmos_moist_bal(double VPcanopy, va_list ap) {
+double func_atmos_moist_bal(double VPcanopy, void *params) {
 /**********************************************************************
   func_atmos_moist_bal.c      Keith Cherkauer        March 2, 2001
 
   This routine solves the atmospheric exchange moisture balance.
 
+  Modifications:
+  2026-Oct-18 Replaced the variable argument list with an argument
+	      structure passed through root_brent().
+
 **********************************************************************/
+  atmos_moist_bal_args_struct *args = (atmos_moist_bal_args_struct *) params;
 
   double  InLatentHeat;
   double  Lv;
@@ -25,15 +30,15 @@ double func_atmos_moist_bal(double VPcanopy, va_list ap) {
   // internal routine variables
   double  Error;
 
-  // extract variables from va_arg
-  InLatentHeat  = (double)  va_arg(ap, double);
-  Lv            = (double)  va_arg(ap, double);
-  Ra            = (double)  va_arg(ap, double);
-  atmos_density = (double)  va_arg(ap, double);
-  gamma         = (double)  va_arg(ap, double);
-  vp            = (double)  va_arg(ap, double);
+  // extract variables from argument structure
+  InLatentHeat  = args->InLatentHeat;
+  Lv            = args->Lv;
+  Ra            = args->Ra;
+  atmos_density = args->atmos_density;
+  gamma         = args->gamma;
+  vp            = args->vp;
 
-  LatentHeat    = (double *)va_arg(ap, double *);
+  LatentHeat    = args->LatentHeat;
 
   // compute sensible heat flux between canopy and atmosphere
   (*LatentHeat) = Lv * atmos_density * Cp * (vp - VPcanopy) / ( gamma * Ra );
@@ -1,11 +1,10 @@
-#include <stdarg.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <vicNl.h>
 
 static char vcid[] = "$Id$";
 
-double func_canopy_energy_bal(double Tfoliage, va_list ap)
+double func_canopy_energy_bal(double Tfoliage, void *params)
 /*********************************************************************
   func_canopy_energy_bal    Keith Cherkauer         January 27, 2001
 
@@ -25,8 +24,11 @@ double func_canopy_energy_bal(double Tfoliage, va_list ap)
   2013-Jul-25 Added photosynthesis terms.				TJB
   2013-Dec-27 Moved SPATIAL_FROST to options_struct.			TJB
   2014-Mar-28 Removed DIST_PRCP option.					TJB
+  2026-Oct-18 Replaced the variable argument list with an argument
+	      structure passed through root_brent().
  ********************************************************************/
 {
+  canopy_energy_bal_args_struct *args = (canopy_energy_bal_args_struct *) params;
 
   extern option_struct   options;
 
@@ -105,74 +107,74 @@ double func_canopy_energy_bal(double Tfoliage, va_list ap)
   double  Tmp;
   double  prec;
 
-  /** Read variables from variable length argument list **/
+  /** Read variables from argument structure **/
 
   /* General Model Parameters */
-  band    = (int) va_arg(ap, int);
-  month   = (int) va_arg(ap, int);
-  rec     = (int) va_arg(ap, int);
+  band    = args->band;
+  month   = args->month;
+  rec     = args->rec;
 
-  delta_t   = (double) va_arg(ap, double);
-  elevation = (double) va_arg(ap, double);
+  delta_t   = args->delta_t;
+  elevation = args->elevation;
 
-  Wmax        = (double *) va_arg(ap, double *);
-  Wcr         = (double *) va_arg(ap, double *);
-  Wpwp        = (double *) va_arg(ap, double *);
-  depth       = (double *) va_arg(ap, double *);
-  frost_fract = (double *) va_arg(ap, double *);
+  Wmax        = args->Wmax;
+  Wcr         = args->Wcr;
+  Wpwp        = args->Wpwp;
+  depth       = args->depth;
+  frost_fract = args->frost_fract;
 
   /* Atmopheric Condition and Forcings */
-  AirDens  = (double) va_arg(ap, double);
-  EactAir  = (double) va_arg(ap, double);
-  Press    = (double) va_arg(ap, double);
-  Le       = (double) va_arg(ap, double);
-  Tcanopy     = (double) va_arg(ap, double);
-  Vpd      = (double) va_arg(ap, double);
-  shortwave= (double) va_arg(ap, double);
-  Catm     = (double) va_arg(ap, double);
-  dryFrac = (double *) va_arg(ap, double *);
-
-  Evap     = (double *) va_arg(ap, double *);
-  Ra       = (double *) va_arg(ap, double *);
-  Ra_used  = (double *) va_arg(ap, double *);
-  Rainfall = (double) va_arg(ap, double);
-  Wind     = (double *) va_arg(ap, double *);
+  AirDens  = args->AirDens;
+  EactAir  = args->EactAir;
+  Press    = args->Press;
+  Le       = args->Le;
+  Tcanopy     = args->Tcanopy;
+  Vpd      = args->Vpd;
+  shortwave= args->shortwave;
+  Catm     = args->Catm;
+  dryFrac = args->dryFrac;
+
+  Evap     = args->Evap;
+  Ra       = args->Ra;
+  Ra_used  = args->Ra_used;
+  Rainfall = args->Rainfall;
+  Wind     = args->Wind;
 
   /* Vegetation Terms */
-  UnderStory = (int) va_arg(ap, int);
-  iveg       = (int) va_arg(ap, int);
-  veg_class  = (int) va_arg(ap, int);
+  UnderStory = args->UnderStory;
+  iveg       = args->iveg;
+  veg_class  = args->veg_class;
 
-  displacement = (double *) va_arg(ap, double *);
-  ref_height   = (double *) va_arg(ap, double *);
-  roughness    = (double *) va_arg(ap, double *);
+  displacement = args->displacement;
+  ref_height   = args->ref_height;
+  roughness    = args->roughness;
 
-  root = (float *) va_arg(ap, float *);
-  CanopLayerBnd= (double *) va_arg(ap, double *);
+  root = args->root;
+  CanopLayerBnd= args->CanopLayerBnd;
 
   /* Water Flux Terms */
-  IntRain = (double) va_arg(ap, double);
-  IntSnow = (double) va_arg(ap, double);
+  IntRain = args->IntRain;
+  IntSnow = args->IntSnow;
 
-  Wdew    = (double *) va_arg(ap, double *);
+  Wdew    = args->Wdew;
 
-  layer   = (layer_data_struct *) va_arg(ap, layer_data_struct *);
-  veg_var = (veg_var_struct *) va_arg(ap, veg_var_struct *);
+  layer   = args->layer;
+  veg_var = args->veg_var;
 
   /* Energy Flux Terms */
-  LongOverIn         = (double) va_arg(ap, double);
-  LongUnderOut       = (double) va_arg(ap, double);
-  NetShortOver       = (double) va_arg(ap, double);
-
-  AdvectedEnergy     = (double *) va_arg(ap, double *);
-  LatentHeat         = (double *) va_arg(ap, double *);
-  LatentHeatSub      = (double *) va_arg(ap, double *);
-  LongOverOut        = (double *) va_arg(ap, double *);
-  NetLongOver        = (double *) va_arg(ap, double *);
-  NetRadiation       = (double *) va_arg(ap, double *);
-  RefreezeEnergy     = (double *) va_arg(ap, double *);
-  SensibleHeat       = (double *) va_arg(ap, double *);
-  VaporMassFlux      = (double *) va_arg(ap, double *);
+  LongOverIn         = args->LongOverIn;
+  LongUnderOut       = args->LongUnderOut;
+  NetShortOver       = args->NetShortOver;
+
+  AdvectedEnergy     = args->AdvectedEnergy;
+  LatentHeat         = args->LatentHeat;
+  LatentHeatSub      = args->LatentHeatSub;
+  LongOverOut        = args->LongOverOut;
+  NetLongOver        = args->NetLongOver;
+  NetRadiation       = args->NetRadiation;
+  RefreezeEnergy     = args->RefreezeEnergy;
+  SensibleHeat       = args->SensibleHeat;
+  VaporMassFlux      = args->VaporMassFlux;
 
   /* Calculate the net radiation at the canopy surface, using the canopy 
      temperature.  The outgoing longwave is subtracted twice, because the 
@@ -5,7 +5,7 @@
 
 static char vcid[] = "$Id$";
 
-double func_surf_energy_bal(double Ts, va_list ap)
+double func_surf_energy_bal(double Ts, void *params)
 /**********************************************************************
 	func_surf_energy_bal	Keith Cherkauer		January 3, 1996
 
@@ -115,8 +115,16 @@ double func_surf_energy_bal(double Ts, va_list ap)
   2014-Apr-25 Added partial veg cover fraction, bare soil evap between
 	      the plants, and re-scaling of LAI & plant fluxes from
 	      global to local and back.					TJB
+  2026-Oct-18 Replaced the variable argument list with an argument
+	      structure passed through root_brent().
+  2026-Oct-18 The choice of the implicit soil temperature solution is
+	      passed in the argument structure (see IMPLICIT_FB).
+  2026-Oct-18 Options are read through OPT_* (see vicNl_def.h), so
+	      that specialized builds can fix them at compile time.
 **********************************************************************/
 {
+  surf_energy_bal_args_struct *args = (surf_energy_bal_args_struct *) params;
+
   extern option_struct options;
   extern veg_lib_struct *veg_lib;
 
@@ -256,6 +264,7 @@ double func_surf_energy_bal(double Ts, va_list ap)
   int FS_ACTIVE;
   int NOFLUX;
   int EXP_TRANS;
+  int IMPLICIT;
   int SNOWING;
 
   int *FIRST_SOLN;
@@ -302,133 +311,134 @@ double func_surf_energy_bal(double Ts, va_list ap)
   double tmp_ref_height[3];
 
   /************************************
-    Read variables from variable list 
+    Read variables from argument structure
   ************************************/
 
   /* general model terms */
-  rec                     = (int) va_arg(ap, int);
-  nrecs                    = (int) va_arg(ap, int);
-  month                   = (int) va_arg(ap, int);
-  VEG                     = (int) va_arg(ap, int);
-  veg_class               = (int) va_arg(ap, int);
-  iveg                    = (int) va_arg(ap, int);
-  delta_t                 = (double) va_arg(ap, double);
+  rec                     = args->rec;
+  nrecs                    = args->nrecs;
+  month                   = args->month;
+  VEG                     = args->VEG;
+  veg_class               = args->veg_class;
+  iveg                    = args->iveg;
+  delta_t                 = args->delta_t;
 
   /* soil layer terms */
-  Cs1                     = (double) va_arg(ap, double);
-  Cs2                     = (double) va_arg(ap, double);
-  D1                      = (double) va_arg(ap, double);
-  D2                      = (double) va_arg(ap, double);
-  T1_old                  = (double) va_arg(ap, double);
-  T2                      = (double) va_arg(ap, double);
-  Ts_old                  = (double) va_arg(ap, double);
-  Told_node               = (double *) va_arg(ap, double *);
-  bubble                  = (double) va_arg(ap, double);
-  dp                      = (double) va_arg(ap, double);
-  expt                    = (double) va_arg(ap, double);
-  ice0                    = (double) va_arg(ap, double);
-  kappa1                  = (double) va_arg(ap, double);
-  kappa2                  = (double) va_arg(ap, double);
-  max_moist               = (double) va_arg(ap, double);
-  moist                   = (double) va_arg(ap, double);
-
-  root                    = (float  *) va_arg(ap, float  *);
-  CanopLayerBnd           = (double *) va_arg(ap, double *);
+  Cs1                     = args->Cs1;
+  Cs2                     = args->Cs2;
+  D1                      = args->D1;
+  D2                      = args->D2;
+  T1_old                  = args->T1_old;
+  T2                      = args->T2;
+  Ts_old                  = args->Ts_old;
+  Told_node               = args->Told_node;
+  bubble                  = args->bubble;
+  dp                      = args->dp;
+  expt                    = args->expt;
+  ice0                    = args->ice0;
+  kappa1                  = args->kappa1;
+  kappa2                  = args->kappa2;
+  max_moist               = args->max_moist;
+  moist                   = args->moist;
+
+  root                    = args->root;
+  CanopLayerBnd           = args->CanopLayerBnd;
 
   /* meteorological forcing terms */
-  UnderStory              = (int) va_arg(ap, int);
-  overstory               = (int) va_arg(ap, int);
-
-  NetShortBare            = (double) va_arg(ap, double);
-  NetShortGrnd            = (double) va_arg(ap, double);
-  NetShortSnow            = (double) va_arg(ap, double);
-  Tair                    = (double) va_arg(ap, double);
-  atmos_density           = (double) va_arg(ap, double);
-  atmos_pressure          = (double) va_arg(ap, double);
-  emissivity              = (double) va_arg(ap, double);
-  LongBareIn              = (double) va_arg(ap, double);
-  LongSnowIn              = (double) va_arg(ap, double);
-  surf_atten              = (double) va_arg(ap, double);
-  vp                      = (double) va_arg(ap, double);
-  vpd                     = (double) va_arg(ap, double);
-  shortwave               = (double) va_arg(ap, double);
-  Catm                    = (double) va_arg(ap, double);
-  dryFrac                 = (double *) va_arg(ap, double *);
-
-  Wdew                    = (double *) va_arg(ap, double *);
-  displacement            = (double *) va_arg(ap, double *);
-  ra                      = (double *) va_arg(ap, double *);
-  Ra_used                 = (double *) va_arg(ap, double *);
-  rainfall                = (double) va_arg(ap, double);
-  ref_height              = (double *) va_arg(ap, double *);
-  roughness               = (double *) va_arg(ap, double *);
-  wind                    = (double *) va_arg(ap, double *);
+  UnderStory              = args->UnderStory;
+  overstory               = args->overstory;
+
+  NetShortBare            = args->NetShortBare;
+  NetShortGrnd            = args->NetShortGrnd;
+  NetShortSnow            = args->NetShortSnow;
+  Tair                    = args->Tair;
+  atmos_density           = args->atmos_density;
+  atmos_pressure          = args->atmos_pressure;
+  emissivity              = args->emissivity;
+  LongBareIn              = args->LongBareIn;
+  LongSnowIn              = args->LongSnowIn;
+  surf_atten              = args->surf_atten;
+  vp                      = args->vp;
+  vpd                     = args->vpd;
+  shortwave               = args->shortwave;
+  Catm                    = args->Catm;
+  dryFrac                 = args->dryFrac;
+
+  Wdew                    = args->Wdew;
+  displacement            = args->displacement;
+  ra                      = args->ra;
+  Ra_used                 = args->Ra_used;
+  rainfall                = args->rainfall;
+  ref_height              = args->ref_height;
+  roughness               = args->roughness;
+  wind                    = args->wind;
 
   /* latent heat terms */
-  Le                      = (double) va_arg(ap, double);
+  Le                      = args->Le;
 
   /* snowpack terms */
-  Advection               = (double) va_arg(ap, double);
-  OldTSurf                = (double) va_arg(ap, double);
-  TPack                   = (double) va_arg(ap, double);
-  Tsnow_surf              = (double) va_arg(ap, double);
-  kappa_snow              = (double) va_arg(ap, double);
-  melt_energy             = (double) va_arg(ap, double);
-  snow_coverage           = (double) va_arg(ap, double);
-  snow_density            = (double) va_arg(ap, double);
-  snow_swq                = (double) va_arg(ap, double);
-  snow_water              = (double) va_arg(ap, double);
+  Advection               = args->Advection;
+  OldTSurf                = args->OldTSurf;
+  TPack                   = args->TPack;
+  Tsnow_surf              = args->Tsnow_surf;
+  kappa_snow              = args->kappa_snow;
+  melt_energy             = args->melt_energy;
+  snow_coverage           = args->snow_coverage;
+  snow_density            = args->snow_density;
+  snow_swq                = args->snow_swq;
+  snow_water              = args->snow_water;
     
-  deltaCC                 = (double *) va_arg(ap, double *);
-  refreeze_energy         = (double *) va_arg(ap, double *);
-  vapor_flux              = (double *) va_arg(ap, double *);
-  blowing_flux            = (double *) va_arg(ap, double *);
-  surface_flux            = (double *) va_arg(ap, double *);
+  deltaCC                 = args->deltaCC;
+  refreeze_energy         = args->refreeze_energy;
+  vapor_flux              = args->vapor_flux;
+  blowing_flux            = args->blowing_flux;
+  surface_flux            = args->surface_flux;
 
   /* soil node terms */
-  Nnodes                  = (int) va_arg(ap, int);
-
-  Cs_node                 = (double *) va_arg(ap, double *);
-  T_node                  = (double *) va_arg(ap, double *);
-  Tnew_node               = (double *) va_arg(ap, double *);
-  Tnew_fbflag             = (char *) va_arg(ap, char *);
-  Tnew_fbcount            = (int *) va_arg(ap, int *);
-  alpha                   = (double *) va_arg(ap, double *);
-  beta                    = (double *) va_arg(ap, double *);
-  bubble_node             = (double *) va_arg(ap, double *);
-  Zsum_node               = (double *) va_arg(ap, double *);
-  expt_node               = (double *) va_arg(ap, double *);
-  gamma                   = (double *) va_arg(ap, double *);
-  ice_node                = (double *) va_arg(ap, double *);
-  kappa_node              = (double *) va_arg(ap, double *);
-  max_moist_node          = (double *) va_arg(ap, double *);
-  moist_node              = (double *) va_arg(ap, double *);
+  Nnodes                  = args->Nnodes;
+
+  Cs_node                 = args->Cs_node;
+  T_node                  = args->T_node;
+  Tnew_node               = args->Tnew_node;
+  Tnew_fbflag             = args->Tnew_fbflag;
+  Tnew_fbcount            = args->Tnew_fbcount;
+  alpha                   = args->alpha;
+  beta                    = args->beta;
+  bubble_node             = args->bubble_node;
+  Zsum_node               = args->Zsum_node;
+  expt_node               = args->expt_node;
+  gamma                   = args->gamma;
+  ice_node                = args->ice_node;
+  kappa_node              = args->kappa_node;
+  max_moist_node          = args->max_moist_node;
+  moist_node              = args->moist_node;
 
   /* model structures */
-  soil_con                = (soil_con_struct *) va_arg(ap, soil_con_struct *);
-  layer               = (layer_data_struct *) va_arg(ap, layer_data_struct *);
-  veg_var             = (veg_var_struct *) va_arg(ap, veg_var_struct *);
+  soil_con                = args->soil_con;
+  layer               = args->layer;
+  veg_var             = args->veg_var;
 
   /* control flags */
-  INCLUDE_SNOW            = (int) va_arg(ap, int);
-  NOFLUX                  = (int) va_arg(ap, int);
-  EXP_TRANS               = (int) va_arg(ap, int);
-  SNOWING                 = (int) va_arg(ap, int);
+  INCLUDE_SNOW            = args->INCLUDE_SNOW;
+  NOFLUX                  = args->NOFLUX;
+  EXP_TRANS               = args->EXP_TRANS;
+  IMPLICIT                = args->IMPLICIT;
+  SNOWING                 = args->SNOWING;
 
-  FIRST_SOLN              = (int *) va_arg(ap, int *);
+  FIRST_SOLN              = args->FIRST_SOLN;
 
   /* returned energy balance terms */
-  NetLongBare             = (double *) va_arg(ap, double *);
-  NetLongSnow             = (double *) va_arg(ap, double *);
-  T1                      = (double *) va_arg(ap, double *);
-  deltaH                  = (double *) va_arg(ap, double *);
-  fusion                  = (double *) va_arg(ap, double *);
-  grnd_flux               = (double *) va_arg(ap, double *);
-  latent_heat             = (double *) va_arg(ap, double *);
-  latent_heat_sub         = (double *) va_arg(ap, double *);
-  sensible_heat           = (double *) va_arg(ap, double *);
-  snow_flux               = (double *) va_arg(ap, double *);
-  store_error             = (double *) va_arg(ap, double *);
+  NetLongBare             = args->NetLongBare;
+  NetLongSnow             = args->NetLongSnow;
+  T1                      = args->T1;
+  deltaH                  = args->deltaH;
+  fusion                  = args->fusion;
+  grnd_flux               = args->grnd_flux;
+  latent_heat             = args->latent_heat;
+  latent_heat_sub         = args->latent_heat_sub;
+  sensible_heat           = args->sensible_heat;
+  snow_flux               = args->snow_flux;
+  store_error             = args->store_error;
 
   /* take additional variables from soil_con structure */
   b_infilt = soil_con->b_infilt;
@@ -463,8 +473,8 @@ double func_surf_energy_bal(double Ts, va_list ap)
   TMean = Ts;
   Tmp = TMean + KELVIN;
 
-  transp = (double *) calloc(options.Nlayer,sizeof(double));
-  for (i=0; i<options.Nlayer; i++) {
+  transp = (double *) calloc(OPT_Nlayer,sizeof(double));
+  for (i=0; i<OPT_Nlayer; i++) {
     transp[i] = 0;
   }
 
@@ -491,7 +501,7 @@ double func_surf_energy_bal(double Ts, va_list ap)
     Estimate soil temperatures for ground heat flux calculations
   ***************************************************************/
 
-  if ( options.QUICK_FLUX ) {
+  if ( OPT_QUICK_FLUX ) {
     /**************************************************************
       Use Liang et al. 1999 Equations to Calculate Ground Heat Flux
       NOTE: T2 is not the temperature of layer 2, nor of node 2, nor at depth dp;
@@ -520,7 +530,7 @@ double func_surf_energy_bal(double Ts, va_list ap)
     T_node[0] = TMean;
       
     /* IMPLICIT Solution */
-    if(options.IMPLICIT) {
+    if(IMPLICIT) {
       Error = solve_T_profile_implicit(Tnew_node, T_node, Tnew_fbflag, Tnew_fbcount, Zsum_node, kappa_node, Cs_node, 
 				       moist_node, delta_t, max_moist_node, bubble_node, expt_node, 
 				       ice_node, alpha, beta, gamma, dp, Nnodes, 
@@ -542,8 +552,8 @@ double func_surf_energy_bal(double Ts, va_list ap)
     }
 
     /* EXPLICIT Solution, or if IMPLICIT Solution Failed */
-    if(!options.IMPLICIT || Error == 1) {
-      if(options.IMPLICIT)
+    if(!IMPLICIT || Error == 1) {
+      if(IMPLICIT)
         FIRST_SOLN[0] = TRUE;
       Error = solve_T_profile(Tnew_node, T_node, Tnew_fbflag, Tnew_fbcount, Zsum_node, kappa_node, Cs_node, 
 			      moist_node, delta_t, max_moist_node, bubble_node, 
@@ -609,7 +619,7 @@ double func_surf_energy_bal(double Ts, va_list ap)
   /******************************************************
     Compute the change in heat due to solid-liquid phase changes in the region between layers 0 and 1
   ******************************************************/
-  if (FS_ACTIVE && options.FROZEN_SOIL) {
+  if (FS_ACTIVE && OPT_FROZEN_SOIL) {
 
     if (!options.EXP_TRANS) {
       if((TMean+ *T1)/2.<0.) {
@@ -705,7 +715,7 @@ double func_surf_energy_bal(double Ts, va_list ap)
 		       elevation, rainfall, depth, Wmax, Wcr, Wpwp, frost_fract,
 		       root, dryFrac, shortwave, Catm, CanopLayerBnd);
     if (veg_var->vegcover < 1) {
-      for (i=0; i<options.Nlayer; i++) {
+      for (i=0; i<OPT_Nlayer; i++) {
         transp[i] = layer[i].evap;
         layer[i].evap = 0;
       }
@@ -724,7 +734,7 @@ double func_surf_energy_bal(double Ts, va_list ap)
 		       depth[0], max_moist * depth[0] * 1000., 
 		       elevation, b_infilt, Ra_bare[0], delta_t, 
 		       resid_moist[0], frost_fract);
-      for (i=0; i<options.Nlayer; i++) {
+      for (i=0; i<OPT_Nlayer; i++) {
         layer[i].evap = veg_var->vegcover*transp[i] + (1-veg_var->vegcover)*layer[i].evap;
         if (layer[i].evap > 0)
           layer[i].bare_evap_frac = 1 - (veg_var->vegcover*transp[i])/layer[i].evap;
@@ -736,7 +746,7 @@ double func_surf_energy_bal(double Ts, va_list ap)
       veg_var->Wdew *= veg_var->vegcover;
     }
     else {
-      for (i=0; i<options.Nlayer; i++) {
+      for (i=0; i<OPT_Nlayer; i++) {
         layer[i].bare_evap_frac = 0;
       }
     }
@@ -746,7 +756,7 @@ double func_surf_energy_bal(double Ts, va_list ap)
 		     depth[0], max_moist * depth[0] * 1000., 
 		     elevation, b_infilt, Ra_used[0], delta_t, 
 		     resid_moist[0], frost_fract);
-    for (i=0; i<options.Nlayer; i++) {
+    for (i=0; i<OPT_Nlayer; i++) {
       layer[i].bare_evap_frac = 1;
     }
   }
@@ -5,6 +5,14 @@
  
 static char vcid[] = "$Id$";
 
+/* Aborts if the global file sets an option that this build fixes at
+   compile time (see OPT_<name> in vicNl_def.h) to another value */
+#define CHECK_FIXED(NAME) \
+  if (options.NAME != FIXED_##NAME) { \
+    sprintf(ErrStr,"Global file sets " #NAME " to %d but this model was built with " #NAME " fixed to %d.  Use the generic model (make model) or a build specialized for this configuration.",(int)options.NAME,(int)FIXED_##NAME); \
+    nrerror(ErrStr); \
+  }
+
 /********************************************************************/
 /*			GLOBAL VARIABLES                            */
 /********************************************************************/
@@ -117,6 +125,17 @@ global_param_struct get_global_param(filenames_struct *names,
   2014-Mar-28 Removed DIST_PRCP option.				                TJB
   2014-Apr-25 Changed LAI_FROM_* to FROM_*; added ALB_SRC.			TJB
   2014-Apr-25 Added VEGCOVER_SRC.						TJB
+  2026-Oct-18 Added ROOT_WARMSTART.
+  2026-Oct-18 Added ROOT_STATS.
+  2026-Oct-18 Added IMPLICIT_FB.
+  2026-Oct-18 Added CROPFRAC_COLLAPSE.
+  2026-Oct-18 Added CHECKPOINT and INIT_CHECKPOINT.
+  2026-Oct-18 Added SINGLE_OUTFILE; COMPRESS can be ZLIB.
+  2026-Oct-18 Added FORCE_CACHE.
+  2026-Oct-18 Added ADAPT_SNOW_STEP.
+  2026-Oct-18 Added BLOWING_TABLE.
+  2026-Oct-18 Specialized builds reject global files that set an
+	      option differently from the build (see FIXED_<name>).
 **********************************************************************/
 {
   extern option_struct    options;
@@ -176,6 +195,9 @@ global_param_struct get_global_param(filenames_struct *names,
   file_num             = 0;
   global.skipyear      = 0;
   strcpy(names->init_state,   "MISSING");
+  strcpy(names->blowing_table, "MISSING");
+  strcpy(names->checkpoint,   "MISSING");
+  strcpy(names->init_checkpoint, "MISSING");
   global.stateyear     = MISSING;
   global.statemonth    = MISSING;
   global.stateday      = MISSING;
@@ -219,6 +241,11 @@ global_param_struct get_global_param(filenames_struct *names,
       else if(strcasecmp("SNOW_STEP",optstr)==0) {
 	sscanf(cmdstr,"%*s %d",&options.SNOW_STEP);
       }
+      else if(strcasecmp("ADAPT_SNOW_STEP",optstr)==0) {
+        sscanf(cmdstr,"%*s %s",flgstr);
+        if(strcasecmp("TRUE",flgstr)==0) options.ADAPT_SNOW_STEP=TRUE;
+        else options.ADAPT_SNOW_STEP = FALSE;
+      }
       else if(strcasecmp("STARTYEAR",optstr)==0) {
         sscanf(cmdstr,"%*s %d",&global.startyear);
       }
@@ -259,6 +286,7 @@ global_param_struct get_global_param(filenames_struct *names,
         else {
           options.FROZEN_SOIL = FALSE;
           options.IMPLICIT = FALSE;
+          options.IMPLICIT_FB = 0;
           options.EXP_TRANS = FALSE;
         }
       }
@@ -272,6 +300,16 @@ global_param_struct get_global_param(filenames_struct *names,
         if(strcasecmp("TRUE",flgstr)==0) options.QUICK_SOLVE=TRUE;
         else options.QUICK_SOLVE = FALSE;
       }
+      else if(strcasecmp("ROOT_WARMSTART",optstr)==0) {
+        sscanf(cmdstr,"%*s %s",flgstr);
+        if(strcasecmp("TRUE",flgstr)==0) options.ROOT_WARMSTART=TRUE;
+        else options.ROOT_WARMSTART = FALSE;
+      }
+      else if(strcasecmp("ROOT_STATS",optstr)==0) {
+        sscanf(cmdstr,"%*s %s",flgstr);
+        if(strcasecmp("TRUE",flgstr)==0) options.ROOT_STATS=TRUE;
+        else options.ROOT_STATS = FALSE;
+      }
       else if( (strcasecmp("NOFLUX",optstr)==0) || (strcasecmp("NO_FLUX",optstr)==0) ) {
         sscanf(cmdstr,"%*s %s",flgstr);
         if(strcasecmp("TRUE",flgstr)==0) options.NOFLUX=TRUE;
@@ -282,6 +320,9 @@ global_param_struct get_global_param(filenames_struct *names,
         if(strcasecmp("TRUE",flgstr)==0) options.IMPLICIT=TRUE;
         else options.IMPLICIT = FALSE;
       }
+      else if(strcasecmp("IMPLICIT_FB",optstr)==0) {
+        sscanf(cmdstr,"%*s %d",&options.IMPLICIT_FB);
+      }
       else if(strcasecmp("EXP_TRANS",optstr)==0) {
         sscanf(cmdstr,"%*s %s",flgstr);
         if(strcasecmp("TRUE",flgstr)==0) options.EXP_TRANS=TRUE;
@@ -297,6 +338,14 @@ global_param_struct get_global_param(filenames_struct *names,
         if(strcasecmp("TRUE",flgstr)==0) options.BLOWING=TRUE;
         else options.BLOWING = FALSE;
       }
+      else if(strcasecmp("BLOWING_TABLE",optstr)==0) {
+        sscanf(cmdstr,"%*s %s",flgstr);
+        if(strcasecmp("FALSE",flgstr)==0) options.BLOWING_TABLE=FALSE;
+        else {
+	  options.BLOWING_TABLE = TRUE;
+	  if(strcasecmp("TRUE",flgstr)!=0) strcpy(names->blowing_table,flgstr);
+	}
+      }
       else if(strcasecmp("CORRPREC",optstr)==0) {
         sscanf(cmdstr,"%*s %s",flgstr);
         if(strcasecmp("TRUE",flgstr)==0) options.CORRPREC=TRUE;
@@ -433,6 +482,11 @@ global_param_struct get_global_param(filenames_struct *names,
         if(strcasecmp("TRUE",flgstr)==0) options.CROPFRAC=TRUE;
         else options.CROPFRAC = FALSE;
       }
+      else if(strcasecmp("CROPFRAC_COLLAPSE",optstr)==0) {
+        sscanf(cmdstr,"%*s %s",flgstr);
+        if(strcasecmp("TRUE",flgstr)==0) options.CROPFRAC_COLLAPSE=TRUE;
+        else options.CROPFRAC_COLLAPSE = FALSE;
+      }
       else if(strcasecmp("IRRIGATION",optstr)==0) {
         sscanf(cmdstr,"%*s %s",flgstr);
         if(strcasecmp("TRUE",flgstr)==0) options.IRRIGATION=TRUE;
@@ -467,6 +521,22 @@ global_param_struct get_global_param(filenames_struct *names,
       else if(strcasecmp("STATEDAY",optstr)==0) {
         sscanf(cmdstr,"%*s %d",&global.stateday);
       }
+      else if(strcasecmp("INIT_CHECKPOINT",optstr)==0) {
+        sscanf(cmdstr,"%*s %s",flgstr);
+        if(strcasecmp("FALSE",flgstr)==0) options.INIT_CHECKPOINT=FALSE;
+        else {
+	  options.INIT_CHECKPOINT = TRUE;
+	  strcpy(names->init_checkpoint,flgstr);
+	}
+      }
+      else if(strcasecmp("CHECKPOINT",optstr)==0) {
+        sscanf(cmdstr,"%*s %s",flgstr);
+        if(strcasecmp("FALSE",flgstr)==0) options.SAVE_CHECKPOINT=FALSE;
+        else {
+	  options.SAVE_CHECKPOINT = TRUE;
+	  strcpy(names->checkpoint,flgstr);
+	}
+      }
       else if(strcasecmp("BINARY_STATE_FILE",optstr)==0) {
         sscanf(cmdstr,"%*s %s",flgstr);
         if(strcasecmp("FALSE",flgstr)==0) options.BINARY_STATE_FILE=FALSE;
@@ -550,6 +620,14 @@ global_param_struct get_global_param(filenames_struct *names,
         if(strcasecmp("TRUE",flgstr)==0) options.ALMA_INPUT=TRUE;
         else options.ALMA_INPUT = FALSE;
       }
+      else if(strcasecmp("FORCE_CACHE",optstr)==0) {
+        sscanf(cmdstr,"%*s %s",flgstr);
+        if(strcasecmp("FALSE",flgstr)==0) options.FORCE_CACHE=FALSE;
+        else {
+	  options.FORCE_CACHE = TRUE;
+	  strcpy(param_set.FORCE_CACHE_PFX,flgstr);
+	}
+      }
 
       /*************************************
        Define parameter files
@@ -712,7 +790,15 @@ global_param_struct get_global_param(filenames_struct *names,
       }
       else if(strcasecmp("COMPRESS",optstr)==0) {
         sscanf(cmdstr,"%*s %s",flgstr);
-        if(strcasecmp("TRUE",flgstr)==0) options.COMPRESS=TRUE;
+        if(strcasecmp("TRUE",flgstr)==0) options.COMPRESS=COMPRESS_GZIP;
+        else if(strcasecmp("ZLIB",flgstr)==0) {
+#if VIC_ZLIB
+          options.COMPRESS=COMPRESS_ZLIB;
+#else
+          fprintf(stderr,"WARNING: COMPRESS ZLIB needs a model built with VIC_ZLIB (see Makefile); files are compressed with gzip instead.\n");
+          options.COMPRESS=COMPRESS_GZIP;
+#endif
+        }
         else options.COMPRESS = FALSE;
       }
       else if(strcasecmp("BINARY_OUTPUT",optstr)==0) {
@@ -740,6 +826,11 @@ global_param_struct get_global_param(filenames_struct *names,
         if(strcasecmp("TRUE",flgstr)==0) options.PRT_HEADER=TRUE;
         else options.PRT_HEADER = FALSE;
       }
+      else if(strcasecmp("SINGLE_OUTFILE",optstr)==0) {
+        sscanf(cmdstr,"%*s %s",flgstr);
+        if(strcasecmp("TRUE",flgstr)==0) options.SINGLE_OUTFILE=TRUE;
+        else options.SINGLE_OUTFILE = FALSE;
+      }
       else if(strcasecmp("PRT_SNOW_BAND",optstr)==0) {
         sscanf(cmdstr,"%*s %s",flgstr);
         if(strcasecmp("TRUE",flgstr)==0) options.PRT_SNOW_BAND=TRUE;
@@ -1006,14 +1097,27 @@ global_param_struct get_global_param(filenames_struct *names,
       nrerror(ErrStr);
   }
 
+  // Validate the checkpoint file information; checkpoints are taken
+  // at the state date
+  if( options.SAVE_CHECKPOINT ) {
+    if ( global.stateyear == MISSING || global.statemonth == MISSING || global.stateday == MISSING )  {
+      snprintf(ErrStr,MAXSTRING,"Incomplete specification of the date to write checkpoint file (%.1024s).\nSpecified date (yyyy-mm-dd): %04d-%02d-%02d\nMake sure STATEYEAR, STATEMONTH, and STATEDAY are set correctly in your global parameter file.\n", names->checkpoint, global.stateyear, global.statemonth, global.stateday);
+      nrerror(ErrStr);
+    }
+    if ( options.INIT_CHECKPOINT && strcmp( names->init_checkpoint, names->checkpoint ) == 0 ) {
+      snprintf(ErrStr,MAXSTRING,"The output checkpoint file (%.1024s) has the same name as the input checkpoint file.", names->checkpoint);
+      nrerror(ErrStr);
+    }
+  }
+
   // Validate soil parameter/simulation mode combinations
   if(options.QUICK_FLUX) {
     if(options.Nnode != 3) {
       fprintf(stderr,"WARNING: To run the model QUICK_FLUX=TRUE, you must define exactly 3 soil thermal nodes.  Currently Nnodes is set to %d.  Setting Nnodes to 3.\n",options.Nnode);
       options.Nnode = 3;
     }
-    if(options.IMPLICIT || options.EXP_TRANS) {
-      sprintf(ErrStr,"To run the model with QUICK_FLUX=TRUE, you cannot have IMPLICIT=TRUE or EXP_TRANS=TRUE.");
+    if(options.IMPLICIT || options.IMPLICIT_FB > 0 || options.EXP_TRANS) {
+      sprintf(ErrStr,"To run the model with QUICK_FLUX=TRUE, you cannot have IMPLICIT=TRUE, IMPLICIT_FB > 0 or EXP_TRANS=TRUE.");
       nrerror(ErrStr);
     }
   }
@@ -1050,6 +1154,36 @@ global_param_struct get_global_param(filenames_struct *names,
     sprintf(ErrStr,"Global file wants more soil thermal nodes (%d) than are defined by MAX_NODES (%d).  Edit vicNl_def.h and recompile.",options.Nnode,MAX_NODES);
     nrerror(ErrStr);
   }
+#ifdef FIXED_FULL_ENERGY
+  CHECK_FIXED(FULL_ENERGY)
+#endif
+#ifdef FIXED_FROZEN_SOIL
+  CHECK_FIXED(FROZEN_SOIL)
+#endif
+#ifdef FIXED_QUICK_FLUX
+  CHECK_FIXED(QUICK_FLUX)
+#endif
+#ifdef FIXED_LAKES
+  CHECK_FIXED(LAKES)
+#endif
+#ifdef FIXED_CARBON
+  CHECK_FIXED(CARBON)
+#endif
+#ifdef FIXED_IRRIGATION
+  CHECK_FIXED(IRRIGATION)
+#endif
+#ifdef FIXED_CROPFRAC
+  CHECK_FIXED(CROPFRAC)
+#endif
+#ifdef FIXED_SNOW_BAND
+  CHECK_FIXED(SNOW_BAND)
+#endif
+#ifdef FIXED_Nlayer
+  CHECK_FIXED(Nlayer)
+#endif
+#ifdef FIXED_Nnode
+  CHECK_FIXED(Nnode)
+#endif
   if(!options.FULL_ENERGY && options.CLOSE_ENERGY) {
     sprintf(ErrStr,"CLOSE_ENERGY is TRUE but FULL_ENERGY is FALSE. Set FULL_ENERGY to TRUE to run CLOSE_ENERGY, or set CLOSE_ENERGY to FALSE.");
     nrerror(ErrStr);
@@ -14,7 +14,6 @@
  * COMMENTS:     
  */
 
-#include <stdarg.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <vicNl.h>
@@ -116,6 +115,11 @@ static char vcid[] = "$Id$";
 	      and clarified the descriptions of the SPATIAL_SNOW
 	      option.								TJB
   2013-Dec-27 Moved SPATIAL_SNOW from compile-time to run-time options.	TJB
+  2026-Oct-18 Pass the arguments of IceEnergyBalance() to root_brent() in an
+	      argument structure; removed CalcIcePackEnergyBalance() and
+	      ErrorIcePackEnergyBalance().
+  2026-Oct-18 Solve for the surface temperature with root_brent_warm(),
+	      starting from the previous surface temperature.
 *****************************************************************************/
 int ice_melt(double            z2,
 	      double            aero_resist,
@@ -194,6 +198,8 @@ int ice_melt(double            z2,
 
   char ErrorString[MAXSTRING];
 
+  ice_energy_bal_args_struct args;
+
   SnowFall = snowfall / 1000.; /* convert to m */
   RainFall = rainfall / 1000.; /* convert to m */
   IceMelt = 0.0;
@@ -296,19 +302,47 @@ int ice_melt(double            z2,
   blowing_flux = snow->blowing_flux;
   surface_flux = snow->surface_flux;
 
+  /* Set the arguments of the ice pack energy balance */
+  args.Dt                 = (double)delta_t;
+  args.Ra                 = aero_resist;
+  args.Ra_used            = aero_resist_used;
+  args.Z                  = z2;
+  args.Displacement       = displacement;
+  args.Z0                 = Z0;
+  args.Wind               = wind;
+  args.ShortRad           = net_short;
+  args.LongRadIn          = longwave;
+  args.AirDens            = density;
+  args.Lv                 = Le;
+  args.Tair               = air_temp;
+  args.Press              = pressure * 1000.;
+  args.Vpd                = vpd * 1000.;
+  args.EactAir            = vp * 1000.;
+  args.Rain               = RainFall;
+  args.SweSurfaceLayer    = SurfaceSwq;
+  args.SurfaceLiquidWater = snow->surf_water;
+  args.OldTSurf           = OldTSurf;
+  args.RefreezeEnergy     = &RefreezeEnergy;
+  args.vapor_flux         = &vapor_flux;
+  args.blowing_flux       = &blowing_flux;
+  args.surface_flux       = &surface_flux;
+  args.AdvectedEnergy     = &advection;
+  args.DeltaColdContent   = deltaCC;
+  args.Tfreeze            = Tcutoff;
+  args.AvgCond            = avgcond;
+  args.SWconducted        = SWconducted;
+  args.SnowDepth          = snow->swq*RHO_W/RHOSNOW;
+  args.SnowDensity        = RHOSNOW;
+  args.SurfAttenuation    = surf_atten;
+  args.qf                 = &SnowFlux;
+  args.LatentHeat         = &latent_heat;
+  args.LatentHeatSub      = &latent_heat_sub;
+  args.SensibleHeat       = &sensible_heat;
+  args.LongRadOut         = &LWnet;
+
   /* Calculate the surface energy balance for snow_temp = 0.0 */
 
-  Qnet = CalcIcePackEnergyBalance((double)0.0, (double)delta_t, aero_resist,
-				  aero_resist_used, z2, displacement, Z0, wind, net_short, 
-				  longwave, density, Le, air_temp,
-				  pressure * 1000., vpd * 1000., vp * 1000.,
-				  RainFall, SurfaceSwq, 
-				  snow->surf_water, OldTSurf, &RefreezeEnergy,
-				  &vapor_flux, &blowing_flux, &surface_flux,
-				  &advection, deltaCC, Tcutoff, avgcond, 
-				  SWconducted, snow->swq*RHO_W/RHOSNOW, 
-				  RHOSNOW, surf_atten, &SnowFlux, 
-				  &latent_heat, &latent_heat_sub, &sensible_heat, &LWnet);
+  Qnet = IceEnergyBalance((double)0.0, &args);
 
   snow->vapor_flux = vapor_flux;
   snow->surface_flux = surface_flux;
@@ -417,21 +451,10 @@ int ice_melt(double            z2,
   else  {
     /* Calculate surface layer temperature using "Brent method" */
     if (SurfaceSwq > MIN_SWQ_EB_THRES) {
-      snow->surf_temp = root_brent((double)(snow->surf_temp-SNOW_DT), 
-				   (double)(snow->surf_temp+SNOW_DT), ErrorString,
-				   IceEnergyBalance, (double)delta_t, 
-				   aero_resist, aero_resist_used, z2, 
-				   displacement, Z0, wind, net_short, longwave,
-				   density, Le, air_temp, pressure * 1000.,
-				   vpd * 1000., vp * 1000., RainFall, 
-				   SurfaceSwq,
-				   snow->surf_water, OldTSurf, &RefreezeEnergy, 
-				   &vapor_flux, &blowing_flux, &surface_flux,
-				   &advection, deltaCC, Tcutoff, 
-				   avgcond, SWconducted,
-				   snow->swq*RHO_W/RHOSNOW,
-				   RHOSNOW,surf_atten,&SnowFlux,
-				   &latent_heat, &latent_heat_sub, &sensible_heat, &LWnet);
+      snow->surf_temp = root_brent_warm(ROOT_ICE, snow->surf_temp,
+					(double)(snow->surf_temp-SNOW_DT), 
+					(double)(snow->surf_temp+SNOW_DT),
+					ErrorString, IceEnergyBalance, &args);
 
       if (snow->surf_temp <= -998) {
         if (options.TFALLBACK) {
@@ -440,18 +463,7 @@ int ice_melt(double            z2,
           snow->surf_temp_fbcount++;
         }
         else {
-          ErrorIcePackEnergyBalance(snow->surf_temp, (double)delta_t, aero_resist,
-				    aero_resist_used, z2, displacement, Z0, wind, net_short,
-				    longwave, density, Le, air_temp,
-				    pressure * 1000., vpd * 1000., vp * 1000.,
-				    RainFall, SurfaceSwq, 
-				    snow->surf_water, OldTSurf, &RefreezeEnergy,
-				    &vapor_flux, &blowing_flux, &surface_flux,
-				    &advection, deltaCC, Tcutoff, 
-				    avgcond, SWconducted,		
-				    snow->swq*RHO_W/RHOSNOW, RHOSNOW,surf_atten,
-				    &SnowFlux, &latent_heat, &latent_heat_sub,
-				    &sensible_heat, &LWnet, ErrorString);
+          ErrorPrintIcePackEnergyBalance(snow->surf_temp, &args, ErrorString);
           return( ERROR );
         }
       }
@@ -461,17 +473,7 @@ int ice_melt(double            z2,
       snow->surf_temp = 999;
     }
     if (snow->surf_temp > -998 && snow->surf_temp < 999) {
-      Qnet = CalcIcePackEnergyBalance(snow->surf_temp, (double)delta_t, aero_resist,
-				      aero_resist_used, z2, displacement, Z0, wind, net_short,
-				      longwave, density, Le, air_temp,
-				      pressure * 1000., vpd * 1000., 
-				      vp * 1000.,RainFall, SurfaceSwq, 
-				      snow->surf_water, OldTSurf, &RefreezeEnergy, 
-				      &vapor_flux, &blowing_flux, &surface_flux,
-				      &advection, deltaCC, Tcutoff, 
-				      avgcond, SWconducted, snow->swq*RHO_W/RHOSNOW, 
-				      RHOSNOW,surf_atten, &SnowFlux, &latent_heat,
-				      &latent_heat_sub, &sensible_heat, &LWnet);
+      Qnet = IceEnergyBalance(snow->surf_temp, &args);
 
       snow->vapor_flux = vapor_flux;
       snow->surface_flux = surface_flux;
@@ -664,54 +666,9 @@ int ice_melt(double            z2,
 
 }
 
-/*****************************************************************************
-  Function name: CalcIcePackEnergyBalance()
-
-  Purpose      : Dummy function to make a direct call to
-                 IceEnergyBalance() possible.
-
-  Required     : 
-    double TSurf - IcePack surface temperature (C)
-    other arguments required by IcePackEnergyBalance()
-
-  Returns      :
-    double Qnet - Net energy exchange at the IcePack snow surface (W/m^2)
-
-  Modifies     : none
-
-  Comments     : function is local to this module
-*****************************************************************************/
-double CalcIcePackEnergyBalance(double Tsurf, ...)
-{
-
-  va_list ap;                   /* Used in traversing variable argument list
-                                 */ 
-  double Qnet;                   /* Net energy exchange at the IcePack snow
-                                   surface (W/m^2) */
-
-  va_start(ap, Tsurf);
-  Qnet = IceEnergyBalance(Tsurf, ap);
-  va_end(ap);
-  
-  return Qnet;
-}
-
-double ErrorIcePackEnergyBalance(double Tsurf, ...)
-{
-
-  va_list ap;                   /* Used in traversing variable argument list
-                                 */ 
-  double Qnet;                   /* Net energy exchange at the IcePack snow
-                                   surface (W/m^2) */
-
-  va_start(ap, Tsurf);
-  Qnet = ErrorPrintIcePackEnergyBalance(Tsurf, ap);
-  va_end(ap);
-  
-  return Qnet;
-}
-
-double ErrorPrintIcePackEnergyBalance(double TSurf, va_list ap)
+double ErrorPrintIcePackEnergyBalance(double TSurf,
+				      ice_energy_bal_args_struct *args,
+				      char *ErrorString)
 {
 
 
@@ -753,53 +710,51 @@ double ErrorPrintIcePackEnergyBalance(double TSurf, va_list ap)
   double SnowDensity; 
   double SurfAttenuation; 
   
-  /* end of list of arguments in variable argument list */
+  /* end of list of variables read from the argument structure */
   double *GroundFlux;
   double *LatentHeat;		/* Latent heat exchange at surface (W/m2) */
   double *LatentHeatSub;	/* Latent heat exchange at surface (W/m2) due to sublimation */
   double *SensibleHeat;		/* Sensible heat exchange at surface (W/m2) */
   double *LWnet;
 
-  char *ErrorString;
 
   /* initialize variables */
-  Dt                 = (double) va_arg(ap, double);
-  Ra                 = (double) va_arg(ap, double);
-  Ra_used            = (double *) va_arg(ap, double *);
-  Z                  = (double) va_arg(ap, double);
-  Displacement       = (double) va_arg(ap, double);
-  Z0                 = (double) va_arg(ap, double);
-  Wind               = (double) va_arg(ap, double);
-  ShortRad           = (double) va_arg(ap, double);
-  LongRadIn          = (double) va_arg(ap, double);
-  AirDens            = (double) va_arg(ap, double);
-  Lv                 = (double) va_arg(ap, double);
-  Tair               = (double) va_arg(ap, double);
-  Press              = (double) va_arg(ap, double);
-  Vpd                = (double) va_arg(ap, double);
-  EactAir            = (double) va_arg(ap, double);
-  Rain               = (double) va_arg(ap, double);
-  SweSurfaceLayer    = (double) va_arg(ap, double);
-  SurfaceLiquidWater = (double) va_arg(ap, double);
-  OldTSurf           = (double) va_arg(ap, double);
-  RefreezeEnergy     = (double *) va_arg(ap, double *);
-  vapor_flux         = (double *) va_arg(ap, double *);
-  blowing_flux       = (double *) va_arg(ap, double *);
-  surface_flux       = (double *) va_arg(ap, double *);
-  AdvectedEnergy     = (double *) va_arg(ap, double *);
-  DeltaColdContent   = (double) va_arg(ap, double);
-  Tfreeze            = (double) va_arg(ap, double);
-  AvgCond            = (double) va_arg(ap, double);
-  SWconducted        = (double) va_arg(ap, double);
-  SnowDepth          = (double) va_arg(ap, double);
-  SnowDensity        = (double) va_arg(ap, double);
-  SurfAttenuation    = (double) va_arg(ap, double);
-  GroundFlux         = (double *) va_arg(ap, double *);
-  LatentHeat         = (double *) va_arg(ap, double *);
-  LatentHeatSub      = (double *) va_arg(ap, double *);
-  SensibleHeat       = (double *) va_arg(ap, double *);
-  LWnet              = (double *) va_arg(ap, double *);
-  ErrorString        = (char *) va_arg(ap, double *);
+  Dt                 = args->Dt;
+  Ra                 = args->Ra;
+  Ra_used            = args->Ra_used;
+  Z                  = args->Z;
+  Displacement       = args->Displacement;
+  Z0                 = args->Z0;
+  Wind               = args->Wind;
+  ShortRad           = args->ShortRad;
+  LongRadIn          = args->LongRadIn;
+  AirDens            = args->AirDens;
+  Lv                 = args->Lv;
+  Tair               = args->Tair;
+  Press              = args->Press;
+  Vpd                = args->Vpd;
+  EactAir            = args->EactAir;
+  Rain               = args->Rain;
+  SweSurfaceLayer    = args->SweSurfaceLayer;
+  SurfaceLiquidWater = args->SurfaceLiquidWater;
+  OldTSurf           = args->OldTSurf;
+  RefreezeEnergy     = args->RefreezeEnergy;
+  vapor_flux         = args->vapor_flux;
+  blowing_flux       = args->blowing_flux;
+  surface_flux       = args->surface_flux;
+  AdvectedEnergy     = args->AdvectedEnergy;
+  DeltaColdContent   = args->DeltaColdContent;
+  Tfreeze            = args->Tfreeze;
+  AvgCond            = args->AvgCond;
+  SWconducted        = args->SWconducted;
+  SnowDepth          = args->SnowDepth;
+  SnowDensity        = args->SnowDensity;
+  SurfAttenuation    = args->SurfAttenuation;
+  GroundFlux         = args->qf;
+  LatentHeat         = args->LatentHeat;
+  LatentHeatSub      = args->LatentHeatSub;
+  SensibleHeat       = args->SensibleHeat;
+  LWnet              = args->LongRadOut;
   
   /* print variables */
   fprintf(stderr, "%s", ErrorString);
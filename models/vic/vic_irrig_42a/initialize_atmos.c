@@ -134,6 +134,14 @@ void initialize_atmos(atmos_data_struct        *atmos,
   2013-Dec-27 Moved OUTPUT_FORCE to options_struct.				TJB
   2014-Apr-25 Added LAI and albedo.						TJB
   2014-Apr-25 Added partial vegcover fraction.					TJB
+  2026-Oct-18 MTCLIM is called through mtclim_cached(), which reuses
+	      the estimates stored in the FORCE_CACHE files.
+  2026-Oct-18 Fixed crash with OUTPUT_FORCE TRUE, in which veg_con and
+	      veg_hist are not allocated; the veg parameter histories are
+	      now skipped in that case.  Pass dmy to write_forcing_file().
+  2026-Oct-18 Fixed the sub-daily vapor pressure from sub-daily QAIR or
+	      REL_HUMID: it used the pressure and air temperature of a
+	      stale index instead of those of the same sub-step.
 **********************************************************************/
 {
   extern option_struct       options;
@@ -145,6 +153,7 @@ void initialize_atmos(atmos_data_struct        *atmos,
   int     j;
   int     k;
   int     v;
+  int     Nveg;
   int     band;
   int     day;
   int     hour;
@@ -254,10 +263,15 @@ void initialize_atmos(atmos_data_struct        *atmos,
 //  if ( !param_set.TYPE[WIND].SUPPLIED && !(param_set.TYPE[WIND_N].SUPPLIED && param_set.TYPE[WIND_E].SUPPLIED) )
 //    nrerror("Input meteorological forcing files must contain either WIND (wind speed) or both WIND_N (north component of wind speed) and WIND_E (east component of wind speed); check input files\n");
 
-  /* Assign N_ELEM for veg-dependent forcings */
-  param_set.TYPE[LAI_IN].N_ELEM = veg_con[0].vegetat_type_num;
-  param_set.TYPE[VEGCOVER].N_ELEM = veg_con[0].vegetat_type_num;
-  param_set.TYPE[ALBEDO].N_ELEM = veg_con[0].vegetat_type_num;
+  /* Assign N_ELEM for veg-dependent forcings; with OUTPUT_FORCE the veg
+     parameters are not read and only the meteorological forcings are set */
+  if (options.OUTPUT_FORCE)
+    Nveg = 0;
+  else
+    Nveg = veg_con[0].vegetat_type_num;
+  param_set.TYPE[LAI_IN].N_ELEM = Nveg;
+  param_set.TYPE[VEGCOVER].N_ELEM = Nveg;
+  param_set.TYPE[ALBEDO].N_ELEM = Nveg;
 
   /* compute number of simulation days */
   tmp_starthour = 0;
@@ -954,9 +968,8 @@ void initialize_atmos(atmos_data_struct        *atmos,
     vp, MTCLIM will use them to compute the other variables
     more accurately.
   **************************************************/
-  mtclim_wrapper(have_dewpt, have_shortwave, hour_offset, elevation, slope,
-                   aspect, ehoriz, whoriz, annual_prec, phi, Ndays_local,
-                   dmy_local, prec, tmax, tmin, tskc, daily_vp, hourlyrad, fdir);
+  mtclim_cached(have_dewpt, have_shortwave, hour_offset, soil_con, Ndays_local,
+                dmy_local, prec, tmax, tmin, tskc, daily_vp, hourlyrad, fdir);
 
   /***********************************************************
     Shortwave, part 2.
@@ -1307,7 +1320,7 @@ void initialize_atmos(atmos_data_struct        *atmos,
           if (global_param.starthour - hour_offset_int < 0) hour += 24;
           atmos[rec].vp[i] = 0;
           for (idx = hour; idx < hour+options.SNOW_STEP; idx++) {
-            atmos[rec].vp[i] += local_forcing_data[QAIR][idx] * atmos[rec].pressure[j] / EPS;
+            atmos[rec].vp[i] += local_forcing_data[QAIR][idx] * atmos[rec].pressure[i] / EPS;
           }
           atmos[rec].vp[i] /= options.SNOW_STEP;
             sum += atmos[rec].vp[i];
@@ -1323,7 +1336,7 @@ void initialize_atmos(atmos_data_struct        *atmos,
           if (global_param.starthour - hour_offset_int < 0) hour += 24;
           atmos[rec].vp[i] = 0;
           for (idx = hour; idx < hour+options.SNOW_STEP; idx++) {
-            atmos[rec].vp[i] += local_forcing_data[REL_HUMID][idx] * svp(atmos[rec].air_temp[j]) / 100;
+            atmos[rec].vp[i] += local_forcing_data[REL_HUMID][idx] * svp(atmos[rec].air_temp[i]) / 100;
           }
           atmos[rec].vp[i] /= options.SNOW_STEP;
           sum += atmos[rec].vp[i];
@@ -1431,7 +1444,7 @@ void initialize_atmos(atmos_data_struct        *atmos,
 
   /* First, assign default climatology */
   for (rec = 0; rec < global_param.nrecs; rec++) {
-    for(v = 0; v < veg_con[0].vegetat_type_num; v++) {
+    for(v = 0; v < Nveg; v++) {
       for (j = 0; j < NF; j++) {
         veg_hist[rec][v].albedo[j] = veg_lib[veg_con[v].veg_class].albedo[dmy[rec].month-1];
       }
@@ -1442,7 +1455,7 @@ void initialize_atmos(atmos_data_struct        *atmos,
     if(param_set.FORCE_DT[param_set.TYPE[ALBEDO].SUPPLIED-1] == 24) {
       /* daily albedo provided */
       for (rec = 0; rec < global_param.nrecs; rec++) {
-        for(v = 0; v < veg_con[0].vegetat_type_num; v++) {
+        for(v = 0; v < Nveg; v++) {
           sum = 0;
           for (j = 0; j < NF; j++) {
             hour = rec*global_param.dt + j*options.SNOW_STEP + global_param.starthour - hour_offset_int;
@@ -1459,7 +1472,7 @@ void initialize_atmos(atmos_data_struct        *atmos,
     else {
       /* sub-daily albedo provided */
       for(rec = 0; rec < global_param.nrecs; rec++) {
-        for(v = 0; v < veg_con[0].vegetat_type_num; v++) {
+        for(v = 0; v < Nveg; v++) {
           sum = 0;
           for(i = 0; i < NF; i++) {
             hour = rec*global_param.dt + i*options.SNOW_STEP + global_param.starthour - hour_offset_int;
@@ -1485,7 +1498,7 @@ void initialize_atmos(atmos_data_struct        *atmos,
 
   /* First, assign default climatology */
   for (rec = 0; rec < global_param.nrecs; rec++) {
-    for(v = 0; v < veg_con[0].vegetat_type_num; v++) {
+    for(v = 0; v < Nveg; v++) {
       for (j = 0; j < NF; j++) {
         veg_hist[rec][v].LAI[j] = veg_lib[veg_con[v].veg_class].LAI[dmy[rec].month-1];
       }
@@ -1496,7 +1509,7 @@ void initialize_atmos(atmos_data_struct        *atmos,
     if(param_set.FORCE_DT[param_set.TYPE[LAI_IN].SUPPLIED-1] == 24) {
       /* daily LAI provided */
       for (rec = 0; rec < global_param.nrecs; rec++) {
-        for(v = 0; v < veg_con[0].vegetat_type_num; v++) {
+        for(v = 0; v < Nveg; v++) {
           sum = 0;
           for (j = 0; j < NF; j++) {
             hour = rec*global_param.dt + j*options.SNOW_STEP + global_param.starthour - hour_offset_int;
@@ -1513,7 +1526,7 @@ void initialize_atmos(atmos_data_struct        *atmos,
     else {
       /* sub-daily LAI provided */
       for(rec = 0; rec < global_param.nrecs; rec++) {
-        for(v = 0; v < veg_con[0].vegetat_type_num; v++) {
+        for(v = 0; v < Nveg; v++) {
           sum = 0;
           for(i = 0; i < NF; i++) {
             hour = rec*global_param.dt + i*options.SNOW_STEP + global_param.starthour - hour_offset_int;
@@ -1539,7 +1552,7 @@ void initialize_atmos(atmos_data_struct        *atmos,
 
   /* First, assign default climatology */
   for (rec = 0; rec < global_param.nrecs; rec++) {
-    for(v = 0; v < veg_con[0].vegetat_type_num; v++) {
+    for(v = 0; v < Nveg; v++) {
       for (j = 0; j < NF; j++) {
         veg_hist[rec][v].vegcover[j] = veg_lib[veg_con[v].veg_class].vegcover[dmy[rec].month-1];
       }
@@ -1550,7 +1563,7 @@ void initialize_atmos(atmos_data_struct        *atmos,
     if(param_set.FORCE_DT[param_set.TYPE[VEGCOVER].SUPPLIED-1] == 24) {
       /* daily vegcover provided */
       for (rec = 0; rec < global_param.nrecs; rec++) {
-        for(v = 0; v < veg_con[0].vegetat_type_num; v++) {
+        for(v = 0; v < Nveg; v++) {
           sum = 0;
           for (j = 0; j < NF; j++) {
             hour = rec*global_param.dt + j*options.SNOW_STEP + global_param.starthour - hour_offset_int;
@@ -1569,7 +1582,7 @@ void initialize_atmos(atmos_data_struct        *atmos,
     else {
       /* sub-daily vegcover provided */
       for(rec = 0; rec < global_param.nrecs; rec++) {
-        for(v = 0; v < veg_con[0].vegetat_type_num; v++) {
+        for(v = 0; v < Nveg; v++) {
           sum = 0;
           for(i = 0; i < NF; i++) {
             hour = rec*global_param.dt + i*options.SNOW_STEP + global_param.starthour - hour_offset_int;
@@ -1596,7 +1609,7 @@ void initialize_atmos(atmos_data_struct        *atmos,
 
   /* First, assign default climatology */
   for (rec = 0; rec < global_param.nrecs; rec++) {
-    for(v = 0; v < veg_con[0].vegetat_type_num; v++) {
+    for(v = 0; v < Nveg; v++) {
       for (j = 0; j < NF; j++) {
         veg_hist[rec][v].crop_frac[j] = veg_lib[veg_con[v].veg_class].crop_frac[dmy[rec].month-1];
       }
@@ -1607,7 +1620,7 @@ void initialize_atmos(atmos_data_struct        *atmos,
     if(param_set.FORCE_DT[param_set.TYPE[CROP_FRAC].SUPPLIED-1] == 24) {
       /* daily crop_frac provided */
       for (rec = 0; rec < global_param.nrecs; rec++) {
-        for(v = 0; v < veg_con[0].vegetat_type_num; v++) {
+        for(v = 0; v < Nveg; v++) {
           if (veg_con[v].crop_frac_active) {
             sum = 0;
             for (j = 0; j < NF; j++) {
@@ -1654,7 +1667,7 @@ void initialize_atmos(atmos_data_struct        *atmos,
 
   /* HACK: if crop, and crop frac is active, normalize vegcover by crop_frac */
   for (rec = 0; rec < global_param.nrecs; rec++) {
-    for(v = 0; v < veg_con[0].vegetat_type_num; v++) {
+    for(v = 0; v < Nveg; v++) {
       if (options.CROPFRAC && veg_con[v].crop_frac_active) {
         if (veg_hist[rec][v].crop_frac[0] > 0) {
           for (j = 0; j < NF; j++) {
@@ -1988,7 +2001,7 @@ void initialize_atmos(atmos_data_struct        *atmos,
 
     // If OUTPUT_FORCE is TRUE then the full
     // forcing data array is dumped into a new set of files.
-    write_forcing_file(atmos, global_param.nrecs, out_data_files, out_data);
+    write_forcing_file(atmos, dmy, global_param.nrecs, out_data_files, out_data);
 
   }
 
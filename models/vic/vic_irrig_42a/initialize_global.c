@@ -133,6 +133,16 @@ void initialize_global() {
   2014-Mar-28 Removed DIST_PRCP option.						TJB
   2014-Apr-25 Added LAI_SRC, VEGPARAM_ALB, and ALB_SRC options.			TJB
   2014-Apr-25 Added VEGPARAM_VEGCOVER and VEGCOVER_SRC options.			TJB
+  2026-Oct-18 Added ROOT_WARMSTART option.
+  2026-Oct-18 Added ROOT_STATS option.
+  2026-Oct-18 Added IMPLICIT_FB option.
+  2026-Oct-18 Added PET_OUT.
+  2026-Oct-18 Added CROPFRAC_COLLAPSE option.
+  2026-Oct-18 Added INIT_CHECKPOINT and SAVE_CHECKPOINT options.
+  2026-Oct-18 Added SINGLE_OUTFILE option.
+  2026-Oct-18 Added FORCE_CACHE option.
+  2026-Oct-18 Added ADAPT_SNOW_STEP option.
+  2026-Oct-18 Added BLOWING_TABLE option.
 *********************************************************************/
 
   extern option_struct options;
@@ -144,20 +154,24 @@ void initialize_global() {
 
   // simulation modes
   options.AboveTreelineVeg      = -1;
+  options.ADAPT_SNOW_STEP       = FALSE;
   options.AERO_RESIST_CANSNOW   = AR_406_FULL;
   options.BLOWING               = FALSE;
+  options.BLOWING_TABLE         = FALSE;
   options.CARBON                = FALSE;
   options.CLOSE_ENERGY          = FALSE;
   options.COMPUTE_TREELINE      = FALSE;
   options.CONTINUEONERROR       = TRUE;
   options.CORRPREC              = FALSE;
   options.CROPFRAC              = FALSE;
+  options.CROPFRAC_COLLAPSE     = FALSE;
   options.EQUAL_AREA            = FALSE;
   options.EXP_TRANS             = TRUE;
   options.FROZEN_SOIL           = FALSE;
   options.FULL_ENERGY           = FALSE;
   options.GRND_FLUX_TYPE        = GF_410;
   options.IMPLICIT              = TRUE;
+  options.IMPLICIT_FB           = 0;
   options.IRRIGATION            = FALSE;
   options.IRR_FREE              = TRUE;
   options.LAKES                 = FALSE;
@@ -175,6 +189,8 @@ void initialize_global() {
   options.QUICK_FLUX            = TRUE;
   options.QUICK_SOLVE           = FALSE;
   options.RC_MODE               = RC_JARVIS;
+  options.ROOT_WARMSTART        = FALSE;
+  options.ROOT_STATS            = FALSE;
   options.ROOT_ZONES            = MISSING;
   options.SHARE_LAYER_MOIST     = TRUE;
   options.SNOW_BAND             = 1;
@@ -189,6 +205,7 @@ void initialize_global() {
   // input options
   options.ALB_SRC               = FROM_VEGLIB;
   options.BASEFLOW              = ARNO;
+  options.FORCE_CACHE           = FALSE;
   options.GRID_DECIMAL          = 2;
   options.JULY_TAVG_SUPPLIED    = FALSE;
   options.LAI_SRC               = FROM_VEGLIB;
@@ -205,6 +222,8 @@ void initialize_global() {
   options.BINARY_STATE_FILE     = FALSE;
   options.INIT_STATE            = FALSE;
   options.SAVE_STATE            = FALSE;
+  options.INIT_CHECKPOINT       = FALSE;
+  options.SAVE_CHECKPOINT       = FALSE;
   // output options
   options.ALMA_OUTPUT           = FALSE;
   options.BINARY_OUTPUT         = FALSE;
@@ -212,7 +231,10 @@ void initialize_global() {
   options.MOISTFRACT            = FALSE;
   options.Noutfiles             = 2;
   options.OUTPUT_FORCE          = FALSE;
+  for(i=0;i<N_PET_TYPES;i++)
+    options.PET_OUT[i]          = TRUE;
   options.PRT_HEADER            = FALSE;
+  options.SINGLE_OUTFILE        = FALSE;
   options.PRT_SNOW_BAND         = FALSE;
 
   /** Initialize forcing file input controls **/
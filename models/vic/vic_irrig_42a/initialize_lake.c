@@ -161,7 +161,7 @@ int initialize_lake (lake_var_struct   *lake,
     lake->sarea_save = lake->sarea;
     status = get_volume(lake_con, lake->ldepth, &tmp_volume);
     if (status < 0) {
-      fprintf(stderr, "Error in get_volume: record = %d, depth = %f, volume = %e\n",0,depth,tmp_volume);
+      fprintf(stderr, "Error in get_volume: record = %d, depth = %f, volume = %e\n",0,lake->ldepth,tmp_volume);
       return(status);
     }
     else if (status > 0) {
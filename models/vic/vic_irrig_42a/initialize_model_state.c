@@ -125,6 +125,9 @@ int initialize_model_state(all_vars_struct     *all_vars,
 	      annual average air temperature and bottom boundary
 	      temperature.											TJB
   2014-Mar-28 Removed DIST_PRCP option.							TJB
+  2026-Oct-18 The intermediate node loop of the QUICK_FLUX=FALSE case is
+	      bounded by MAX_NODES as well, for builds with a small
+	      MAX_NODES.
 **********************************************************************/
 {
   extern option_struct options;
@@ -386,7 +389,7 @@ int initialize_model_state(all_vars_struct     *all_vars,
 	    soil_con->Zsum_node[2] = Zsum;
 	    tmpdp  = dp - soil_con[0].depth[0] * 2.5;
 	    tmpadj = 3.5;
-	    for ( index = 3; index < Nnodes-1; index++ ) {
+	    for ( index = 3; index < Nnodes-1 && index < MAX_NODES; index++ ) {
 	      if ( FIRST_VEG ) {
 		soil_con->dz_node[index] = tmpdp/(((double)Nnodes-tmpadj));
 	      }
@@ -1375,19 +1375,22 @@ double specheat (double t)
       return cpt;
     }
 
-void temp_area(double sw_visible, double sw_nir, double surface_force, 
-	       double *T, double *Tnew, double *water_density, double *de,
-	       int dt, double *surface, int numnod, double dz, double surfdz, double *temph, 
-	       double *cp, double *energy_out_bottom)
+void temp_area_setup(double sw_visible, double sw_nir, double *T,
+		     double *water_density, double *de, int dt,
+		     double *surface, int numnod, double dz, double surfdz,
+		     double *cp, lake_column_struct *col)
 {
-/********************************************************************** 				       
-  Calculate the water temperature for different levels in the lake.
- 
+/**********************************************************************
+  Build the tridiagonal system solved by temp_area() for the
+  temperatures at the start of the time step.  Everything but the
+  surface forcing is computed here, so the system is factored once per
+  time step rather than once per iteration of water_energy_balance()
+  and water_under_ice().
+
   Parameters :
- 
+
   sw_visible   Shortwave rad in visible band entering top of water column
   sw_nir       Shortwave rad in near infrared band entering top of water column
-  surface_force The remaining rerms i nthe top layer energy balance 
   T		Lake water temperature at different levels (K).
   water_density		Water density at different levels (kg/m3).
   de		Diffusivity of water (or ice) (m2/d).
@@ -1395,40 +1398,24 @@ void temp_area(double sw_visible, double sw_nir, double surface_force,
   surface	Area of the lake at different levels (m2).
   numnod	Number of nodes in the lake (-).
   dz        Thickness of the lake layers. 
+  cp           Specific heat (J/Kg K) 
+  col		The system for temp_area().
 
   Modifications:
-  2007-Apr-23 Added initialization of temph.				TJB
-  2007-Oct-24 Modified by moving closing bracket for if ( numnod==1 ) up
-	      so that the code actually calls energycalc() even if the
-	      lake is represented by only one node.			KAC via TJB
-  2010-Nov-21 Fixed bug in definition of zhalf.				TJB
+  2026-Oct-18 Split from temp_area().
 
  **********************************************************************/
 
   double z[MAX_LAKE_NODES], zhalf[MAX_LAKE_NODES];
-  double a[MAX_LAKE_NODES], b[MAX_LAKE_NODES], c[MAX_LAKE_NODES];
-  double d[MAX_LAKE_NODES];
- 
-  double dist12;
+  double a[MAX_LAKE_NODES], b[MAX_LAKE_NODES];
   int k;
   double surface_1, surface_2, surface_avg, T1;
   double cnextra;
-  double swtop; /* The solar radiation at the top of the water column. */
   double top, bot; /* The depth of the top and the bottom of the current water layer. */
-  double water_density_new;
-  double jouleold, joulenew;
-  double energyinput;
-  double energymixed;
   double term1, term2;
 
 /**********************************************************************
- * Calculate the distance between the centers of the surface and first
- * lake layers.
- **********************************************************************/
-
-/**********************************************************************
- * Initialize the water density at all the nodes and the depth of all
- * and distance between all nodes.
+ * Initialize the depth of all and distance between all nodes.
  **********************************************************************/
 
   for(k=0; k<numnod; k++) {
@@ -1442,157 +1429,180 @@ void temp_area(double sw_visible, double sw_nir, double surface_force,
     zhalf[0]=0.5*(z[0]+z[1]);
   else
     zhalf[0]=0.5*z[0];
-  energyinput=0.0;
-  energymixed = 0.0;
 
 /**********************************************************************
- * Calculate the right hand side vector in the tridiagonal matrix system
- * of equations.
+ * Shortwave absorbed by the surface layer; temp_area() adds the
+ * surface forcing.
  **********************************************************************/
 
   surface_1 = surface[0];
   surface_2 = surface[1];
   surface_avg = (surface_1 + surface_2)/2.;
 
-  T1 = (sw_visible*(1*surface_1-surface_2*exp(-lamwsw*surfdz)) + 
-       sw_nir*(1*surface_1-surface_2*exp(-lamwlw*surfdz)))/surface_avg 
-  + (surface_force*surface_1)/surface_avg;          /* W/m2 */
-
-  energyinput +=T1*surface_avg;
-  cnextra = 0.5*(surface_2/surface_avg)*(de[0]/zhalf[0])*((T[1]-T[0])/z[0]);
-      
-  energymixed += cnextra;
+  col->sw_top = (sw_visible*(1*surface_1-surface_2*exp(-lamwsw*surfdz)) + 
+		 sw_nir*(1*surface_1-surface_2*exp(-lamwlw*surfdz)))/surface_avg;
+  col->area_top = surface_avg;
+  col->T0 = T[0];
+  col->heat0 = (1.e3+water_density[0])*cp[0]*z[0];
 
-  *temph=0.0;
-       
   if(numnod==1)
-    Tnew[0] = T[0]+(T1*dt*SECPHOUR)/((1.e3+water_density[0])*cp[0]*z[0]);
-  else {	
-	 
-    /* --------------------------------------------------------------------
-     * First calculate d for the surface layer of the lake.
-     * -------------------------------------------------------------------- */
-	 
-    d[0]= T[0]+(T1*dt*SECPHOUR)/((1.e3+water_density[0])*cp[0]*z[0])+cnextra*dt*SECPHOUR;
+    return;
 
-    *energy_out_bottom = (surface_1 - surface_2)*(sw_visible*exp(-lamwsw*surfdz) + 
-						      sw_nir*exp(-lamwlw*surfdz));
-	 
-	 
-	 
-    /* --------------------------------------------------------------------
-     * Calculate d for the remainder of the column.
-     * --------------------------------------------------------------------*/
+  cnextra = 0.5*(surface_2/surface_avg)*(de[0]/zhalf[0])*((T[1]-T[0])/z[0]);
+  col->mix0 = cnextra*dt*SECPHOUR;
 
-    /* ....................................................................
-     * All nodes but the deepest node.
-     * ....................................................................*/
+  /* --------------------------------------------------------------------
+   * Calculate d for the remainder of the column.
+   * --------------------------------------------------------------------*/
 
-    for(k=1; k<numnod-1; k++) {
+  /* ....................................................................
+   * All nodes but the deepest node.
+   * ....................................................................*/
 
-      top = (surfdz+(k-1)*dz);
-      bot = (surfdz+(k)*dz);
+  for(k=1; k<numnod-1; k++) {
 
-      surface_1 = surface[k]; 
-      surface_2 = surface[k+1];
-      surface_avg =( surface[k]  + surface[k+1]) / 2.;
+    top = (surfdz+(k-1)*dz);
+    bot = (surfdz+(k)*dz);
 
+    surface_1 = surface[k]; 
+    surface_2 = surface[k+1];
+    surface_avg =( surface[k]  + surface[k+1]) / 2.;
 
-      T1 = (sw_visible*(surface_1*exp(-lamwsw*top)-surface_2*exp(-lamwsw*bot)) + 
-	   sw_nir*(surface_1*exp(-lamwlw*top)-surface_2*exp(-lamwlw*bot)))/surface_avg; 
+    T1 = (sw_visible*(surface_1*exp(-lamwsw*top)-surface_2*exp(-lamwsw*bot)) + 
+	  sw_nir*(surface_1*exp(-lamwlw*top)-surface_2*exp(-lamwlw*bot)))/surface_avg; 
 
-      energyinput +=T1*surface_avg;
-      term1 = 0.5 *(1./surface_avg)*((de[k]/zhalf[k])*((T[k+1]-T[k])/z[k]))*surface_2;
-      term2 = 0.5 *(-1./surface_avg)*((de[k-1]/zhalf[k-1])*((T[k]-T[k-1])/z[k]))*surface_1;
+    term1 = 0.5 *(1./surface_avg)*((de[k]/zhalf[k])*((T[k+1]-T[k])/z[k]))*surface_2;
+    term2 = 0.5 *(-1./surface_avg)*((de[k-1]/zhalf[k-1])*((T[k]-T[k-1])/z[k]))*surface_1;
 	 
-      cnextra = term1 + term2;
+    cnextra = term1 + term2;
 	
-      energymixed += (term1+term2);
-      d[k]= T[k]+(T1*dt*SECPHOUR)/((1.e3+water_density[k])*cp[k]*z[k])
-                +cnextra*dt*SECPHOUR;
+    col->d[k]= T[k]+(T1*dt*SECPHOUR)/((1.e3+water_density[k])*cp[k]*z[k])
+                   +cnextra*dt*SECPHOUR;
 
-      *energy_out_bottom += (surface_1 - surface_2)*(sw_visible*exp(-lamwsw*bot) + 
-	 						sw_nir*exp(-lamwlw*bot));
-
-    }
-    /* ....................................................................
-     * Calculation for the deepest node.
-     * ....................................................................*/
-    k=numnod-1;
-    surface_1 = surface[k];
-    surface_2 = surface[k];
-    surface_avg = surface[k];
+  }
+  /* ....................................................................
+   * Calculation for the deepest node.
+   * ....................................................................*/
+  k=numnod-1;
+  surface_1 = surface[k];
+  surface_2 = surface[k];
+  surface_avg = surface[k];
      
-    top = (surfdz+(k-1)*dz);
-    bot = (surfdz+(k)*dz);
+  top = (surfdz+(k-1)*dz);
+  bot = (surfdz+(k)*dz);
 
-    //       T1 = (sw_visible*(exp(-lamwsw*top)) + 
-    //	    sw_nir*(exp(-lamwlw*top)))*surface_1/surface_avg; 
+  T1 = (sw_visible*(surface_1*exp(-lamwsw*top)-surface_2*exp(-lamwsw*bot)) + 
+	sw_nir*(surface_1*exp(-lamwlw*top)-surface_2*exp(-lamwlw*bot)))/surface_avg; 
 
-    T1 = (sw_visible*(surface_1*exp(-lamwsw*top)-surface_2*exp(-lamwsw*bot)) + 
-	 sw_nir*(surface_1*exp(-lamwlw*top)-surface_2*exp(-lamwlw*bot)))/surface_avg; 
+  cnextra = 0.5 * (-1.*surface_1/surface_avg)*((de[k-1]/zhalf[k-1])*((T[k]-T[k-1])/z[k]));
 
-    energyinput +=T1*surface_avg;
-    energyinput /= surface[0];
+  col->energy_out_bottom = surface_2*(sw_visible*exp(-lamwsw*bot) + sw_nir*exp(-lamwlw*bot));
+  col->energy_out_bottom /= surface[0];
 
-    cnextra = 0.5 * (-1.*surface_1/surface_avg)*((de[k-1]/zhalf[k-1])*((T[k]-T[k-1])/z[k]));
+  col->d[k] = T[k]+(T1*dt*SECPHOUR)/((1.e3+water_density[k])*cp[k]*z[k])
+                  +cnextra*dt*SECPHOUR;
 
-    *energy_out_bottom = 0.;
-    *energy_out_bottom += surface_2*(sw_visible*exp(-lamwsw*bot) + sw_nir*exp(-lamwlw*bot));
-    *energy_out_bottom /= surface[0];
+  /**********************************************************************
+   * Calculate arrays for tridiagonal matrix.
+   **********************************************************************/
 
-    energymixed += cnextra;
-    
-    d[k] = T[k]+(T1*dt*SECPHOUR)/((1.e3+water_density[k])*cp[k]*z[k])
-               +cnextra*dt*SECPHOUR;
+  /* --------------------------------------------------------------------
+   * Top node of the column.
+   * --------------------------------------------------------------------*/
 
-    /**********************************************************************
-     * Calculate arrays for tridiagonal matrix.
-     **********************************************************************/
+  surface_2 = surface[1];
+  surface_avg = (surface[0] + surface[1] ) / 2.;
 
-    /* --------------------------------------------------------------------
-     * Top node of the column.
-     * --------------------------------------------------------------------*/
+  b[0] = -0.5 * ( de[0] / zhalf[0] )
+        * ( dt*SECPHOUR / z[0] ) * surface_2/surface_avg;
+  a[0] = 1. - b[0];
 
-     
-    surface_2 = surface[1];
-    surface_avg = (surface[0] + surface[1] ) / 2.;
+  /* --------------------------------------------------------------------
+   * Second to second last node of the column.
+   * --------------------------------------------------------------------*/
 
-    b[0] = -0.5 * ( de[0] / zhalf[0] )
-          * ( dt*SECPHOUR / z[0] ) * surface_2/surface_avg;
-    a[0] = 1. - b[0];
+  for(k=1;k<numnod-1;k++) {
+    surface_1 = surface[k];
+    surface_2 = surface[k+1];
+    surface_avg = ( surface[k]  + surface[k+1]) / 2.;
 
-    /* --------------------------------------------------------------------
-     * Second to second last node of the column.
-     * --------------------------------------------------------------------*/
+    b[k] = -0.5 * ( de[k] / zhalf[k] )
+	   * ( dt*SECPHOUR / z[k] )*surface_2/surface_avg;
+    col->sub[k] = -0.5 * ( de[k-1] / zhalf[k-1] )
+	          * ( dt*SECPHOUR / z[k] )*surface_1/surface_avg;
+    a[k] = 1. - b[k] - col->sub[k];
 
-    for(k=1;k<numnod-1;k++) {
-      surface_1 = surface[k];
-      surface_2 = surface[k+1];
-      surface_avg = ( surface[k]  + surface[k+1]) / 2.;
+  }
+  /* --------------------------------------------------------------------
+   * Deepest node of the column.
+   * --------------------------------------------------------------------*/
 
-      b[k] = -0.5 * ( de[k] / zhalf[k] )
-	     * ( dt*SECPHOUR / z[k] )*surface_2/surface_avg;
-      c[k] = -0.5 * ( de[k-1] / zhalf[k-1] )
-	     * ( dt*SECPHOUR / z[k] )*surface_1/surface_avg;
-      a[k] = 1. - b[k] - c[k];
+  surface_1 = surface[numnod-1];
+  surface_avg = surface[numnod-1];
+  col->sub[numnod-1] = -0.5 * ( de[numnod-1] / zhalf[numnod-1] )
+	               * ( dt*SECPHOUR / z[numnod-1] ) * surface_1/surface_avg;
+  a[numnod-1] = 1. - col->sub[numnod-1];
 
-    }
+  /**********************************************************************
+   * Factor the tridiagonal matrix.
+   **********************************************************************/
+
+  tridia_factor(numnod, col->sub, a, b, col->alpha, col->gamma);
+
+}
+
+void temp_area(lake_column_struct *col, double surface_force, double *Tnew,
+	       double *water_density, int dt, double *surface, int numnod,
+	       double dz, double surfdz, double *temph, double *cp,
+	       double *energy_out_bottom)
+{
+/********************************************************************** 				       
+  Calculate the water temperature for different levels in the lake.
+ 
+  Parameters :
+ 
+  col		Tridiagonal system from temp_area_setup().
+  surface_force The remaining rerms i nthe top layer energy balance 
+  Tnew		New lake water temperature at different levels (K).
+  water_density		Water density at different levels (kg/m3).
+  dt		Time step size (s).
+  surface	Area of the lake at different levels (m2).
+  numnod	Number of nodes in the lake (-).
+  dz        Thickness of the lake layers. 
+
+  Modifications:
+  2007-Apr-23 Added initialization of temph.				TJB
+  2007-Oct-24 Modified by moving closing bracket for if ( numnod==1 ) up
+	      so that the code actually calls energycalc() even if the
+	      lake is represented by only one node.			KAC via TJB
+  2010-Nov-21 Fixed bug in definition of zhalf.				TJB
+  2026-Oct-18 The system is built and factored by temp_area_setup();
+	      only the surface node depends on surface_force.
+
+ **********************************************************************/
+
+  double T1;
+  double joulenew;
+
+  T1 = col->sw_top + (surface_force*surface[0])/col->area_top;          /* W/m2 */
+
+  if(numnod==1)
+    Tnew[0] = col->T0+(T1*dt*SECPHOUR)/col->heat0;
+  else {	
+	 
     /* --------------------------------------------------------------------
-     * Deepest node of the column.
-     * --------------------------------------------------------------------*/
+     * First calculate d for the surface layer of the lake.
+     * -------------------------------------------------------------------- */
+	 
+    col->d[0]= col->T0+(T1*dt*SECPHOUR)/col->heat0+col->mix0;
 
-    surface_1 = surface[numnod-1];
-    surface_avg = surface[numnod-1];
-    c[numnod-1] = -0.5 * ( de[numnod-1] / zhalf[numnod-1] )
-	          * ( dt*SECPHOUR / z[numnod-1] ) * surface_1/surface_avg;
-    a[numnod-1] = 1. - c[numnod-1];
+    *energy_out_bottom = col->energy_out_bottom;
 
     /**********************************************************************
      * Solve the tridiagonal matrix.
      **********************************************************************/
      
-    tridia(numnod,c,a,b,d,Tnew);
+    tridia_solve(numnod, col->sub, col->alpha, col->gamma, col->d, Tnew);
 
   }
 
@@ -1603,8 +1613,6 @@ void temp_area(double sw_visible, double sw_nir, double surface_force,
     
   energycalc(Tnew, &joulenew, numnod,dz, surfdz, surface, cp, water_density);
      
-  *temph=0.0;
-
   *temph = joulenew;
 
 }
@@ -1628,15 +1636,18 @@ void tracer_mixer (double *T,
  * freezeflag	         0 for ice, 1 for liquid water.
  * surface	Area of the lake per node number (m2).
  * numnod	         Number of nodes in the lake (-).
+ *
+ * Modifications:
+ * 2026-Oct-18 When mixing makes the node above the mixed part unstable,
+ *             mixing resumes at that node instead of rescanning the
+ *             column from the surface; the result is unchanged.
  **********************************************************************/
 
-  int    k,j,m;             /* Counter variables. */
+  int    k,m;               /* Counter variables. */
   int    mixprev;
   double avet, avev;
-  double vol; /* Volume of the surface layer (formerly vol_tr). */
   double heatcon; /*( Heat content of the surface layer (formerly vol). */ 
   double Tav, densnew;
-  double rho_max;
   double water_density[MAX_LAKE_NODES];
   
   for ( k = 0; k < numnod; k++ )
@@ -1683,15 +1694,13 @@ void tracer_mixer (double *T,
  * --------------------------------------------------------------------*/
 
 	if (m == 0) {
-	  /* Calculate the heat content and volume of the surface layer. */
+	  /* Calculate the heat content of the surface layer. */
 	  heatcon = surfdz*(1.e3+water_density[m])*cp[m]*surface[m];
-	  vol = surfdz * surface[m];
 	}
 	else {
-	  /* Calculate the heat content and volume of all layers but 
-	     the surface layer. */
+	  /* Calculate the heat content of all layers but the surface
+	     layer. */
 	  heatcon = dz*(1.e3+water_density[m])*cp[m]*surface[m];
-	  vol = dz * surface[m];
 	}
 	
 	/* Calculate the volumetric weighed average lake temperature. */
@@ -1708,37 +1717,26 @@ void tracer_mixer (double *T,
 
       densnew = calc_density(Tav);
 
-/* --------------------------------------------------------------------
- * Calculate the maximum density up to the local level.
- * --------------------------------------------------------------------*/
-
-      rho_max = 0.0;
-	
-      for ( j = 0; j < mixprev; j++ ) {
-	if ( (1000.+water_density[j]) > rho_max ) {
-	  rho_max=1000.+water_density[j];
-	}
-      }
-
 /* --------------------------------------------------------------------
  * Adjust temperatures and density in the mixed part of column.
  * --------------------------------------------------------------------*/
 
-      for ( j = mixprev; j <= k+1; j++ ) {
-	T[j]=Tav;
-	water_density[j] = densnew;
+      for ( m = mixprev; m <= k+1; m++ ) {
+	T[m]=Tav;
+	water_density[m] = densnew;
       }
 
 /* --------------------------------------------------------------------
  * Check to make sure that the mixing has not generated new instabilities
- * above the previous depth to the instabilities.
+ * above the previous depth to the instabilities.  The column above
+ * mixprev is stable, so its densest node is the one at mixprev-1; if
+ * that node is now denser than the mixed water, the instability has
+ * moved up one node and the scan continues from there.
  * --------------------------------------------------------------------*/
 
-      if (rho_max > (1000.+densnew)) {
-	
-	/* If there are still instabilities iterate again..*/
-	mixprev = 0;
-	k=-1;
+      if (mixprev > 0 && (1000.+water_density[mixprev-1]) > (1000.+densnew)) {
+	mixprev--;
+	k = mixprev-1;
       }
     }
 
@@ -1752,13 +1750,6 @@ void tracer_mixer (double *T,
     }
   }
 
-/**********************************************************************
- * Recalculate the water density.
- **********************************************************************/
-
-  for ( k = 0; k < numnod; k++ ) {
-    water_density[k] = calc_density(T[k]);
-  }
 }      
 
 void tridia (int ne, 
@@ -1798,18 +1789,36 @@ void tridia (int ne,
  * no tests are made to determine singularity. If a singular or numerically
  * singular matrix is used as input a divide by zero or floating point
  * overflow will result.
+ *
+ * Modifications:
+ * 2026-Oct-18 Split into tridia_factor() and tridia_solve(), so that
+ *             a factored system can be solved for several right hand
+ *             sides.
  **********************************************************************/
 
      double alpha[MAX_LAKE_NODES], gamma[MAX_LAKE_NODES]; /* Work arrays dimensioned (nd,ne).*/
 
-     int nm1, i, ib;
-  
-     nm1 = ne-1;
+     tridia_factor(ne, a, b, c, alpha, gamma);
+     tridia_solve(ne, a, alpha, gamma, y, x);
 
+}  
+
+void tridia_factor (int ne, 
+		    double *a, 
+		    double *b, 
+		    double *c, 
+		    double *alpha, 
+		    double *gamma) {
 /**********************************************************************
- * Obtain the LU decompositions.
+ * Obtain the LU decomposition used by tridia_solve().  a, b and c are
+ * as in tridia().  alpha(1) through alpha(ne-1) hold the reciprocals
+ * of the pivots and alpha(ne) the last pivot itself.
  **********************************************************************/
 
+     int nm1, i;
+  
+     nm1 = ne-1;
+
 	  alpha[0] = 1./b[0];
 	  gamma[0] = c[0]*alpha[0];
 
@@ -1819,10 +1828,25 @@ void tridia (int ne,
 	  gamma[i] = c[i]*alpha[i];
       }
 
+      alpha[nm1] = b[nm1]-a[nm1]*gamma[nm1-1];
+
+}
+
+void tridia_solve (int ne, 
+		   double *a, 
+		   double *alpha, 
+		   double *gamma, 
+		   double *y, 
+		   double *x) {
 /**********************************************************************
- * Solve the system.
+ * Solve a tridiagonal system factored by tridia_factor() for the right
+ * hand side y.
  **********************************************************************/
 
+     int nm1, i;
+  
+     nm1 = ne-1;
+
       x[0] = y[0]*alpha[0];
 	
       for(i=1; i<nm1; i++) {
@@ -1830,8 +1854,7 @@ void tridia (int ne,
       }
 
     
-      x[nm1] = (y[nm1]-a[nm1]*x[nm1-1])/
-	   (b[nm1]-a[nm1]*gamma[nm1-1]);
+      x[nm1] = (y[nm1]-a[nm1]*x[nm1-1])/alpha[nm1];
 
       for(i=nm1-1; i>=0; i--) {
             x[i] = x[i]-gamma[i]*x[i+1];
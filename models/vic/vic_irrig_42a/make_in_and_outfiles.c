@@ -33,6 +33,10 @@ void make_in_and_outfiles(filep_struct         *filep,
 	      in global parameter file.					TJB
   2011-May-25 Expanded latchar, lngchar, and junk allocations to handle
 	      GRID_DECIMAL > 4.						TJB
+  2026-Oct-18 Output files get a buffer of OUT_BUFFER_SIZE bytes.  With
+	      SINGLE_OUTFILE, each prefix has one file for all cells,
+	      opened for the first cell, and the output of each cell is
+	      collected in memory until close_files().
 
 **********************************************************************/
 {
@@ -91,13 +95,26 @@ void make_in_and_outfiles(filep_struct         *filep,
     strcpy(out_data_files[filenum].filename, filenames->result_dir);
     strcat(out_data_files[filenum].filename, "/");
     strcat(out_data_files[filenum].filename, out_data_files[filenum].prefix);
+    sprintf(out_data_files[filenum].cellname, "%s_%s", latchar, lngchar);
+    if(options.SINGLE_OUTFILE) {
+      if(out_data_files[filenum].single_fh == NULL) {
+        if(options.BINARY_OUTPUT)
+          out_data_files[filenum].single_fh = open_file(out_data_files[filenum].filename, "wb");
+        else out_data_files[filenum].single_fh = open_file(out_data_files[filenum].filename, "w");
+        setvbuf(out_data_files[filenum].single_fh, NULL, _IOFBF, OUT_BUFFER_SIZE);
+      }
+      out_data_files[filenum].fh = open_memstream(&out_data_files[filenum].block,
+                                                  &out_data_files[filenum].blocksize);
+      if(out_data_files[filenum].fh == NULL)
+        nrerror("Memory allocation error in make_in_and_outfiles().");
+      continue;
+    }
     strcat(out_data_files[filenum].filename, "_");
-    strcat(out_data_files[filenum].filename, latchar);
-    strcat(out_data_files[filenum].filename, "_");
-    strcat(out_data_files[filenum].filename, lngchar);
+    strcat(out_data_files[filenum].filename, out_data_files[filenum].cellname);
     if(options.BINARY_OUTPUT)
       out_data_files[filenum].fh = open_file(out_data_files[filenum].filename, "wb");
     else out_data_files[filenum].fh = open_file(out_data_files[filenum].filename, "w");
+    setvbuf(out_data_files[filenum].fh, NULL, _IOFBF, OUT_BUFFER_SIZE);
   }
 
 } 
@@ -0,0 +1,218 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <vicNl.h>
+
+static char vcid[] = "$Id$";
+
+#define MTCLIM_CACHE_MAGIC   "VICMTCL"
+#define MTCLIM_CACHE_VERSION 1
+
+static unsigned long long mtclim_input_hash(int, int, double, soil_con_struct *,
+					    int, dmy_struct *, double *,
+					    double *, double *, double *,
+					    double *);
+static int read_mtclim_cache(char *, int, unsigned long long, double *,
+			     double *, double *, double *);
+static void write_mtclim_cache(char *, int, unsigned long long, double *,
+			       double *, double *, double *);
+
+void mtclim_cached(int                have_dewpt,
+		   int                have_shortwave,
+		   double             hour_offset,
+		   soil_con_struct   *soil_con,
+		   int                Ndays,
+		   dmy_struct        *dmy,
+		   double            *prec,
+		   double            *tmax,
+		   double            *tmin,
+		   double            *tskc,
+		   double            *vp,
+		   double            *hourlyrad,
+		   double            *fdir)
+/**********************************************************************
+  mtclim_cached
+
+  Calls mtclim_wrapper() for the cell described by soil_con, unless
+  options.FORCE_CACHE is set and the cell's cache file holds the
+  results of a call with the same inputs.  The cache file is
+  FORCE_CACHE_PFX followed by the cell's <lat>_<lng>, as the forcing
+  files; it stores the MTCLIM outputs (tskc, vp, fdir, hourlyrad) with
+  a hash of every MTCLIM input, so a change to the forcings, the soil
+  parameters, the simulation period or an MTCLIM option makes the
+  model compute and store them again.  The water available for
+  irrigation is not an MTCLIM input, so runs that differ only in
+  IRR_RUN/IRR_WITH share the cache.  A run with OUTPUT_FORCE TRUE
+  fills the cache of all cells without running the model.
+**********************************************************************/
+{
+  extern option_struct    options;
+  extern param_set_struct param_set;
+
+  char               filename[MAXSTRING];
+  char               latchar[20], lngchar[20], junk[6];
+  unsigned long long hash;
+
+  if (!options.FORCE_CACHE) {
+    mtclim_wrapper(have_dewpt, have_shortwave, hour_offset,
+		   soil_con->elevation, soil_con->slope, soil_con->aspect,
+		   soil_con->ehoriz, soil_con->whoriz, soil_con->annual_prec,
+		   soil_con->lat, Ndays, dmy, prec, tmax, tmin, tskc, vp,
+		   hourlyrad, fdir);
+    return;
+  }
+
+  sprintf(junk, "%%.%if", options.GRID_DECIMAL);
+  sprintf(latchar, junk, soil_con->lat);
+  sprintf(lngchar, junk, soil_con->lng);
+  strcpy(filename, param_set.FORCE_CACHE_PFX);
+  strcat(filename, latchar);
+  strcat(filename, "_");
+  strcat(filename, lngchar);
+
+  hash = mtclim_input_hash(have_dewpt, have_shortwave, hour_offset, soil_con,
+			   Ndays, dmy, prec, tmax, tmin, vp, hourlyrad);
+
+  if (read_mtclim_cache(filename, Ndays, hash, tskc, vp, hourlyrad, fdir))
+    return;
+
+  mtclim_wrapper(have_dewpt, have_shortwave, hour_offset,
+		 soil_con->elevation, soil_con->slope, soil_con->aspect,
+		 soil_con->ehoriz, soil_con->whoriz, soil_con->annual_prec,
+		 soil_con->lat, Ndays, dmy, prec, tmax, tmin, tskc, vp,
+		 hourlyrad, fdir);
+
+  write_mtclim_cache(filename, Ndays, hash, tskc, vp, hourlyrad, fdir);
+}
+
+/* Hash of everything mtclim_wrapper() reads, including the options
+   used by the MTCLIM routines */
+static unsigned long long mtclim_input_hash(int              have_dewpt,
+					    int              have_shortwave,
+					    double           hour_offset,
+					    soil_con_struct *soil_con,
+					    int              Ndays,
+					    dmy_struct      *dmy,
+					    double          *prec,
+					    double          *tmax,
+					    double          *tmin,
+					    double          *vp,
+					    double          *hourlyrad)
+{
+  extern option_struct options;
+
+  unsigned long long h;
+  int                i;
+
+  h = HASH_INIT;
+  HASH(h, have_dewpt);
+  HASH(h, have_shortwave);
+  HASH(h, hour_offset);
+  HASH(h, soil_con->elevation);
+  HASH(h, soil_con->slope);
+  HASH(h, soil_con->aspect);
+  HASH(h, soil_con->ehoriz);
+  HASH(h, soil_con->whoriz);
+  HASH(h, soil_con->annual_prec);
+  HASH(h, soil_con->lat);
+  HASH(h, options.LW_CLOUD);
+  HASH(h, options.MTCLIM_SWE_CORR);
+  HASH(h, options.SW_PREC_THRESH);
+  HASH(h, options.VP_ITER);
+  HASH(h, Ndays);
+  for (i = 0; i < Ndays*24; i++)
+    HASH(h, dmy[i].day_in_year);
+  HASH_N(h, prec, Ndays);
+  HASH_N(h, tmax, Ndays);
+  HASH_N(h, tmin, Ndays);
+  if (have_dewpt)
+    HASH_N(h, vp, Ndays);
+  if (have_shortwave)
+    HASH_N(h, hourlyrad, Ndays*24);
+
+  return h;
+}
+
+/* Returns TRUE if filename holds the outputs for inputs with this hash */
+static int read_mtclim_cache(char               *filename,
+			     int                 Ndays,
+			     unsigned long long  hash,
+			     double             *tskc,
+			     double             *vp,
+			     double             *hourlyrad,
+			     double             *fdir)
+{
+  FILE               *fp;
+  char                magic[8];
+  int                 header[2];
+  unsigned long long  file_hash;
+  int                 ok;
+
+  if ((fp = fopen(filename, "rb")) == NULL)
+    return FALSE;
+
+  ok = (fread(magic, sizeof(char), 8, fp) == 8
+	&& memcmp(magic, MTCLIM_CACHE_MAGIC, 8) == 0
+	&& fread(header, sizeof(int), 2, fp) == 2
+	&& header[0] == MTCLIM_CACHE_VERSION && header[1] == Ndays
+	&& fread(&file_hash, sizeof(unsigned long long), 1, fp) == 1
+	&& file_hash == hash);
+
+  /* the outputs are only overwritten once the header matches */
+  if (ok)
+    ok = (fread(tskc, sizeof(double), Ndays, fp) == (size_t)Ndays
+	  && fread(vp, sizeof(double), Ndays, fp) == (size_t)Ndays
+	  && fread(fdir, sizeof(double), Ndays, fp) == (size_t)Ndays
+	  && fread(hourlyrad, sizeof(double), Ndays*24, fp) == (size_t)(Ndays*24));
+  fclose(fp);
+
+  if (!ok)
+    return FALSE;
+
+#if VERBOSE
+  fprintf(stderr,"Read MTCLIM estimates from cache file %s\n",filename);
+#endif
+
+  return TRUE;
+}
+
+/* Writes to a temporary file that is renamed when complete, so that
+   runs sharing the cache never read a partly written file */
+static void write_mtclim_cache(char               *filename,
+			       int                 Ndays,
+			       unsigned long long  hash,
+			       double             *tskc,
+			       double             *vp,
+			       double             *hourlyrad,
+			       double             *fdir)
+{
+  FILE *fp;
+  char  tmpname[MAXSTRING+20];
+  char  magic[8] = MTCLIM_CACHE_MAGIC;
+  int   header[2];
+  int   ok;
+
+  sprintf(tmpname, "%s.tmp%d", filename, (int)getpid());
+  if ((fp = fopen(tmpname, "wb")) == NULL) {
+    fprintf(stderr, "WARNING: Unable to open MTCLIM cache file %s for writing.\n", tmpname);
+    return;
+  }
+
+  header[0] = MTCLIM_CACHE_VERSION;
+  header[1] = Ndays;
+  ok = (fwrite(magic, sizeof(char), 8, fp) == 8
+	&& fwrite(header, sizeof(int), 2, fp) == 2
+	&& fwrite(&hash, sizeof(unsigned long long), 1, fp) == 1
+	&& fwrite(tskc, sizeof(double), Ndays, fp) == (size_t)Ndays
+	&& fwrite(vp, sizeof(double), Ndays, fp) == (size_t)Ndays
+	&& fwrite(fdir, sizeof(double), Ndays, fp) == (size_t)Ndays
+	&& fwrite(hourlyrad, sizeof(double), Ndays*24, fp) == (size_t)(Ndays*24));
+  if (fclose(fp) != 0)
+    ok = FALSE;
+
+  if (!ok || rename(tmpname, filename) != 0) {
+    fprintf(stderr, "WARNING: Unable to write MTCLIM cache file %s.\n", filename);
+    unlink(tmpname);
+  }
+}
@@ -1,6 +1,5 @@
 #include <stdio.h>
 #include <math.h>
-#include <stdarg.h>
 #include <vicNl.h>
 
 #define MAXTRIAL 150
@@ -12,8 +11,7 @@
 #define RELAX2   0.7
 #define RELAX3   0.2
 
-int newt_raph(void (*vecfunc)(double x[], double fvec[], int n, int init, ...), 
-               double x[], int n)
+int newt_raph(double x[], int n, heat_eqn_args_struct *args)
 {
 
 /******************************************************************
@@ -30,18 +28,22 @@ int newt_raph(void (*vecfunc)(double x[], double fvec[], int n, int init, ...),
   2012-Jan-28 Replaced local precompile variable MAXSIZE with VIC's
 	      MAX_NODES so that array lengths here are always in sync
 	      with array lengths in the rest of VIC.			TJB 
+  2026-Oct-18 Solves the implicit heat equation of fda_heat_eqn()
+	      directly, with the analytic Jacobian of fda_heat_jac()
+	      instead of the forward differences of fdjac3().  Removed
+	      the unused full Jacobian array.
 ******************************************************************/
 
-  int k, i, index[MAX_NODES], Error;
-  double errx, errf, d, fvec[MAX_NODES], fjac[MAX_NODES*MAX_NODES], p[MAX_NODES];
+  int k, i, Error;
+  double errx, errf, fvec[MAX_NODES], p[MAX_NODES];
   double a[MAX_NODES], b[MAX_NODES], c[MAX_NODES];
 
   Error = 0;
 
   for (k=0; k<MAXTRIAL; k++) {
 
-    // calculate function value for all nodes, i.e. focus = -1
-    (*vecfunc)(x, fvec, n, 0, -1);
+    // calculate function value for all nodes
+    fda_heat_eqn(x, fvec, n, args);
 
     // stop if TOLF is satisfied
     errf=0.0;
@@ -52,7 +54,7 @@ int newt_raph(void (*vecfunc)(double x[], double fvec[], int n, int init, ...),
     }
     
     // calculate the Jacobian
-    fdjac3(x, fvec, a, b, c, vecfunc, n);
+    fda_heat_jac(x, a, b, c, n, args);
 
     for (i=0; i<n; i++) p[i]=-fvec[i];
 
@@ -100,46 +102,6 @@ int newt_raph(void (*vecfunc)(double x[], double fvec[], int n, int init, ...),
 
 
 
-#define EPS2     1e-4
-
-void fdjac3(double x[], double fvec[], double a[], double b[], double c[],
-            void (*vecfunc)(double x[], double fvec[], int n, int init, ...), 
-            int n)
-{
-
-/******************************************************************
-  fdjac3    2006    Ming Pan      mpan@princeton.EDU
-
- forward difference approx to Jacobian,
- adapted from "Numerical Recipes"
-
-******************************************************************/
-
-  int i, j;
-  double h, temp, f[MAX_NODES];
-
-  for (j=0; j<n; j++) {
-    temp=x[j];
-    h=EPS2*fabs(temp);
-    if (h==0) h=EPS2;
-    x[j]=temp+h;
-    h=x[j]-temp;
-
-    // only update column j-1, j and j+1, caused by change in x[j]
-    (*vecfunc)(x, f, n, 0, j);
-
-    x[j]=temp;
-
-    b[j]=(f[j]-fvec[j])/h;
-    if (j!=0) c[j-1]=(f[j-1]-fvec[j-1])/h;
-    if (j!=n-1) a[j+1]=(f[j+1]-fvec[j+1])/h;
-  }
-
-}
-
-#undef EPS2
-
-
 void tridiag(double a[], double b[], double c[], double r[], unsigned n)
 {
 
@@ -426,11 +426,15 @@ void init_output_list(out_data_struct *out_data, int write, char *format, int ty
 
   This routine initializes the output information for all output variables.
 
+  2026-Oct-18 All variables are active until set_active_outvars() is
+	      called.
+
 *************************************************************/
   int varid, i;
 
   for (varid=0; varid<N_OUTVAR_TYPES; varid++) {
     out_data[varid].write = write;
+    out_data[varid].active = TRUE;
     strcpy(out_data[varid].format,format);
     out_data[varid].type = type;
     out_data[varid].mult = mult;
@@ -483,6 +487,44 @@ int set_output_var(out_data_file_struct *out_data_files,
 }
 
 
+void set_active_outvars(out_data_struct *out_data) {
+/*************************************************************
+  set_active_outvars()
+
+  This routine limits the variables aggregated by put_data() to
+  those that are written, plus those that written variables are
+  derived from after aggregation.  The band-specific variables are
+  collected per tile as a group, so they are all active if any of
+  them is written.  The per-record values (data) of the variables
+  used by the water and energy balance checks and by save_data()
+  are computed regardless.
+
+*************************************************************/
+  extern option_struct options;
+  int varid;
+  int band_active;
+
+  band_active = FALSE;
+  for (varid=0; varid<N_OUTVAR_TYPES; varid++) {
+    out_data[varid].active = out_data[varid].write;
+    if (varid >= OUT_FIRST_BAND && varid <= OUT_LAST_BAND && out_data[varid].write)
+      band_active = TRUE;
+  }
+  for (varid=OUT_FIRST_BAND; varid<=OUT_LAST_BAND; varid++)
+    out_data[varid].active = band_active;
+
+  if (out_data[OUT_AERO_RESIST].active)
+    out_data[OUT_AERO_COND].active = TRUE;
+  if (out_data[OUT_AERO_RESIST1].active)
+    out_data[OUT_AERO_COND1].active = TRUE;
+  if (out_data[OUT_AERO_RESIST2].active)
+    out_data[OUT_AERO_COND2].active = TRUE;
+  if (options.ALMA_OUTPUT && out_data[OUT_SUB_SNOW].active)
+    out_data[OUT_SUB_CANOP].active = TRUE;
+
+}
+
+
 void zero_output_list(out_data_struct *out_data) {
 /*************************************************************
   zero_output_list()      Ted Bohn     September 08, 2006
@@ -28,6 +28,9 @@ void parse_output_info(filenames_struct      *names,
   2009-Mar-15 Added default values for format, typestr, and
 	      multstr, so that they can be omitted from global
 	      param file.					TJB
+  2026-Oct-18 Sets options.PET_OUT, so that only the types of
+	      potential evap that are written are computed.
+  2026-Oct-18 Calls set_active_outvars().
 **********************************************************************/
 {
   extern option_struct    options;
@@ -124,4 +127,15 @@ void parse_output_info(filenames_struct      *names,
   }
   fclose(gp);
 
+  /** Potential evap types that are written (default or user-defined outputs) **/
+  options.PET_OUT[PET_SATSOIL] = out_data[OUT_PET_SATSOIL].write;
+  options.PET_OUT[PET_H2OSURF] = out_data[OUT_PET_H2OSURF].write;
+  options.PET_OUT[PET_SHORT]   = out_data[OUT_PET_SHORT].write;
+  options.PET_OUT[PET_TALL]    = out_data[OUT_PET_TALL].write;
+  options.PET_OUT[PET_NATVEG]  = out_data[OUT_PET_NATVEG].write;
+  options.PET_OUT[PET_VEGNOCR] = out_data[OUT_PET_VEGNOCR].write;
+
+  /** Variables aggregated by put_data() **/
+  set_active_outvars(out_data);
+
 }
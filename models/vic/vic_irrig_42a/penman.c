@@ -32,6 +32,8 @@
 	      based on photosynthetic demand.				TJB
   2014-May-05 Moved pre-compile constants CLOSURE, RSMAX, and
 	      VPDMINFACTOR to vicNl_def.h.				TJB
+  2026-Oct-18 Options are read through OPT_* (see vicNl_def.h), so
+	      that specialized builds can fix them at compile time.
 
 ********************************************************************************/
 #include <stdio.h>
@@ -91,7 +93,7 @@ double calc_rc(double rs,
       Tfactor=1.;
       DAYfactor=1.;
       vpdfactor=1.;
-      if(options.IRRIGATION) gsm_inv=1.; //only when irrig=true
+      if(OPT_IRRIGATION) gsm_inv=1.; //only when irrig=true
     }
 
     /* calculate canopy resistance in s/m */
@@ -41,6 +41,8 @@ void prepare_full_energy(int               iveg,
   2013-Dec-26 Removed EXCESS_ICE option.				TJB
   2013-Dec-27 Moved SPATIAL_FROST to options_struct.			TJB
   2014-Mar-28 Removed DIST_PRCP option.					TJB
+  2026-Oct-18 Options are read through OPT_* (see vicNl_def.h), so
+	      that specialized builds can fix them at compile time.
 *******************************************************************/
 
   extern option_struct options;
@@ -49,14 +51,14 @@ void prepare_full_energy(int               iveg,
   double            *null_ptr;
   layer_data_struct *layer;
 
-  layer = (layer_data_struct *)calloc(options.Nlayer,
+  layer = (layer_data_struct *)calloc(OPT_Nlayer,
 				      sizeof(layer_data_struct));
 
-  for(band=0;band<options.SNOW_BAND;band++) {
+  for(band=0;band<OPT_SNOW_BAND;band++) {
 
     if (soil_con->AreaFract[band] > 0.0) {
 
-      for(i=0;i<options.Nlayer;i++) 
+      for(i=0;i<OPT_Nlayer;i++) 
         layer[i] = all_vars->cell[iveg][band].layer[i];
     
       /* Compute top soil layer moisture content (mm/mm) */
@@ -65,7 +67,7 @@ void prepare_full_energy(int               iveg,
 
       /* Compute top soil layer ice content (mm/mm) */
 
-      if(options.FROZEN_SOIL && soil_con->FS_ACTIVE){
+      if(OPT_FROZEN_SOIL && soil_con->FS_ACTIVE){
         if((all_vars->energy[iveg][band].T[0] 
 	    + all_vars->energy[iveg][band].T[1])/2.<0.) {
 	  ice0[band] = moist0[band] 
@@ -91,7 +93,7 @@ void prepare_full_energy(int               iveg,
 					    soil_con->soil_density,
 					    soil_con->organic,
 					    soil_con->frost_fract,
-					    options.Nlayer);
+					    OPT_Nlayer);
     
       /** Save Thermal Conductivities for Energy Balance **/
       all_vars->energy[iveg][band].kappa[0] = layer[0].kappa; 
@@ -300,6 +300,7 @@ print_filenames(filenames_struct *fnames)
     printf("\tf_path_pfx[0]: %s\n", fnames->f_path_pfx[0]);
     printf("\tf_path_pfx[1]: %s\n", fnames->f_path_pfx[1]);
     printf("\tglobal       : %s\n", fnames->global);
+    printf("\tblowing_table: %s\n", fnames->blowing_table);
     printf("\tinit_state   : %s\n", fnames->init_state);
     printf("\tlakeparam    : %s\n", fnames->lakeparam);
     printf("\tresult_dir   : %s\n", fnames->result_dir);
@@ -499,8 +500,10 @@ print_option(option_struct *option)
 {
     printf("option:\n");
     printf("\tAboveTreelineVeg   : %d\n", option->AboveTreelineVeg);
+    printf("\tADAPT_SNOW_STEP    : %d\n", option->ADAPT_SNOW_STEP);
     printf("\tAERO_RESIST_CANSNOW: %d\n", option->AERO_RESIST_CANSNOW);
     printf("\tBLOWING            : %d\n", option->BLOWING);
+    printf("\tBLOWING_TABLE      : %d\n", option->BLOWING_TABLE);
     printf("\tCARBON             : %d\n", option->CARBON);
     printf("\tCLOSE_ENERGY       : %d\n", option->CLOSE_ENERGY);
     printf("\tCOMPUTE_TREELINE   : %d\n", option->COMPUTE_TREELINE);
@@ -512,6 +515,7 @@ print_option(option_struct *option)
     printf("\tFULL_ENERGY        : %d\n", option->FULL_ENERGY);
     printf("\tGRND_FLUX_TYPE     : %d\n", option->GRND_FLUX_TYPE);
     printf("\tIMPLICIT           : %d\n", option->IMPLICIT);
+    printf("\tIMPLICIT_FB        : %d\n", option->IMPLICIT_FB);
     printf("\tJULY_TAVG_SUPPLIED : %d\n", option->JULY_TAVG_SUPPLIED);
     printf("\tLAKES              : %d\n", option->LAKES);
     printf("\tLW_CLOUD           : %d\n", option->LW_CLOUD);
@@ -527,6 +531,8 @@ print_option(option_struct *option)
     // printf("\tNVEGTYPES          : %d\n", option->NVEGTYPES);
     printf("\tPLAPSE             : %d\n", option->PLAPSE);
     printf("\tRC_MODE            : %d\n", option->RC_MODE);
+    printf("\tROOT_WARMSTART     : %d\n", option->ROOT_WARMSTART);
+    printf("\tROOT_STATS         : %d\n", option->ROOT_STATS);
     printf("\tROOT_ZONES         : %d\n", option->ROOT_ZONES);
     printf("\tQUICK_FLUX         : %d\n", option->QUICK_FLUX);
     printf("\tQUICK_SOLVE        : %d\n", option->QUICK_SOLVE);
@@ -541,6 +547,7 @@ print_option(option_struct *option)
     printf("\tVP_INTERP          : %d\n", option->VP_INTERP);
     printf("\tVP_ITER            : %d\n", option->VP_ITER);
     printf("\tALMA_INPUT         : %d\n", option->ALMA_INPUT);
+    printf("\tFORCE_CACHE        : %d\n", option->FORCE_CACHE);
     printf("\tBASEFLOW           : %d\n", option->BASEFLOW);
     printf("\tGRID_DECIMAL       : %d\n", option->GRID_DECIMAL);
     printf("\tVEGLIB_PHOTO       : %d\n", option->VEGLIB_PHOTO);
@@ -558,6 +565,7 @@ print_option(option_struct *option)
     printf("\tNoutfiles          : %d\n", option->Noutfiles);
     printf("\tOUTPUT_FORCE       : %d\n", option->OUTPUT_FORCE);
     printf("\tPRT_HEADER         : %d\n", option->PRT_HEADER);
+    printf("\tSINGLE_OUTFILE     : %d\n", option->SINGLE_OUTFILE);
     printf("\tPRT_SNOW_BAND      : %d\n", option->PRT_SNOW_BAND);
 }
 
@@ -570,6 +578,7 @@ print_out_data(out_data_struct *out,
     printf("out_data:\n");
     printf("\tvarname: %s\n", out->varname);
     printf("\twrite: %d\n", out->write);
+    printf("\tactive: %d\n", out->active);
     printf("\tformat: %s\n", out->format);
     printf("\ttype: %d\n", out->type);
     printf("\tmult: %.4f\n", out->mult);
@@ -630,6 +639,8 @@ print_save_data(save_data_struct *save)
     printf("\tsurfstor: %.4lf\n", save->surfstor);
     printf("\tswe: %.4lf\n", save->swe);
     printf("\twdew: %.4lf\n", save->wdew);
+    printf("\tstorage: %.4lf\n", save->storage);
+    printf("\tstep_count: %d\n", save->step_count);
 }
 
 void
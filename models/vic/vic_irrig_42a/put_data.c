@@ -156,6 +156,21 @@ int  put_data(all_vars_struct   *all_vars,
   2014-Mar-28 Removed DIST_PRCP option.					TJB
   2014-Apr-25 Added OUT_LAI.						TJB
   2014-Apr-25 Added OUT_VEGCOVER.					TJB
+  2026-Oct-18 Report the iteration statistics of root_brent() at the end
+	      of each cell.
+  2026-Oct-18 Output is not written if out_data_files is NULL.
+  2026-Oct-18 Only active variables (see set_active_outvars()) are
+	      aggregated, and band-specific variables are only
+	      collected if they are active.
+  2026-Oct-18 Report the use of snow sub-steps at the end of each cell.
+  2026-Oct-18 Options are read through OPT_* (see vicNl_def.h), so
+	      that specialized builds can fix them at compile time.
+  2026-Oct-18 The iteration statistics of root_brent() are kept and
+	      reported by the caller (see vic_cell.c and vicNl.c).
+  2026-Oct-18 The use of snow sub-steps is also reported by the caller.
+  2026-Oct-18 The step count of the output interval and the storage of
+	      the water balance check are kept in save_data, so that
+	      cells can be stepped in turn.
 **********************************************************************/
 {
   extern global_param_struct global_param;
@@ -195,7 +210,6 @@ int  put_data(all_vars_struct   *all_vars,
   int                     dt_sec;
   int                     out_dt_sec;
   int                     out_step_ratio;
-  static int              step_count;
   int                     ErrorFlag;
   static int              Tfoliage_fbcount_total;
   static int              Tcanopy_fbcount_total;
@@ -226,7 +240,8 @@ int  put_data(all_vars_struct   *all_vars,
   dt_sec = global_param.dt*SECPHOUR;
   out_dt_sec = global_param.out_dt*SECPHOUR;
   out_step_ratio = (int)(out_dt_sec/dt_sec);
-  if (rec >= 0) step_count++;
+  if (rec >= 0) save_data->step_count++;
+  else save_data->step_count = 0;
   if (rec == 0) {
     Tsoil_fbcount_total = 0;
     Tsurf_fbcount_total = 0;
@@ -236,12 +251,12 @@ int  put_data(all_vars_struct   *all_vars,
   }
 
   // Compute treeline adjustment factors
-  for ( band = 0; band < options.SNOW_BAND; band++ ) {
+  for ( band = 0; band < OPT_SNOW_BAND; band++ ) {
     if ( AboveTreeLine[band] ) {
       Cv = 0;
       for ( veg = 0 ; veg < veg_con[0].vegetat_type_num ; veg++ ) {
 	if ( veg_lib[veg_con[veg].veg_class].overstory ) {
-          if (options.LAKES && veg_con[veg].LAKE) {
+          if (OPT_LAKES && veg_con[veg].LAKE) {
             if (band == 0) {
               // Fraction of tile that is flooded
               Clake = lake_var.sarea/lake_con->basin[0];
@@ -280,7 +295,7 @@ int  put_data(all_vars_struct   *all_vars,
   out_data[OUT_QAIR].data[0]      = EPS * atmos->vp[NR]/atmos->pressure[NR];
   out_data[OUT_RAINF].data[0]     = atmos->out_rain; // mm over grid cell
   out_data[OUT_REL_HUMID].data[0] = 100.*atmos->vp[NR]/(atmos->vp[NR]+atmos->vpd[NR]);
-  if (options.LAKES && lake_con->Cl[0] > 0)
+  if (OPT_LAKES && lake_con->Cl[0] > 0)
     out_data[OUT_LAKE_CHAN_IN].data[0] = atmos->channel_in[NR]; // mm over grid cell
   else
     out_data[OUT_LAKE_CHAN_IN].data[0] = 0;
@@ -299,7 +314,7 @@ int  put_data(all_vars_struct   *all_vars,
 
     Cv = veg_con[veg].Cv;
     Clake = 0;
-    Nbands = options.SNOW_BAND;
+    Nbands = OPT_SNOW_BAND;
     IsWet = 0;
 
     if (veg < veg_con[0].vegetat_type_num)
@@ -310,7 +325,7 @@ int  put_data(all_vars_struct   *all_vars,
     if ( Cv > 0) {
 
       // Check if this is lake/wetland tile
-      if (options.LAKES && veg_con[veg].LAKE) {
+      if (OPT_LAKES && veg_con[veg].LAKE) {
         Clake = lake_var.sarea/lake_con->basin[0];
         Nbands = 1;
         IsWet = 1;
@@ -392,7 +407,7 @@ int  put_data(all_vars_struct   *all_vars,
 
           if (IsWet) {
             // Wetland soil temperatures
-            for(i=0;i<options.Nnode;i++) {
+            for(i=0;i<OPT_Nnode;i++) {
               out_data[OUT_SOIL_TNODE_WL].data[i] = energy[veg][band].T[i];
             }
           }
@@ -411,7 +426,7 @@ int  put_data(all_vars_struct   *all_vars,
               lake_var.energy.fdepth[i]      = energy[veg][band].fdepth[i];
               lake_var.energy.tdepth[i]      = energy[veg][band].fdepth[i];
             }
-            for (i=0; i<options.Nnode; i++) {
+            for (i=0; i<OPT_Nnode; i++) {
               lake_var.energy.ice[i]         = energy[veg][band].ice[i];
               lake_var.energy.T[i]           = energy[veg][band].T[i];
             }
@@ -586,7 +601,7 @@ int  put_data(all_vars_struct   *all_vars,
    *****************************************/
   // Water balance terms
   out_data[OUT_DELSOILMOIST].data[0] = 0;
-  for (index=0; index<options.Nlayer; index++) {
+  for (index=0; index<OPT_Nlayer; index++) {
     out_data[OUT_SOIL_MOIST].data[index] = out_data[OUT_SOIL_LIQ].data[index]+out_data[OUT_SOIL_ICE].data[index];
     out_data[OUT_DELSOILMOIST].data[0] += out_data[OUT_SOIL_MOIST].data[index];
     out_data[OUT_SMLIQFRAC].data[index] = out_data[OUT_SOIL_LIQ].data[index]/out_data[OUT_SOIL_MOIST].data[index];
@@ -600,7 +615,7 @@ int  put_data(all_vars_struct   *all_vars,
   }
 
   // Irrigation terms
-  if (options.IRRIGATION) {
+  if (OPT_IRRIGATION) {
     //fprintf(stderr,"put_data A0 rec%d out_irrig %f out_irr_extract %f out_irr_run %f\n",rec,out_data[OUT_IRRIG].data[0],out_data[OUT_IRR_EXTRACT].data[0],out_data[OUT_IRR_RUN].data[0]);
     if (out_data[OUT_IRRIG].data[0]-out_data[OUT_IRR_EXTRACT].data[0] < out_data[OUT_IRR_RUN].data[0]) {
       out_data[OUT_IRR_RUN_USED].data[0] = out_data[OUT_IRRIG].data[0]-out_data[OUT_IRR_EXTRACT].data[0];
@@ -634,7 +649,7 @@ int  put_data(all_vars_struct   *all_vars,
 
   // Save current moisture state for use in next time step
   save_data->total_soil_moist = 0;
-  for (index=0; index<options.Nlayer; index++) {
+  for (index=0; index<OPT_Nlayer; index++) {
     save_data->total_soil_moist += out_data[OUT_SOIL_MOIST].data[index];
   }
   save_data->surfstor = out_data[OUT_SURFSTOR].data[0];
@@ -642,7 +657,7 @@ int  put_data(all_vars_struct   *all_vars,
   save_data->wdew = out_data[OUT_WDEW].data[0];
 
   // Carbon Terms
-  if (options.CARBON) {
+  if (OPT_CARBON) {
     out_data[OUT_RHET].data[0] *= (double)global_param.dt/24.0; // convert to gC/m2d
     out_data[OUT_NEE].data[0] = out_data[OUT_NPP].data[0]-out_data[OUT_RHET].data[0];
   }
@@ -652,7 +667,7 @@ int  put_data(all_vars_struct   *all_vars,
     ********************/
   inflow  = out_data[OUT_PREC].data[0] + out_data[OUT_LAKE_CHAN_IN].data[0]; // mm over grid cell
   outflow = out_data[OUT_EVAP].data[0] + out_data[OUT_RUNOFF].data[0] + out_data[OUT_BASEFLOW].data[0]; // mm over grid cell
-  if (options.IRRIGATION) {
+  if (OPT_IRRIGATION) {
     inflow += out_data[OUT_IRR_APPLIED].data[0]; //orig
     //fprintf(stderr,"put_data A rec %d inflow %f irr_applied %f\n",rec,inflow,out_data[OUT_IRR_APPLIED].data[0]);
   }
@@ -661,19 +676,20 @@ int  put_data(all_vars_struct   *all_vars,
   //fprintf(stderr,"put_data L3 rec %d inflow %f swe %f\n",rec,inflow,out_data[OUT_SWE].data[0]);
 
   storage = 0.;
-  for(index=0;index<options.Nlayer;index++)
+  for(index=0;index<OPT_Nlayer;index++)
     if(options.MOISTFRACT)
       storage += (out_data[OUT_SOIL_LIQ].data[index] + out_data[OUT_SOIL_ICE].data[index]) 
 	* depth[index] * 1000;
     else
       storage += out_data[OUT_SOIL_LIQ].data[index] + out_data[OUT_SOIL_ICE].data[index];
   storage += out_data[OUT_SWE].data[0] + out_data[OUT_SNOW_CANOPY].data[0] + out_data[OUT_WDEW].data[0] + out_data[OUT_SURFSTOR].data[0];
-  out_data[OUT_WATER_ERROR].data[0] = calc_water_balance_error(rec,inflow,outflow,storage);
+  out_data[OUT_WATER_ERROR].data[0] = calc_water_balance_error(rec,inflow,outflow,storage,save_data->storage);
+  save_data->storage = storage;
   //fprintf(stderr,"put_data M rec %d storage %f\n",rec,storage); 
   /********************
     Check Energy Balance 
   ********************/
-  if(options.FULL_ENERGY)
+  if(OPT_FULL_ENERGY)
     out_data[OUT_ENERGY_ERROR].data[0] = calc_energy_balance_error(rec, 
                               out_data[OUT_NET_SHORT].data[0] + out_data[OUT_NET_LONG].data[0],
 			      out_data[OUT_LATENT].data[0]+out_data[OUT_LATENT_SUB].data[0],
@@ -706,6 +722,8 @@ int  put_data(all_vars_struct   *all_vars,
     Temporal Aggregation 
     ********************/
   for (v=0; v<N_OUTVAR_TYPES; v++) {
+    if (!out_data[v].active)
+      continue;
     if (out_data[v].aggtype == AGG_TYPE_END) {
       for (i=0; i<out_data[v].nelem; i++) {
         out_data[v].aggdata[i] = out_data[v].data[i];
@@ -730,7 +748,7 @@ int  put_data(all_vars_struct   *all_vars,
     Output procedure
     (only execute when we've completed an output interval)
     ********************/
-  if (step_count == out_step_ratio) {
+  if (save_data->step_count == out_step_ratio) {
 
     /***********************************************
       Change of units for ALMA-compliant output
@@ -779,10 +797,10 @@ int  put_data(all_vars_struct   *all_vars,
       out_data[OUT_BARESOILT].aggdata[0] += KELVIN;
       out_data[OUT_SNOW_PACK_TEMP].aggdata[0] += KELVIN;
       out_data[OUT_SNOW_SURF_TEMP].aggdata[0] += KELVIN;
-      for (index=0; index<options.Nlayer; index++) {
+      for (index=0; index<OPT_Nlayer; index++) {
         out_data[OUT_SOIL_TEMP].aggdata[index] += KELVIN;
       }
-      for (index=0; index<options.Nnode; index++) {
+      for (index=0; index<OPT_Nnode; index++) {
         out_data[OUT_SOIL_TNODE].aggdata[index] += KELVIN;
         out_data[OUT_SOIL_TNODE_WL].aggdata[index] += KELVIN;
       }
@@ -801,9 +819,11 @@ int  put_data(all_vars_struct   *all_vars,
     /*************
       Write Data
     *************/
-    if(rec >= skipyear) {
+    if(rec >= skipyear && out_data_files != NULL) {
       if (options.BINARY_OUTPUT) {
         for (v=0; v<N_OUTVAR_TYPES; v++) {
+          if (!out_data[v].active)
+            continue;
           for (i=0; i<out_data[v].nelem; i++) {
             out_data[v].aggdata[i] *= out_data[v].mult;
           }
@@ -813,10 +833,12 @@ int  put_data(all_vars_struct   *all_vars,
     }
 
     // Reset the step count
-    step_count = 0;
+    save_data->step_count = 0;
 
     // Reset the agg data
     for (v=0; v<N_OUTVAR_TYPES; v++) {
+      if (!out_data[v].active)
+        continue;
       for (i=0; i<out_data[v].nelem; i++) {
         out_data[v].aggdata[i] = 0;
       }
@@ -858,7 +880,7 @@ void collect_wb_terms(cell_data_struct  cell,
 
   /** record evaporation components **/
   tmp_evap = 0.0;
-  for(index=0;index<options.Nlayer;index++) {
+  for(index=0;index<OPT_Nlayer;index++) {
     tmp_evap += cell.layer[index].evap;
     if (HasVeg) {
       out_data[OUT_EVAP_BARE].data[0] += cell.layer[index].evap * cell.layer[index].bare_evap_frac * AreaFactor;
@@ -936,7 +958,7 @@ void collect_wb_terms(cell_data_struct  cell,
   }
 
   /** record layer moistures **/
-  for(index=0;index<options.Nlayer;index++) {
+  for(index=0;index<OPT_Nlayer;index++) {
     tmp_moist = cell.layer[index].moist;
     tmp_ice = 0;
     for ( frost_area = 0; frost_area < options.Nfrost; frost_area++ )
@@ -957,7 +979,7 @@ void collect_wb_terms(cell_data_struct  cell,
   out_data[OUT_ZWT_LUMPED].data[0] += cell.zwt_lumped * AreaFactor;
 
   /** record layer temperatures **/
-  for(index=0;index<options.Nlayer;index++) {
+  for(index=0;index<OPT_Nlayer;index++) {
     out_data[OUT_SOIL_TEMP].data[index] += cell.layer[index].T * AreaFactor;
   }
 
@@ -991,7 +1013,7 @@ void collect_wb_terms(cell_data_struct  cell,
   /*****************************
     Record Carbon Cycling Variables 
   *****************************/
-  if (options.CARBON) {
+  if (OPT_CARBON) {
 
     out_data[OUT_APAR].data[0] += veg_var.aPAR * AreaFactor;
     out_data[OUT_GPP].data[0] += veg_var.GPP * MCg * SEC_PER_DAY * AreaFactor;
@@ -1008,14 +1030,14 @@ void collect_wb_terms(cell_data_struct  cell,
   /*****************************
     Record Irrigation Terms 
   *****************************/
-  if (options.IRRIGATION) {
+  if (OPT_IRRIGATION) {
     out_data[OUT_IRRIG].data[0] += veg_var.irrig * AreaFactor;
     out_data[OUT_IRR_EXTRACT].data[0] += cell.irr_extract * AreaFactor;
     //fprintf(stderr,"put_data A collect wb terms out_irrig %f irrig %f areafactor %f\n",out_data[OUT_IRRIG].data[0],veg_var.irrig,AreaFactor);
     //fprintf(stderr,"put_data B collect wb terms out_irr_extract %f cell_irr_extract %f areafactor %f\n",out_data[OUT_IRR_EXTRACT].data[0],cell.irr_extract,AreaFactor);
   }
 
-  if (options.IRRIGATION)
+  if (OPT_IRRIGATION)
 	out_data[OUT_IRRIG_WITH_PREC].data[0] = out_data[OUT_IRRIG].data[0] + out_data[OUT_PREC].data[0];
 
 }
@@ -1058,7 +1080,7 @@ void collect_eb_terms(energy_bal_struct energy,
   **********************************/
 
   /** record freezing and thawing front depths **/
-  if(options.FROZEN_SOIL) {
+  if(OPT_FROZEN_SOIL) {
     for(index = 0; index < MAX_FRONTS; index++) {
       if(energy.fdepth[index] != MISSING)
         out_data[OUT_FDEPTH].data[index] += energy.fdepth[index] * AreaFactor * 100.;
@@ -1086,7 +1108,7 @@ void collect_eb_terms(energy_bal_struct energy,
   **********************************/
 
   /** record surface radiative temperature **/
-  if ( overstory && snow.snow && !(options.LAKES && IsWet)) {
+  if ( overstory && snow.snow && !(OPT_LAKES && IsWet)) {
     rad_temp = energy.Tfoliage + KELVIN;
   }
   else
@@ -1113,11 +1135,11 @@ void collect_eb_terms(energy_bal_struct energy,
   out_data[OUT_SURF_TEMP].data[0] += surf_temp * AreaFactor;
   
   /** record thermal node temperatures **/
-  for(index=0;index<options.Nnode;index++) {
+  for(index=0;index<OPT_Nnode;index++) {
     out_data[OUT_SOIL_TNODE].data[index] += energy.T[index] * AreaFactor;
   }
   if (IsWet) {
-    for(index=0;index<options.Nnode;index++) {
+    for(index=0;index<OPT_Nnode;index++) {
       out_data[OUT_SOIL_TNODE_WL].data[index] = energy.T[index];
     }
   }
@@ -1125,7 +1147,7 @@ void collect_eb_terms(energy_bal_struct energy,
   /** record temperature flags  **/
   out_data[OUT_SURFT_FBFLAG].data[0] += energy.Tsurf_fbflag * AreaFactor;
   *Tsurf_fbcount_total += energy.Tsurf_fbcount;
-  for (index=0; index<options.Nnode; index++) {
+  for (index=0; index<OPT_Nnode; index++) {
     out_data[OUT_SOILT_FBFLAG].data[index] += energy.T_fbflag[index] * AreaFactor;
     *Tsoil_fbcount_total += energy.T_fbcount[index];
   }
@@ -1206,6 +1228,10 @@ void collect_eb_terms(energy_bal_struct energy,
     Record Band-Specific Variables
   **********************************/
 
+  /** band-specific variables are active as a group **/
+  if (!out_data[OUT_SWE_BAND].active)
+    return;
+
   /** record band snow water equivalent **/
   out_data[OUT_SWE_BAND].data[band] += snow.swq * Cv * lakefactor * 1000.;
 
@@ -5,6 +5,11 @@
 
 static char vcid[] = "$Id$";
 
+#define ASCII_BLOCK 1048576  /* bytes read at a time from ASCII files */
+
+static char *read_block(FILE *, size_t *);
+static int   parse_double(char **, char *, double *);
+
 void read_atmos_data(FILE                 *infile,
 		     global_param_struct   global_param,
 		     int                   file_num,
@@ -60,6 +65,12 @@ void read_atmos_data(FILE                 *infile,
   2014-Apr-25 Added non-climatological veg parameters (as forcing
 	      variables).						TJB
   2014-Apr-25 Added partial vegcover fraction.				TJB
+  2026-Oct-18 ASCII files are read in one block and parsed in memory
+	      instead of with one fscanf() per value.  Records are
+	      counted as before.
+  2026-Oct-18 parse_double() reads incomplete exponents and signs
+	      without digits as fscanf() does (checked by
+	      bench/forcing_bench.c).
 
   **********************************************************************/
 {
@@ -81,6 +92,11 @@ void read_atmos_data(FILE                 *infile,
   char            ErrStr[MAXSTRING+1];
   unsigned short  Identifier[4];
   int             Nbytes;
+  char           *block;
+  char           *p;
+  char           *end;
+  char            at_eof;
+  size_t          size;
 
   Nfields     = param_set.N_TYPES[file_num];
   field_index = param_set.FORCE_INDEX[file_num];
@@ -219,30 +235,46 @@ void read_atmos_data(FILE                 *infile,
     // and to any other functions that read the files, so that those functions could
     // also read the headers if necessary).
 
+    /* read the rest of the file into memory; the loops below follow
+       the fscanf()/fgets() calls they replace, including how the end
+       of the file is detected */
+    block = read_block(infile, &size);
+    p     = block;
+    end   = block + size;
+
     /* skip to the beginning of the required met data */
     for(i=0;i<skip_recs;i++){
-      if( fgets(str, MAXSTRING, infile) == NULL )
+      if( p == end )
 	nrerror("No data for the specified time period in the forcing file.  Model stopping...");
+      while( p < end && *p++ != '\n' );
     }
 	  
     /* read forcing data */
     rec=0;
+    at_eof=FALSE;
 
-    while( !feof(infile) && (rec * param_set.FORCE_DT[file_num] 
+    while( !at_eof && (rec * param_set.FORCE_DT[file_num] 
 			      < global_param.nrecs * global_param.dt ) ) {
       for(i=0;i<Nfields;i++) {
         if (field_index[i] != ALBEDO && field_index[i] != LAI_IN && field_index[i] != VEGCOVER) {
-	  fscanf(infile,"%lf", &forcing_data[field_index[i]][rec]);
+	  parse_double(&p, end, &forcing_data[field_index[i]][rec]);
+	  if (p == end) at_eof = TRUE;
         }
         else {
           for(j=0;j<param_set.TYPE[field_index[i]].N_ELEM;j++) {
-	    fscanf(infile,"%lf", &veg_hist_data[field_index[i]][j][rec]);
+	    parse_double(&p, end, &veg_hist_data[field_index[i]][j][rec]);
+	    if (p == end) at_eof = TRUE;
           }
         }
       }
-      fgets(str, MAXSTRING, infile);
+      /* rest of the line */
+      while( p < end && *p != '\n' ) p++;
+      if( p == end ) at_eof = TRUE;
+      else p++;
       rec++;
     }
+
+    free(block);
   }
   
   if(rec * param_set.FORCE_DT[file_num] 
@@ -254,3 +286,143 @@ void read_atmos_data(FILE                 *infile,
   }
   
 }
+
+/* Reads the rest of a file into a '\0'-terminated block; size is
+   the number of bytes read */
+static char *read_block(FILE   *infile,
+			size_t *size)
+{
+  char   *block;
+  size_t  alloc;
+  size_t  n;
+
+  alloc = ASCII_BLOCK;
+  block = (char *)malloc(alloc+1);
+  *size = 0;
+  while (block != NULL
+	 && (n = fread(block + *size, 1, alloc - *size, infile)) > 0) {
+    *size += n;
+    if (*size == alloc) {
+      alloc *= 2;
+      block = (char *)realloc(block, alloc+1);
+    }
+  }
+  if (block == NULL)
+    nrerror("Memory allocation error in read_atmos_data().");
+  block[*size] = '\0';
+
+  return block;
+}
+
+/* Skips white space and converts the number at *p like fscanf("%lf"),
+   leaving *p where fscanf() would leave the file: after the longest
+   prefix of a number, e.g. after "1e" in "1e x", or after the sign in
+   "- 1".  Returns FALSE, with *value unchanged, if there is no number.
+   Decimal numbers of up to 15 digits with a power-of-ten scale within
+   10^22 are converted here, exactly (one correctly rounded
+   multiplication or division); longer ones, nan, inf and hexadecimal
+   numbers are left to strtod(). */
+static int parse_double(char  **p,
+			char   *end,
+			double *value)
+{
+  static const double pow10[] = { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7,
+				   1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14,
+				   1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21,
+				   1e22 };
+  char               *c;
+  char               *num_end;
+  char                neg;
+  char                point;
+  unsigned long long  mant;
+  int                 ndigits;
+  int                 nread;
+  int                 scale;
+  int                 exp10;
+  int                 eneg;
+  double              x;
+
+  c = *p;
+  while (c < end && (*c == ' ' || *c == '\t' || *c == '\n' || *c == '\r'
+		     || *c == '\v' || *c == '\f'))
+    c++;
+  *p = c;
+  if (c == end)
+    return FALSE;
+
+  neg = FALSE;
+  if (*c == '-' || *c == '+') {
+    neg = (*c == '-');
+    c++;
+  }
+  mant    = 0;
+  ndigits = 0;
+  nread   = 0;
+  scale   = 0;
+  while (*c >= '0' && *c <= '9') {
+    mant = mant * 10 + (*c - '0');
+    if (mant > 0) ndigits++;
+    nread++;
+    c++;
+  }
+  point = FALSE;
+  if (*c == '.') {
+    point = TRUE;
+    c++;
+    while (*c >= '0' && *c <= '9') {
+      mant = mant * 10 + (*c - '0');
+      if (mant > 0) ndigits++;
+      nread++;
+      scale--;
+      c++;
+    }
+  }
+
+  if ((nread == 1 && mant == 0 && !point && (*c == 'x' || *c == 'X'))
+      || (nread == 0 && !point && (*c == 'n' || *c == 'N' || *c == 'i'
+				   || *c == 'I'))) {
+    /* hexadecimal, nan or inf */
+    x = strtod(*p, &num_end);
+    if (num_end == *p)
+      return FALSE;
+    *value = x;
+    *p = num_end;
+    return TRUE;
+  }
+  if (nread == 0) {
+    /* a sign or a point without digits: fscanf() fails after
+       reading them */
+    *p = c;
+    return FALSE;
+  }
+
+  /* an exponent is read up to its last digit; "e" or "e+" without
+     digits is read too and ignored, as fscanf() does */
+  exp10 = 0;
+  if (*c == 'e' || *c == 'E') {
+    c++;
+    eneg = FALSE;
+    if (*c == '-' || *c == '+') {
+      eneg = (*c == '-');
+      c++;
+    }
+    while (*c >= '0' && *c <= '9') {
+      if (exp10 < 10000) exp10 = exp10 * 10 + (*c - '0');
+      c++;
+    }
+    if (eneg) exp10 = -exp10;
+  }
+  exp10 += scale;
+
+  if (ndigits > 15 || exp10 < -22 || exp10 > 22)
+    x = strtod(*p, NULL);
+  else {
+    x = (double)mant;
+    if (exp10 < 0) x /= pow10[-exp10];
+    else x *= pow10[exp10];
+    if (neg) x = -x;
+  }
+  *value = x;
+  *p = c;
+  return TRUE;
+}
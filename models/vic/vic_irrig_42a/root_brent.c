@@ -11,6 +11,10 @@
  *               method.  
  * DESCRIP-END.
  * FUNCTIONS:    RootBrent()
+ *               root_brent_warm()
+ *               reset_root_stats()
+ *               print_root_stats()
+ *               use_root_stats()
  * COMMENTS:     
  */
 
@@ -34,6 +38,29 @@ static char vcid[] = "$Id$";
 #define MACHEPS 3e-8
 #define TSTEP   10
 #define T       1e-7   
+#define WARM_MIN_DT 0.01  /* smallest half-width of a warm-start bracket (C) */
+#define WARM_FACTOR 2.0   /* half-width as a multiple of the mean change of
+                             the solution from its initial guess */
+#define WARM_WEIGHT 0.9   /* weight of the history in that mean change */
+#define WARM_GROW   1.6   /* growth factor of a bracket that missed the root */
+
+#define EVAL(x) (stats->nevals++, Function((x), params))
+
+/* Statistics of the cell being run (see use_root_stats()); root_brent()
+   calls made outside a cell are counted in default_root_stats */
+static root_stats_struct default_root_stats[N_ROOT_SITES];
+static root_stats_struct *root_stats = default_root_stats;
+
+static char *root_site_names[N_ROOT_SITES] = {
+  "Tfoliage", "Tcanopy", "Tsnowsurf", "Tsurf", "soil T profile", "Tlakeice"
+};
+
+static double brent_bracket(double, double, char *,
+			    double (*)(double, void *), void *,
+			    root_stats_struct *);
+static double brent_search(double, double, double, double, char *,
+			   double (*)(double, void *), void *,
+			   root_stats_struct *);
 
 /*****************************************************************************
   GENERAL DOCUMENTATION FOR THIS MODULE
@@ -63,6 +90,21 @@ static char vcid[] = "$Id$";
   If this is not the case the program will abort.  In addition the program
   will perform not more than a certain number of iterations, as specified
   in brent.h, and will abort if more iterations are needed.
+
+  root_brent_warm() is used for temperatures that change little from one
+  call to the next.  When options.ROOT_WARMSTART is set, it first brackets
+  the root around an initial guess (normally the solution of the previous
+  time step or iteration), with a half-width that follows the recent
+  changes of the solution at the same call site.  A bracket that misses
+  the root is widened on one side only, past the secant estimate of the
+  root, so every evaluation is kept.  If that fails it falls back to the
+  fixed bracket of root_brent().
+
+  Every call is counted against its call site (ROOT_* in vicNl_def.h),
+  in the statistics of the cell being run, which also hold the
+  warm-start history.  vic_cell_step() selects them with
+  use_root_stats(); print_root_stats() reports them at the end of a
+  cell when options.ROOT_STATS is set.
 ******************************************************************************/
   
 /*****************************************************************************
@@ -71,17 +113,14 @@ static char vcid[] = "$Id$";
   Purpose      : Calculate the surface temperature
 
   Required     :
+    int site              - Call site, for the iteration statistics
     double LowerBound     - Lower bound for root
     double UpperBound     - Upper bound for root
     char *ErrorString     - For storing description of errors (if any)
-    double (*Function)(double Estimate, va_list ap)
-    ...                   - Variable arguments 
-                            The number and order of arguments has to be
-                            appropriate for the Function pointed to, since
-                            the list of arguments after Nargs will be passed
-                            on to Function.
-                            See the appropriate Function for the correct
-                            arguments. 
+    double (*Function)(double Estimate, void *params)
+    void *params          - Argument structure of Function, passed on
+                            unchanged at every evaluation.  See the
+                            appropriate Function for the structure type.
 
   Returns      :
     double b              - Effective surface temperature (C)
@@ -101,46 +140,237 @@ static char vcid[] = "$Id$";
   2007-Sep-01 Removed the integer "eval" since it is never used for anything.	JCA
   2009-May-22 Modified root-bracketing scheme to handle case when one bound
 	      yields garbage output from the target function.			TJB
+  2026-Oct-18 Replaced the variable argument list with a pointer to an
+	      argument structure that the caller fills once per solve, rather
+	      than marshalling the argument list at every evaluation.
+  2026-Oct-18 Added the call site argument; function evaluations are
+	      counted per call site.  Split the root search into
+	      brent_search() so that root_brent_warm() can share it.
+  2026-Oct-18 The statistics are those selected by use_root_stats().
+	      Initialized last_bad, c, d and e on every path.
+*****************************************************************************/
+double root_brent(int site, double LowerBound, double UpperBound,
+		  char *ErrorString,
+		  double (*Function)(double Estimate, void *params),
+		  void *params)
+{
+  root_stats_struct *stats;
+  double root;
+
+  stats = &root_stats[site];
+  stats->ncalls++;
+  root = brent_bracket(LowerBound, UpperBound, ErrorString, Function, params,
+		       stats);
+  if (root == ERROR) stats->nfail++;
+
+  return root;
+}
+
+/*****************************************************************************
+  Function name: root_brent_warm()
+
+  Purpose      : Calculate the root of Function starting from an initial
+                 guess
+
+  Required     :
+    int site              - Call site, for the iteration statistics and the
+                            width of the warm-start bracket
+    double Guess          - Initial guess of the root
+    double LowerBound     - Lower bound for root, as for root_brent()
+    double UpperBound     - Upper bound for root, as for root_brent()
+    char *ErrorString     - For storing description of errors (if any)
+    double (*Function)(double Estimate, void *params)
+    void *params          - Argument structure of Function
+
+  Returns      :
+    double                - Root of Function, or ERROR
+
+  Modifies     : 
+    char *ErrorString     - Stores description of errors
+
+  Comments     :
+    Same as root_brent() unless options.ROOT_WARMSTART is TRUE.  The
+    warm-start bracket is not widened beyond the interval root_brent()
+    would search when starting from [LowerBound, UpperBound]; a guess
+    outside that interval uses root_brent() itself.
+*****************************************************************************/
+double root_brent_warm(int site, double Guess, double LowerBound,
+		       double UpperBound, char *ErrorString,
+		       double (*Function)(double Estimate, void *params),
+		       void *params)
+{
+  extern option_struct options;
+
+  root_stats_struct *stats;
+  double width;
+  double step;
+  double LowerLimit;
+  double UpperLimit;
+  double a;
+  double b;
+  double fa;
+  double fb;
+  double root;
+
+  LowerLimit = LowerBound - MAXTRIES * TSTEP;
+  UpperLimit = UpperBound + MAXTRIES * TSTEP;
+  if (!options.ROOT_WARMSTART || Guess <= LowerLimit || Guess >= UpperLimit)
+    return root_brent(site, LowerBound, UpperBound, ErrorString, Function,
+		      params);
+
+  stats = &root_stats[site];
+  stats->ncalls++;
+
+  /* half-width of the bracket from the recent changes of the solution */
+  width = 0.5 * (UpperBound - LowerBound);
+  if (stats->nhist > 0 && WARM_FACTOR * stats->mean_shift < width)
+    width = WARM_FACTOR * stats->mean_shift;
+  if (width < WARM_MIN_DT) width = WARM_MIN_DT;
+
+  a = Guess - width;
+  b = Guess + width;
+  if (a < LowerLimit) a = LowerLimit;
+  if (b > UpperLimit) b = UpperLimit;
+  fa = EVAL(a);
+  fb = EVAL(b);
+
+  /* if the bracket missed the root, move the end nearer to the root past
+     the secant estimate of the root (keeping the points already
+     evaluated), until the bracket contains the root or reaches as far as
+     the bracket of root_brent() could be widened */
+  while (fa != ERROR && fb != ERROR && fa * fb > 0
+	 && a > LowerLimit && b < UpperLimit) {
+    if (fabs(fa) < fabs(fb)) {
+      step = (fa != fb) ? WARM_GROW * fabs(fa * (b - a) / (fb - fa)) : 0;
+      if (step < b - a) step = b - a;
+      a -= step;
+      if (a < LowerLimit) a = LowerLimit;
+      fa = EVAL(a);
+    }
+    else {
+      step = (fa != fb) ? WARM_GROW * fabs(fb * (b - a) / (fb - fa)) : 0;
+      if (step < b - a) step = b - a;
+      b += step;
+      if (b > UpperLimit) b = UpperLimit;
+      fb = EVAL(b);
+    }
+  }
+
+  if (fa != ERROR && fb != ERROR && fa * fb <= 0) {
+    root = brent_search(a, b, fa, fb, ErrorString, Function, params, stats);
+    if (root != ERROR) stats->nwarm++;
+  }
+  else
+    root = brent_bracket(LowerBound, UpperBound, ErrorString, Function,
+			 params, stats);
+
+  if (root == ERROR)
+    stats->nfail++;
+  else {
+    stats->mean_shift = WARM_WEIGHT * stats->mean_shift
+      + (1. - WARM_WEIGHT) * fabs(root - Guess);
+    if (stats->nhist == 0) stats->mean_shift = fabs(root - Guess);
+    stats->nhist++;
+  }
+
+  return root;
+}
+
+/*****************************************************************************
+  Function name: use_root_stats()
+
+  Purpose      : Select the statistics (N_ROOT_SITES of them) that the
+                 following calls of root_brent() and root_brent_warm()
+                 update; NULL selects statistics kept here, for calls
+                 made outside a cell
+*****************************************************************************/
+void use_root_stats(root_stats_struct *stats)
+{
+  root_stats = (stats != NULL) ? stats : default_root_stats;
+}
+
+/*****************************************************************************
+  Function name: reset_root_stats()
+
+  Purpose      : Reset the iteration statistics and the warm-start history
+                 of all call sites, at the start of a cell
+*****************************************************************************/
+void reset_root_stats(root_stats_struct *stats)
+{
+  int site;
+
+  for (site = 0; site < N_ROOT_SITES; site++) {
+    stats[site].ncalls     = 0;
+    stats[site].nevals     = 0;
+    stats[site].nwarm      = 0;
+    stats[site].nfail      = 0;
+    stats[site].nhist      = 0;
+    stats[site].mean_shift = 0.;
+  }
+}
+
+/*****************************************************************************
+  Function name: print_root_stats()
+
+  Purpose      : Report the iteration statistics of all call sites that
+                 were used
+*****************************************************************************/
+void print_root_stats(root_stats_struct *stats)
+{
+  extern option_struct options;
+
+  int site;
+
+  fprintf(stderr,"Temperature solutions (calls, function evaluations, evaluations per call%s, failures):\n",
+	  options.ROOT_WARMSTART ? ", found in warm-start bracket" : "");
+  for (site = 0; site < N_ROOT_SITES; site++) {
+    if (stats[site].ncalls == 0) continue;
+    fprintf(stderr,"  %-15s %ld %ld %.2f", root_site_names[site],
+	    stats[site].ncalls, stats[site].nevals,
+	    (double)stats[site].nevals / (double)stats[site].ncalls);
+    if (options.ROOT_WARMSTART)
+      fprintf(stderr," %ld", stats[site].nwarm);
+    fprintf(stderr," %ld\n", stats[site].nfail);
+  }
+}
+
+/*****************************************************************************
+  Function name: brent_bracket()
+
+  Purpose      : Bracket the root starting from [LowerBound, UpperBound]
+                 and search it with brent_search(); this is the body of
+                 root_brent()
 *****************************************************************************/
-double root_brent(double LowerBound, double UpperBound, char *ErrorString,
-                double (*Function)(double Estimate, va_list ap), ...)
+static double brent_bracket(double LowerBound, double UpperBound,
+			    char *ErrorString,
+			    double (*Function)(double Estimate, void *params),
+			    void *params, root_stats_struct *stats)
 {
   const char *Routine = "RootBrent";
-  va_list ap;                   /* Used in traversing variable argument list */ 
   double a;
   double b;
   double c;
-  double d;
-  double e;
   double fa;
   double fb;
   double fc;
-  double m;
-  double p;
-  double q;
-  double r;
-  double s;
-  double tol;
   double last_bad;
   double last_good;
   int which_err;
   int i;
   int j;
 
-  /* initialize variable argument list */
   a = LowerBound;
   b = UpperBound;
-  va_start(ap, Function);
-  fa = Function(a, ap);
-  va_start(ap, Function);
-  fb = Function(b, ap);
+  fa = EVAL(a);
+  fb = EVAL(b);
  
   which_err = 0;
+  last_bad  = a;
+  last_good = b;
 
   // If Function returns values of ERROR for both bounds, give up
   if (fa == ERROR && fb == ERROR) {
     sprintf(ErrorString,"ERROR: %s: lower and upper bounds %f and %f failed to bracket the root because the given function was not defined at either point.\n",Routine,a,b);
-    va_end(ap);
     return(ERROR);
   }      
 
@@ -160,23 +390,20 @@ double root_brent(double LowerBound, double UpperBound, char *ErrorString,
     }
 
     c = 0.5*(last_bad+last_good);
-    va_start(ap, Function);
-    fc = Function(c, ap);
+    fc = EVAL(c);
 
     /* search for valid point via bisection */
     j = 0;
     while (fc == ERROR && j < MAXITER) {
       last_bad = c;
       c = 0.5*(last_bad+last_good);
-      va_start(ap, Function);
-      fc = Function(c, ap);
+      fc = EVAL(c);
       j++;
     }
 
     if (fc == ERROR) {
       /* if we get here, we could not find a bound for which the function returns a valid value */
       sprintf(ErrorString,"ERROR: %s: the given function produced undefined values while attempting to bracket the root between %f and %f.\n",Routine,LowerBound,UpperBound);
-      va_end(ap);
       return(ERROR);
     }
     else {
@@ -201,32 +428,26 @@ double root_brent(double LowerBound, double UpperBound, char *ErrorString,
     if (which_err == 0) { // No undefined values were encountered
       a -= TSTEP;
       b += TSTEP;
-      va_start(ap, Function);
-      fa = Function(a, ap);
-      va_start(ap, Function);
-      fb = Function(b, ap);
+      fa = EVAL(a);
+      fb = EVAL(b);
     }
     else { // Undefined values were encountered
       if (which_err == -1) { // Undefined values encountered in the lower direction
         b += TSTEP;
-        va_start(ap, Function);
-        fb = Function(b, ap);
+        fb = EVAL(b);
         if (fb == ERROR) {
           /* Undefined function values in both directions - give up */
           sprintf(ErrorString,"ERROR: %s: the given function produced undefined values while attempting to bracket the root between %f and %f.\n",Routine,LowerBound,UpperBound);
-          va_end(ap);
           return(ERROR);
         }
         last_good = a;
       }
       else { // Undefined values encountered in the upper direction
         a -= TSTEP;
-        va_start(ap, Function);
-        fa = Function(a, ap);
+        fa = EVAL(a);
         if (fa == ERROR) {
           /* Undefined function values in both directions - give up */
           sprintf(ErrorString,"ERROR: %s: the given function produced undefined values while attempting to bracket the root between %f and %f.\n",Routine,LowerBound,UpperBound);
-          va_end(ap);
           return(ERROR);
         }
         last_good = b;
@@ -234,21 +455,18 @@ double root_brent(double LowerBound, double UpperBound, char *ErrorString,
 
       /* search for valid point via bisection */
       c = 0.5*(last_good+last_bad);
-      va_start(ap, Function);
-      fc = Function(c, ap);
+      fc = EVAL(c);
       i = 0;
       while (fc == ERROR && i < MAXITER) {
         last_bad = c;
         c = 0.5*(last_bad+last_good);
-        va_start(ap, Function);
-        fc = Function(c, ap);
+        fc = EVAL(c);
         i++;
       }
 
       if (fc == ERROR) {
         /* if we get here, we could not find a bound for which the function returns a valid value */
         sprintf(ErrorString,"ERROR: %s: the given function produced undefined values while attempting to bracket the root between %f and %f.\n",Routine,LowerBound,UpperBound);
-        va_end(ap);
         return(ERROR);
       }
       else {
@@ -269,7 +487,6 @@ double root_brent(double LowerBound, double UpperBound, char *ErrorString,
   if ((fa * fb) >= 0) {
     /* if we get here, the lower and upper bounds did not bracket the root */
     sprintf(ErrorString,"WARNING: %s: lower and upper bounds %f and %f failed to bracket the root.\n",Routine,a,b);
-    va_end(ap);
     return(ERROR);
   }
 
@@ -277,7 +494,38 @@ double root_brent(double LowerBound, double UpperBound, char *ErrorString,
  
   // Now search for the root
 
+  return brent_search(a, b, fa, fb, ErrorString, Function, params, stats);
+
+}
+
+/*****************************************************************************
+  Function name: brent_search()
+
+  Purpose      : Search the root in a bracket [a, b] with f(a) = fa and
+                 f(b) = fb of opposite signs
+*****************************************************************************/
+static double brent_search(double a, double b, double fa, double fb,
+			   char *ErrorString,
+			   double (*Function)(double Estimate, void *params),
+			   void *params, root_stats_struct *stats)
+{
+  const char *Routine = "RootBrent";
+  double c;
+  double d;
+  double e;
+  double fc;
+  double m;
+  double p;
+  double q;
+  double r;
+  double s;
+  double tol;
+  int i;
+
+  c  = a;
   fc = fb;
+  d  = b - a;
+  e  = d;
 
   for (i = 0; i < MAXITER; i++) {
 
@@ -301,7 +549,6 @@ double root_brent(double LowerBound, double UpperBound, char *ErrorString,
     m = 0.5 * (c - b);
     
     if (fabs(m) <= tol || fb == 0) {
-      va_end(ap);
       return b;
     }
     
@@ -347,13 +594,11 @@ double root_brent(double LowerBound, double UpperBound, char *ErrorString,
       a = b;
       fa = fb;
       b += (fabs(d) > tol) ? d : ((m > 0) ? tol : -tol);
-      va_start(ap, Function);
-      fb = Function(b, ap);
+      fb = EVAL(b);
 
       // Catch ERROR values returned from Function
       if(fb == ERROR){
 	sprintf(ErrorString,"ERROR returned to root_brent on iteration %d: temperature = %.4f\n",i+1,b);
-	va_end(ap);
 	return( ERROR );
       }      
 
@@ -361,7 +606,6 @@ double root_brent(double LowerBound, double UpperBound, char *ErrorString,
   }
   /* If we get here, there were too many iterations */
   sprintf(ErrorString,"WARNING: %s: too many iterations.\n",Routine);
-  va_end(ap);
   return(ERROR);
 
 }
@@ -371,3 +615,8 @@ double root_brent(double LowerBound, double UpperBound, char *ErrorString,
 #undef MACHEPS
 #undef TSTEP
 #undef T
+#undef WARM_MIN_DT
+#undef WARM_FACTOR
+#undef WARM_WEIGHT
+#undef WARM_GROW
+#undef EVAL
@@ -4,6 +4,11 @@
 #include <math.h>
 
 static char vcid[] = "$Id$";
+
+static void layer_drainage(soil_con_struct *, int, int, double, double *,
+			   double *, double [][MAX_LAYERS], double [][MAX_LAYERS],
+			   double [][MAX_LAYERS], double *, double *);
+
 int  runoff(cell_data_struct  *cell,
             energy_bal_struct *energy,
             soil_con_struct   *soil_con,
@@ -166,43 +171,31 @@ int  runoff(cell_data_struct  *cell,
   2013-Dec-27 Removed QUICK_FS option.						TJB
   2014-Mar-28 Removed DIST_PRCP option.						TJB
   2014-May-09 Added check on liquid soil moisture to ensure always >= 0.	TJB
+  2026-Oct-18 Moved the hourly drainage and baseflow computation to
+	      layer_drainage(), which sets up the soil parameters once
+	      for all frost areas of the tile.
+  2026-Oct-18 Options are read through OPT_* (see vicNl_def.h), so
+	      that specialized builds can fix them at compile time.
 **********************************************************************/
 {  
   extern option_struct options;
-  int                firstlayer, lindex;
+  int                lindex;
   int                i;
-  int                last_layer[MAX_LAYERS*3];
-  int                last_index;
-  int                last_cnt;
-  int                time_step;
-  int                tmplayer;
   int                frost_area;
   int                ErrorFlag;
-  double             A, frac;
+  double             A;
   double             tmp_runoff;
-  double             inflow;
   double             resid_moist[MAX_LAYERS]; // residual moisture (mm)
   double             org_moist[MAX_LAYERS];   // total soil moisture (liquid and frozen) at beginning of this function (mm)
   double             avail_liq[MAX_LAYERS][MAX_FROST_AREAS]; // liquid soil moisture available for evap/drainage (mm)
-  double             liq[MAX_LAYERS];         // current liquid soil moisture (mm)
-  double             ice[MAX_LAYERS];         // current frozen soil moisture (mm)
+  double             liq[MAX_FROST_AREAS][MAX_LAYERS]; // current liquid soil moisture (mm)
+  double             ice[MAX_FROST_AREAS][MAX_LAYERS]; // current frozen soil moisture (mm)
   double             moist[MAX_LAYERS];       // current total soil moisture (liquid and frozen) (mm)
-  double             max_moist[MAX_LAYERS];   // maximum storable moisture (liquid and frozen) (mm)
-  double             Ksat[MAX_LAYERS];
-  double             Q12[MAX_LAYERS-1];
-  double             Dsmax;
-  double             tmp_inflow;
-  double             tmp_moist;
   double             tmp_moist_for_runoff[MAX_LAYERS];
-  double             tmp_liq;
-  double             dt_inflow;
-  double             dt_runoff;
   double             runoff[MAX_FROST_AREAS];
   double             tmp_dt_runoff[MAX_FROST_AREAS];
   double             baseflow[MAX_FROST_AREAS];
-  double             dt_baseflow;
-  double             rel_moist;
-  double             evap[MAX_LAYERS][MAX_FROST_AREAS];
+  double             evap[MAX_FROST_AREAS][MAX_LAYERS];
   double             sum_liq;
   double             evap_fraction;
   double             evap_sum;
@@ -210,12 +203,11 @@ int  runoff(cell_data_struct  *cell,
   double             max_temp;
   double             tmp_fract;
   double             Tlayer_spatial[MAX_LAYERS][MAX_FROST_AREAS];
-  double             b[MAX_LAYERS];
   layer_data_struct *layer;
   layer_data_struct  tmp_layer;
 
   /** Set Residual Moisture **/
-  for ( i = 0; i < options.Nlayer; i++ ) 
+  for ( i = 0; i < OPT_Nlayer; i++ ) 
     resid_moist[i] = soil_con->resid_moist[i] * soil_con->depth[i] * 1000.;
 
   /** Allocate and Set Values for Soil Sublayers **/
@@ -228,11 +220,11 @@ int  runoff(cell_data_struct  *cell,
   for ( frost_area = 0; frost_area < options.Nfrost; frost_area++ )
     baseflow[frost_area] = 0;
       
-  for ( lindex = 0; lindex < options.Nlayer; lindex++ ) {
-    evap[lindex][0] = layer[lindex].evap/(double)dt;
+  for ( lindex = 0; lindex < OPT_Nlayer; lindex++ ) {
+    evap[0][lindex] = layer[lindex].evap/(double)dt;
     org_moist[lindex] = layer[lindex].moist;
     layer[lindex].moist = 0;
-    if ( evap[lindex][0] > 0 ) { // if there is positive evaporation
+    if ( evap[0][lindex] > 0 ) { // if there is positive evaporation
       sum_liq = 0;
       // compute available soil moisture for each frost sub area.
       for ( frost_area = 0; frost_area < options.Nfrost; frost_area++ ) {
@@ -242,29 +234,30 @@ int  runoff(cell_data_struct  *cell,
       }
       // compute fraction of available soil moisture that is evaporated
       if (sum_liq > 0) {
-        evap_fraction = evap[lindex][0] / sum_liq;
+        evap_fraction = evap[0][lindex] / sum_liq;
       }
       else {
         evap_fraction = 1.0;
       }
       // distribute evaporation between frost sub areas by percentage
-      evap_sum = evap[lindex][0];
+      evap_sum = evap[0][lindex];
       for ( frost_area = options.Nfrost - 1; frost_area >= 0; frost_area-- ) {
-        evap[lindex][frost_area] = avail_liq[lindex][frost_area] * evap_fraction;
-        avail_liq[lindex][frost_area] -= evap[lindex][frost_area];
-        evap_sum -= evap[lindex][frost_area] * frost_fract[frost_area];
+        evap[frost_area][lindex] = avail_liq[lindex][frost_area] * evap_fraction;
+        avail_liq[lindex][frost_area] -= evap[frost_area][lindex];
+        evap_sum -= evap[frost_area][lindex] * frost_fract[frost_area];
       }
     }
     else {
       for ( frost_area = options.Nfrost - 1; frost_area > 0; frost_area-- )
-        evap[lindex][frost_area] = evap[lindex][0];
+        evap[frost_area][lindex] = evap[0][lindex];
     }
   }
 
   // compute temperatures of frost subareas
-  for ( lindex = 0; lindex < options.Nlayer; lindex++ ) {
+  for ( lindex = 0; lindex < OPT_Nlayer; lindex++ ) {
     min_temp = layer[lindex].T - soil_con->frost_slope / 2.;
     max_temp = min_temp + soil_con->frost_slope;
+    tmp_fract = 0;
     for ( frost_area = 0; frost_area < options.Nfrost; frost_area++ ) {
       if ( options.Nfrost > 1 ) {
         if ( frost_area == 0 ) tmp_fract = frost_fract[0] / 2.;
@@ -275,258 +268,328 @@ int  runoff(cell_data_struct  *cell,
     }
   }
 
-  for ( frost_area = 0; frost_area < options.Nfrost; frost_area++ ) {
-
-    /** ppt = amount of liquid water coming to the surface **/
-    inflow = ppt;
-	
-    /**************************************************
-      Initialize Variables
-    **************************************************/
-    for ( lindex = 0; lindex < options.Nlayer; lindex++ ) {
-      Ksat[lindex]         = soil_con->Ksat[lindex] / 24.;
-      b[lindex]            = (soil_con->expt[lindex] - 3.) / 2.;
+  /**************************************************
+    Initialize Variables
+  **************************************************/
+  for ( lindex = 0; lindex < OPT_Nlayer; lindex++ ) {
+    for ( frost_area = 0; frost_area < options.Nfrost; frost_area++ ) {
 
       /** Set Layer Liquid Moisture Content **/
-      liq[lindex] = org_moist[lindex] - layer[lindex].ice[frost_area];
+      liq[frost_area][lindex] = org_moist[lindex] - layer[lindex].ice[frost_area];
 
       /** Set Layer Frozen Moisture Content **/
-      ice[lindex]       = layer[lindex].ice[frost_area];
-
-      /** Set Layer Maximum Moisture Content **/
-      max_moist[lindex] = soil_con->max_moist[lindex];
+      ice[frost_area][lindex] = layer[lindex].ice[frost_area];
 
-    } // initialize variables for each layer
+    }
+  } // initialize variables for each layer
 
-    /******************************************************
-      Runoff Based on Soil Moisture Level of Upper Layers
-    ******************************************************/
+  /******************************************************
+    Runoff Based on Soil Moisture Level of Upper Layers
+  ******************************************************/
 
-    for(lindex=0;lindex<options.Nlayer;lindex++) {
-      tmp_moist_for_runoff[lindex] = (liq[lindex] + ice[lindex]);
+  for ( frost_area = 0; frost_area < options.Nfrost; frost_area++ ) {
+    for(lindex=0;lindex<OPT_Nlayer;lindex++) {
+      tmp_moist_for_runoff[lindex] = (liq[frost_area][lindex] + ice[frost_area][lindex]);
     }
-    compute_runoff_and_asat(soil_con, tmp_moist_for_runoff, inflow, &A, &(runoff[frost_area]));
+    compute_runoff_and_asat(soil_con, tmp_moist_for_runoff, ppt, &A, &(runoff[frost_area]));
 
     // save dt_runoff based on initial runoff estimate,
     // since we will modify total runoff below for the case of completely saturated soil
     tmp_dt_runoff[frost_area] = runoff[frost_area] / (double) dt;
-	  
-    /**************************************************
-      Compute Flow Between Soil Layers (using an hourly time step)
-    **************************************************/
-	  
-    dt_inflow  =  inflow / (double) dt;
-	  
+  }
+
+  /**************************************************
+    Compute Flow Between Soil Layers and Baseflow
+    (using an hourly time step) for all frost areas
+  **************************************************/
+
+  layer_drainage(soil_con, dt, options.Nfrost, ppt / (double) dt,
+		 tmp_dt_runoff, resid_moist, evap, liq, ice,
+		 runoff, baseflow);
+
+  for ( frost_area = 0; frost_area < options.Nfrost; frost_area++ ) {
+
+    /** If negative baseflow, reduce evap accordingly **/
+    if ( baseflow[frost_area] < 0 ) {
+      layer[OPT_Nlayer-1].evap += baseflow[frost_area];
+      baseflow[frost_area]          = 0;
+    }
+
+    /** Recompute Asat based on final moisture level of upper layers **/
+    for(lindex=0;lindex<OPT_Nlayer;lindex++) {
+      tmp_moist_for_runoff[lindex] = (liq[frost_area][lindex] + ice[frost_area][lindex]);
+    }
+    compute_runoff_and_asat(soil_con, tmp_moist_for_runoff, 0, &A, &tmp_runoff);
+
+    /** Store tile-wide values **/
+    for ( lindex = 0; lindex < OPT_Nlayer; lindex++ ) 
+      layer[lindex].moist += ((liq[frost_area][lindex] + ice[frost_area][lindex]) * frost_fract[frost_area]); 
+    cell->asat     += A * frost_fract[frost_area];
+    cell->runoff   += runoff[frost_area] * frost_fract[frost_area];
+    cell->baseflow += baseflow[frost_area] * frost_fract[frost_area];
+
+  }
+
+  /** Compute water table depth **/
+  wrap_compute_zwt(soil_con, cell);
+
+  /** Recompute Thermal Parameters Based on New Moisture Distribution **/
+  if(OPT_FULL_ENERGY || OPT_FROZEN_SOIL) {
+    
+    for(lindex=0;lindex<OPT_Nlayer;lindex++) {
+      tmp_layer = cell->layer[lindex];
+      moist[lindex] = tmp_layer.moist;
+    }
+    
+    ErrorFlag = distribute_node_moisture_properties(energy->moist, energy->ice,
+						    energy->kappa_node, energy->Cs_node,
+						    soil_con->Zsum_node, energy->T,
+						    soil_con->max_moist_node,
+						    soil_con->expt_node,
+						    soil_con->bubble_node, 
+						    moist, soil_con->depth, 
+						    soil_con->soil_dens_min,
+						    soil_con->bulk_dens_min,
+						    soil_con->quartz, 
+						    soil_con->soil_density,
+						    soil_con->bulk_density,
+						    soil_con->organic, Nnodes, 
+						    OPT_Nlayer, soil_con->FS_ACTIVE);
+    if ( ErrorFlag == ERROR ) return (ERROR);
+  }
+  return (0);
+
+}
+
+static void layer_drainage(soil_con_struct *soil_con,
+			   int              dt,
+			   int              Nunits,
+			   double           dt_inflow,
+			   double          *dt_runoff,
+			   double          *resid_moist,
+			   double           evap[][MAX_LAYERS],
+			   double           liq[][MAX_LAYERS],
+			   double           ice[][MAX_LAYERS],
+			   double          *runoff,
+			   double          *baseflow)
+/**********************************************************************
+  layer_drainage
+
+  Computes the flow between the soil layers and the baseflow from the
+  bottom layer on an hourly time step, for Nunits soil columns that
+  share the soil parameters of soil_con (the frost areas of a tile).
+  The parameters of the hourly loop are computed once for all units,
+  and each unit is advanced on local copies of its column, stored as
+  [unit][layer].  The conductivity of a layer that evaporation takes
+  down to residual moisture is 0, so pow() is only called for layers
+  that can drain.
+
+  evap, liq and ice are hourly evaporation, liquid and frozen
+  moisture (mm); dt_runoff is the hourly surface runoff taken from
+  the top layer.  Excess moisture that cannot be stored is added to
+  runoff; baseflow is incremented by the baseflow of each hour.
+**********************************************************************/
+{
+  extern option_struct options;
+  int    lindex;
+  int    bottom;
+  int    time_step;
+  int    tmplayer;
+  int    u;
+  double Ksat[MAX_LAYERS];
+  double max_moist[MAX_LAYERS];
+  double moist_range[MAX_LAYERS];
+  double expt[MAX_LAYERS];
+  double resid[MAX_LAYERS];
+  double Q12[MAX_LAYERS-1];
+  double col_liq[MAX_LAYERS];
+  double col_ice[MAX_LAYERS];
+  double col_evap[MAX_LAYERS];
+  double col_runoff;
+  double col_baseflow;
+  double Dsmax;
+  double base_lin;
+  double base_nonlin;
+  double inflow;
+  double tmp_inflow;
+  double tmp_moist;
+  double tmp_liq;
+  double layer_runoff;
+  double rel_moist;
+  double frac;
+  double dt_baseflow;
+
+  bottom = OPT_Nlayer-1;
+  for ( lindex = 0; lindex < OPT_Nlayer; lindex++ ) {
+    Ksat[lindex]        = soil_con->Ksat[lindex] / 24.;
+    max_moist[lindex]   = soil_con->max_moist[lindex];
+    moist_range[lindex] = soil_con->max_moist[lindex] - resid_moist[lindex];
+    expt[lindex]        = soil_con->expt[lindex];
+    resid[lindex]       = resid_moist[lindex];
+  }
+  Dsmax       = soil_con->Dsmax / 24.;
+  base_lin    = Dsmax * soil_con->Ds / soil_con->Ws;
+  base_nonlin = Dsmax * (1 - soil_con->Ds / soil_con->Ws);
+
+  for ( u = 0; u < Nunits; u++ ) {
+
+    for ( lindex = 0; lindex < OPT_Nlayer; lindex++ ) {
+      col_liq[lindex]  = liq[u][lindex];
+      col_ice[lindex]  = ice[u][lindex];
+      col_evap[lindex] = evap[u][lindex];
+    }
+    col_runoff   = runoff[u];
+    col_baseflow = baseflow[u];
+
     for (time_step = 0; time_step < dt; time_step++) {
-      inflow   = dt_inflow;
-      last_cnt = 0;
-	    
+
       /*************************************
         Compute Drainage between Sublayers 
       *************************************/
 
-      for( lindex = 0; lindex < options.Nlayer-1; lindex++ ) {
-
-        /** Brooks & Corey relation for hydraulic conductivity **/
-	      
-        if((tmp_liq = liq[lindex] - evap[lindex][frost_area]) < resid_moist[lindex])
-	  tmp_liq = resid_moist[lindex];
-	      
-	if(liq[lindex] > resid_moist[lindex]) {
-	  Q12[lindex] = Ksat[lindex] * pow(((tmp_liq - resid_moist[lindex]) / (soil_con->max_moist[lindex] - resid_moist[lindex])), soil_con->expt[lindex]); 
-	}
-	else Q12[lindex] = 0.;
-	last_layer[last_cnt] = lindex;
+      /** Brooks & Corey relation for hydraulic conductivity; no drainage
+          (without calling pow()) if evaporation takes the layer down to
+          residual moisture **/
+      for( lindex = 0; lindex < bottom; lindex++ ) {
+        tmp_liq = col_liq[lindex] - col_evap[lindex];
+        if (col_liq[lindex] > resid[lindex] && tmp_liq > resid[lindex])
+          Q12[lindex] = Ksat[lindex] * pow(((tmp_liq - resid[lindex]) / moist_range[lindex]), expt[lindex]);
+        else Q12[lindex] = 0.;
       }
-	    
+
       /**************************************************
         Solve for Current Soil Layer Moisture, and
         Check Versus Maximum and Minimum Moisture Contents.  
       **************************************************/
-	    
-      firstlayer = TRUE;
-      last_index = 0;
-      for ( lindex = 0; lindex < options.Nlayer - 1; lindex++ ) {
-	      
-        if ( lindex == 0 ) dt_runoff = tmp_dt_runoff[frost_area];
-	else dt_runoff = 0;
-
-	/* transport moisture for all sublayers **/
-
-	tmp_inflow = 0.;
-	      
-	/** Update soil layer moisture content **/
-	liq[lindex] = liq[lindex] + (inflow - dt_runoff) - (Q12[lindex] + evap[lindex][frost_area]);
-	      
-	/** Verify that soil layer moisture is less than maximum **/
-	if((liq[lindex]+ice[lindex]) > max_moist[lindex]) {
-	  tmp_inflow = (liq[lindex]+ice[lindex]) - max_moist[lindex];
-	  liq[lindex] = max_moist[lindex] - ice[lindex];
+
+      inflow = dt_inflow;
+      for ( lindex = 0; lindex < bottom; lindex++ ) {
+
+        if ( lindex == 0 ) layer_runoff = dt_runoff[u];
+        else layer_runoff = 0;
+
+        tmp_inflow = 0.;
+
+        /** Update soil layer moisture content **/
+        col_liq[lindex] = col_liq[lindex] + (inflow - layer_runoff) - (Q12[lindex] + col_evap[lindex]);
+
+        /** Verify that soil layer moisture is less than maximum **/
+        if((col_liq[lindex]+col_ice[lindex]) > max_moist[lindex]) {
+          tmp_inflow = (col_liq[lindex]+col_ice[lindex]) - max_moist[lindex];
+          col_liq[lindex] = max_moist[lindex] - col_ice[lindex];
 
           if(lindex==0) {
-	    Q12[lindex] += tmp_inflow;
-	    tmp_inflow = 0;
-	  }
-	  else {
-	    tmplayer = lindex;
-	    while(tmp_inflow > 0) {
-	      tmplayer--;
-	      if ( tmplayer < 0 ) {
-		/** If top layer saturated, add to runoff **/
-		runoff[frost_area] += tmp_inflow;
-		tmp_inflow = 0;
-	      }
-	      else {
-		/** else add excess soil moisture to next higher layer **/
-		liq[tmplayer] += tmp_inflow;
-		if((liq[tmplayer]+ice[tmplayer]) > max_moist[tmplayer]) {
-		  tmp_inflow = ((liq[tmplayer] + ice[tmplayer]) - max_moist[tmplayer]);
-		  liq[tmplayer] = max_moist[tmplayer] - ice[tmplayer];
-		}
-	        else tmp_inflow=0;
-	      }
-	    }
-	  } /** end trapped excess moisture **/
-	} /** end check if excess moisture in top layer **/
-	      
-	firstlayer=FALSE;
-	      
-	/** verify that current layer moisture is greater than minimum **/
-	if (liq[lindex] < 0) {
-	  /** liquid cannot fall below 0 **/
-	  Q12[lindex] += liq[lindex];
-	  liq[lindex] = 0;
-	}
-	if ((liq[lindex]+ice[lindex]) < resid_moist[lindex]) {
-	  /** moisture cannot fall below minimum **/
-	  Q12[lindex] += (liq[lindex]+ice[lindex]) - resid_moist[lindex];
-	  liq[lindex] = resid_moist[lindex] - ice[lindex];
-	}
-	      
-	inflow = (Q12[lindex]+tmp_inflow);
-	Q12[lindex] += tmp_inflow;
-	      
-	last_index++;
-	      
+            Q12[lindex] += tmp_inflow;
+            tmp_inflow = 0;
+          }
+          else {
+            tmplayer = lindex;
+            while(tmp_inflow > 0) {
+              tmplayer--;
+              if ( tmplayer < 0 ) {
+                /** If top layer saturated, add to runoff **/
+                col_runoff += tmp_inflow;
+                tmp_inflow = 0;
+              }
+              else {
+                /** else add excess soil moisture to next higher layer **/
+                col_liq[tmplayer] += tmp_inflow;
+                if((col_liq[tmplayer]+col_ice[tmplayer]) > max_moist[tmplayer]) {
+                  tmp_inflow = ((col_liq[tmplayer] + col_ice[tmplayer]) - max_moist[tmplayer]);
+                  col_liq[tmplayer] = max_moist[tmplayer] - col_ice[tmplayer];
+                }
+                else tmp_inflow=0;
+              }
+            }
+          } /** end trapped excess moisture **/
+        } /** end check if excess moisture in top layer **/
+
+        /** verify that current layer moisture is greater than minimum **/
+        if (col_liq[lindex] < 0) {
+          /** liquid cannot fall below 0 **/
+          Q12[lindex] += col_liq[lindex];
+          col_liq[lindex] = 0;
+        }
+        if ((col_liq[lindex]+col_ice[lindex]) < resid[lindex]) {
+          /** moisture cannot fall below minimum **/
+          Q12[lindex] += (col_liq[lindex]+col_ice[lindex]) - resid[lindex];
+          col_liq[lindex] = resid[lindex] - col_ice[lindex];
+        }
+
+        inflow = (Q12[lindex]+tmp_inflow);
+        Q12[lindex] += tmp_inflow;
+
       } /* end loop through soil layers */
-	    
+
       /**************************************************
         Compute Baseflow
       **************************************************/
-	    
+
       /** ARNO model for the bottom soil layer (based on bottom
           soil layer moisture from previous time step) **/
-	    
-      lindex = options.Nlayer-1;
-      Dsmax = soil_con->Dsmax / 24.;
+
+      lindex = bottom;
 
       /** Compute relative moisture **/
-      rel_moist = (liq[lindex]-resid_moist[lindex]) / (soil_con->max_moist[lindex]-resid_moist[lindex]);
+      rel_moist = (col_liq[lindex]-resid[lindex]) / moist_range[lindex];
 
       /** Compute baseflow as function of relative moisture **/
-      frac = Dsmax * soil_con->Ds / soil_con->Ws;
-      dt_baseflow = frac * rel_moist;
+      dt_baseflow = base_lin * rel_moist;
       if (rel_moist > soil_con->Ws) {
         frac = (rel_moist - soil_con->Ws) / (1 - soil_con->Ws);
-        dt_baseflow += Dsmax * (1 - soil_con->Ds / soil_con->Ws) * pow(frac,soil_con->c);
+        dt_baseflow += base_nonlin * pow(frac,soil_con->c);
       }
-	    
+
       /** Make sure baseflow isn't negative **/
       if(dt_baseflow < 0) dt_baseflow = 0;
-	    
+
       /** Extract baseflow from the bottom soil layer **/ 
-	    
-      liq[lindex] += Q12[lindex-1] - (evap[lindex][frost_area] + dt_baseflow);
-	    
-      /** Check Lower Sub-Layer Moistures **/
-      tmp_moist = 0;
+
+      col_liq[lindex] += Q12[lindex-1] - (col_evap[lindex] + dt_baseflow);
 
       /* If soil moisture has gone below minimum, take water out
        * of baseflow and add back to soil to make up the difference
        * Note: this may lead to negative baseflow, in which case we will
        * reduce evap to make up for it */
-      if((liq[lindex]+ice[lindex]) < resid_moist[lindex]) {
-        dt_baseflow += (liq[lindex]+ice[lindex]) - resid_moist[lindex];
-        liq[lindex] = resid_moist[lindex] - ice[lindex];
+      if((col_liq[lindex]+col_ice[lindex]) < resid[lindex]) {
+        dt_baseflow += (col_liq[lindex]+col_ice[lindex]) - resid[lindex];
+        col_liq[lindex] = resid[lindex] - col_ice[lindex];
       }
 
-      if((liq[lindex]+ice[lindex]) > max_moist[lindex]) {
+      if((col_liq[lindex]+col_ice[lindex]) > max_moist[lindex]) {
         /* soil moisture above maximum */
-        tmp_moist = ((liq[lindex]+ice[lindex]) - max_moist[lindex]);
-        liq[lindex] = max_moist[lindex] - ice[lindex];
+        tmp_moist = ((col_liq[lindex]+col_ice[lindex]) - max_moist[lindex]);
+        col_liq[lindex] = max_moist[lindex] - col_ice[lindex];
         tmplayer = lindex;
         while(tmp_moist > 0) {
           tmplayer--;
           if(tmplayer<0) {
             /** If top layer saturated, add to runoff **/
-            runoff[frost_area] += tmp_moist;
+            col_runoff += tmp_moist;
             tmp_moist = 0;
           }
           else {
             /** else if sublayer exists, add excess soil moisture **/
-            liq[tmplayer] += tmp_moist ;
-            if ( ( liq[tmplayer] + ice[tmplayer]) > max_moist[tmplayer] ) {
-	      tmp_moist = ((liq[tmplayer] + ice[tmplayer]) - max_moist[tmplayer]);
-	      liq[tmplayer] = max_moist[tmplayer] - ice[tmplayer];
+            col_liq[tmplayer] += tmp_moist ;
+            if ( ( col_liq[tmplayer] + col_ice[tmplayer]) > max_moist[tmplayer] ) {
+              tmp_moist = ((col_liq[tmplayer] + col_ice[tmplayer]) - max_moist[tmplayer]);
+              col_liq[tmplayer] = max_moist[tmplayer] - col_ice[tmplayer];
             }
             else tmp_moist=0;
           }
         }
       }
-	    
-      baseflow[frost_area] += dt_baseflow;
-	    
-    } /* end of hourly time step loop */
-
-    /** If negative baseflow, reduce evap accordingly **/
-    if ( baseflow[frost_area] < 0 ) {
-      layer[lindex].evap   += baseflow[frost_area];
-      baseflow[frost_area]  = 0;
-    }
-
-    /** Recompute Asat based on final moisture level of upper layers **/
-    for(lindex=0;lindex<options.Nlayer;lindex++) {
-      tmp_moist_for_runoff[lindex] = (liq[lindex] + ice[lindex]);
-    }
-    compute_runoff_and_asat(soil_con, tmp_moist_for_runoff, 0, &A, &tmp_runoff);
 
-    /** Store tile-wide values **/
-    for ( lindex = 0; lindex < options.Nlayer; lindex++ ) 
-      layer[lindex].moist += ((liq[lindex] + ice[lindex]) * frost_fract[frost_area]); 
-    cell->asat     += A * frost_fract[frost_area];
-    cell->runoff   += runoff[frost_area] * frost_fract[frost_area];
-    cell->baseflow += baseflow[frost_area] * frost_fract[frost_area];
+      col_baseflow += dt_baseflow;
 
-  }
+    } /* end of hourly time step loop */
 
-  /** Compute water table depth **/
-  wrap_compute_zwt(soil_con, cell);
+    for ( lindex = 0; lindex < OPT_Nlayer; lindex++ )
+      liq[u][lindex] = col_liq[lindex];
+    runoff[u]   = col_runoff;
+    baseflow[u] = col_baseflow;
 
-  /** Recompute Thermal Parameters Based on New Moisture Distribution **/
-  if(options.FULL_ENERGY || options.FROZEN_SOIL) {
-    
-    for(lindex=0;lindex<options.Nlayer;lindex++) {
-      tmp_layer = cell->layer[lindex];
-      moist[lindex] = tmp_layer.moist;
-    }
-    
-    ErrorFlag = distribute_node_moisture_properties(energy->moist, energy->ice,
-						    energy->kappa_node, energy->Cs_node,
-						    soil_con->Zsum_node, energy->T,
-						    soil_con->max_moist_node,
-						    soil_con->expt_node,
-						    soil_con->bubble_node, 
-						    moist, soil_con->depth, 
-						    soil_con->soil_dens_min,
-						    soil_con->bulk_dens_min,
-						    soil_con->quartz, 
-						    soil_con->soil_density,
-						    soil_con->bulk_density,
-						    soil_con->organic, Nnodes, 
-						    options.Nlayer, soil_con->FS_ACTIVE);
-    if ( ErrorFlag == ERROR ) return (ERROR);
-  }
-  return (0);
+  } /* end loop through units */
 
 }
 
@@ -544,7 +607,7 @@ void compute_runoff_and_asat(soil_con_struct *soil_con, double *moist, double in
 
   top_moist = 0.;
   top_max_moist=0.;
-  for(lindex=0;lindex<options.Nlayer-1;lindex++) {
+  for(lindex=0;lindex<OPT_Nlayer-1;lindex++) {
     top_moist += moist[lindex];
     top_max_moist += soil_con->max_moist[lindex];
   }
@@ -16,7 +16,6 @@
  */
 
 #include <math.h>
-#include <stdarg.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <vicNl.h>
@@ -81,6 +80,10 @@ static char vcid[] = "$Id$";
   2013-Dec-27 Moved SPATIAL_FROST to options_struct.			TJB
   2014-Mar-28 Removed DIST_PRCP option.					TJB
   2014-May-05 Added logic to handle LAI = 0.				TJB
+  2026-Oct-18 Pass the arguments of func_canopy_energy_bal() to root_brent()
+	      in an argument structure; removed solve_canopy_energy_bal()
+	      and error_calc_canopy_energy_bal().
+  2026-Oct-18 Added call site argument to root_brent().
 *****************************************************************************/
 int snow_intercept(double  Dt,
 		   double  F,  
@@ -190,6 +193,8 @@ int snow_intercept(double  Dt,
 
   char ErrorString[MAXSTRING];
 
+  canopy_energy_bal_args_struct args;
+
   AirDens   = atmos->density[hidx];
   EactAir   = atmos->vp[hidx];
   Press     = atmos->pressure[hidx];
@@ -346,33 +351,65 @@ int snow_intercept(double  Dt,
 
   Tupper = Tlower = MISSING;
 
+  /* Set the arguments of the canopy energy balance; the net shortwave
+     radiation is set below, once the canopy albedo is known */
+  args.band           = band;
+  args.month          = month;
+  args.rec            = rec;
+  args.delta_t        = Dt;
+  args.elevation      = soil_con->elevation;
+  args.Wmax           = soil_con->max_moist;
+  args.Wcr            = soil_con->Wcr;
+  args.Wpwp           = soil_con->Wpwp;
+  args.depth          = soil_con->depth;
+  args.frost_fract    = soil_con->frost_fract;
+  args.AirDens        = AirDens;
+  args.EactAir        = EactAir;
+  args.Press          = Press;
+  args.Le             = Le;
+  args.Tcanopy        = Tcanopy;
+  args.Vpd            = Vpd;
+  args.shortwave      = shortwave;
+  args.Catm           = Catm;
+  args.dryFrac        = dryFrac;
+  args.Evap           = &Evap;
+  args.Ra             = Ra;
+  args.Ra_used        = Ra_used;
+  args.Rainfall       = *RainFall;
+  args.Wind           = Wind;
+  args.UnderStory     = UnderStory;
+  args.iveg           = iveg;
+  args.veg_class      = veg_class;
+  args.displacement   = displacement;
+  args.ref_height     = ref_height;
+  args.roughness      = roughness;
+  args.root           = root;
+  args.CanopLayerBnd  = CanopLayerBnd;
+  args.IntRain        = IntRainOrg;
+  args.IntSnow        = *IntSnow;
+  args.Wdew           = IntRain;
+  args.layer          = layer;
+  args.veg_var        = veg_var;
+  args.LongOverIn     = LongOverIn;
+  args.LongUnderOut   = LongUnderOut;
+  args.AdvectedEnergy = AdvectedEnergy;
+  args.LatentHeat     = LatentHeat;
+  args.LatentHeatSub  = LatentHeatSub;
+  args.LongOverOut    = LongOverOut;
+  args.NetLongOver    = NetLongOver;
+  args.NetRadiation   = &NetRadiation;
+  args.RefreezeEnergy = &RefreezeEnergy;
+  args.SensibleHeat   = SensibleHeat;
+  args.VaporMassFlux  = VaporMassFlux;
+
   if ( *IntSnow > 0 || *SnowFall > 0 ) {
     /* Snow present or accumulating in the canopy */
 
     *AlbedoOver = NEW_SNOW_ALB; // albedo of intercepted snow in canopy
     *NetShortOver = (1. - *AlbedoOver) * ShortOverIn; // net SW in canopy
+    args.NetShortOver = *NetShortOver;
 
-    Qnet = solve_canopy_energy_bal(0., band, month, rec, Dt, 
-				   soil_con->elevation, soil_con->max_moist,
-				   soil_con->Wcr, soil_con->Wpwp, 
-				   soil_con->depth, 
-				   soil_con->frost_fract, 
-				   AirDens, EactAir, Press, Le, 
-				   Tcanopy, Vpd,
-				   shortwave, Catm, dryFrac,
-				   &Evap, Ra, Ra_used,
-				   *RainFall, Wind, UnderStory, iveg, 
-				   veg_class, displacement, ref_height, 
-				   roughness, root, CanopLayerBnd, 
-				   IntRainOrg, *IntSnow, 
-				   IntRain, layer, veg_var, 
-				   LongOverIn, LongUnderOut, 
-				   *NetShortOver, 
-				   AdvectedEnergy, 
-				   LatentHeat, LatentHeatSub, 
-				   LongOverOut, NetLongOver, &NetRadiation, 
-				   &RefreezeEnergy, SensibleHeat, 
-				   VaporMassFlux);
+    Qnet = func_canopy_energy_bal(0., &args);
 
     if ( Qnet != 0 ) {
       /* Intercepted snow not melting - need to find temperature */
@@ -388,6 +425,7 @@ int snow_intercept(double  Dt,
     /* No snow in canopy */
     *AlbedoOver = bare_albedo;
     *NetShortOver = (1. - *AlbedoOver) * ShortOverIn; // net SW in canopy
+    args.NetShortOver = *NetShortOver;
     Qnet = -9999;
     Tupper = (*Tfoliage) + SNOW_DT;
     Tlower = (*Tfoliage) - SNOW_DT;
@@ -396,24 +434,8 @@ int snow_intercept(double  Dt,
 
   if ( Tupper != MISSING && Tlower != MISSING ) {
 
-    *Tfoliage = root_brent(Tlower, Tupper, ErrorString, func_canopy_energy_bal,  band, 
-			   month, rec, Dt, soil_con->elevation, soil_con->max_moist, 
-			   soil_con->Wcr, soil_con->Wpwp, soil_con->depth, 
-			   soil_con->frost_fract, 
-			   AirDens, EactAir, Press, Le, 
-			   Tcanopy, Vpd, shortwave, Catm, dryFrac,
-			   &Evap, Ra, Ra_used,
-			   *RainFall, Wind, UnderStory, iveg, 
-			   veg_class, displacement, ref_height, 
-			   roughness, root, CanopLayerBnd, IntRainOrg, *IntSnow, 
-			   IntRain, layer, veg_var, 
-			   LongOverIn, LongUnderOut, 
-			   *NetShortOver, 
-			   AdvectedEnergy, 
-			   LatentHeat, LatentHeatSub, 
-			   LongOverOut, NetLongOver, &NetRadiation, 
-			   &RefreezeEnergy, SensibleHeat, 
-			   VaporMassFlux);
+    *Tfoliage = root_brent(ROOT_FOLIAGE, Tlower, Tupper, ErrorString,
+			   func_canopy_energy_bal, &args);
     
     if ( *Tfoliage <= -998 ) {
       if (options.TFALLBACK) {
@@ -422,47 +444,12 @@ int snow_intercept(double  Dt,
         (*Tfoliage_fbcount)++;
       }
       else { 
-        Qnet = error_calc_canopy_energy_bal(*Tfoliage, band, month, rec, Dt, 
-					    soil_con->elevation, soil_con->max_moist, 
-					    soil_con->Wcr, soil_con->Wpwp, 
-					    soil_con->depth, 
-					    soil_con->frost_fract, 
-					    AirDens, EactAir, Press, Le, 
-					    Tcanopy, Vpd, shortwave, Catm, dryFrac,
-					    &Evap, Ra, Ra_used,
-					    *RainFall, Wind, UnderStory, iveg, 
-					    veg_class, displacement, ref_height, 
-					    roughness, root, CanopLayerBnd, IntRainOrg, *IntSnow, 
-					    IntRain, layer, veg_var, 
-					    LongOverIn, LongUnderOut, *NetShortOver, 
-					    AdvectedEnergy, 
-					    LatentHeat, LatentHeatSub, 
-					    LongOverOut, NetLongOver, &NetRadiation, 
-					    &RefreezeEnergy, SensibleHeat, 
-					    VaporMassFlux, ErrorString);
+        Qnet = error_print_canopy_energy_bal(*Tfoliage, &args, ErrorString);
         return( ERROR );
       }
     }
     
-    Qnet = solve_canopy_energy_bal(*Tfoliage, band, month, rec, Dt, 
-				   soil_con->elevation, soil_con->max_moist, soil_con->Wcr, 
-				   soil_con->Wpwp, soil_con->depth, 
-				   soil_con->frost_fract, 
-				   AirDens, EactAir, Press, Le, 
-				   Tcanopy, Vpd, shortwave, Catm, dryFrac,
-				   &Evap, Ra, Ra_used,
-				   *RainFall, Wind, UnderStory, iveg, 
-				   veg_class, displacement, ref_height, 
-				   roughness, root, CanopLayerBnd,
-				   IntRainOrg, *IntSnow, 
-				   IntRain, layer, veg_var, 
-				   LongOverIn, LongUnderOut, 
-				   *NetShortOver, 
-				   AdvectedEnergy, 
-				   LatentHeat, LatentHeatSub, 
-				   LongOverOut, NetLongOver, &NetRadiation, 
-				   &RefreezeEnergy, SensibleHeat, 
-				   VaporMassFlux);
+    Qnet = func_canopy_energy_bal(*Tfoliage, &args);
 
   }
 
@@ -629,31 +616,9 @@ int snow_intercept(double  Dt,
 
 }
 
-double solve_canopy_energy_bal(double Tfoliage, ...)
-{
-  va_list  ap;
-  double   Qnet;
-
-  va_start(ap, Tfoliage);
-  Qnet = func_canopy_energy_bal(Tfoliage, ap);
-  va_end(ap);
-
-  return Qnet;
-}
-
-double error_calc_canopy_energy_bal(double Tfoliage, ...)
-{
-  va_list  ap;
-  double   Qnet;
-
-  va_start(ap, Tfoliage);
-  Qnet = error_print_canopy_energy_bal(Tfoliage, ap);
-  va_end(ap);
-
-  return Qnet;
-}
-
-double error_print_canopy_energy_bal(double Tfoliage, va_list ap)
+double error_print_canopy_energy_bal(double Tfoliage,
+				     canopy_energy_bal_args_struct *args,
+				     char *ErrorString)
 {  
 
   extern option_struct options;
@@ -725,78 +690,76 @@ double error_print_canopy_energy_bal(double Tfoliage, va_list ap)
   double *SensibleHeat;
   double *VaporMassFlux;
 
-  char *ErrorString;
   int   cidx;
 
-  /** Read variables from variable length argument list **/
+  /** Read variables from argument structure **/
 
   /* General Model Parameters */
-  band    = (int) va_arg(ap, int);
-  month   = (int) va_arg(ap, int);
-  rec     = (int) va_arg(ap, int);
+  band    = args->band;
+  month   = args->month;
+  rec     = args->rec;
 
-  delta_t   = (double) va_arg(ap, double);
-  elevation = (double) va_arg(ap, double);
+  delta_t   = args->delta_t;
+  elevation = args->elevation;
 
-  Wmax  = (double *) va_arg(ap, double *);
-  Wcr   = (double *) va_arg(ap, double *);
-  Wpwp  = (double *) va_arg(ap, double *);
-  depth = (double *) va_arg(ap, double *);
-  frost_fract = (double *) va_arg(ap, double *);
+  Wmax  = args->Wmax;
+  Wcr   = args->Wcr;
+  Wpwp  = args->Wpwp;
+  depth = args->depth;
+  frost_fract = args->frost_fract;
 
   /* Atmopheric Condition and Forcings */
-  AirDens = (double) va_arg(ap, double);
-  EactAir = (double) va_arg(ap, double);
-  Press   = (double) va_arg(ap, double);
-  Le      = (double) va_arg(ap, double);
-  Tcanopy = (double) va_arg(ap, double);
-  Vpd     = (double) va_arg(ap, double);
-  shortwave=(double) va_arg(ap, double);
-  Catm    = (double) va_arg(ap, double);
-  dryFrac = (double *) va_arg(ap, double *);
-
-  Evap     = (double *) va_arg(ap, double *);
-  Ra       = (double *) va_arg(ap, double *);
-  Ra_used  = (double *) va_arg(ap, double *);
-  Rainfall = (double) va_arg(ap, double);
-  Wind     = (double *) va_arg(ap, double *);
+  AirDens = args->AirDens;
+  EactAir = args->EactAir;
+  Press   = args->Press;
+  Le      = args->Le;
+  Tcanopy = args->Tcanopy;
+  Vpd     = args->Vpd;
+  shortwave= args->shortwave;
+  Catm    = args->Catm;
+  dryFrac = args->dryFrac;
+
+  Evap     = args->Evap;
+  Ra       = args->Ra;
+  Ra_used  = args->Ra_used;
+  Rainfall = args->Rainfall;
+  Wind     = args->Wind;
 
   /* Vegetation Terms */
-  UnderStory = (int) va_arg(ap, int);
-  iveg       = (int) va_arg(ap, int);
-  veg_class  = (int) va_arg(ap, int);
+  UnderStory = args->UnderStory;
+  iveg       = args->iveg;
+  veg_class  = args->veg_class;
 
-  displacement = (double *) va_arg(ap, double *);
-  ref_height   = (double *) va_arg(ap, double *);
-  roughness    = (double *) va_arg(ap, double *);
+  displacement = args->displacement;
+  ref_height   = args->ref_height;
+  roughness    = args->roughness;
 
-  root = (float *) va_arg(ap, float *);
-  CanopLayerBnd = (double *) va_arg(ap, double *);
+  root = args->root;
+  CanopLayerBnd = args->CanopLayerBnd;
 
   /* Water Flux Terms */
-  IntRain = (double) va_arg(ap, double);
-  IntSnow = (double) va_arg(ap, double);
+  IntRain = args->IntRain;
+  IntSnow = args->IntSnow;
 
-  Wdew    = (double *) va_arg(ap, double *);
+  Wdew    = args->Wdew;
 
-  layer   = (layer_data_struct *) va_arg(ap, layer_data_struct *);
-  veg_var = (veg_var_struct *) va_arg(ap, veg_var_struct *);
+  layer   = args->layer;
+  veg_var = args->veg_var;
 
   /* Energy Flux Terms */
-  LongOverIn       = (double) va_arg(ap, double);
-  LongUnderOut     = (double) va_arg(ap, double);
-  NetShortOver     = (double) va_arg(ap, double);
-
-  AdvectedEnergy     = (double *) va_arg(ap, double *);
-  LatentHeat         = (double *) va_arg(ap, double *);
-  LatentHeatSub      = (double *) va_arg(ap, double *);
-  LongOverOut        = (double *) va_arg(ap, double *);
-  NetLongOver        = (double *) va_arg(ap, double *);
-  NetRadiation       = (double *) va_arg(ap, double *);
-  RefreezeEnergy     = (double *) va_arg(ap, double *);
-  SensibleHeat       = (double *) va_arg(ap, double *);
-  VaporMassFlux      = (double *) va_arg(ap, double *);
-  ErrorString        = (char *) va_arg(ap, char *);
+  LongOverIn       = args->LongOverIn;
+  LongUnderOut     = args->LongUnderOut;
+  NetShortOver     = args->NetShortOver;
+
+  AdvectedEnergy     = args->AdvectedEnergy;
+  LatentHeat         = args->LatentHeat;
+  LatentHeatSub      = args->LatentHeatSub;
+  LongOverOut        = args->LongOverOut;
+  NetLongOver        = args->NetLongOver;
+  NetRadiation       = args->NetRadiation;
+  RefreezeEnergy     = args->RefreezeEnergy;
+  SensibleHeat       = args->SensibleHeat;
+  VaporMassFlux      = args->VaporMassFlux;
 
   /** Print variable info */
   fprintf(stderr, "%s", ErrorString);
@@ -14,7 +14,6 @@
  * COMMENTS:     
  */
 
-#include <stdarg.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <vicNl.h>
@@ -115,6 +114,11 @@ static char vcid[] = "$Id$";
   2007-Aug-31 Checked root_brent return value against -998 rather than -9998.    JCA
   2009-Sep-19 Added T fbcount to count TFALLBACK occurrences.		TJB
   2009-Oct-08 Extended T fallback scheme to snow and ice T.		TJB
+  2026-Oct-18 The arguments of SnowPackEnergyBalance() are now set once
+	      in an argument structure that is passed to root_brent(),
+	      SnowPackEnergyBalance() and ErrorPrintSnowPackEnergyBalance().
+  2026-Oct-18 Solve for the surface temperature with root_brent_warm(),
+	      starting from the previous surface temperature.
 *****************************************************************************/
 int  snow_melt(double            Le, 
                double            NetShortSnow,  // net SW at absorbed by snow
@@ -188,6 +192,7 @@ int  snow_melt(double            Le,
   double melt_energy = 0.;
 
   char ErrorString[MAXSTRING];
+  snowpack_energy_bal_args_struct args;
 
   SnowFall = snowfall / 1000.; /* convet to m */
   RainFall = rainfall / 1000.; /* convet to m */
@@ -245,21 +250,45 @@ int  snow_melt(double            Le,
   
   /* Calculate the surface energy balance for snow_temp = 0.0 */
   
-  Qnet = CalcSnowPackEnergyBalance((double)0.0, delta_t, aero_resist, aero_resist_used,
-				   displacement, z2, Z0, 
-				   density, vp, LongSnowIn, Le, pressure,
-				   RainFall, NetShortSnow, vpd, 
-				   wind, (*OldTSurf), coverage, 
-				   snow->depth, snow->density,
-				   snow->surf_water, SurfaceSwq, 
-				   Tcanopy, Tgrnd, 
-				   &advection, &advected_sensible_heat, 
-				   &deltaCC, 
-				   &grnd_flux, &latent_heat, 
-				   &latent_heat_sub, NetLongSnow, 
-				   &RefreezeEnergy, &sensible_heat, 
-				   &snow->vapor_flux, &snow->blowing_flux,
-				   &snow->surface_flux);
+  /* Set the arguments of the snow pack energy balance */
+  
+  args.Dt                   = delta_t;
+  args.Ra                   = aero_resist;
+  args.Ra_used              = aero_resist_used;
+  args.Displacement         = displacement;
+  args.Z                    = z2;
+  args.Z0                   = Z0;
+  args.AirDens              = density;
+  args.EactAir              = vp;
+  args.LongSnowIn           = LongSnowIn;
+  args.Lv                   = Le;
+  args.Press                = pressure;
+  args.Rain                 = RainFall;
+  args.NetShortUnder        = NetShortSnow;
+  args.Vpd                  = vpd;
+  args.Wind                 = wind;
+  args.OldTSurf             = (*OldTSurf);
+  args.SnowCoverFract       = coverage;
+  args.SnowDepth            = snow->depth;
+  args.SnowDensity          = snow->density;
+  args.SurfaceLiquidWater   = snow->surf_water;
+  args.SweSurfaceLayer      = SurfaceSwq;
+  args.Tair                 = Tcanopy;
+  args.TGrnd                = Tgrnd;
+  args.AdvectedEnergy       = &advection;
+  args.AdvectedSensibleHeat = &advected_sensible_heat;
+  args.DeltaColdContent     = &deltaCC;
+  args.GroundFlux           = &grnd_flux;
+  args.LatentHeat           = &latent_heat;
+  args.LatentHeatSub        = &latent_heat_sub;
+  args.NetLongUnder         = NetLongSnow;
+  args.RefreezeEnergy       = &RefreezeEnergy;
+  args.SensibleHeat         = &sensible_heat;
+  args.vapor_flux           = &snow->vapor_flux;
+  args.blowing_flux         = &snow->blowing_flux;
+  args.surface_flux         = &snow->surface_flux;
+
+  Qnet = SnowPackEnergyBalance((double)0.0, &args);
 
   /* Check that snow swq exceeds minimum value for model stability */
 //  if ( SurfaceSwq > MIN_SWQ_EB_THRES && !UNSTABLE_SNOW ) {
@@ -339,24 +368,11 @@ int  snow_melt(double            Le,
     else  {
       /* Calculate surface layer temperature using "Brent method" */
       if (SurfaceSwq > MIN_SWQ_EB_THRES) {
-	snow->surf_temp = root_brent((double)(snow->surf_temp-SNOW_DT), 
-				     (double)(snow->surf_temp+SNOW_DT),
-				     ErrorString, SnowPackEnergyBalance, 
-				     delta_t, aero_resist, aero_resist_used,
-				     displacement, z2, Z0, 
-				     density, vp, LongSnowIn, Le, pressure,
-				     RainFall, NetShortSnow, vpd, 
-				     wind, (*OldTSurf), coverage, 
-				     snow->depth, snow->density, 
-				     snow->surf_water, SurfaceSwq, 
-				     Tcanopy, Tgrnd, 
-				     &advection, &advected_sensible_heat, 
-				     &deltaCC, 
-				     &grnd_flux, &latent_heat, 
-				     &latent_heat_sub, NetLongSnow, 
-				     &RefreezeEnergy, &sensible_heat, 
-				     &snow->vapor_flux, &snow->blowing_flux,
-				     &snow->surface_flux);
+	snow->surf_temp = root_brent_warm(ROOT_SNOW, snow->surf_temp,
+					  (double)(snow->surf_temp-SNOW_DT), 
+					  (double)(snow->surf_temp+SNOW_DT),
+					  ErrorString, SnowPackEnergyBalance,
+					  &args);
       
         if (snow->surf_temp <= -998) {
           if (options.TFALLBACK) {
@@ -365,22 +381,8 @@ int  snow_melt(double            Le,
             snow->surf_temp_fbcount++;
           }
           else {
-	    error = ErrorSnowPackEnergyBalance(snow->surf_temp, rec, iveg, band,
-					 delta_t, aero_resist, aero_resist_used,
-					 displacement, z2, Z0, 
-					 density, vp, LongSnowIn, Le, pressure,
-					 RainFall, NetShortSnow, vpd, 
-					 wind, (*OldTSurf), coverage, 
-					 snow->depth, snow->density,
-					 snow->surf_water, SurfaceSwq, 
-					 Tcanopy, Tgrnd, 
-					 &advection, &advected_sensible_heat, 
-					 &deltaCC, 
-					 &grnd_flux, &latent_heat, 
-					 &latent_heat_sub, 
-					 NetLongSnow, &RefreezeEnergy, 
-					 &sensible_heat, &snow->vapor_flux,
-					 &snow->blowing_flux, &snow->surface_flux);
+	    error = ErrorPrintSnowPackEnergyBalance(snow->surf_temp, &args,
+						    rec, iveg, band, ErrorString);
             return(ERROR);
           }
         }
@@ -391,22 +393,7 @@ int  snow_melt(double            Le,
 	snow->surf_temp = 999;
       }
       if (snow->surf_temp > -998 && snow->surf_temp < 999) {
-	Qnet = CalcSnowPackEnergyBalance(snow->surf_temp, 
-					 delta_t, aero_resist, aero_resist_used,
-					 displacement, z2, Z0, 
-					 density, vp, LongSnowIn, Le, pressure,
-					 RainFall, NetShortSnow, vpd, 
-					 wind, (*OldTSurf), coverage, 
-					 snow->depth, snow->density,
-					 snow->surf_water, SurfaceSwq, 
-					 Tcanopy, Tgrnd, 
-					 &advection, &advected_sensible_heat, 
-					 &deltaCC, 
-					 &grnd_flux, &latent_heat, 
-					 &latent_heat_sub, 
-					 NetLongSnow, &RefreezeEnergy, 
-					 &sensible_heat, &snow->vapor_flux,
-					 &snow->blowing_flux, &snow->surface_flux);
+	Qnet = SnowPackEnergyBalance(snow->surf_temp, &args);
 	
 	/* since we iterated, the surface layer is below freezing and no snowmelt */ 
 	
@@ -578,60 +565,14 @@ int  snow_melt(double            Le,
   return ( 0 );
 }
 
-/*****************************************************************************
-  Function name: CalcSnowPackEnergyBalance()
-
-  Purpose      : Dummy function to make a direct call to
-                 SnowEnergyBalance() possible.
-
-  Required     : 
-    double TSurf - SnowPack surface temperature (C)
-    other arguments required by SnowPackEnergyBalance()
-
-  Returns      :
-    double Qnet - Net energy exchange at the SnowPack snow surface (W/m^2)
-
-  Modifies     : none
-
-  Comments     : function is local to this module
-*****************************************************************************/
-double CalcSnowPackEnergyBalance(double Tsurf, ...)
-{
-
-  va_list ap;                   /* Used in traversing variable argument list
-                                 */ 
-  double Qnet;                   /* Net energy exchange at the SnowPack snow
-                                   surface (W/m^2) */
-
-  va_start(ap, Tsurf);
-  Qnet = SnowPackEnergyBalance(Tsurf, ap);
-  va_end(ap);
-  
-  return Qnet;
-}
-
-double ErrorSnowPackEnergyBalance(double Tsurf, ...)
-{
-
-  va_list ap;                   /* Used in traversing variable argument list
-                                 */ 
-  double Qnet;                   /* Net energy exchange at the SnowPack snow
-                                   surface (W/m^2) */
-
-  va_start(ap, Tsurf);
-  Qnet = ErrorPrintSnowPackEnergyBalance(Tsurf, ap);
-  va_end(ap);
-  
-  return Qnet;
-}
-
-double ErrorPrintSnowPackEnergyBalance(double TSurf, va_list ap)
+double ErrorPrintSnowPackEnergyBalance(double TSurf,
+				       snowpack_energy_bal_args_struct *args,
+				       int rec, int iveg, int band, char *ErrorString)
 {
 
-  /* Define Variable Argument List */
+  /* Define Variables Read from the Argument Structure */
 
   /* General Model Parameters */
-  int rec, iveg, band;
   double Dt;                      /* Model time step (sec) */
 
   /* Vegetation Parameters */
@@ -670,8 +611,6 @@ double ErrorPrintSnowPackEnergyBalance(double TSurf, va_list ap)
 				     area into snow covered area (W/m^2) */
   double *DeltaColdContent;       /* Change in cold content of surface 
 				     layer (W/m2) */
-  double *DeltaPackColdContent;   /* Change in sold content of pack 
-				     layer (W/m^2) */
   double *GroundFlux;		  /* Ground Heat Flux (W/m2) */
   double *LatentHeat;		  /* Latent heat exchange at surface (W/m2) */
   double *LatentHeatSub;          /* Latent heat of sub exchange at 
@@ -688,58 +627,52 @@ double ErrorPrintSnowPackEnergyBalance(double TSurf, va_list ap)
   double *SurfaceMassFlux;          /* Mass flux of water vapor to or from the
 					 intercepted snow */
 
-  char *ErrorString;
 
-  /* Read Variable Argument List */
+  /* Read Argument Structure */
 
   /* General Model Parameters */
-  rec       = (int) va_arg(ap, int);
-  iveg      = (int) va_arg(ap, int);
-  band      = (int) va_arg(ap, int);
-  Dt        = (double) va_arg(ap, double);
+  Dt        = args->Dt;
 
   /* Vegetation Parameters */
-  Ra           = (double) va_arg(ap, double);
-  Displacement = (double) va_arg(ap, double);
-  Z            = (double) va_arg(ap, double);
-  Z0           = (double) va_arg(ap, double);
+  Ra           = args->Ra;
+  Displacement = args->Displacement;
+  Z            = args->Z;
+  Z0           = args->Z0[0];
 
   /* Atmospheric Forcing Variables */
-  AirDens    = (double) va_arg(ap, double);
-  EactAir    = (double) va_arg(ap, double);
-  LongSnowIn = (double) va_arg(ap, double);
-  Lv         = (double) va_arg(ap, double);
-  Press      = (double) va_arg(ap, double);
-  Rain       = (double) va_arg(ap, double);
-  ShortRad   = (double) va_arg(ap, double);
-  Vpd        = (double) va_arg(ap, double);
-  Wind       = (double) va_arg(ap, double);
+  AirDens    = args->AirDens;
+  EactAir    = args->EactAir;
+  LongSnowIn = args->LongSnowIn;
+  Lv         = args->Lv;
+  Press      = args->Press;
+  Rain       = args->Rain;
+  ShortRad   = args->NetShortUnder;
+  Vpd        = args->Vpd;
+  Wind       = args->Wind;
 
   /* Snowpack Variables */
-  OldTSurf           = (double) va_arg(ap, double);
-  SnowCoverFract     = (double) va_arg(ap, double);
-  SnowDensity        = (double) va_arg(ap, double);
-  SurfaceLiquidWater = (double) va_arg(ap, double);
-  SweSurfaceLayer    = (double) va_arg(ap, double);
+  OldTSurf           = args->OldTSurf;
+  SnowCoverFract     = args->SnowCoverFract;
+  SnowDensity        = args->SnowDensity;
+  SurfaceLiquidWater = args->SurfaceLiquidWater;
+  SweSurfaceLayer    = args->SweSurfaceLayer;
 
   /* Energy Balance Components */
-  Tair         = (double) va_arg(ap, double);
-  TGrnd           = (double) va_arg(ap, double);
-
-  AdvectedEnergy        = (double *) va_arg(ap, double *);
-  AdvectedSensibleHeat  = (double *)va_arg(ap, double *);
-  DeltaColdContent      = (double *) va_arg(ap, double *);
-  DeltaPackColdContent  = (double *) va_arg(ap, double *);
-  GroundFlux            = (double *) va_arg(ap, double *);
-  LatentHeat            = (double *) va_arg(ap, double *);
-  LatentHeatSub         = (double *) va_arg(ap, double *);
-  NetLongSnow           = (double *) va_arg(ap, double *);
-  RefreezeEnergy        = (double *) va_arg(ap, double *);
-  SensibleHeat          = (double *) va_arg(ap, double *);
-  VaporMassFlux         = (double *) va_arg(ap, double *);
-  BlowingMassFlux       = (double *) va_arg(ap, double *);
-  SurfaceMassFlux       = (double *) va_arg(ap, double *);
-  ErrorString           = (char *) va_arg(ap, char *);
+  Tair         = args->Tair;
+  TGrnd           = args->TGrnd;
+
+  AdvectedEnergy        = args->AdvectedEnergy;
+  AdvectedSensibleHeat  = args->AdvectedSensibleHeat;
+  DeltaColdContent      = args->DeltaColdContent;
+  GroundFlux            = args->GroundFlux;
+  LatentHeat            = args->LatentHeat;
+  LatentHeatSub         = args->LatentHeatSub;
+  NetLongSnow           = args->NetLongUnder;
+  RefreezeEnergy        = args->RefreezeEnergy;
+  SensibleHeat          = args->SensibleHeat;
+  VaporMassFlux         = args->vapor_flux;
+  BlowingMassFlux       = args->blowing_flux;
+  SurfaceMassFlux       = args->surface_flux;
 
   /* print variables */
   fprintf(stderr, "%s", ErrorString);
@@ -779,7 +712,6 @@ double ErrorPrintSnowPackEnergyBalance(double TSurf, va_list ap)
   fprintf(stderr,"AdvectedEnergy = %f\n",AdvectedEnergy[0]);
   fprintf(stderr,"AdvectedSensibleHeat = %f\n",AdvectedSensibleHeat[0]);
   fprintf(stderr,"DeltaColdContent = %f\n",DeltaColdContent[0]);
-  fprintf(stderr,"DeltaPackColdContent = %f\n",DeltaPackColdContent[0]);
   fprintf(stderr,"GroundFlux = %f\n",GroundFlux[0]);
   fprintf(stderr,"LatentHeat = %f\n",LatentHeat[0]);
   fprintf(stderr,"LatentHeatSub = %f\n",LatentHeatSub[0]);
@@ -79,7 +79,7 @@ void soil_carbon_balance(soil_con_struct *soil_con,
     i++;
   }
   Nnodes = i;
-  if (soil_con->Zsum_node[i] > dZTot) {
+  if (i > 0 && soil_con->Zsum_node[i] > dZTot) {
     Nnodes--;
   }
   dZ = (double*)calloc(Nnodes,sizeof(double));
@@ -106,6 +106,59 @@ double soil_conductivity(double moist,
 }
 
 
+double soil_conductivity_dWu(double moist, 
+			     double Wu, 
+			     double soil_dens_min, 
+			     double bulk_dens_min,
+			     double quartz,
+			     double soil_density, 
+			     double bulk_density,
+			     double organic) {
+/**********************************************************************
+  Derivative of soil_conductivity() with respect to the liquid water
+  content Wu, at constant total moisture.  Used for the Jacobian of
+  the implicit soil temperature solution.  Arguments are as for
+  soil_conductivity().
+
+  Returns dK/dWu in W/m/K
+
+  Modifications:
+**********************************************************************/
+  double Ki = 2.2;      /* thermal conductivity of ice (W/mK) */
+  double Kw = 0.57;     /* thermal conductivity of water (W/mK) */
+  double Ksat;
+  double Kdry;
+  double Kdry_org = 0.05;
+  double Kdry_min;
+  double Ks;
+  double Ks_org = 0.25;
+  double Ks_min;
+  double Sr;
+  double porosity;
+
+  /* K does not depend on Wu for dry or unfrozen soil */
+  if(moist<=0. || Wu==moist) return (0.);
+
+  Kdry_min = (0.135*bulk_dens_min+64.7)/(soil_dens_min-0.947*bulk_dens_min);
+  Kdry = (1-organic)*Kdry_min + organic*Kdry_org;
+
+  porosity = 1.0 - bulk_density / soil_density;
+  Sr = moist/porosity;
+
+  if(quartz < .2)
+    Ks_min = pow(7.7,quartz) * pow(3.0,1.0-quartz);
+  else
+    Ks_min = pow(7.7,quartz) * pow(2.2,1.0-quartz);
+  Ks = (1-organic)*Ks_min + organic*Ks_org;
+
+  /** Soil frozen: K = (Ksat-Kdry)*Sr+Kdry, Ksat ~ Ki^(porosity-Wu)*Kw^Wu **/
+  Ksat = pow(Ks,1.0-porosity) * pow(Ki,porosity-Wu) * pow(Kw,Wu);
+  if((Ksat-Kdry)*Sr+Kdry < Kdry) return (0.);
+
+  return (Sr*Ksat*log(Kw/Ki));
+}
+
+
 double volumetric_heat_capacity(double soil_fract,
                                 double water_fract,
                                 double ice_fract,
@@ -344,6 +397,8 @@ int distribute_node_moisture_properties(double *moist_node,
 	      set using SLAB_MOIST_FRACT * max_moist_node.		KAC via TJB
   2013-Dec-26 Removed EXCESS_ICE option.				TJB
   2013-Dec-27 Removed QUICK_FS option.					TJB
+  2026-Oct-18 Options are read through OPT_* (see vicNl_def.h), so
+	      that specialized builds can fix them at compile time.
 *********************************************************************/
 
   extern option_struct options;
@@ -389,7 +444,7 @@ int distribute_node_moisture_properties(double *moist_node,
 //    }
     if (moist_node[nidx]-max_moist_node[nidx] > 0) moist_node[nidx] = max_moist_node[nidx]; // HACK!!!!!!!!!!!
 
-    if(T_node[nidx] < 0 && (FS_ACTIVE && options.FROZEN_SOIL)) {
+    if(T_node[nidx] < 0 && (FS_ACTIVE && OPT_FROZEN_SOIL)) {
       /* compute moisture and ice contents */
       ice_node[nidx] 
 	= moist_node[nidx] - maximum_unfrozen_water(T_node[nidx],
@@ -536,6 +591,7 @@ int estimate_layer_ice_content(layer_data_struct *layer,
     for ( nidx = min_nidx; nidx <= max_nidx; nidx++ ) {
       min_temp = tmpT[nidx][options.Nfrost] - frost_slope / 2.;
       max_temp = min_temp + frost_slope;
+      tmp_fract = 0;
       for ( frost_area = 0; frost_area < options.Nfrost; frost_area++ ) {
 	if ( options.Nfrost > 1 ) {
 	  if ( frost_area == 0 ) tmp_fract = frost_fract[0] / 2.;
@@ -548,7 +604,7 @@ int estimate_layer_ice_content(layer_data_struct *layer,
     }
 
     // Get soil node ice content for current layer
-    if (options.FROZEN_SOIL && FS_ACTIVE) {
+    if (OPT_FROZEN_SOIL && FS_ACTIVE) {
       for ( nidx = min_nidx; nidx <= max_nidx; nidx++ ) {
         for ( frost_area = 0; frost_area < options.Nfrost; frost_area++ ) {
 	  tmp_ice[nidx][frost_area] = layer[lidx].moist 
@@ -623,20 +679,20 @@ int estimate_layer_ice_content_quick_flux(layer_data_struct *layer,
 
   // compute cumulative layer depths
   Lsum[0] = 0;
-  for ( lidx = 1; lidx <= options.Nlayer; lidx++ ) Lsum[lidx] = depth[lidx-1] + Lsum[lidx-1];
+  for ( lidx = 1; lidx <= OPT_Nlayer; lidx++ ) Lsum[lidx] = depth[lidx-1] + Lsum[lidx-1];
 
   // estimate soil layer average temperatures
   layer[0].T = 0.5*(Tsurf+T1); // linear profile in topmost layer
-  for ( lidx = 1; lidx < options.Nlayer; lidx++ ) {
+  for ( lidx = 1; lidx < OPT_Nlayer; lidx++ ) {
     layer[lidx].T = Tp - Dp/(depth[lidx])*(T1-Tp)*(exp(-(Lsum[lidx+1]-Lsum[1])/Dp)-exp(-(Lsum[lidx]-Lsum[1])/Dp));
   }
 
   // estimate soil layer ice contents
-  for ( lidx = 0; lidx < options.Nlayer; lidx++ ) {
+  for ( lidx = 0; lidx < OPT_Nlayer; lidx++ ) {
 
     for ( frost_area = 0; frost_area < options.Nfrost; frost_area++ ) layer[lidx].ice[frost_area] = 0;
 
-    if (options.FROZEN_SOIL && FS_ACTIVE) {
+    if (OPT_FROZEN_SOIL && FS_ACTIVE) {
 
       min_temp = layer[lidx].T - frost_slope / 2.;
       max_temp = min_temp + frost_slope;
@@ -809,3 +865,26 @@ double maximum_unfrozen_water(double T,
   
 }
 
+double maximum_unfrozen_water_dT(double T,
+                                 double max_moist,
+                                 double bubble,
+                                 double expt) {
+/**********************************************************************
+  Derivative of maximum_unfrozen_water() with respect to T; zero where
+  the unfrozen water content is limited to [0, max_moist].
+
+  Modifications:
+**********************************************************************/
+
+  double unfrozen;
+
+  if ( T < 0. ) {
+    unfrozen = max_moist * pow((-Lf * T) / 273.16 / (9.81 * bubble / 100.), -(2.0 / (expt - 3.0)));  
+    if(unfrozen > max_moist || unfrozen < 0.) return (0.);
+    return (-(2.0 / (expt - 3.0)) * unfrozen / T);
+  }
+
+  return (0.);
+
+}
+
@@ -4,7 +4,7 @@
 
 static char vcid[] = "$Id$";
 
-double soil_thermal_eqn(double T, va_list ap) {
+double soil_thermal_eqn(double T, void *params) {
 
  /******************************************************************
   Modifications:
@@ -21,7 +21,10 @@ double soil_thermal_eqn(double T, va_list ap) {
   2007-Oct-08 Fixed error in EXP_TRANS formulation.				JCA
   2013-Dec-26 Removed EXCESS_ICE option.				TJB
   2013-Dec-27 Removed QUICK_FS option.					TJB
+  2026-Oct-18 Replaced the variable argument list with an argument
+	      structure passed through root_brent().
   ******************************************************************/
+  soil_thermal_args_struct *args = (soil_thermal_args_struct *) params;
 
 
   double value;
@@ -46,22 +49,22 @@ double soil_thermal_eqn(double T, va_list ap) {
   double flux_term1;
   double flux_term2;
 
-  TL         = (double) va_arg(ap, double);
-  TU         = (double) va_arg(ap, double);
-  T0         = (double) va_arg(ap, double);
-  moist      = (double) va_arg(ap, double);
-  max_moist  = (double) va_arg(ap, double);
-  bubble     = (double) va_arg(ap, double);
-  expt       = (double) va_arg(ap, double);
-  ice0       = (double) va_arg(ap, double);
-  gamma      = (double) va_arg(ap, double);
-  A          = (double) va_arg(ap, double);
-  B          = (double) va_arg(ap, double);
-  C          = (double) va_arg(ap, double);
-  D          = (double) va_arg(ap, double);
-  E          = (double) va_arg(ap, double);
-  EXP_TRANS  = (int) va_arg(ap, int);
-  node       = (int) va_arg(ap, int);
+  TL         = args->TL;
+  TU         = args->TU;
+  T0         = args->T0;
+  moist      = args->moist;
+  max_moist  = args->max_moist;
+  bubble     = args->bubble;
+  expt       = args->expt;
+  ice0       = args->ice0;
+  gamma      = args->gamma;
+  A          = args->A;
+  B          = args->B;
+  C          = args->C;
+  D          = args->D;
+  E          = args->E;
+  EXP_TRANS  = args->EXP_TRANS;
+  node       = args->node;
 
   if(T<0.) {
     ice = moist - maximum_unfrozen_water(T,max_moist,bubble,expt);
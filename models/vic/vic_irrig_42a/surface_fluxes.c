@@ -8,6 +8,11 @@ static char vcid[] = "$Id$";
 #define GRND_TOL 0.001
 #define OVER_TOL 0.001
 
+/* Counts of the cell being run (see use_snow_step_stats()); steps
+   taken outside a cell are counted in default_snow_steps */
+static snow_step_stats_struct default_snow_steps;
+static snow_step_stats_struct *snow_steps = &default_snow_steps;
+
 int surface_fluxes(char                 overstory,
 		   double               BareAlbedo,
 		   double               height,
@@ -98,7 +103,7 @@ int surface_fluxes(char                 overstory,
 	      step = sub-daily.						TJB
   2007-Aug-17 Added features for EXCESS_ICE option.                     JCA
   2008-May-05 Changed moist from a scalar to an array (moist0).  Previously,
-	      when options.SNOW_BAND > 1, the value of moist computed
+	      when OPT_SNOW_BAND > 1, the value of moist computed
 	      for earlier bands was always overwritten by the value
 	      of moist computed for the final band (even if the final
 	      band had 0 area).						KAC via TJB
@@ -145,6 +150,14 @@ int surface_fluxes(char                 overstory,
   2014-Mar-28 Removed DIST_PRCP option.					TJB
   2014-Apr-25 Added non-climatological veg parameters.			TJB
   2014-Apr-25 Added partial vegcover fraction.				TJB
+  2026-Oct-18 Potential evap is only computed for the types that are
+	      written (options.PET_OUT).
+  2026-Oct-18 With ADAPT_SNOW_STEP, snow sub-steps are only used if
+	      snow can fall in this band; counts the steps that use
+	      them (print_snow_step_stats()).
+  2026-Oct-18 The counts are those selected by use_snow_step_stats().
+  2026-Oct-18 Options are read through OPT_* (see vicNl_def.h), so
+	      that specialized builds can fix them at compile time.
 **********************************************************************/
 {
   extern veg_lib_struct *veg_lib;
@@ -164,6 +177,7 @@ int surface_fluxes(char                 overstory,
   int                    step_inc; // number of atmos array elements to skip per surface fluxes step
   int                    endhidx;  // index of final element of atmos array
   int                    step_dt;  // time length of surface fluxes step
+  int                    snow_possible; // TRUE = snow can fall during this step
   int                    lidx;
   int                    over_iter;
   int                    under_iter;
@@ -327,7 +341,7 @@ int surface_fluxes(char                 overstory,
   else
     MAX_ITER_GRND_CANOPY = 0;
 
-  if (options.CARBON) {
+  if (OPT_CARBON) {
     store_gsLayer = (double*)calloc(options.Ncanopy,sizeof(double));
   }
 
@@ -382,7 +396,17 @@ int surface_fluxes(char                 overstory,
     if frozen soils are present)
   ********************************/
 
-  if(snow->swq > 0 || snow->snow_canopy > 0 || atmos->snowflag[NR]) {
+  /* atmos->snowflag[NR] is set if snow can fall in the coldest band */
+  snow_possible = atmos->snowflag[NR];
+  if (snow_possible && options.ADAPT_SNOW_STEP && NF > 1) {
+    snow_possible = FALSE;
+    for (hidx = 0; hidx < NF; hidx++)
+      if (atmos->snowflag[hidx]
+	  && atmos->air_temp[hidx] + soil_con->Tfactor[band] < gp->MAX_SNOW_TEMP)
+	snow_possible = TRUE;
+  }
+
+  if(snow->swq > 0 || snow->snow_canopy > 0 || snow_possible) {
     hidx      = 0;
     step_inc  = 1;
     endhidx   = hidx + NF;
@@ -394,6 +418,10 @@ int surface_fluxes(char                 overstory,
     endhidx   = hidx + step_inc;
     step_dt   = gp->dt;
   }
+  if (NF > 1) {
+    snow_steps->nsteps++;
+    if (hidx == 0) snow_steps->nsubsteps++;
+  }
 
   /*******************************************
     Initialize sub-model time step variables
@@ -444,7 +472,7 @@ int surface_fluxes(char                 overstory,
   // veg_var and cell structures
   store_throughfall = 0.;
   store_canopyevap  = 0.;
-  for ( lidx = 0; lidx < options.Nlayer; lidx++ ) {
+  for ( lidx = 0; lidx < OPT_Nlayer; lidx++ ) {
     store_layerevap[lidx] = 0.;
   }
   step_Wdew          = veg_var->Wdew;
@@ -458,7 +486,7 @@ int surface_fluxes(char                 overstory,
   N_steps                 = 0;
 
   // Carbon cycling
-  if (options.CARBON) {
+  if (OPT_CARBON) {
     store_gc        = 0;
     for (cidx=0; cidx<options.Ncanopy; cidx++) {
       store_gsLayer[cidx] = 0;
@@ -501,7 +529,7 @@ int surface_fluxes(char                 overstory,
     last_snow_flux    = 999;
 
     // compute LAI and absorbed PAR per canopy layer
-    if (options.CARBON && iveg < Nveg) {
+    if (OPT_CARBON && iveg < Nveg) {
       LAIlayer = (double *)calloc(options.Ncanopy,sizeof(double));
       faPAR = (double *)calloc(options.Ncanopy,sizeof(double));
       /* Compute absorbed PAR per ground area per canopy layer (W/m2)
@@ -654,7 +682,7 @@ int surface_fluxes(char                 overstory,
 			       &step_out_prec, &step_out_rain, &step_out_snow,
 			       &step_ppt, &rainfall, ref_height, 
 			       roughness, snow_inflow, &snowfall, &surf_atten, 
-			       wind, root, UNSTABLE_SNOW, options.Nnode, 
+			       wind, root, UNSTABLE_SNOW, OPT_Nnode, 
 			       Nveg, iveg, band, step_dt, rec, hidx, veg_class,
 			       &UnderStory, CanopLayerBnd, &dryFrac, 
 			       dmy, atmos, &(iter_snow_energy), 
@@ -701,8 +729,8 @@ int surface_fluxes(char                 overstory,
 				     displacement, &step_melt, &step_ppt, 
 				     rainfall, ref_height, roughness, 
 				     snowfall, wind, root, INCLUDE_SNOW, 
-				     UnderStory, options.Nnode, Nveg, band, 
-				     step_dt, hidx, iveg, options.Nlayer, 
+				     UnderStory, OPT_Nnode, Nveg, band, 
+				     step_dt, hidx, iveg, OPT_Nlayer, 
 				     (int)overstory, rec, veg_class, 
 				     CanopLayerBnd, &dryFrac, atmos, 
 				     &(dmy[rec]), &iter_soil_energy, 
@@ -806,7 +834,7 @@ int surface_fluxes(char                 overstory,
     /**************************************
       Compute GPP, Raut, and NPP
     **************************************/
-    if (options.CARBON) {
+    if (OPT_CARBON) {
       if (iveg < Nveg && !step_snow.snow && dryFrac > 0) {
         canopy_assimilation(veg_lib[veg_class].Ctype,
                             veg_lib[veg_class].MaxCarboxRate,
@@ -883,6 +911,7 @@ int surface_fluxes(char                 overstory,
 
     // Next, loop over pot_evap types and apply the correction to the relevant aerodynamic resistance
     for (p=0; p<N_PET_TYPES; p++) {
+      if (!options.PET_OUT[p]) continue;
       if (stability_factor[0] == HUGE_RESIST)
         step_aero_resist[p][0] = HUGE_RESIST;
       else
@@ -905,7 +934,7 @@ int surface_fluxes(char                 overstory,
     snow_veg_var = iter_snow_veg_var;
     soil_veg_var = iter_soil_veg_var;
     step_snow = iter_snow;
-    for(lidx = 0; lidx < options.Nlayer; lidx++) {
+    for(lidx = 0; lidx < OPT_Nlayer; lidx++) {
       step_layer[lidx] = iter_layer[lidx];
     }
 
@@ -921,7 +950,7 @@ int surface_fluxes(char                 overstory,
         snow_veg_var.Wdew  = soil_veg_var.Wdew;
       }
       step_Wdew = soil_veg_var.Wdew;
-      if (options.CARBON) {
+      if (OPT_CARBON) {
         store_gc  += 1/soil_veg_var.rc;
         for (cidx=0; cidx<options.Ncanopy; cidx++) {
           store_gsLayer[cidx]  += 1/soil_veg_var.rsLayer[cidx];
@@ -936,7 +965,7 @@ int surface_fluxes(char                 overstory,
         store_NPP  += soil_veg_var.NPP;
       }
     }
-    for(lidx = 0; lidx < options.Nlayer; lidx++)
+    for(lidx = 0; lidx < OPT_Nlayer; lidx++)
       store_layerevap[lidx] += step_layer[lidx].evap;
     store_ppt += step_ppt;
     if (iter_aero_resist_used[0]>0)
@@ -1131,7 +1160,7 @@ int surface_fluxes(char                 overstory,
     Store carbon cycle variable sums for sub-model time steps
   **********************************************************/
 
-  if(options.CARBON && iveg != Nveg) {
+  if(OPT_CARBON && iveg != Nveg) {
     veg_var->rc       = 1/store_gc/(double)N_steps;
     for (cidx=0; cidx<options.Ncanopy; cidx++) {
       veg_var->rsLayer[cidx] = 1/store_gsLayer[cidx]/(double)N_steps;
@@ -1164,11 +1193,58 @@ int surface_fluxes(char                 overstory,
   //fprintf(stdout,"surface_fluxes inflow %f ppt %f veg_varirrig %f\n",(*inflow),ppt,veg_var->irrig);
 
   ErrorFlag = runoff(cell, energy, soil_con, ppt, soil_con->frost_fract,
-                     gp->dt, options.Nnode, band, rec, iveg);
+                     gp->dt, OPT_Nnode, band, rec, iveg);
 
   return( ErrorFlag );
 
 }
 
+void use_snow_step_stats(snow_step_stats_struct *stats)
+/**********************************************************************
+  use_snow_step_stats
+
+  Selects the counts that the following calls of surface_fluxes()
+  update; NULL selects counts kept here, for steps taken outside a
+  cell.
+**********************************************************************/
+{
+  snow_steps = (stats != NULL) ? stats : &default_snow_steps;
+}
+
+void reset_snow_step_stats(snow_step_stats_struct *stats)
+/**********************************************************************
+  reset_snow_step_stats
+
+  Resets the counts of model steps that used snow sub-steps, at the
+  start of a cell.
+**********************************************************************/
+{
+  stats->nsteps    = 0;
+  stats->nsubsteps = 0;
+}
+
+void print_snow_step_stats(snow_step_stats_struct *stats)
+/**********************************************************************
+  print_snow_step_stats
+
+  Reports the fraction of model steps (of all tiles and bands) that
+  used snow sub-steps, in the cell and in all cells reported so far,
+  when the model time step is longer than SNOW_STEP.
+**********************************************************************/
+{
+  static snow_step_stats_struct total;
+
+  if (NF <= 1 || stats->nsteps == 0)
+    return;
+
+  total.nsteps    += stats->nsteps;
+  total.nsubsteps += stats->nsubsteps;
+  fprintf(stderr,"Snow sub-steps used in %ld of %ld steps (%.1f%%); all cells so far: %ld of %ld (%.1f%%)\n",
+	  stats->nsubsteps, stats->nsteps,
+	  100. * stats->nsubsteps / stats->nsteps,
+	  total.nsubsteps, total.nsteps,
+	  100. * total.nsubsteps / total.nsteps);
+}
+
 #undef GRND_TOL
 #undef OVER_TOL
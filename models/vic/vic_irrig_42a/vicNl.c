@@ -2,7 +2,6 @@
 #include <stdlib.h>
 #include <string.h>
 #include <vicNl.h>
-#include <global.h>
 
 static char vcid[] = "$Id$";
 
@@ -98,6 +97,18 @@ int main(int argc, char *argv[])
 	      OUTPUT_FORCE condition to avoid memory leak.		TJB
   2014-Mar-28 Removed DIST_PRCP option.					TJB
   2014-Apr-25 Added non-climatological veg parameters.			TJB
+  2026-Oct-18 Each cell is now run through the vic_cell_*() calls
+	      (vic_cell.c); global variables moved there with global.h.
+  2026-Oct-18 Added checkpoint files: cells continue from the snapshot
+	      in INIT_CHECKPOINT when their inputs up to it match, and
+	      snapshots are written to CHECKPOINT at the state date.
+  2026-Oct-18 Added closing of the SINGLE_OUTFILE files and waiting
+	      for the compression of output files.
+  2026-Oct-18 Builds the blowing snow table when BLOWING_TABLE is TRUE.
+  2026-Oct-18 Reports the iteration statistics of the temperature
+	      solutions of each cell when ROOT_STATS is TRUE.
+  2026-Oct-18 Reports the use of snow sub-steps of each cell when
+	      ADAPT_SNOW_STEP is TRUE.
 **********************************************************************/
 {
 
@@ -128,17 +139,15 @@ int main(int argc, char *argv[])
   double                   Clake;
   dmy_struct              *dmy;
   atmos_data_struct       *atmos;
-  veg_hist_struct        **veg_hist;
   veg_con_struct          *veg_con;
   soil_con_struct          soil_con;
-  all_vars_struct          all_vars;
   filenames_struct         filenames;
   filep_struct             filep;
   lake_con_struct          lake_con;
   out_data_file_struct     *out_data_files;
   out_data_struct          *out_data;
-  save_data_struct         save_data;
-  all_vars_struct          all_vars_crop;
+  cell_ctx_struct         *cell;
+  cell_snapshot_struct     snapshot;
  
   /** Read Model Options **/
   initialize_global();
@@ -165,6 +174,10 @@ int main(int argc, char *argv[])
   if (!options.OUTPUT_FORCE) {
     /** Read Vegetation Library File **/
     veg_lib = read_veglib(filep.veglib,&Nveg_type);
+
+    /** Build the Blowing Snow Table **/
+    if (options.BLOWING && options.BLOWING_TABLE)
+      init_blowing_table(filenames.blowing_table);
   } /* !OUTPUT_FORCE */
 
   /** Initialize Parameters **/
@@ -178,6 +191,8 @@ int main(int argc, char *argv[])
 
   /** Initial state **/
   startrec = 0;
+  filep.checkpoint      = NULL;
+  filep.init_checkpoint = NULL;
   if (!options.OUTPUT_FORCE) {
 
     if ( options.INIT_STATE ) 
@@ -191,6 +206,13 @@ int main(int argc, char *argv[])
                                            options.Nnode);
     else filep.statefile = NULL;
 
+    /** open checkpoint files **/
+    if ( options.INIT_CHECKPOINT )
+      filep.init_checkpoint = open_checkpoint_file(filenames.init_checkpoint,
+                                                   "rb");
+    if ( options.SAVE_CHECKPOINT )
+      filep.checkpoint = open_checkpoint_file(filenames.checkpoint, "wb");
+
   } /* !OUTPUT_FORCE */
 
   /************************************
@@ -231,12 +253,10 @@ int main(int argc, char *argv[])
         /** Read Elevation Band Data if Used **/
         read_snowband(filep.snowband, &soil_con);
 
-        /** Make Top-level Control Structure **/
-        all_vars     = make_all_vars(veg_con[0].vegetat_type_num);
-        all_vars_crop     = make_all_vars(veg_con[0].Ncrop-1);
-
-        /** allocate memory for the veg_hist_struct **/
-        alloc_veg_hist(global_param.nrecs, veg_con[0].vegetat_type_num, &veg_hist);
+        /** Make Cell Context (state, veg_hist) **/
+        cell = vic_cell_create(cellnum, &soil_con, veg_con, &lake_con, dmy,
+                               atmos, out_data);
+        cell->out_data_files = out_data_files;
 
       } /* !OUTPUT_FORCE */
 
@@ -249,8 +269,11 @@ int main(int argc, char *argv[])
       fprintf(stderr,"Initializing Forcing Data\n");
 #endif /* VERBOSE */
 
-      initialize_atmos(atmos, dmy, filep.forcing, veg_lib, veg_con, veg_hist,
-		       &soil_con, out_data_files, out_data); 
+      if (!options.OUTPUT_FORCE)
+        vic_cell_force(cell, filep.forcing);
+      else /* no veg parameters are read with OUTPUT_FORCE */
+        initialize_atmos(atmos, dmy, filep.forcing, veg_lib, NULL, NULL,
+		         &soil_con, out_data_files, out_data); 
 
       if (!options.OUTPUT_FORCE) {
 
@@ -261,65 +284,75 @@ int main(int argc, char *argv[])
 #if VERBOSE
         fprintf(stderr,"Model State Initialization\n");
 #endif /* VERBOSE */
-        ErrorFlag = initialize_model_state(&all_vars, &all_vars_crop, dmy[0], &global_param, filep, 
-			       soil_con.gridcel, veg_con[0].vegetat_type_num,
-			       options.Nnode, 
-			       atmos[0].air_temp[NR],
-			       &soil_con, veg_con, lake_con);
+
+        /** Update Error Handling Structure **/
+        Error.filep = filep;
+        Error.out_data_files = out_data_files;
+
+        /** Initialize the model state and the storage terms in the
+            water and energy balances **/
+        ErrorFlag = vic_cell_init(cell, filep.init_state, startrec);
         if ( ErrorFlag == ERROR ) {
 	  if ( options.CONTINUEONERROR == TRUE ) {
 	    // Handle grid cell solution error
-	    fprintf(stderr, "ERROR: Grid cell %i failed in record %i so the simulation has not finished.  An incomplete output file has been generated, check your inputs before rerunning the simulation.\n", soil_con.gridcel, rec);
+	    fprintf(stderr, "ERROR: Grid cell %i failed in record %i so the simulation has not finished.  An incomplete output file has been generated, check your inputs before rerunning the simulation.\n", soil_con.gridcel, startrec);
 	    break;
 	  } else {
 	    // Else exit program on cell solution error as in previous versions
-	    sprintf(ErrStr, "ERROR: Grid cell %i failed in record %i so the simulation has ended. Check your inputs before rerunning the simulation.\n", soil_con.gridcel, rec);
+	    sprintf(ErrStr, "ERROR: Grid cell %i failed in record %i so the simulation has ended. Check your inputs before rerunning the simulation.\n", soil_con.gridcel, startrec);
 	    vicerror(ErrStr);
 	  }
         }
+
+        /** Continue from the snapshot of the cell if its inputs up to
+            the snapshot are the same as in this run **/
+        if ( filep.init_checkpoint != NULL ) {
+          if ( vic_cell_read_snapshot(filep.init_checkpoint, soil_con.gridcel,
+                                      &snapshot) == ERROR )
+            fprintf(stderr, "WARNING: Grid cell %i is not in checkpoint file %s; it is simulated from the start.\n", soil_con.gridcel, filenames.init_checkpoint);
+          else {
+            if ( vic_cell_restore(cell, &snapshot) == ERROR )
+              fprintf(stderr, "WARNING: The forcings, parameters or model options of grid cell %i differ from those of checkpoint file %s; it is simulated from the start.\n", soil_con.gridcel, filenames.init_checkpoint);
+            vic_cell_free_snapshot(&snapshot);
+          }
+        }
       
 #if VERBOSE
         fprintf(stderr,"Running Model\n");
 #endif /* VERBOSE */
 
-        /** Update Error Handling Structure **/
-        Error.filep = filep;
-        Error.out_data_files = out_data_files;
-
-        /** Initialize the storage terms in the water and energy balances **/
-        /** Sending a negative record number (-global_param.nrecs) to put_data() will accomplish this **/
-	ErrorFlag = put_data(&all_vars, &atmos[0], &soil_con, veg_con, &lake_con, out_data_files, out_data, &save_data, &dmy[0], -global_param.nrecs);
-
         /******************************************
 	  Run Model in Grid Cell for all Time Steps
 	******************************************/
 
-        for ( rec = startrec ; rec < global_param.nrecs; rec++ ) {
+        for ( rec = cell->rec ; rec < global_param.nrecs; rec++ ) {
 
           if ( rec == global_param.nrecs - 1 ) LASTREC = TRUE;
           else LASTREC = FALSE;
 
 	  /**************************************************
-	    Compute cell physics for 1 timestep
+	    Compute cell physics for 1 timestep, and
+	    write cell average values for current time step
 	  **************************************************/
-	  ErrorFlag = full_energy(cellnum, rec, &atmos[rec], &all_vars, &all_vars_crop, dmy, &global_param, &lake_con, &soil_con, veg_con, veg_hist);
-
-	  /**************************************************
-	    Write cell average values for current time step
-	  **************************************************/
-	  ErrorFlag = put_data(&all_vars, &atmos[rec], &soil_con, veg_con, &lake_con, out_data_files, out_data, &save_data, &dmy[rec], rec);
+	  ErrorFlag = vic_cell_step(cell, NULL);
 
 	  /************************************
 	    Save model state at assigned date
 	    (after the final time step of the assigned date)
 	  ************************************/
-	  if ( filep.statefile != NULL
-	       &&  ( dmy[rec].year == global_param.stateyear
-		     && dmy[rec].month == global_param.statemonth 
-		     && dmy[rec].day == global_param.stateday
-		     && ( rec+1 == global_param.nrecs
-			  || dmy[rec+1].day != global_param.stateday ) ) )
-	    write_model_state(&all_vars, &global_param, veg_con->vegetat_type_num, soil_con.gridcel, &filep, &soil_con, lake_con);
+	  if ( dmy[rec].year == global_param.stateyear
+	       && dmy[rec].month == global_param.statemonth 
+	       && dmy[rec].day == global_param.stateday
+	       && ( rec+1 == global_param.nrecs
+		    || dmy[rec+1].day != global_param.stateday ) ) {
+	    if ( filep.statefile != NULL )
+	      vic_cell_save_state(cell, filep.statefile);
+	    if ( filep.checkpoint != NULL ) {
+	      vic_cell_snapshot(cell, &snapshot);
+	      vic_cell_write_snapshot(filep.checkpoint, &snapshot);
+	      vic_cell_free_snapshot(&snapshot);
+	    }
+	  }
 
 
           if ( ErrorFlag == ERROR ) {
@@ -338,15 +371,16 @@ int main(int argc, char *argv[])
 
         } /* End Rec Loop */
 
+        if ( options.ROOT_STATS ) print_root_stats(cell->root_stats);
+        if ( options.ADAPT_SNOW_STEP ) print_snow_step_stats(&cell->snow_steps);
+
       } /* !OUTPUT_FORCE */
 
       close_files(&filep,out_data_files,&filenames); 
 
       if (!options.OUTPUT_FORCE) {
 
-        free_veg_hist(global_param.nrecs, veg_con[0].vegetat_type_num, &veg_hist);
-        free_all_vars(&all_vars,veg_con[0].vegetat_type_num);
-        free_all_vars(&all_vars_crop,veg_con[0].Ncrop-1);
+        vic_cell_free(&cell);
         free_vegcon(&veg_con);
         free((char *)soil_con.AreaFract);
         free((char *)soil_con.BandElev);
@@ -360,6 +394,9 @@ int main(int argc, char *argv[])
   } 	/* End Grid Loop */
 
   /** cleanup **/
+  if (options.SINGLE_OUTFILE)
+    close_single_outfiles(out_data_files);
+  finish_compression();
   free_atmos(global_param.nrecs, &atmos);
   free_dmy(&dmy);
   free_out_data_files(&out_data_files);
@@ -377,6 +414,10 @@ int main(int argc, char *argv[])
       fclose(filep.init_state);
     if ( options.SAVE_STATE && strcmp( filenames.statefile, "NONE" ) != 0 )
       fclose(filep.statefile);
+    if ( filep.init_checkpoint != NULL )
+      fclose(filep.init_checkpoint);
+    if ( filep.checkpoint != NULL )
+      fclose(filep.checkpoint);
   } /* !OUTPUT_FORCE */
 
   return EXIT_SUCCESS;
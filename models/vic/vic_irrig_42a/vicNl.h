@@ -124,6 +124,31 @@
   2014-Apr-25 Added non-climatological veg parameter functions.		TJB
   2014-Apr-25 Resurrected calc_veg_displacement() and
 	      calc_veg_roughness().					TJB
+  2026-Oct-18 Functions solved by root_brent() now take an argument
+	      structure instead of a va_list; removed the variable argument
+	      wrappers around them.
+  2026-Oct-18 Added call site argument to root_brent(); added
+	      root_brent_warm(), reset_root_stats() and print_root_stats().
+  2026-Oct-18 fda_heat_eqn() and newt_raph() now take an argument
+	      structure; replaced fdjac3() with the analytic Jacobian
+	      fda_heat_jac().  Added maximum_unfrozen_water_dT() and
+	      soil_conductivity_dWu().
+  2026-Oct-18 Added the vic_cell_*() calls.
+  2026-Oct-18 Added cell snapshots and open_checkpoint_file().
+  2026-Oct-18 Added close_single_outfiles(), finish_compression() and
+	      write_outfile_chunk().
+  2026-Oct-18 Added hash_bytes() and mtclim_cached(); added dmy to
+	      write_forcing_file().
+  2026-Oct-18 Added set_active_outvars().
+  2026-Oct-18 Added reset_snow_step_stats() and print_snow_step_stats().
+  2026-Oct-18 Added init_blowing_table().
+  2026-Oct-18 Added photosynth_layers().
+  2026-Oct-18 Added use_root_stats(); reset_root_stats() and
+	      print_root_stats() take the statistics of a cell.
+  2026-Oct-18 Added use_snow_step_stats(); reset_snow_step_stats() and
+	      print_snow_step_stats() take the counts of a cell.
+  2026-Oct-18 Added the storage of the previous record to
+	      calc_water_balance_error().
 ************************************************************************/
 
 #include <math.h>
@@ -163,7 +188,6 @@ int    calc_soil_thermal_fluxes(int, double *, double *, char *, int *, double *
 				double *, double *, double *, 
 				double *, double *, double *, 
 				int, int, int, int);
-double CalcSnowPackEnergyBalance(double Tsurf, ...);
 double CalcBlowingSnow(double, double, int, double, double, double, double, 
                        double, double, double, double, double, float, 
                        float, double, int, int, float, double, double, double *); 
@@ -194,7 +218,7 @@ double calc_surf_energy_bal(double, double, double, double, double, double,
 double calc_veg_displacement(double);
 double calc_veg_height(double);
 double calc_veg_roughness(double);
-double calc_water_balance_error(int, double, double, double);
+double calc_water_balance_error(int, double, double, double, double);
 void canopy_assimilation(char, double, double, double, double *, double,
                          double, double *, double, double, double *,
                          double, char *, double *, double *,
@@ -210,6 +234,7 @@ void   check_files(filep_struct *, filenames_struct *);
 FILE  *check_state_file(char *, dmy_struct *, global_param_struct *, int, int, 
                         int *);
 void   close_files(filep_struct *, out_data_file_struct *, filenames_struct *);
+void   close_single_outfiles(out_data_file_struct *);
 filenames_struct cmd_proc(int argc, char *argv[]);
 void   collect_eb_terms(energy_bal_struct, snow_data_struct, cell_data_struct,
                         int *, int *, int *, int *, int *, double, double, double,
@@ -244,18 +269,12 @@ void   distribute_soil_property(double *,double,double,
 				double **l_param,
 				int, int, double *, double *);
 
-double error_calc_atmos_energy_bal(double Tcanopy, ...);
-double error_calc_atmos_moist_bal(double , ...);
-double error_calc_canopy_energy_bal(double Tsurf, ...);
-double error_calc_surf_energy_bal(double Tsurf, ...);
-double ErrorSnowPackEnergyBalance(double Tsurf, ...);
-double error_print_atmos_energy_bal(double, va_list);
-double error_print_atmos_moist_bal(double, va_list);
-double error_print_canopy_energy_bal(double, va_list);
-double ErrorPrintSnowPackEnergyBalance(double, va_list);
-double error_print_solve_T_profile(double, va_list);
-double error_print_surf_energy_bal(double, va_list);
-double error_solve_T_profile(double Tsurf, ...);
+double error_print_atmos_energy_bal(double, atmos_energy_bal_args_struct *, char *);
+double error_print_atmos_moist_bal(double, atmos_moist_bal_args_struct *, char *);
+double error_print_canopy_energy_bal(double, canopy_energy_bal_args_struct *, char *);
+double ErrorPrintSnowPackEnergyBalance(double, snowpack_energy_bal_args_struct *, int, int, int, char *);
+double error_print_solve_T_profile(double, soil_thermal_args_struct *, char *);
+double error_print_surf_energy_bal(double, surf_energy_bal_args_struct *, dmy_struct *, char *);
 double estimate_dew_point(double, double, double, double, double);
 int estimate_layer_ice_content(layer_data_struct *, double *, double *,
 			       double *, double *, double *, double *,
@@ -273,11 +292,11 @@ double f(double, double, double, double, double, double, double, double,
          double, double, int, double *, double, double, double, double *,
          double *, double *, double *, double *, double *);
 void   faparl(double *, double, double, double, double, double *, double *);
-void   fda_heat_eqn(double *, double *, int, int, ...);
-void   fdjac3(double *, double *, double *, double *, double *,
-            void (*vecfunc)(double *, double *, int, int, ...), 
-            int);
+void   fda_heat_eqn(double *, double *, int, heat_eqn_args_struct *);
+void   fda_heat_jac(double *, double *, double *, double *, int,
+		    heat_eqn_args_struct *);
 void   find_0_degree_fronts(energy_bal_struct *, double *, double *, int);
+void   finish_compression();
 layer_data_struct find_average_layer(layer_data_struct *, layer_data_struct *,
 				     double, double);
 void   free_atmos(int nrecs, atmos_data_struct **atmos);
@@ -291,20 +310,22 @@ void   free_out_data(out_data_struct **);
 int    full_energy(int, int, atmos_data_struct *, all_vars_struct *, all_vars_struct *,
 		   dmy_struct *, global_param_struct *, lake_con_struct *,
                    soil_con_struct *, veg_con_struct *, veg_hist_struct **);
-double func_atmos_energy_bal(double, va_list);
-double func_atmos_moist_bal(double, va_list);
-double func_canopy_energy_bal(double, va_list);
-double func_surf_energy_bal(double, va_list);
+double func_atmos_energy_bal(double, void *);
+double func_atmos_moist_bal(double, void *);
+double func_canopy_energy_bal(double, void *);
+double func_surf_energy_bal(double, void *);
 double get_dist(double, double, double, double);
 void   get_force_type(char *, int, int *);
 global_param_struct get_global_param(filenames_struct *, FILE *);
 void   get_next_time_step(int *, int *, int *, int *, int *, int);
 
+unsigned long long hash_bytes(unsigned long long, const void *, size_t);
 double hermint(double, int, double *, double *, double *, double *, double *);
 void   hermite(int, double *, double *, double *, double *, double *);
 double hiTinhib(double);
 void   HourlyT(int, int, int *, double *, int *, double *, double *);
 
+void   init_blowing_table(char *);
 void   init_output_list(out_data_struct *, int, char *, int, float);
 void   initialize_atmos(atmos_data_struct *, dmy_struct *, FILE **,
 			veg_lib_struct *, veg_con_struct *, veg_hist_struct **,
@@ -335,17 +356,21 @@ snow_data_struct **make_snow_data(int);
 veg_var_struct **make_veg_var(int);
 void   MassRelease(double *,double *,double *,double *);
 double maximum_unfrozen_water(double, double, double, double);
+double maximum_unfrozen_water_dT(double, double, double, double);
 double modify_Ksat(double);
+void mtclim_cached(int, int, double, soil_con_struct *, int, dmy_struct *,
+                   double *, double *, double *, double *, double *,
+                   double *, double *);
 void mtclim_wrapper(int, int, double, double, double, double,
                       double, double, double, double,
                       int, dmy_struct *, double *,
                       double *, double *, double *, double *, double *, double *);
 
 double new_snow_density(double);
-int    newt_raph(void (*vecfunc)(double *, double *, int, int, ...), 
-               double *, int);
+int    newt_raph(double *, int, heat_eqn_args_struct *);
 void   nrerror(char *);
 
+FILE  *open_checkpoint_file(char *, char *);
 FILE  *open_file(char string[], char type[]);
 FILE  *open_state_file(global_param_struct *, filenames_struct, int, int);
 
@@ -354,6 +379,9 @@ double penman(double, double, double, double, double, double, double);
 void photosynth(char, double, double, double, double, double, double,
                 double, double, double, char *, double *, double *,
                 double *, double *, double *);
+void photosynth_layers(char, double, double, double, double *, double, double,
+                       double *, double, double, char *, int, double *,
+                       double *, double *, double *, double *);
 void   prepare_full_energy(int, int, int, all_vars_struct *, 
 			   soil_con_struct *, double *, double *); 
 int    put_data(all_vars_struct *, atmos_data_struct *,
@@ -399,7 +427,14 @@ veg_lib_struct *read_veglib(FILE *, int *);
 veg_con_struct *read_vegparam(FILE *, int, int);
 void   redistribute_moisture(layer_data_struct *, double *, double *,
 			     double *, double *, double *, int);
-double root_brent(double, double, char *, double (*Function)(double, va_list), ...);
+void   print_root_stats(root_stats_struct *);
+void   print_snow_step_stats(snow_step_stats_struct *);
+void   reset_root_stats(root_stats_struct *);
+void   reset_snow_step_stats(snow_step_stats_struct *);
+double root_brent(int, double, double, char *, double (*Function)(double, void *), void *);
+double root_brent_warm(int, double, double, double, char *, double (*Function)(double, void *), void *);
+void   use_root_stats(root_stats_struct *);
+void   use_snow_step_stats(snow_step_stats_struct *);
 int    runoff(cell_data_struct *, energy_bal_struct *, soil_con_struct *,
               double, double *, int, int, int, int, int);
 
@@ -409,6 +444,7 @@ void set_node_parameters(double *, double *, double *, double *, double *, doubl
 			 double *, double *, int, int, char);
 out_data_file_struct *set_output_defaults(out_data_struct *);
 int set_output_var(out_data_file_struct *, int, int, out_data_struct *, char *, int, char *, int, float);
+void set_active_outvars(out_data_struct *);
 double snow_albedo(double, double, double, double, double, double, int, char);
 double snow_density(snow_data_struct *, double, double, double, double, double);
 int    snow_intercept(double, double, double, double, double, double,
@@ -429,11 +465,12 @@ int    snow_melt(double, double, double, double, double *, double, double *, dou
                  double *, double *, double *, double *, double *, double *, 
                  double *, double *, double *, double *, double *, double *, 
                  int, int, int, int, snow_data_struct *, soil_con_struct *);
-double SnowPackEnergyBalance(double, va_list);
+double SnowPackEnergyBalance(double, void *);
 void   soil_carbon_balance(soil_con_struct *, energy_bal_struct *,
                            cell_data_struct *, veg_var_struct *);
 double soil_conductivity(double, double, double, double, double, double, double, double);
-double soil_thermal_eqn(double, va_list);
+double soil_conductivity_dWu(double, double, double, double, double, double, double, double);
+double soil_thermal_eqn(double, void *);
 double solve_snow(char, double, double, double, double, double,
                   double, double, double, double, double, double,
                   double *, double *, double *, double *, double *,
@@ -447,10 +484,6 @@ double solve_snow(char, double, double, double, double, double,
                   layer_data_struct *,
                   snow_data_struct *, soil_con_struct *,
                   veg_var_struct *);
-double solve_atmos_energy_bal(double Tcanopy, ...);
-double solve_atmos_moist_bal(double , ...);
-double solve_canopy_energy_bal(double Tfoliage, ...);
-double solve_surf_energy_bal(double Tsurf, ...);
 int    solve_T_profile(double *, double *, char *, int *, double *, double *,double *, 
 		       double *, double, double *, double *, double *,
 		       double *, double *, double *, double *, double, double *,
@@ -485,17 +518,34 @@ int update_thermal_nodes(all_vars_struct *,
 			 int, int, soil_con_struct *, veg_con_struct *);
 void usage(char *);
 
+cell_ctx_struct *vic_cell_create(int, soil_con_struct *, veg_con_struct *,
+				 lake_con_struct *, dmy_struct *,
+				 atmos_data_struct *, out_data_struct *);
+void   vic_cell_force(cell_ctx_struct *, FILE **);
+void   vic_cell_free(cell_ctx_struct **);
+void   vic_cell_free_snapshot(cell_snapshot_struct *);
+double vic_cell_get(cell_ctx_struct *, int, int);
+int    vic_cell_init(cell_ctx_struct *, FILE *, int);
+int    vic_cell_read_snapshot(FILE *, int, cell_snapshot_struct *);
+int    vic_cell_restore(cell_ctx_struct *, cell_snapshot_struct *);
+void   vic_cell_save_state(cell_ctx_struct *, FILE *);
+void   vic_cell_set_irrigation(cell_ctx_struct *, double, double);
+void   vic_cell_snapshot(cell_ctx_struct *, cell_snapshot_struct *);
+int    vic_cell_step(cell_ctx_struct *, atmos_data_struct *);
+void   vic_cell_write_snapshot(FILE *, cell_snapshot_struct *);
 void   vicerror(char *);
 double volumetric_heat_capacity(double,double,double,double);
 
 void wrap_compute_zwt(soil_con_struct *, cell_data_struct *);
 void write_data(out_data_file_struct *, out_data_struct *, dmy_struct *, int);
-void write_forcing_file(atmos_data_struct *, int, out_data_file_struct *, out_data_struct *);
+void write_forcing_file(atmos_data_struct *, dmy_struct *, int,
+                        out_data_file_struct *, out_data_struct *);
 void write_header(out_data_file_struct *, out_data_struct *, dmy_struct *, global_param_struct);
 void write_layer(layer_data_struct *, int, int, 
                  double *, double *);
 void write_model_state(all_vars_struct *, global_param_struct *, int, 
 		       int, filep_struct *, soil_con_struct *, lake_con_struct);
+void write_outfile_chunk(out_data_file_struct *);
 void write_vegvar(veg_var_struct *, int);
 
 void zero_output_list(out_data_struct *);
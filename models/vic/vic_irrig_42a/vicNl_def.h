@@ -148,6 +148,35 @@
   2014-Apr-25 Added partial vegcover fraction.				TJB
   2014-May-05 Moved constants CLOSURE, RSMAX, and VPDMINFACTOR from
 	      penman.c to here.						TJB
+  2026-Oct-18 Added argument structures for the functions solved by
+	      root_brent(), replacing variable argument lists.
+  2026-Oct-18 Added ROOT_WARMSTART option and the ROOT_* call sites of
+	      root_brent().
+  2026-Oct-18 Added heat_eqn_args_struct for the implicit soil
+	      temperature solution, replacing a variable argument list.
+  2026-Oct-18 Added IMPLICIT_FB option.
+  2026-Oct-18 Added options.PET_OUT.
+  2026-Oct-18 Added CROPFRAC_COLLAPSE option.
+  2026-Oct-18 Added cell_ctx_struct.
+  2026-Oct-18 Added cell_snapshot_struct and the SAVE_CHECKPOINT and
+	      INIT_CHECKPOINT options.
+  2026-Oct-18 Added SINGLE_OUTFILE option, COMPRESS_GZIP/COMPRESS_ZLIB
+	      and OUT_BUFFER_SIZE.
+  2026-Oct-18 Added FORCE_CACHE option and the HASH macros.
+  2026-Oct-18 Added active to out_data_struct.
+  2026-Oct-18 Added ADAPT_SNOW_STEP option.
+  2026-Oct-18 Added BLOWING_TABLE option and blowing_table file name.
+  2026-Oct-18 Added lake_column_struct.
+  2026-Oct-18 Added the OPT_* macros for options fixed at compile time;
+	      MAX_NODES and MAX_BANDS may be set by the compiler.
+  2026-Oct-18 Added ROOT_STATS option; the iteration statistics and
+	      warm-start history of root_brent() (root_stats_struct) are
+	      kept in cell_ctx_struct and cell_snapshot_struct.
+  2026-Oct-18 Added snow_step_stats_struct; the counts of steps that
+	      used snow sub-steps are kept with the root_brent()
+	      statistics.
+  2026-Oct-18 Added storage and step_count to save_data_struct, so
+	      that each cell keeps its own.
 *********************************************************************/
 #include <snow.h>
 
@@ -169,8 +198,12 @@
 /***** Define maximum array sizes for model source code *****/
 #define MAX_VEG        12      /* maximum number of vegetation types per cell */
 #define MAX_LAYERS     3       /* maximum number of soil moisture layers */
+#ifndef MAX_NODES
 #define MAX_NODES      50      /* maximum number of soil thermal nodes */
+#endif
+#ifndef MAX_BANDS
 #define MAX_BANDS      10      /* maximum number of snow bands */
+#endif
 #define MAX_FRONTS     3       /* maximum number of freezing and thawing front depths to store */
 #define MAX_FROST_AREAS 10     /* maximum number of frost sub-areas */
 #define MAX_LAKE_NODES 20      /* maximum number of lake thermal nodes */
@@ -428,6 +461,15 @@ extern char ref_veg_ref_crop[];
                                    while computing energy balance (C) */
 #define CANOPY_VP    25.0	/* Used to bracket canopy vapor pressures 
                                    while computing moisture balance (Pa) */
+
+/***** Call sites of root_brent(), for its iteration statistics *****/
+#define ROOT_FOLIAGE  0		/* intercepted snow temperature */
+#define ROOT_CANOPY   1		/* canopy air temperature */
+#define ROOT_SNOW     2		/* snow pack surface temperature */
+#define ROOT_SURF     3		/* surface temperature */
+#define ROOT_SOIL     4		/* soil node temperatures */
+#define ROOT_ICE      5		/* lake ice surface temperature */
+#define N_ROOT_SITES  6
 #define DEFAULT_WIND_SPEED 3.0  /* Default wind speed [m/s] used when wind is not supplied as a forcing */
 #define SLAB_MOIST_FRACT 1.0    /* Volumetric moisture content (fraction of porosity) in the soil/rock below the bottom soil layer; this assumes that the soil below the bottom layer has the same texture as the bottom layer. */
 
@@ -629,7 +671,7 @@ extern char ref_veg_ref_crop[];
 #define OUT_VP             133  /* near surface vapor pressure [kPa] (ALMA_OUTPUT: [Pa]) */
 #define OUT_VPD            134  /* near surface vapor pressure deficit [kPa] (ALMA_OUTPUT: [Pa]) */
 #define OUT_WIND           135  /* near surface wind speed [m/s] */
-// Band-specific quantities
+// Band-specific quantities (OUT_FIRST_BAND to OUT_LAST_BAND)
 #define OUT_ADV_SENS_BAND       136  /* net sensible heat flux advected to snow pack [W/m2] */
 #define OUT_ADVECTION_BAND      137  /* advected energy [W/m2] */
 #define OUT_ALBEDO_BAND         138  /* average surface albedo [fraction] */
@@ -651,6 +693,8 @@ extern char ref_veg_ref_crop[];
 #define OUT_SNOW_PACKT_BAND     154  /* snow pack temperature [C] (ALMA_OUTPUT: [K]) */
 #define OUT_SNOW_SURFT_BAND     155  /* snow surface temperature [C] (ALMA_OUTPUT: [K]) */
 #define OUT_SWE_BAND            156  /* snow water equivalent in snow pack [mm] */
+#define OUT_FIRST_BAND OUT_ADV_SENS_BAND
+#define OUT_LAST_BAND  OUT_SWE_BAND
 // Carbon-Cycling Terms
 #define OUT_APAR           157  /* absorbed PAR [W/m2] */
 #define OUT_GPP            158  /* gross primary productivity [g C/m2d] */
@@ -682,6 +726,20 @@ extern char ref_veg_ref_crop[];
 #define OUT_TYPE_FLOAT   5 /* single-precision floating point */
 #define OUT_TYPE_DOUBLE  6 /* double-precision floating point */
 
+/***** Output compression methods (options.COMPRESS) *****/
+#define COMPRESS_GZIP    1 /* gzip each file in a shell (= TRUE) */
+#define COMPRESS_ZLIB    2 /* compress in the model with zlib, on a
+			      background thread */
+
+/***** Size of the write buffer of each output file (bytes) *****/
+#define OUT_BUFFER_SIZE  1048576
+
+/***** 64-bit FNV-1a hash of input data (hash_bytes()) *****/
+#define HASH_INIT  14695981039346656037ULL
+#define HASH_PRIME 1099511628211ULL
+#define HASH(h, x) (h) = hash_bytes((h), &(x), sizeof(x))
+#define HASH_N(h, x, n) (h) = hash_bytes((h), (x), (n)*sizeof(*(x)))
+
 /***** Output aggregation method types *****/
 #define AGG_TYPE_AVG     0 /* average over agg interval */
 #define AGG_TYPE_BEG     1 /* value at beginning of agg interval */
@@ -709,8 +767,10 @@ extern int NF;			/* array index loop counter limit for atmos
 
 /** file structures **/
 typedef struct {
+  FILE *checkpoint;     /* output checkpoint file */
   FILE *forcing[3];     /* atmospheric forcing data files */
   FILE *globalparam;    /* global parameters file */
+  FILE *init_checkpoint;/* input checkpoint file */
   FILE *init_state;     /* initial model state file */
   FILE *lakeparam;      /* lake parameter file */
   FILE *snowband;       /* snow elevation band data file */
@@ -721,9 +781,12 @@ typedef struct {
 } filep_struct;
 
 typedef struct {
+  char  blowing_table[MAXSTRING]; /* blowing snow table file name */
+  char  checkpoint[MAXSTRING];  /* output checkpoint file name */
   char  forcing[3][MAXSTRING];  /* atmospheric forcing data file names */
   char  f_path_pfx[3][MAXSTRING];  /* path and prefix for atmospheric forcing data file names */
   char  global[MAXSTRING];      /* global control file name */
+  char  init_checkpoint[MAXSTRING]; /* input checkpoint file name */
   char  init_state[MAXSTRING];  /* initial model state file name */
   char  lakeparam[MAXSTRING];   /* lake model constants file */
   char  result_dir[MAXSTRING];  /* directory where results will be written */
@@ -739,6 +802,11 @@ typedef struct {
   // simulation modes
   int    AboveTreelineVeg; /* Default veg type to use above treeline;
 			      Negative number indicates bare soil. */
+  char   ADAPT_SNOW_STEP; /* TRUE = when the model time step is longer
+			     than SNOW_STEP, only use snow sub-steps in the
+			     snow bands where snow is present or can fall;
+			     FALSE = use them in every band of the cell
+			     when snow can fall in any band (default) */
   char   AERO_RESIST_CANSNOW; /* "AR_406" = multiply aerodynamic resistance
 					    by 10 for latent heat but not
 					    for sensible heat (as in
@@ -764,6 +832,10 @@ typedef struct {
 					    always use canopy aero_resist
 					    for ET. */
   char   BLOWING;        /* TRUE = calculate sublimation from blowing snow */
+  char   BLOWING_TABLE;  /* TRUE = take the blowing snow integrals from a
+			    table built at startup (or read from the file
+			    blowing_table); FALSE = integrate them at every
+			    step (default) */
   char   CARBON;         /* TRUE = simulate carbon cycling processes;
 			    FALSE = no carbon cycling (default) */
   char   CLOSE_ENERGY;   /* TRUE = all energy balance calculations are
@@ -778,6 +850,8 @@ typedef struct {
   char   CONTINUEONERROR;/* TRUE = VIC will continue to run after a cell has an error */
   char   CORRPREC;       /* TRUE = correct precipitation for gage undercatch */
   char   CROPFRAC;       /* TRUE = account for fallow (non-planted) fraction */
+  char   CROPFRAC_COLLAPSE; /* TRUE = do not solve the fallow sub-tile of a
+                               crop tile while the crop fraction is 1 */
   char   EQUAL_AREA;     /* TRUE = RESOLUTION stores grid cell area in km^2;
 			    FALSE = RESOLUTION stores grid cell side length in degrees */
   char   EXP_TRANS;      /* TRUE = Uses grid transform for exponential node 
@@ -789,6 +863,10 @@ typedef struct {
                             "GF_410"  = use formulas from VIC 4.1.0 */
   char   IMPLICIT;       /* TRUE = Use implicit solution when computing 
 			    soil thermal fluxes */
+  int    IMPLICIT_FB;    /* if IMPLICIT is FALSE, use the implicit solution
+			    for tiles in which the explicit solution has
+			    fallen back to the previous soil temperature
+			    at least this many times; 0 = never (default) */
   char   IRRIGATION;     /* TRUE = apply irrigation (to crop veg tiles) */ 
   char   IRR_FREE;       /* TRUE = irrigation is NOT restricted to available water */ 
   char   JULY_TAVG_SUPPLIED; /* If TRUE and COMPUTE_TREELINE is also true,
@@ -818,6 +896,14 @@ typedef struct {
 			    FALSE = air pressure set to constant 95.5 kPa */
   char   RC_MODE;        /* RC_JARVIS = compute canopy resistance via Jarvis formulation (default)
                             RC_PHOTO = compute canopy resistance based on photosynthetic activity */
+  char   ROOT_WARMSTART; /* TRUE = start the iterative solutions of snow,
+			    surface, soil and lake ice temperatures from a
+			    bracket around the previous solution, whose
+			    width follows the recent changes of the solution;
+			    FALSE = use fixed brackets (default) */
+  char   ROOT_STATS;     /* TRUE = report the iteration statistics of the
+			    temperature solutions at the end of each cell;
+			    FALSE = do not report them (default) */
   int    ROOT_ZONES;     /* Number of root zones used in simulation */
   char   QUICK_FLUX;     /* TRUE = Use Liang et al., 1999 formulation for
 			    ground heat flux, if FALSE use explicit finite
@@ -856,6 +942,8 @@ typedef struct {
 
   // input options
   char   ALMA_INPUT;     /* TRUE = input variables are in ALMA-compliant units; FALSE = standard VIC units */
+  char   FORCE_CACHE;    /* TRUE = keep the MTCLIM estimates of each cell in
+			    cache files and reuse them when the inputs match */
   char   BASEFLOW;       /* ARNO: read Ds, Dm, Ws, c; NIJSSEN2001: read d1, d2, d3, d4 */
   int    GRID_DECIMAL;   /* Number of decimal places in grid file extensions */
   char   VEGLIB_IRR;     /* TRUE = veg library contains irrigation parameters */
@@ -878,23 +966,91 @@ typedef struct {
   char   BINARY_STATE_FILE; /* TRUE = model state file is binary (default) */
   char   INIT_STATE;     /* TRUE = initialize model state from file */
   char   SAVE_STATE;     /* TRUE = save state file */       
+  char   INIT_CHECKPOINT;/* TRUE = continue cells from the snapshots in a
+			    checkpoint file */
+  char   SAVE_CHECKPOINT;/* TRUE = write snapshots of all cells to a
+			    checkpoint file at the state date */
 
   // output options
   char   ALMA_OUTPUT;    /* TRUE = output variables are in ALMA-compliant units; FALSE = standard VIC units */
   char   BINARY_OUTPUT;  /* TRUE = output files are in binary, not ASCII */
-  char   COMPRESS;       /* TRUE = Compress all output files */
+  char   COMPRESS;       /* FALSE, COMPRESS_GZIP (TRUE) or COMPRESS_ZLIB =
+			    how to compress all output files */
   char   MOISTFRACT;     /* TRUE = output soil moisture as fractional moisture content */
   int    Noutfiles;      /* Number of output files (not including state files) */
+  char   PET_OUT[N_PET_TYPES]; /* TRUE = potential evap of this type is written
+			    to an output file; other types are not computed
+			    (set by parse_output_info) */
   char   OUTPUT_FORCE;   /* TRUE = perform disaggregation of forcings, skip
                             the simulation, and output the disaggregated
                             forcings. */
   char   PRT_HEADER;     /* TRUE = insert header at beginning of output file; FALSE = no header */
+  char   SINGLE_OUTFILE; /* TRUE = write all cells to one file per output
+			    file prefix; FALSE = one file per cell */
   char   PRT_SNOW_BAND;  /* TRUE = print snow parameters for each snow band. This is only used when default
 				   output files are used (for backwards-compatibility); if outfiles and
 				   variables are explicitly mentioned in global parameter file, this option
 				   is ignored. */
 } option_struct;
 
+/***** Options read through OPT_<name> in the routines called for every
+       tile and step.  A specialized build (make spec, see the Makefile)
+       defines FIXED_<name>, which makes the option a constant there so
+       that the compiler drops the branches not taken and unrolls loops
+       over layers and nodes; get_global_param() rejects global files
+       that ask for another value.  Otherwise OPT_<name> is the run-time
+       option. *****/
+#ifdef FIXED_FULL_ENERGY
+#define OPT_FULL_ENERGY FIXED_FULL_ENERGY
+#else
+#define OPT_FULL_ENERGY options.FULL_ENERGY
+#endif
+#ifdef FIXED_FROZEN_SOIL
+#define OPT_FROZEN_SOIL FIXED_FROZEN_SOIL
+#else
+#define OPT_FROZEN_SOIL options.FROZEN_SOIL
+#endif
+#ifdef FIXED_QUICK_FLUX
+#define OPT_QUICK_FLUX FIXED_QUICK_FLUX
+#else
+#define OPT_QUICK_FLUX options.QUICK_FLUX
+#endif
+#ifdef FIXED_LAKES
+#define OPT_LAKES FIXED_LAKES
+#else
+#define OPT_LAKES options.LAKES
+#endif
+#ifdef FIXED_CARBON
+#define OPT_CARBON FIXED_CARBON
+#else
+#define OPT_CARBON options.CARBON
+#endif
+#ifdef FIXED_IRRIGATION
+#define OPT_IRRIGATION FIXED_IRRIGATION
+#else
+#define OPT_IRRIGATION options.IRRIGATION
+#endif
+#ifdef FIXED_CROPFRAC
+#define OPT_CROPFRAC FIXED_CROPFRAC
+#else
+#define OPT_CROPFRAC options.CROPFRAC
+#endif
+#ifdef FIXED_SNOW_BAND
+#define OPT_SNOW_BAND FIXED_SNOW_BAND
+#else
+#define OPT_SNOW_BAND options.SNOW_BAND
+#endif
+#ifdef FIXED_Nlayer
+#define OPT_Nlayer FIXED_Nlayer
+#else
+#define OPT_Nlayer options.Nlayer
+#endif
+#ifdef FIXED_Nnode
+#define OPT_Nnode FIXED_Nnode
+#else
+#define OPT_Nnode options.Nnode
+#endif
+
 /*******************************************************
   Stores forcing file input information.
 *******************************************************/
@@ -918,6 +1074,8 @@ typedef struct {
   int  FORCE_FORMAT[3]; /* ASCII or BINARY */
   int  FORCE_INDEX[3][N_FORCING_TYPES];
   int  N_TYPES[3];
+  char FORCE_CACHE_PFX[MAXSTRING]; /* path and prefix of the MTCLIM cache
+			   files (options.FORCE_CACHE) */
 } param_set_struct;
 
 /*******************************************************
@@ -1451,6 +1609,24 @@ typedef struct {
   cell_data_struct  soil;         /* Soil column below lake */
 } lake_var_struct;
 
+/*****************************************************************
+  This structure stores the tridiagonal system of the lake thermal
+  column built by temp_area_setup(); only the surface forcing
+  changes while temp_area() is iterated within a time step.
+  *****************************************************************/
+typedef struct {
+  double sub[MAX_LAKE_NODES];     /* Sub-diagonal of the system */
+  double alpha[MAX_LAKE_NODES];   /* LU factors of the system, from tridia_factor() */
+  double gamma[MAX_LAKE_NODES];
+  double d[MAX_LAKE_NODES];       /* Right hand side; d[0] is set by temp_area() */
+  double T0;                      /* Temperature of the surface node (C) */
+  double heat0;                   /* Heat capacity of the surface node per unit area (J/m2/K) */
+  double mix0;                    /* Diffusive temperature change of the surface node (C) */
+  double sw_top;                  /* Shortwave absorbed by the surface node (W/m2) */
+  double area_top;                /* Mean area of the surface node (m2) */
+  double energy_out_bottom;       /* Shortwave reaching the lake bottom (W/m2) */
+} lake_column_struct;
+
 /*****************************************************************
   This structure stores all variables needed to solve, or save 
   solututions for all versions of this model.
@@ -1472,6 +1648,10 @@ typedef struct {
   double	surfstor;         /* surface water storage [mm] */
   double	swe;              /* snow water equivalent [mm] */
   double	wdew;             /* canopy interception [mm] */
+  double	storage;          /* total storage of the water balance
+				     check [mm] */
+  int		step_count;       /* records aggregated since the last
+				     output interval was written */
 } save_data_struct;
 
 /*******************************************************
@@ -1480,6 +1660,8 @@ typedef struct {
 typedef struct {
   char		varname[20]; /* name of variable */
   int		write;       /* FALSE = don't write; TRUE = write */
+  int		active;      /* TRUE = aggregated by put_data(); see
+		                set_active_outvars() */
   char		format[10];  /* format, when written to an ascii file;
 		                should match the desired fprintf format specifier, e.g. %.4f */
   int		type;        /* type, when written to a binary file;
@@ -1512,6 +1694,10 @@ typedef struct {
 		                (a variable's id number is its index in the out_data array).
 		                The order of the id numbers in the varid array
 		                is the order in which the variables will be written. */
+  char		cellname[40]; /* "<lat>_<lon>" of the cell being written */
+  FILE		*single_fh;  /* file of all cells (SINGLE_OUTFILE) */
+  char		*block;      /* output of the cell being written (SINGLE_OUTFILE) */
+  size_t	blocksize;   /* size of block (bytes) */
 } out_data_file_struct;
 
 /********************************************************
@@ -1532,3 +1718,423 @@ typedef struct {
   veg_var_struct    *veg_var;
 } Error_struct;
 
+
+/********************************************************
+  The following structures hold the arguments of the
+  functions whose roots are found by root_brent().  The
+  caller fills the structure once and root_brent() passes
+  it through to the function at every evaluation.
+  ********************************************************/
+
+/* func_surf_energy_bal() */
+typedef struct {
+  /* general model terms */
+  int     rec;
+  int     nrecs;
+  int     month;
+  int     VEG;
+  int     veg_class;
+  int     iveg;
+  double  delta_t;
+  /* soil layer terms */
+  double  Cs1;
+  double  Cs2;
+  double  D1;
+  double  D2;
+  double  T1_old;
+  double  T2;
+  double  Ts_old;
+  double *Told_node;
+  double  bubble;
+  double  dp;
+  double  expt;
+  double  ice0;
+  double  kappa1;
+  double  kappa2;
+  double  max_moist;
+  double  moist;
+  float  *root;
+  double *CanopLayerBnd;
+  /* meteorological forcing terms */
+  int     UnderStory;
+  int     overstory;
+  double  NetShortBare;  /* net SW that reaches bare ground */
+  double  NetShortGrnd;  /* net SW that penetrates snowpack */
+  double  NetShortSnow;  /* net SW that reaches snow surface */
+  double  Tair;          /* temperature of canopy air or atmosphere */
+  double  atmos_density;
+  double  atmos_pressure;
+  double  emissivity;
+  double  LongBareIn;    /* incoming LW to snow-free surface */
+  double  LongSnowIn;    /* incoming LW to snow surface - if INCLUDE_SNOW */
+  double  surf_atten;
+  double  vp;
+  double  vpd;
+  double  shortwave;
+  double  Catm;
+  double *dryFrac;
+  double *Wdew;
+  double *displacement;
+  double *ra;
+  double *Ra_used;
+  double  rainfall;
+  double *ref_height;
+  double *roughness;
+  double *wind;
+  /* latent heat terms */
+  double  Le;
+  /* snowpack terms */
+  double  Advection;
+  double  OldTSurf;
+  double  TPack;
+  double  Tsnow_surf;
+  double  kappa_snow;    /* snow conductance / depth */
+  double  melt_energy;   /* energy consumed in reducing the snowpack coverage */
+  double  snow_coverage; /* snowpack coverage fraction */
+  double  snow_density;
+  double  snow_swq;
+  double  snow_water;
+  double *deltaCC;
+  double *refreeze_energy;
+  double *vapor_flux;
+  double *blowing_flux;
+  double *surface_flux;
+  /* soil node terms */
+  int     Nnodes;
+  double *Cs_node;
+  double *T_node;
+  double *Tnew_node;
+  char   *Tnew_fbflag;
+  int    *Tnew_fbcount;
+  double *alpha;
+  double *beta;
+  double *bubble_node;
+  double *Zsum_node;
+  double *expt_node;
+  double *gamma;
+  double *ice_node;
+  double *kappa_node;
+  double *max_moist_node;
+  double *moist_node;
+  /* model structures */
+  soil_con_struct   *soil_con;
+  layer_data_struct *layer;
+  veg_var_struct    *veg_var;
+  /* control flags */
+  int     INCLUDE_SNOW;
+  int     NOFLUX;
+  int     EXP_TRANS;
+  int     IMPLICIT;      /* use the implicit soil temperature solution */
+  int     SNOWING;
+  int    *FIRST_SOLN;
+  /* returned energy balance terms */
+  double *NetLongBare;   /* net LW from snow-free ground */
+  double *NetLongSnow;   /* net LW from snow surface - if INCLUDE_SNOW */
+  double *T1;
+  double *deltaH;
+  double *fusion;
+  double *grnd_flux;
+  double *latent_heat;
+  double *latent_heat_sub;
+  double *sensible_heat;
+  double *snow_flux;
+  double *store_error;
+} surf_energy_bal_args_struct;
+
+/* SnowPackEnergyBalance() */
+typedef struct {
+  /* general model parameters */
+  double  Dt;                   /* model time step (sec) */
+  double  Ra;                   /* aerodynamic resistance (s/m) */
+  double *Ra_used;              /* aerodynamic resistance after stability correction (s/m) */
+  /* vegetation parameters */
+  double  Displacement;         /* displacement height (m) */
+  double  Z;                    /* reference height (m) */
+  double *Z0;                   /* surface roughness height (m) */
+  /* atmospheric forcing variables */
+  double  AirDens;              /* density of air (kg/m3) */
+  double  EactAir;              /* actual vapor pressure of air (Pa) */
+  double  LongSnowIn;           /* incoming longwave radiation (W/m2) */
+  double  Lv;                   /* latent heat of vaporization (J/kg3) */
+  double  Press;                /* air pressure (Pa) */
+  double  Rain;                 /* rain fall (m/timestep) */
+  double  NetShortUnder;        /* net incident shortwave radiation (W/m2) */
+  double  Vpd;                  /* vapor pressure deficit (Pa) */
+  double  Wind;                 /* wind speed (m/s) */
+  /* snowpack variables */
+  double  OldTSurf;             /* surface temperature during previous time step */
+  double  SnowCoverFract;       /* fraction of area covered by snow */
+  double  SnowDepth;            /* depth of snowpack (m) */
+  double  SnowDensity;          /* density of snowpack (kg/m^3) */
+  double  SurfaceLiquidWater;   /* liquid water in the surface layer (m) */
+  double  SweSurfaceLayer;      /* snow water equivalent in surface layer (m) */
+  /* energy balance components */
+  double  Tair;                 /* canopy air / air temperature (C) */
+  double  TGrnd;                /* ground surface temperature (C) */
+  double *AdvectedEnergy;       /* energy advected by precipitation (W/m2) */
+  double *AdvectedSensibleHeat; /* sensible heat advected from snow-free area (W/m2) */
+  double *DeltaColdContent;     /* change in cold content of surface layer (W/m2) */
+  double *GroundFlux;           /* ground heat flux (W/m2) */
+  double *LatentHeat;           /* latent heat exchange at surface (W/m2) */
+  double *LatentHeatSub;        /* latent heat of sublimation exchange at surface (W/m2) */
+  double *NetLongUnder;         /* net longwave radiation at snowpack surface (W/m2) */
+  double *RefreezeEnergy;       /* refreeze energy (W/m2) */
+  double *SensibleHeat;         /* sensible heat exchange at surface (W/m2) */
+  double *vapor_flux;           /* mass flux of water vapor to or from the pack (m/timestep) */
+  double *blowing_flux;         /* mass flux of water vapor from blowing snow (m/timestep) */
+  double *surface_flux;         /* mass flux of water vapor from pack snow (m/timestep) */
+} snowpack_energy_bal_args_struct;
+
+/* IceEnergyBalance() */
+typedef struct {
+  double  Dt;                   /* model time step (hours) */
+  double  Ra;                   /* aerodynamic resistance (s/m) */
+  double *Ra_used;              /* aerodynamic resistance after stability correction (s/m) */
+  double  Z;                    /* reference height (m) */
+  double  Displacement;         /* displacement height (m) */
+  double  Z0;                   /* surface roughness height (m) */
+  double  Wind;                 /* wind speed (m/s) */
+  double  ShortRad;             /* net incident shortwave radiation (W/m2) */
+  double  LongRadIn;            /* incoming longwave radiation (W/m2) */
+  double  AirDens;              /* density of air (kg/m3) */
+  double  Lv;                   /* latent heat of vaporization (J/kg3) */
+  double  Tair;                 /* air temperature (C) */
+  double  Press;                /* air pressure (Pa) */
+  double  Vpd;                  /* vapor pressure deficit (Pa) */
+  double  EactAir;              /* actual vapor pressure of air (Pa) */
+  double  Rain;                 /* rain fall (m/timestep) */
+  double  SweSurfaceLayer;      /* snow water equivalent in surface layer (m) */
+  double  SurfaceLiquidWater;   /* liquid water in the surface layer (m) */
+  double  OldTSurf;             /* surface temperature during previous time step */
+  double *RefreezeEnergy;       /* refreeze energy (W/m2) */
+  double *vapor_flux;           /* total mass flux of water vapor to or from snow (m/timestep) */
+  double *blowing_flux;         /* mass flux of water vapor to or from blowing snow (m/timestep) */
+  double *surface_flux;         /* mass flux of water vapor to or from snow pack (m/timestep) */
+  double *AdvectedEnergy;       /* energy advected by precipitation (W/m2) */
+  double  DeltaColdContent;     /* change in cold content (W/m2) */
+  double  Tfreeze;
+  double  AvgCond;
+  double  SWconducted;
+  double  SnowDepth;
+  double  SnowDensity;
+  double  SurfAttenuation;
+  double *qf;                   /* ground heat flux (W/m2) */
+  double *LatentHeat;           /* latent heat exchange at surface (W/m2) */
+  double *LatentHeatSub;        /* latent heat exchange at surface due to sublimation (W/m2) */
+  double *SensibleHeat;         /* sensible heat exchange at surface (W/m2) */
+  double *LongRadOut;
+} ice_energy_bal_args_struct;
+
+/* func_canopy_energy_bal() */
+typedef struct {
+  /* general model parameters */
+  int     band;
+  int     month;
+  int     rec;
+  double  delta_t;
+  double  elevation;
+  double *Wmax;
+  double *Wcr;
+  double *Wpwp;
+  double *depth;
+  double *frost_fract;
+  /* atmospheric condition and forcings */
+  double  AirDens;
+  double  EactAir;
+  double  Press;
+  double  Le;
+  double  Tcanopy;
+  double  Vpd;
+  double  shortwave;
+  double  Catm;
+  double *dryFrac;
+  double *Evap;
+  double *Ra;
+  double *Ra_used;
+  double  Rainfall;
+  double *Wind;
+  /* vegetation terms */
+  int     UnderStory;
+  int     iveg;
+  int     veg_class;
+  double *displacement;
+  double *ref_height;
+  double *roughness;
+  float  *root;
+  double *CanopLayerBnd;
+  /* water flux terms */
+  double  IntRain;
+  double  IntSnow;
+  double *Wdew;
+  layer_data_struct *layer;
+  veg_var_struct    *veg_var;
+  /* energy flux terms */
+  double  LongOverIn;
+  double  LongUnderOut;
+  double  NetShortOver;
+  double *AdvectedEnergy;
+  double *LatentHeat;
+  double *LatentHeatSub;
+  double *LongOverOut;
+  double *NetLongOver;
+  double *NetRadiation;
+  double *RefreezeEnergy;
+  double *SensibleHeat;
+  double *VaporMassFlux;
+} canopy_energy_bal_args_struct;
+
+/* func_atmos_energy_bal() */
+typedef struct {
+  double  LatentHeat;
+  double  NetRadiation;
+  double  Ra;
+  double  Tair;
+  double  atmos_density;
+  double  InSensible;
+  double *SensibleHeat;
+} atmos_energy_bal_args_struct;
+
+/* func_atmos_moist_bal() */
+typedef struct {
+  double  InLatentHeat;
+  double  Lv;
+  double  Ra;
+  double  atmos_density;
+  double  gamma;
+  double  vp;
+  double *LatentHeat;
+} atmos_moist_bal_args_struct;
+
+/* soil_thermal_eqn() */
+typedef struct {
+  double  TL;
+  double  TU;
+  double  T0;
+  double  moist;
+  double  max_moist;
+  double  bubble;
+  double  expt;
+  double  ice0;
+  double  gamma;
+  double  A;
+  double  B;
+  double  C;
+  double  D;
+  double  E;
+  int     EXP_TRANS;
+  int     node;
+} soil_thermal_args_struct;
+
+/* fda_heat_eqn() and fda_heat_jac() */
+typedef struct {
+  double  deltat;
+  int     FS_ACTIVE;
+  int     NOFLUX;
+  int     EXP_TRANS;
+  double *T0;
+  double *moist;
+  double *ice;
+  double *kappa;
+  double *Cs;
+  double *max_moist;
+  double *bubble;
+  double *expt;
+  double *alpha;
+  double *beta;
+  double *gamma;
+  double *Zsum;
+  double  Dp;
+  double *bulk_dens_min;
+  double *soil_dens_min;
+  double *quartz;
+  double *bulk_density;
+  double *soil_density;
+  double *organic;
+  double *depth;
+  int     Nlayers;
+  /* set up by solve_T_profile_implicit() */
+  double  Bexp;              /* exponential grid transform constant */
+  double  Ts;                /* surface boundary temperature */
+  double  Tb;                /* bottom boundary temperature */
+  int     lidx[MAX_NODES];   /* soil layer used for the properties of each node */
+} heat_eqn_args_struct;
+
+/*******************************************************
+  This structure stores the iteration statistics of one
+  call site of root_brent(), and the recent changes of
+  its solution that set the warm-start bracket.
+  *******************************************************/
+typedef struct {
+  long   ncalls;     /* number of solutions requested */
+  long   nevals;     /* number of function evaluations */
+  long   nwarm;      /* solutions found in the warm-start bracket */
+  long   nfail;      /* solutions that failed */
+  long   nhist;      /* solutions that contributed to mean_shift */
+  double mean_shift; /* mean change of the solution from its initial guess */
+} root_stats_struct;
+
+/*******************************************************
+  This structure stores the number of model steps of a
+  cell (of all tiles and bands) and how many of them
+  used snow sub-steps (see ADAPT_SNOW_STEP).
+  *******************************************************/
+typedef struct {
+  long   nsteps;     /* model steps that could use sub-steps */
+  long   nsubsteps;  /* model steps that used them */
+} snow_step_stats_struct;
+
+/*******************************************************
+  This structure stores everything needed to run one
+  grid cell through the vic_cell_*() calls (see
+  vic_cell.c).  Parameters are owned by the caller.
+  *******************************************************/
+typedef struct {
+  int                   cellnum;       /* index of the cell in the run */
+  int                   startrec;      /* first record simulated */
+  int                   rec;           /* next record to be simulated */
+  soil_con_struct      *soil_con;      /* soil parameters */
+  veg_con_struct       *veg_con;       /* vegetation parameters */
+  lake_con_struct      *lake_con;      /* lake parameters */
+  dmy_struct           *dmy;           /* dates of all records */
+  atmos_data_struct    *atmos;         /* forcings of all records */
+  veg_hist_struct     **veg_hist;      /* veg parameter histories of all
+					  records */
+  all_vars_struct       all_vars;      /* model state */
+  all_vars_struct       all_vars_crop; /* state of the crop sub-tiles */
+  out_data_struct      *out_data;      /* output variables of the last
+					  record */
+  out_data_file_struct *out_data_files;/* output files; NULL = do not
+					  write output */
+  save_data_struct      save_data;     /* storages of the last record */
+  root_stats_struct     root_stats[N_ROOT_SITES]; /* statistics and
+					  warm-start history of the
+					  temperature solutions */
+  snow_step_stats_struct snow_steps;   /* use of snow sub-steps */
+  char                  own_atmos;     /* TRUE = atmos was allocated by
+					  vic_cell_create() */
+  char                  own_out_data;  /* TRUE = out_data was allocated by
+					  vic_cell_create() */
+} cell_ctx_struct;
+
+/*******************************************************
+  This structure stores a copy of the model state of a
+  grid cell, from which another run with the same inputs
+  up to that point can continue (see vic_cell.c).
+  *******************************************************/
+typedef struct {
+  int                   gridcel;       /* grid cell number */
+  int                   startrec;      /* first record simulated */
+  int                   rec;           /* next record to be simulated */
+  dmy_struct            date;          /* date of record rec-1 */
+  int                   Nveg;          /* number of veg tiles */
+  int                   Ncrop;         /* number of crop sub-tiles */
+  unsigned long long    hash;          /* hash of the inputs of records
+					  startrec to rec-1 */
+  all_vars_struct       all_vars;      /* model state */
+  all_vars_struct       all_vars_crop; /* state of the crop sub-tiles */
+  save_data_struct      save_data;     /* storages of record rec-1 */
+  root_stats_struct     root_stats[N_ROOT_SITES]; /* statistics and
+					  warm-start history of the
+					  temperature solutions */
+  snow_step_stats_struct snow_steps;   /* use of snow sub-steps */
+} cell_snapshot_struct;
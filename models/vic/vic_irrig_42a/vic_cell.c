@@ -0,0 +1,835 @@
+/*
+ * Purpose: run a single grid cell one record at a time
+ * Usage  : Part of VIC; also built into libvic_irrig.a (make lib)
+ * Notes  : The calls below are what vicNl.c uses to run each cell.  A
+ *          coupled or parallel driver can use them in the same way:
+ *
+ *            initialize_global(); get_global_param(); read_veglib();
+ *            dmy = make_dmy(&global_param);
+ *            for each cell:
+ *              read soil_con, veg_con (and lake_con, snow bands)
+ *              ctx = vic_cell_create(cellnum, &soil_con, veg_con,
+ *                                    &lake_con, dmy, NULL, NULL);
+ *              vic_cell_force(ctx, forcing files), or fill ctx->atmos
+ *              and ctx->veg_hist directly
+ *              vic_cell_init(ctx, init_state, startrec);
+ *            for each record, for each cell:
+ *              vic_cell_set_irrigation(ctx, irr_run, irr_with);
+ *              vic_cell_step(ctx, NULL);
+ *              vic_cell_get(ctx, OUT_RUNOFF, 0); ...
+ *            vic_cell_free(&ctx);
+ *
+ *          A copy of the state of a cell (vic_cell_snapshot()) lets other
+ *          runs continue from that record instead of repeating the
+ *          spin-up (vic_cell_restore()), as long as their forcings
+ *          (including the water available for irrigation), parameters
+ *          and model options up to that record are the same.  Snapshots
+ *          can be kept in memory or written to a checkpoint file.
+ *
+ *          Model options, global_param and veg_lib are global and
+ *          shared by all cells.  Stepping does no file I/O unless
+ *          ctx->out_data_files is set.
+ *
+ *          Cells may be stepped in turn, record by record and in any
+ *          order: everything that carries over from one record to the
+ *          next is kept in the context (including the step count of the
+ *          output interval and the storage of the water balance check,
+ *          in save_data), so the outputs of a cell do not depend on the
+ *          other cells.  Cells cannot be stepped concurrently, from
+ *          several threads, because the model also keeps this state for
+ *          the whole process:
+ *
+ *            - root_brent() and surface_fluxes() count into the
+ *              root_stats and snow_steps of the cell that
+ *              vic_cell_step() selects with use_root_stats() and
+ *              use_snow_step_stats(); the selection is global while a
+ *              step runs.
+ *            - The work arrays of fda_heat_eqn() and solve_T_profile()
+ *              (frozen_soil.c), the running sum of trapzd()
+ *              (CalcBlowingSnow.c) and the line buffer of write_data()
+ *              are static scratch space, used within one call.
+ *            - The blowing snow table (CalcBlowingSnow.c) is built by
+ *              init_blowing_table() before the cells are run and is
+ *              only read afterwards.
+ *            - compress_files.c has one queue of output files and one
+ *              worker thread for all cells.
+ *            - Messages to stderr are based on static running totals:
+ *              the cumulative errors of calc_water_balance_error() and
+ *              calc_energy_balance_error(), the fallback totals of
+ *              put_data() and the failure counts of the implicit scheme
+ *              in func_surf_energy_bal() are reset at the start of a
+ *              cell and printed at its last record, and the all-cells
+ *              totals of print_snow_step_stats() add up the cells as
+ *              they are reported.  When cells are stepped in turn these
+ *              messages mix the records of all cells; their outputs do
+ *              not.
+ */
+
+/****************************************************************************/
+/*			  PREPROCESSOR DIRECTIVES                           */
+/****************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vicNl.h>
+#include <global.h>
+
+static char vcid[] = "$Id$";
+
+#define CHECKPOINT_MAGIC   "VICCKPT"
+#define CHECKPOINT_VERSION 5
+
+static unsigned long long input_hash(cell_ctx_struct *, int, int);
+static void copy_all_vars(all_vars_struct *, all_vars_struct *, int);
+static long snapshot_size(int, int);
+
+/****************************************************************************/
+/*			       vic_cell_create()                            */
+/****************************************************************************/
+cell_ctx_struct *vic_cell_create(int                cellnum,
+				 soil_con_struct   *soil_con,
+				 veg_con_struct    *veg_con,
+				 lake_con_struct   *lake_con,
+				 dmy_struct        *dmy,
+				 atmos_data_struct *atmos,
+				 out_data_struct   *out_data)
+/*******************************************************************
+  vic_cell_create
+
+  Allocates the state of a grid cell.  atmos (forcings of all records)
+  and out_data may be shared between cells run one after another; if
+  NULL, they are allocated here.  Snow band data must already be in
+  soil_con.
+*******************************************************************/
+{
+  extern global_param_struct global_param;
+  cell_ctx_struct *ctx;
+
+  ctx = (cell_ctx_struct *) calloc(1, sizeof(cell_ctx_struct));
+  if (ctx == NULL)
+    vicerror("Memory allocation error in vic_cell_create().");
+
+  ctx->cellnum  = cellnum;
+  ctx->rec      = 0;
+  ctx->soil_con = soil_con;
+  ctx->veg_con  = veg_con;
+  ctx->lake_con = lake_con;
+  ctx->dmy      = dmy;
+
+  ctx->all_vars      = make_all_vars(veg_con[0].vegetat_type_num);
+  ctx->all_vars_crop = make_all_vars(veg_con[0].Ncrop-1);
+  alloc_veg_hist(global_param.nrecs, veg_con[0].vegetat_type_num,
+		 &ctx->veg_hist);
+
+  if (atmos == NULL) {
+    alloc_atmos(global_param.nrecs, &ctx->atmos);
+    ctx->own_atmos = TRUE;
+  }
+  else
+    ctx->atmos = atmos;
+
+  if (out_data == NULL) {
+    ctx->out_data = create_output_list();
+    ctx->own_out_data = TRUE;
+  }
+  else
+    ctx->out_data = out_data;
+
+  ctx->out_data_files = NULL;
+
+  return ctx;
+}
+
+/****************************************************************************/
+/*			       vic_cell_force()                             */
+/****************************************************************************/
+void vic_cell_force(cell_ctx_struct *ctx,
+		    FILE           **forcing)
+/*******************************************************************
+  vic_cell_force
+
+  Reads the forcing files of the cell and fills ctx->atmos and
+  ctx->veg_hist for all records.
+*******************************************************************/
+{
+  extern veg_lib_struct *veg_lib;
+
+  initialize_atmos(ctx->atmos, ctx->dmy, forcing, veg_lib, ctx->veg_con,
+		   ctx->veg_hist, ctx->soil_con, ctx->out_data_files,
+		   ctx->out_data);
+}
+
+/****************************************************************************/
+/*			       vic_cell_init()                              */
+/****************************************************************************/
+int vic_cell_init(cell_ctx_struct *ctx,
+		  FILE            *init_state,
+		  int              startrec)
+/*******************************************************************
+  vic_cell_init
+
+  Initializes the model state, from init_state if options.INIT_STATE
+  is TRUE, the storage terms of the water and energy balance checks
+  and the statistics of the temperature solutions.  The first call to vic_cell_step() simulates startrec.
+  Forcings must be set.
+*******************************************************************/
+{
+  extern option_struct       options;
+  extern global_param_struct global_param;
+  filep_struct               filep;
+  int                        ErrorFlag;
+
+  memset(&filep, 0, sizeof(filep_struct));
+  filep.init_state = init_state;
+
+  ErrorFlag = initialize_model_state(&ctx->all_vars, &ctx->all_vars_crop,
+				     ctx->dmy[0], &global_param, filep,
+				     ctx->soil_con->gridcel,
+				     ctx->veg_con[0].vegetat_type_num,
+				     options.Nnode,
+				     ctx->atmos[0].air_temp[NR],
+				     ctx->soil_con, ctx->veg_con,
+				     *ctx->lake_con);
+  if ( ErrorFlag == ERROR ) return ( ERROR );
+
+  ctx->startrec = startrec;
+  ctx->rec      = startrec;
+  reset_root_stats(ctx->root_stats);
+  reset_snow_step_stats(&ctx->snow_steps);
+
+  /* A negative record number initializes the storage terms */
+  return put_data(&ctx->all_vars, &ctx->atmos[0], ctx->soil_con,
+		  ctx->veg_con, ctx->lake_con, ctx->out_data_files,
+		  ctx->out_data, &ctx->save_data, &ctx->dmy[0],
+		  -global_param.nrecs);
+}
+
+/****************************************************************************/
+/*			   vic_cell_set_irrigation()                        */
+/****************************************************************************/
+void vic_cell_set_irrigation(cell_ctx_struct *ctx,
+			     double           irr_run,
+			     double           irr_with)
+/*******************************************************************
+  vic_cell_set_irrigation
+
+  Sets the water available for irrigation (mm) in the next record
+  from the local channel (IRR_RUN) and from withdrawals external to
+  the cell (IRR_WITH), overriding the forcing files.
+*******************************************************************/
+{
+  atmos_data_struct *atmos;
+  int                j;
+
+  atmos = &ctx->atmos[ctx->rec];
+  for (j = 0; j < NF; j++) {
+    atmos->irr_run[j]  = irr_run;
+    atmos->irr_with[j] = irr_with;
+  }
+  atmos->irr_run[NR]  = irr_run;
+  atmos->irr_with[NR] = irr_with;
+}
+
+/****************************************************************************/
+/*			       vic_cell_step()                              */
+/****************************************************************************/
+int vic_cell_step(cell_ctx_struct   *ctx,
+		  atmos_data_struct *atmos)
+/*******************************************************************
+  vic_cell_step
+
+  Simulates the next record of the cell.  If atmos is NULL, the
+  forcings in ctx->atmos are used.  Afterwards the cell averages of
+  the record are in ctx->out_data (see vic_cell_get()); they are only
+  written if ctx->out_data_files is set.
+*******************************************************************/
+{
+  extern global_param_struct global_param;
+  int                        rec;
+  int                        ErrorFlag;
+  int                        PutFlag;
+
+  rec = ctx->rec;
+  if (rec >= global_param.nrecs)
+    return ( ERROR );
+  if (atmos == NULL)
+    atmos = &ctx->atmos[rec];
+
+  use_root_stats(ctx->root_stats);
+  use_snow_step_stats(&ctx->snow_steps);
+  ErrorFlag = full_energy(ctx->cellnum, rec, atmos, &ctx->all_vars,
+			  &ctx->all_vars_crop, ctx->dmy, &global_param,
+			  ctx->lake_con, ctx->soil_con, ctx->veg_con,
+			  ctx->veg_hist);
+  use_root_stats(NULL);
+  use_snow_step_stats(NULL);
+
+  PutFlag = put_data(&ctx->all_vars, atmos, ctx->soil_con, ctx->veg_con,
+		     ctx->lake_con, ctx->out_data_files, ctx->out_data,
+		     &ctx->save_data, &ctx->dmy[rec], rec);
+
+  ctx->rec++;
+
+  if ( ErrorFlag == ERROR || PutFlag == ERROR ) return ( ERROR );
+  return ( 0 );
+}
+
+/****************************************************************************/
+/*				vic_cell_get()                              */
+/****************************************************************************/
+double vic_cell_get(cell_ctx_struct *ctx,
+		    int              varid,
+		    int              elem)
+/*******************************************************************
+  vic_cell_get
+
+  Returns element elem of output variable varid (OUT_*) for the last
+  simulated record, in the model's internal units.
+*******************************************************************/
+{
+  if (varid < 0 || varid >= N_OUTVAR_TYPES
+      || elem < 0 || elem >= ctx->out_data[varid].nelem)
+    return ( MISSING );
+  return ( ctx->out_data[varid].data[elem] );
+}
+
+/****************************************************************************/
+/*			     vic_cell_save_state()                          */
+/****************************************************************************/
+void vic_cell_save_state(cell_ctx_struct *ctx,
+			 FILE            *statefile)
+/*******************************************************************
+  vic_cell_save_state
+
+  Writes the model state of the cell to statefile, in the state file
+  format (see write_model_state()).  The file header is written by
+  open_state_file().
+*******************************************************************/
+{
+  extern global_param_struct global_param;
+  filep_struct               filep;
+
+  memset(&filep, 0, sizeof(filep_struct));
+  filep.statefile = statefile;
+
+  write_model_state(&ctx->all_vars, &global_param,
+		    ctx->veg_con[0].vegetat_type_num, ctx->soil_con->gridcel,
+		    &filep, ctx->soil_con, *ctx->lake_con);
+}
+
+/****************************************************************************/
+/*				vic_cell_free()                             */
+/****************************************************************************/
+void vic_cell_free(cell_ctx_struct **ctx)
+/*******************************************************************
+  vic_cell_free
+
+  Frees what vic_cell_create() allocated.  The parameters are left
+  to the caller.
+*******************************************************************/
+{
+  extern global_param_struct global_param;
+  int                        Nveg;
+
+  if (*ctx == NULL)
+    return;
+
+  Nveg = (*ctx)->veg_con[0].vegetat_type_num;
+  free_veg_hist(global_param.nrecs, Nveg, &(*ctx)->veg_hist);
+  free_all_vars(&(*ctx)->all_vars, Nveg);
+  free_all_vars(&(*ctx)->all_vars_crop, (*ctx)->veg_con[0].Ncrop-1);
+  if ((*ctx)->own_atmos)
+    free_atmos(global_param.nrecs, &(*ctx)->atmos);
+  if ((*ctx)->own_out_data)
+    free_out_data(&(*ctx)->out_data);
+
+  free(*ctx);
+  *ctx = NULL;
+}
+
+/****************************************************************************/
+/*			      vic_cell_snapshot()                           */
+/****************************************************************************/
+void vic_cell_snapshot(cell_ctx_struct      *ctx,
+		       cell_snapshot_struct *snap)
+/*******************************************************************
+  vic_cell_snapshot
+
+  Copies the model state of the cell after the last simulated record
+  into snap, together with a hash of the forcings and parameters that
+  led to it.  Free with vic_cell_free_snapshot().
+*******************************************************************/
+{
+  extern option_struct options;
+
+  snap->gridcel  = ctx->soil_con->gridcel;
+  snap->startrec = ctx->startrec;
+  snap->rec      = ctx->rec;
+  if (ctx->rec > 0)
+    snap->date = ctx->dmy[ctx->rec-1];
+  else
+    memset(&snap->date, 0, sizeof(dmy_struct));
+  snap->Nveg  = ctx->veg_con[0].vegetat_type_num;
+  snap->Ncrop = ctx->veg_con[0].Ncrop;
+  snap->hash  = input_hash(ctx, ctx->startrec, ctx->rec);
+
+  snap->all_vars      = make_all_vars(snap->Nveg);
+  snap->all_vars_crop = make_all_vars(snap->Ncrop-1);
+  copy_all_vars(&snap->all_vars, &ctx->all_vars, snap->Nveg+1);
+  copy_all_vars(&snap->all_vars_crop, &ctx->all_vars_crop, snap->Ncrop);
+  snap->save_data = ctx->save_data;
+  memcpy(snap->root_stats, ctx->root_stats, sizeof(ctx->root_stats));
+  snap->snow_steps = ctx->snow_steps;
+}
+
+/****************************************************************************/
+/*			      vic_cell_restore()                            */
+/****************************************************************************/
+int vic_cell_restore(cell_ctx_struct      *ctx,
+		     cell_snapshot_struct *snap)
+/*******************************************************************
+  vic_cell_restore
+
+  Continues the cell from snap: the next call to vic_cell_step()
+  simulates record snap->rec.  Call after vic_cell_init() with the
+  same start record as the run that took the snapshot.  Returns ERROR,
+  leaving the cell unchanged, if the snapshot is of another cell or
+  if the forcings, parameters or model options of the records before
+  snap->rec differ from those of the snapshot.
+*******************************************************************/
+{
+  extern global_param_struct global_param;
+  dmy_struct                *date;
+
+  if (snap->gridcel != ctx->soil_con->gridcel
+      || snap->Nveg != ctx->veg_con[0].vegetat_type_num
+      || snap->Ncrop != ctx->veg_con[0].Ncrop
+      || snap->startrec != ctx->startrec
+      || snap->rec <= snap->startrec || snap->rec > global_param.nrecs)
+    return ( ERROR );
+
+  date = &ctx->dmy[snap->rec-1];
+  if (date->year != snap->date.year || date->month != snap->date.month
+      || date->day != snap->date.day || date->hour != snap->date.hour)
+    return ( ERROR );
+
+  if (input_hash(ctx, snap->startrec, snap->rec) != snap->hash)
+    return ( ERROR );
+
+  copy_all_vars(&ctx->all_vars, &snap->all_vars, snap->Nveg+1);
+  copy_all_vars(&ctx->all_vars_crop, &snap->all_vars_crop, snap->Ncrop);
+  ctx->rec = snap->rec;
+
+  /* Restart the balance checks from the restored storages */
+  if (put_data(&ctx->all_vars, &ctx->atmos[0], ctx->soil_con, ctx->veg_con,
+	       ctx->lake_con, ctx->out_data_files, ctx->out_data,
+	       &ctx->save_data, &ctx->dmy[0], -global_param.nrecs) == ERROR)
+    return ( ERROR );
+  ctx->save_data = snap->save_data;
+  memcpy(ctx->root_stats, snap->root_stats, sizeof(ctx->root_stats));
+  ctx->snow_steps = snap->snow_steps;
+
+  return ( 0 );
+}
+
+/****************************************************************************/
+/*			    vic_cell_free_snapshot()                        */
+/****************************************************************************/
+void vic_cell_free_snapshot(cell_snapshot_struct *snap)
+{
+  free_all_vars(&snap->all_vars, snap->Nveg);
+  free_all_vars(&snap->all_vars_crop, snap->Ncrop-1);
+}
+
+/****************************************************************************/
+/*			    open_checkpoint_file()                          */
+/****************************************************************************/
+FILE *open_checkpoint_file(char *filename,
+			   char *type)
+/*******************************************************************
+  open_checkpoint_file
+
+  Opens a checkpoint file for writing ("wb") or reading ("rb").  The
+  file header records the model dimensions and the sizes of the state
+  structures; the snapshots that follow are stored as they are in
+  memory, so a checkpoint file can only be read by a model built the
+  same way with the same numbers of bands, layers and nodes.
+*******************************************************************/
+{
+  extern option_struct options;
+  FILE *fp;
+  char  magic[8];
+  int   header[11];
+  int   file_header[11];
+
+  header[0]  = CHECKPOINT_VERSION;
+  header[1]  = options.SNOW_BAND;
+  header[2]  = options.Nlayer;
+  header[3]  = options.Nnode;
+  header[4]  = options.CARBON;
+  header[5]  = options.Ncanopy;
+  header[6]  = sizeof(cell_data_struct);
+  header[7]  = sizeof(energy_bal_struct);
+  header[8]  = sizeof(snow_data_struct);
+  header[9]  = sizeof(veg_var_struct);
+  header[10] = sizeof(lake_var_struct);
+
+  fp = open_file(filename, type);
+  if (type[0] == 'w') {
+    memset(magic, 0, 8);
+    strcpy(magic, CHECKPOINT_MAGIC);
+    fwrite(magic, sizeof(char), 8, fp);
+    fwrite(header, sizeof(int), 11, fp);
+  }
+  else {
+    if (fread(magic, sizeof(char), 8, fp) != 8
+	|| strncmp(magic, CHECKPOINT_MAGIC, 8) != 0
+	|| fread(file_header, sizeof(int), 11, fp) != 11
+	|| memcmp(header, file_header, sizeof(header)) != 0) {
+      fprintf(stderr, "%s is not a checkpoint file of this model build and configuration.\n", filename);
+      nrerror("Unable to read checkpoint file");
+    }
+  }
+
+  return fp;
+}
+
+/****************************************************************************/
+/*			   vic_cell_write_snapshot()                        */
+/****************************************************************************/
+void vic_cell_write_snapshot(FILE                 *fp,
+			     cell_snapshot_struct *snap)
+/*******************************************************************
+  vic_cell_write_snapshot
+
+  Appends snap to a checkpoint file opened by open_checkpoint_file().
+*******************************************************************/
+{
+  extern option_struct options;
+  all_vars_struct     *all_vars;
+  int                  Nitems;
+  int                  i, j, pass;
+
+  fwrite(&snap->gridcel, sizeof(int), 1, fp);
+  fwrite(&snap->startrec, sizeof(int), 1, fp);
+  fwrite(&snap->rec, sizeof(int), 1, fp);
+  fwrite(&snap->date, sizeof(dmy_struct), 1, fp);
+  fwrite(&snap->Nveg, sizeof(int), 1, fp);
+  fwrite(&snap->Ncrop, sizeof(int), 1, fp);
+  fwrite(&snap->hash, sizeof(unsigned long long), 1, fp);
+
+  for (pass = 0; pass < 2; pass++) {
+    all_vars = (pass == 0) ? &snap->all_vars : &snap->all_vars_crop;
+    Nitems   = (pass == 0) ? snap->Nveg+1 : snap->Ncrop;
+    for (i = 0; i < Nitems; i++) {
+      fwrite(all_vars->cell[i], sizeof(cell_data_struct), options.SNOW_BAND, fp);
+      fwrite(all_vars->energy[i], sizeof(energy_bal_struct), options.SNOW_BAND, fp);
+      fwrite(all_vars->snow[i], sizeof(snow_data_struct), options.SNOW_BAND, fp);
+      fwrite(all_vars->veg_var[i], sizeof(veg_var_struct), options.SNOW_BAND, fp);
+      if (options.CARBON) {
+	for (j = 0; j < options.SNOW_BAND; j++) {
+	  fwrite(all_vars->veg_var[i][j].NscaleFactor, sizeof(double), options.Ncanopy, fp);
+	  fwrite(all_vars->veg_var[i][j].aPARLayer, sizeof(double), options.Ncanopy, fp);
+	  fwrite(all_vars->veg_var[i][j].CiLayer, sizeof(double), options.Ncanopy, fp);
+	  fwrite(all_vars->veg_var[i][j].rsLayer, sizeof(double), options.Ncanopy, fp);
+	}
+      }
+    }
+    fwrite(&all_vars->lake_var, sizeof(lake_var_struct), 1, fp);
+  }
+  fwrite(&snap->save_data, sizeof(save_data_struct), 1, fp);
+  fwrite(snap->root_stats, sizeof(root_stats_struct), N_ROOT_SITES, fp);
+  fwrite(&snap->snow_steps, sizeof(snow_step_stats_struct), 1, fp);
+}
+
+/****************************************************************************/
+/*			    vic_cell_read_snapshot()                        */
+/****************************************************************************/
+int vic_cell_read_snapshot(FILE                 *fp,
+			   int                   gridcel,
+			   cell_snapshot_struct *snap)
+/*******************************************************************
+  vic_cell_read_snapshot
+
+  Reads the snapshot of grid cell gridcel from a checkpoint file
+  opened by open_checkpoint_file().  The search starts after the last
+  snapshot read, so cells run in the order they were written are
+  found without rereading the file.  Returns ERROR if the cell is not
+  in the file.  Free with vic_cell_free_snapshot().
+*******************************************************************/
+{
+  extern option_struct options;
+  all_vars_struct     *all_vars;
+  veg_var_struct       veg_var;
+  long                 start, first;
+  char                 wrapped;
+  int                  Nitems;
+  int                  i, j, pass;
+
+  first   = 8 + 11 * sizeof(int);
+  start   = ftell(fp);
+  wrapped = FALSE;
+
+  while (TRUE) {
+    if (wrapped && ftell(fp) >= start)
+      return ( ERROR );
+    if (fread(&snap->gridcel, sizeof(int), 1, fp) != 1) {
+      if (wrapped)
+	return ( ERROR );
+      fseek(fp, first, SEEK_SET);
+      wrapped = TRUE;
+      continue;
+    }
+    fread(&snap->startrec, sizeof(int), 1, fp);
+    fread(&snap->rec, sizeof(int), 1, fp);
+    fread(&snap->date, sizeof(dmy_struct), 1, fp);
+    fread(&snap->Nveg, sizeof(int), 1, fp);
+    fread(&snap->Ncrop, sizeof(int), 1, fp);
+    if (fread(&snap->hash, sizeof(unsigned long long), 1, fp) != 1)
+      return ( ERROR );
+    if (snap->gridcel == gridcel)
+      break;
+    fseek(fp, snapshot_size(snap->Nveg, snap->Ncrop), SEEK_CUR);
+  }
+
+  snap->all_vars      = make_all_vars(snap->Nveg);
+  snap->all_vars_crop = make_all_vars(snap->Ncrop-1);
+  for (pass = 0; pass < 2; pass++) {
+    all_vars = (pass == 0) ? &snap->all_vars : &snap->all_vars_crop;
+    Nitems   = (pass == 0) ? snap->Nveg+1 : snap->Ncrop;
+    for (i = 0; i < Nitems; i++) {
+      fread(all_vars->cell[i], sizeof(cell_data_struct), options.SNOW_BAND, fp);
+      fread(all_vars->energy[i], sizeof(energy_bal_struct), options.SNOW_BAND, fp);
+      fread(all_vars->snow[i], sizeof(snow_data_struct), options.SNOW_BAND, fp);
+      for (j = 0; j < options.SNOW_BAND; j++) {
+	/* keep the photosynthesis arrays allocated by make_all_vars() */
+	veg_var = all_vars->veg_var[i][j];
+	fread(&all_vars->veg_var[i][j], sizeof(veg_var_struct), 1, fp);
+	all_vars->veg_var[i][j].NscaleFactor = veg_var.NscaleFactor;
+	all_vars->veg_var[i][j].aPARLayer    = veg_var.aPARLayer;
+	all_vars->veg_var[i][j].CiLayer      = veg_var.CiLayer;
+	all_vars->veg_var[i][j].rsLayer      = veg_var.rsLayer;
+      }
+      if (options.CARBON) {
+	for (j = 0; j < options.SNOW_BAND; j++) {
+	  fread(all_vars->veg_var[i][j].NscaleFactor, sizeof(double), options.Ncanopy, fp);
+	  fread(all_vars->veg_var[i][j].aPARLayer, sizeof(double), options.Ncanopy, fp);
+	  fread(all_vars->veg_var[i][j].CiLayer, sizeof(double), options.Ncanopy, fp);
+	  fread(all_vars->veg_var[i][j].rsLayer, sizeof(double), options.Ncanopy, fp);
+	}
+      }
+    }
+    fread(&all_vars->lake_var, sizeof(lake_var_struct), 1, fp);
+  }
+  if (fread(&snap->save_data, sizeof(save_data_struct), 1, fp) != 1
+      || fread(snap->root_stats, sizeof(root_stats_struct), N_ROOT_SITES, fp)
+	 != N_ROOT_SITES
+      || fread(&snap->snow_steps, sizeof(snow_step_stats_struct), 1, fp) != 1) {
+    vic_cell_free_snapshot(snap);
+    return ( ERROR );
+  }
+
+  return ( 0 );
+}
+
+/****************************************************************************/
+/*				snapshot_size()                             */
+/****************************************************************************/
+static long snapshot_size(int Nveg,
+			  int Ncrop)
+/* Size of the state of a snapshot in a checkpoint file */
+{
+  extern option_struct options;
+  long                 band_size;
+
+  band_size = sizeof(cell_data_struct) + sizeof(energy_bal_struct)
+    + sizeof(snow_data_struct) + sizeof(veg_var_struct);
+  if (options.CARBON)
+    band_size += 4 * options.Ncanopy * sizeof(double);
+
+  return ( (long)(Nveg + 1 + Ncrop) * options.SNOW_BAND * band_size
+	   + 2 * sizeof(lake_var_struct) + sizeof(save_data_struct)
+	   + N_ROOT_SITES * sizeof(root_stats_struct)
+	   + sizeof(snow_step_stats_struct) );
+}
+
+/****************************************************************************/
+/*				copy_all_vars()                             */
+/****************************************************************************/
+static void copy_all_vars(all_vars_struct *to,
+			  all_vars_struct *from,
+			  int              Nitems)
+/* Copies the state of Nitems tiles; both must come from make_all_vars() */
+{
+  extern option_struct options;
+  veg_var_struct      *veg_to;
+  veg_var_struct      *veg_from;
+  veg_var_struct       veg_var;
+  int                  i, j;
+
+  for (i = 0; i < Nitems; i++) {
+    memcpy(to->cell[i], from->cell[i], options.SNOW_BAND*sizeof(cell_data_struct));
+    memcpy(to->energy[i], from->energy[i], options.SNOW_BAND*sizeof(energy_bal_struct));
+    memcpy(to->snow[i], from->snow[i], options.SNOW_BAND*sizeof(snow_data_struct));
+    for (j = 0; j < options.SNOW_BAND; j++) {
+      veg_to   = &to->veg_var[i][j];
+      veg_from = &from->veg_var[i][j];
+      veg_var  = *veg_to;
+      *veg_to  = *veg_from;
+      veg_to->NscaleFactor = veg_var.NscaleFactor;
+      veg_to->aPARLayer    = veg_var.aPARLayer;
+      veg_to->CiLayer      = veg_var.CiLayer;
+      veg_to->rsLayer      = veg_var.rsLayer;
+      if (options.CARBON) {
+	memcpy(veg_to->NscaleFactor, veg_from->NscaleFactor, options.Ncanopy*sizeof(double));
+	memcpy(veg_to->aPARLayer, veg_from->aPARLayer, options.Ncanopy*sizeof(double));
+	memcpy(veg_to->CiLayer, veg_from->CiLayer, options.Ncanopy*sizeof(double));
+	memcpy(veg_to->rsLayer, veg_from->rsLayer, options.Ncanopy*sizeof(double));
+      }
+    }
+  }
+  to->lake_var = from->lake_var;
+}
+
+/****************************************************************************/
+/*				 hash_bytes()                               */
+/****************************************************************************/
+unsigned long long hash_bytes(unsigned long long  hash,
+			      const void         *data,
+			      size_t              n)
+/*******************************************************************
+  64-bit FNV-1a hash of n bytes at data, continuing from hash
+  (HASH_INIT for a new hash).
+*******************************************************************/
+{
+  const unsigned char *p;
+  size_t               i;
+
+  p = (const unsigned char *) data;
+  for (i = 0; i < n; i++) {
+    hash ^= p[i];
+    hash *= HASH_PRIME;
+  }
+  return hash;
+}
+
+/****************************************************************************/
+/*				 input_hash()                               */
+/****************************************************************************/
+static unsigned long long input_hash(cell_ctx_struct *ctx,
+				     int              first,
+				     int              last)
+/*******************************************************************
+  Hash of the forcings (including the water available for irrigation,
+  IRR_RUN and IRR_WITH) and veg parameter histories of records first
+  to last-1, of the soil and veg parameters of the cell and of the
+  model options that change the simulated state.  Runs that share a
+  spin-up may only differ after it.
+*******************************************************************/
+{
+  extern option_struct       options;
+  extern global_param_struct global_param;
+  soil_con_struct           *soil_con;
+  veg_con_struct            *veg_con;
+  atmos_data_struct         *atmos;
+  veg_hist_struct           *veg_hist;
+  unsigned long long         h;
+  int                        Nveg;
+  int                        rec, v;
+
+  soil_con = ctx->soil_con;
+  Nveg     = ctx->veg_con[0].vegetat_type_num;
+  h        = HASH_INIT;
+
+  HASH(h, global_param.dt);
+  HASH(h, options.IRRIGATION);
+  HASH(h, options.CROPFRAC);
+  HASH(h, options.CROPFRAC_COLLAPSE);
+  HASH(h, options.FULL_ENERGY);
+  HASH(h, options.FROZEN_SOIL);
+  HASH(h, options.QUICK_FLUX);
+  HASH(h, options.ROOT_WARMSTART);
+  HASH(h, options.CARBON);
+  HASH(h, options.LAKES);
+  HASH(h, options.Nlayer);
+  HASH(h, options.Nnode);
+  HASH(h, options.SNOW_BAND);
+  HASH(h, soil_con->gridcel);
+  HASH(h, soil_con->FS_ACTIVE);
+  HASH(h, soil_con->Ds);
+  HASH(h, soil_con->Dsmax);
+  HASH(h, soil_con->Ws);
+  HASH(h, soil_con->c);
+  HASH(h, soil_con->b_infilt);
+  HASH(h, soil_con->Ksat);
+  HASH(h, soil_con->Wcr);
+  HASH(h, soil_con->Wpwp);
+  HASH(h, soil_con->Wcr_irrig);
+  HASH(h, soil_con->Wpwp_irrig);
+  HASH(h, soil_con->bubble);
+  HASH(h, soil_con->bulk_density);
+  HASH(h, soil_con->depth);
+  HASH(h, soil_con->expt);
+  HASH(h, soil_con->init_moist);
+  HASH(h, soil_con->max_moist);
+  HASH(h, soil_con->organic);
+  HASH(h, soil_con->porosity);
+  HASH(h, soil_con->quartz);
+  HASH(h, soil_con->resid_moist);
+  HASH(h, soil_con->soil_density);
+  HASH(h, soil_con->dp);
+  HASH(h, soil_con->avg_temp);
+  HASH(h, soil_con->annual_prec);
+  HASH(h, soil_con->rough);
+  HASH(h, soil_con->snow_rough);
+  HASH(h, soil_con->frost_slope);
+  HASH(h, soil_con->max_snow_distrib_slope);
+  HASH(h, soil_con->elevation);
+  HASH(h, soil_con->lat);
+  HASH(h, soil_con->lng);
+  HASH(h, soil_con->time_zone_lng);
+  HASH_N(h, soil_con->AreaFract, options.SNOW_BAND);
+  HASH_N(h, soil_con->BandElev, options.SNOW_BAND);
+  HASH_N(h, soil_con->Pfactor, options.SNOW_BAND);
+  HASH_N(h, soil_con->Tfactor, options.SNOW_BAND);
+
+  for (v = 0; v < Nveg; v++) {
+    veg_con = &ctx->veg_con[v];
+    HASH(h, veg_con->Cv);
+    HASH(h, veg_con->root);
+    HASH(h, veg_con->veg_class);
+    HASH(h, veg_con->crop_frac_active);
+  }
+
+  for (rec = first; rec < last; rec++) {
+    atmos = &ctx->atmos[rec];
+    HASH_N(h, atmos->air_temp, NR+1);
+    HASH_N(h, atmos->Catm, NR+1);
+    HASH_N(h, atmos->channel_in, NR+1);
+    HASH_N(h, atmos->coszen, NR+1);
+    HASH_N(h, atmos->density, NR+1);
+    HASH_N(h, atmos->fdir, NR+1);
+    HASH_N(h, atmos->longwave, NR+1);
+    HASH_N(h, atmos->par, NR+1);
+    HASH_N(h, atmos->prec, NR+1);
+    HASH_N(h, atmos->pressure, NR+1);
+    HASH_N(h, atmos->shortwave, NR+1);
+    HASH_N(h, atmos->snowflag, NR+1);
+    HASH_N(h, atmos->tskc, NR+1);
+    HASH_N(h, atmos->vp, NR+1);
+    HASH_N(h, atmos->vpd, NR+1);
+    HASH_N(h, atmos->wind, NR+1);
+    HASH_N(h, atmos->irr_run, NR+1);
+    HASH_N(h, atmos->irr_with, NR+1);
+    for (v = 0; v < Nveg; v++) {
+      veg_hist = &ctx->veg_hist[rec][v];
+      HASH_N(h, veg_hist->albedo, NR+1);
+      HASH_N(h, veg_hist->crop_frac, NR+1);
+      HASH_N(h, veg_hist->LAI, NR+1);
+      HASH_N(h, veg_hist->vegcover, NR+1);
+    }
+  }
+
+  return h;
+}
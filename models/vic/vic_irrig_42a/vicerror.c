@@ -18,6 +18,8 @@ void vicerror(char error_text[])
               out_data and out_data_files structures.xi			TJB
   2006-Oct-16 Merged infiles and outfiles structs into filep_struct.	TJB
   2012-Jan-16 Removed LINK_DEBUG code					BN
+  2026-Oct-18 Closes the SINGLE_OUTFILE files and waits for files
+	      being compressed.
 **********************************************************************/
 {
         extern option_struct options;
@@ -31,6 +33,9 @@ void vicerror(char error_text[])
 	fprintf(stderr,"%s\n",error_text);
 	fprintf(stderr,"...now writing output files...\n");
         close_files(&(Error.filep), Error.out_data_files, &fnames);
+        if (options.SINGLE_OUTFILE)
+          close_single_outfiles(Error.out_data_files);
+        finish_compression();
 	fprintf(stderr,"...now exiting to system...\n");
         fflush(stdout);
         fflush(stderr);
@@ -43,6 +43,8 @@
   2008-Mar-01 Added assignments for Tcutk and Le to ensure that they are always
 	      assigned a value before being used.				TJB
   2009-Dec-11 Replaced "assert" statements with "if" statements.		TJB
+  2026-Oct-18 The eddy diffusivity and the tridiagonal system of
+	      temp_area() are computed once, before the iterations.
 *****************************************************************************/
 int water_energy_balance(int     numnod,
 			 double *surface,
@@ -96,6 +98,7 @@ int water_energy_balance(int     numnod,
   
   double de[MAX_LAKE_NODES]; 
   double epsilon = 0.0001;
+  lake_column_struct col;
 
   /* Calculate the surface energy balance for water surface temp = 0.0 */
  
@@ -107,6 +110,16 @@ int water_energy_balance(int     numnod,
     Tnew[k] = T[k];
  
   energycalc(T, &jouleold, numnod,dz, surfdz, surface, cp, water_density);
+
+  /* --------------------------------------------------------------------
+   * Calculate the eddy diffusivity and the tridiagonal system for the
+   * lake temperatures; only the surface forcing changes between
+   * iterations.
+   * -------------------------------------------------------------------- */
+
+  eddy(1, wind, T, water_density, de, lat, numnod, dz, surfdz);
+  temp_area_setup(shortwave*a1, shortwave*a2, T, water_density, de, dt,
+		  surface, numnod, dz, surfdz, cp, &col);
  
   while((fabs(Tmean - Ts) > epsilon) && iterations < MAX_ITER) {
  
@@ -150,20 +163,13 @@ int water_energy_balance(int     numnod,
       Temperatures at Water Thermal Nodes
     *************************************************************/
 
-    /* --------------------------------------------------------------------
-     * Calculate the eddy diffusivity.
-     * -------------------------------------------------------------------- */
- 
-    eddy(1, wind, T, water_density, de, lat, numnod, dz, surfdz);
- 
     /* --------------------------------------------------------------------
      * Calculate the lake temperatures at different levels for the
      * new timestep.
      * -------------------------------------------------------------------- */
 
-    temp_area(shortwave*a1, shortwave*a2, *Qle+*Qh+*LWnet, T, Tnew,
-	      water_density, de, dt, surface, numnod, 
-	      dz, surfdz, &joulenew, cp, energy_out_bottom);
+    temp_area(&col, *Qle+*Qh+*LWnet, Tnew, water_density, dt, surface,
+	      numnod, dz, surfdz, &joulenew, cp, energy_out_bottom);
  
     /* Surface temperature < 0.0, then ice will form. */
     if(Tnew[0] <  Tcutoff) {
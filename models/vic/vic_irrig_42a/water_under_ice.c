@@ -41,6 +41,8 @@
   2007-Nov-06 Replaced lake.fraci with lake.areai.  Added workaround for
 	      non-convergence of temperatures.					LCB via TJB
   2009-Dec-11 Replaced "assert" statements with "if" statements.		TJB
+  2026-Oct-18 The shortwave under the ice and the tridiagonal system of
+	      temp_area() are computed once, before the iterations.
 *****************************************************************************/
 int water_under_ice(int     freezeflag, 
 		    double  sw_ice,
@@ -73,6 +75,7 @@ int water_under_ice(int     freezeflag,
   double epsilon = 0.0001;
   double qw_init, qw_mean, qw_final;
   double sw_underice_visible, sw_underice_nir;
+  lake_column_struct col;
   
   iterations = 0;
 
@@ -89,6 +92,15 @@ int water_under_ice(int     freezeflag,
 
   energycalc(Ti, &jouleold, numnod,dz, surfdz, surface, water_cp, water_density);
 
+  // compute shortwave that transmitted through the lake ice 
+  sw_underice_visible = a1*sw_ice*exp(-1.*(lamisw*hice+lamssw*sdepth));
+  sw_underice_nir = a2*sw_ice*exp(-1.*(lamilw*hice+lamslw*sdepth));
+
+  // build the system for the lake temperatures; only qw changes
+  // between iterations
+  temp_area_setup(sw_underice_visible, sw_underice_nir, Ti, water_density,
+		  de, dt, surface, numnod, dz, surfdz, water_cp, &col);
+
   while((fabs(qw_mean - *qw) > epsilon) && iterations < MAX_ITER) {
     
     if(iterations == 0)
@@ -96,17 +108,12 @@ int water_under_ice(int     freezeflag,
     else
       *qw = qw_mean;
 
-    // compute shortwave that transmitted through the lake ice 
-    sw_underice_visible = a1*sw_ice*exp(-1.*(lamisw*hice+lamssw*sdepth));
-    sw_underice_nir = a2*sw_ice*exp(-1.*(lamilw*hice+lamslw*sdepth));
-	
     /* --------------------------------------------------------------------
      * Calculate the lake temperatures at different levels for the
      * new timestep.
      * -------------------------------------------------------------------- */
 	
-    temp_area (sw_underice_visible, sw_underice_nir, -1.*(*qw) , Ti, Tnew,
-	       water_density, de, dt, surface, numnod, 
+    temp_area (&col, -1.*(*qw), Tnew, water_density, dt, surface, numnod, 
 	       dz, surfdz, &joulenew, water_cp, energy_out_bottom);
 
     // recompute storage of heat in the lake
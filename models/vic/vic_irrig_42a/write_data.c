@@ -1,5 +1,6 @@
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <vicNl.h>
 
 static char vcid[] = "$Id$";
@@ -78,19 +79,26 @@ void write_data(out_data_file_struct *out_data_files,
 	      aggregation of output variables.				TJB
   2012-Jan-16 Removed LINK_DEBUG code					BN
   2013-Dec-27 Moved OUTPUT_FORCE to options_struct.			TJB
+  2026-Oct-18 Binary records are assembled in one buffer, kept between
+	      calls, and written with one fwrite() per file.
 **********************************************************************/
 {
   extern option_struct options;
+  static char        *buffer = NULL;
+  static size_t       buffer_size = 0;
+  size_t              nbytes;
+  size_t              pos;
   int                 file_idx;
   int                 var_idx;
   int                 elem_idx;
-  int                 ptr_idx;
-  char               *tmp_cptr;
-  short int          *tmp_siptr;
-  unsigned short int *tmp_usiptr;
-  int                *tmp_iptr;
-  float              *tmp_fptr;
-  double             *tmp_dptr;
+  int                 date[4];
+  out_data_struct    *var;
+  char                cval;
+  short int           sival;
+  unsigned short int  usival;
+  int                 ival;
+  float               fval;
+  double              dval;
 
   /***************************************************************
     Write output files using default VIC ASCII or BINARY formats
@@ -102,88 +110,86 @@ void write_data(out_data_file_struct *out_data_files,
 
   if(options.BINARY_OUTPUT) {  // BINARY
 
-    // Initialize pointers
-    tmp_cptr = (char *)calloc(N_OUTVAR_TYPES*options.Nlayer*options.SNOW_BAND,sizeof(char));
-    tmp_siptr = (short int *)calloc(N_OUTVAR_TYPES*options.Nlayer*options.SNOW_BAND,sizeof(short int));
-    tmp_usiptr = (unsigned short int *)calloc(N_OUTVAR_TYPES*options.Nlayer*options.SNOW_BAND,sizeof(unsigned short int));
-    tmp_iptr = (int *)calloc(N_OUTVAR_TYPES*options.Nlayer*options.SNOW_BAND,sizeof(int));
-    tmp_fptr = (float *)calloc(N_OUTVAR_TYPES*options.Nlayer*options.SNOW_BAND,sizeof(float));
-    tmp_dptr = (double *)calloc(N_OUTVAR_TYPES*options.Nlayer*options.SNOW_BAND,sizeof(double));
-
     // Time
-    tmp_iptr[0] = dmy->year;
-    tmp_iptr[1] = dmy->month;
-    tmp_iptr[2] = dmy->day;
-    tmp_iptr[3] = dmy->hour;
+    date[0] = dmy->year;
+    date[1] = dmy->month;
+    date[2] = dmy->day;
+    date[3] = dmy->hour;
 
     // Loop over output files
     for (file_idx = 0; file_idx < options.Noutfiles; file_idx++) {
 
+      // Make sure the buffer holds the largest possible record
+      nbytes = 4*sizeof(int);
+      for (var_idx = 0; var_idx < out_data_files[file_idx].nvars; var_idx++)
+        nbytes += out_data[out_data_files[file_idx].varid[var_idx]].nelem*sizeof(double);
+      if (nbytes > buffer_size) {
+        buffer = (char *)realloc(buffer, nbytes);
+        if (buffer == NULL)
+          vicerror("Memory allocation error in write_data().");
+        buffer_size = nbytes;
+      }
+      pos = 0;
+
       if (!options.OUTPUT_FORCE) {
 
         // Write the date
         if (dt < 24) {
           // Write year, month, day, and hour
-          fwrite(tmp_iptr, sizeof(int), 4, out_data_files[file_idx].fh);
+          memcpy(buffer, date, 4*sizeof(int));
+          pos = 4*sizeof(int);
         }
         else {
           // Only write year, month, and day
-          fwrite(tmp_iptr, sizeof(int), 3, out_data_files[file_idx].fh);
+          memcpy(buffer, date, 3*sizeof(int));
+          pos = 3*sizeof(int);
         }
 
       }
 
       // Loop over this output file's data variables
       for (var_idx = 0; var_idx < out_data_files[file_idx].nvars; var_idx++) {
+        var = &out_data[out_data_files[file_idx].varid[var_idx]];
         // Loop over this variable's elements
-        ptr_idx = 0;
-        if (out_data[out_data_files[file_idx].varid[var_idx]].type == OUT_TYPE_CHAR) {
-          for (elem_idx = 0; elem_idx < out_data[out_data_files[file_idx].varid[var_idx]].nelem; elem_idx++) {
-            tmp_cptr[ptr_idx++] = (char)out_data[out_data_files[file_idx].varid[var_idx]].aggdata[elem_idx];
-          }
-          fwrite(tmp_cptr, sizeof(char), ptr_idx, out_data_files[file_idx].fh);
-        }
-        else if (out_data[out_data_files[file_idx].varid[var_idx]].type == OUT_TYPE_SINT) {
-          for (elem_idx = 0; elem_idx < out_data[out_data_files[file_idx].varid[var_idx]].nelem; elem_idx++) {
-            tmp_siptr[ptr_idx++] = (short int)out_data[out_data_files[file_idx].varid[var_idx]].aggdata[elem_idx];
-          }
-          fwrite(tmp_siptr, sizeof(short int), ptr_idx, out_data_files[file_idx].fh);
-        }
-        else if (out_data[out_data_files[file_idx].varid[var_idx]].type == OUT_TYPE_USINT) {
-          for (elem_idx = 0; elem_idx < out_data[out_data_files[file_idx].varid[var_idx]].nelem; elem_idx++) {
-            tmp_usiptr[ptr_idx++] = (unsigned short int)out_data[out_data_files[file_idx].varid[var_idx]].aggdata[elem_idx];
+        for (elem_idx = 0; elem_idx < var->nelem; elem_idx++) {
+          switch (var->type) {
+          case OUT_TYPE_CHAR:
+            cval = (char)var->aggdata[elem_idx];
+            memcpy(buffer+pos, &cval, sizeof(char));
+            pos += sizeof(char);
+            break;
+          case OUT_TYPE_SINT:
+            sival = (short int)var->aggdata[elem_idx];
+            memcpy(buffer+pos, &sival, sizeof(short int));
+            pos += sizeof(short int);
+            break;
+          case OUT_TYPE_USINT:
+            usival = (unsigned short int)var->aggdata[elem_idx];
+            memcpy(buffer+pos, &usival, sizeof(unsigned short int));
+            pos += sizeof(unsigned short int);
+            break;
+          case OUT_TYPE_INT:
+            ival = (int)var->aggdata[elem_idx];
+            memcpy(buffer+pos, &ival, sizeof(int));
+            pos += sizeof(int);
+            break;
+          case OUT_TYPE_FLOAT:
+            fval = (float)var->aggdata[elem_idx];
+            memcpy(buffer+pos, &fval, sizeof(float));
+            pos += sizeof(float);
+            break;
+          case OUT_TYPE_DOUBLE:
+            dval = (double)var->aggdata[elem_idx];
+            memcpy(buffer+pos, &dval, sizeof(double));
+            pos += sizeof(double);
+            break;
           }
-          fwrite(tmp_usiptr, sizeof(unsigned short int), ptr_idx, out_data_files[file_idx].fh);
-        }
-        else if (out_data[out_data_files[file_idx].varid[var_idx]].type == OUT_TYPE_INT) {
-          for (elem_idx = 0; elem_idx < out_data[out_data_files[file_idx].varid[var_idx]].nelem; elem_idx++) {
-            tmp_iptr[ptr_idx++] = (int)out_data[out_data_files[file_idx].varid[var_idx]].aggdata[elem_idx];
-          }
-          fwrite(tmp_iptr, sizeof(int), ptr_idx, out_data_files[file_idx].fh);
-        }
-        else if (out_data[out_data_files[file_idx].varid[var_idx]].type == OUT_TYPE_FLOAT) {
-          for (elem_idx = 0; elem_idx < out_data[out_data_files[file_idx].varid[var_idx]].nelem; elem_idx++) {
-            tmp_fptr[ptr_idx++] = (float)out_data[out_data_files[file_idx].varid[var_idx]].aggdata[elem_idx];
-          }
-          fwrite(tmp_fptr, sizeof(float), ptr_idx, out_data_files[file_idx].fh);
-        }
-        else if (out_data[out_data_files[file_idx].varid[var_idx]].type == OUT_TYPE_DOUBLE) {
-          for (elem_idx = 0; elem_idx < out_data[out_data_files[file_idx].varid[var_idx]].nelem; elem_idx++) {
-            tmp_dptr[ptr_idx++] = (double)out_data[out_data_files[file_idx].varid[var_idx]].aggdata[elem_idx];
-          }
-          fwrite(tmp_dptr, sizeof(double), ptr_idx, out_data_files[file_idx].fh);
         }
       }
 
-    }
+      fwrite(buffer, sizeof(char), pos, out_data_files[file_idx].fh);
 
-    // Free the arrays
-    free((char *)tmp_cptr);
-    free((char *)tmp_siptr);
-    free((char *)tmp_usiptr);
-    free((char *)tmp_iptr);
-    free((char *)tmp_fptr);
-    free((char *)tmp_dptr);
+    }
 
   }
 
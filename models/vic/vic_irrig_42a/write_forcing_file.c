@@ -5,6 +5,7 @@
 static char vcid[] = "$Id$";
 
 void write_forcing_file(atmos_data_struct *atmos,
+			dmy_struct        *dmy,
 			int                nrecs,
 			out_data_file_struct *out_data_files, 
 			out_data_struct   *out_data)
@@ -29,6 +30,9 @@ void write_forcing_file(atmos_data_struct *atmos,
   2013-Jul-25 Added OUT_CATM, OUT_COSZEN, OUT_FDIR, and OUT_PAR.	TJB
   2013-Dec-27 Moved OUTPUT_FORCE to options_struct.					TJB
   2014-Apr-02 Fixed uninitialized dummy variables.					TJB
+  2026-Oct-18 Pass the date of each record to write_data(), which
+	      crashed on the NULL dummy date.
+  2026-Oct-18 Only active variables are copied and scaled.
 **********************************************************************/
 {
   extern global_param_struct global_param;
@@ -37,15 +41,17 @@ void write_forcing_file(atmos_data_struct *atmos,
   int                 rec, i, j, v;
   short int          *tmp_siptr;
   unsigned short int *tmp_usiptr;
-  dmy_struct         *dummy_dmy;
+  dmy_struct          dmy_step;
   int                 dt_sec;
 
   dt_sec = global_param.dt*SECPHOUR;
-  dummy_dmy = NULL;
 
   for ( rec = 0; rec < nrecs; rec++ ) {
     for ( j = 0; j < NF; j++ ) {
 
+      dmy_step = dmy[rec];
+      dmy_step.hour += j*options.SNOW_STEP;
+
       out_data[OUT_AIR_TEMP].data[0]  = atmos[rec].air_temp[j];
       out_data[OUT_CATM].data[0]      = atmos[rec].Catm[j]*1e6;
       out_data[OUT_COSZEN].data[0]    = atmos[rec].coszen[j];
@@ -76,6 +82,8 @@ void write_forcing_file(atmos_data_struct *atmos,
       }
 
       for (v=0; v<N_OUTVAR_TYPES; v++) {
+        if (!out_data[v].active)
+          continue;
         for (i=0; i<out_data[v].nelem; i++) {
           out_data[v].aggdata[i] = out_data[v].data[i];
         }
@@ -93,12 +101,14 @@ void write_forcing_file(atmos_data_struct *atmos,
 
       if (options.BINARY_OUTPUT) {
         for (v=0; v<N_OUTVAR_TYPES; v++) {
+          if (!out_data[v].active)
+            continue;
           for (i=0; i<out_data[v].nelem; i++) {
             out_data[v].aggdata[i] *= out_data[v].mult;
           }
         }
       }
-      write_data(out_data_files, out_data, dummy_dmy, global_param.dt);
+      write_data(out_data_files, out_data, &dmy_step, global_param.dt);
     }
   }
 
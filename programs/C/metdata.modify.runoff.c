@@ -29,8 +29,15 @@
  *              must correspond to cellnumber in soilfile.  
  *            Here: SoilCols = 56
  *            Here: OldParam (metfile) = 10
+ *            Routed streamflow is read from streamflow_<lat>_<lon>.bin
+ *            (OUTPUT_FORMAT BINARY or BOTH in the routing input file)
+ *            if present, else from the ascii streamflow_<lat>_<lon>.
+ *            The program stops if the ascii file is newer than the
+ *            .bin file, e.g. rewritten by
+ *            routing.subtract.water.used.for.irrigation after a
+ *            routing run with OUTPUT_FORMAT BOTH.
 
-gcc -lm -Wall ../programs/C/metdata.modify.runoff.c
+gcc -lm -Wall -I../models/rout ../programs/C/metdata.modify.runoff.c ../models/rout/RoutBinary.c
 
 
 */
@@ -41,6 +48,7 @@ gcc -lm -Wall ../programs/C/metdata.modify.runoff.c
 #include <float.h>
 #include <math.h>
 #include <string.h>
+#include "routbin.h"
 
 #define EPS 1e-7		/* precision */
 #define SOILCOLS 56
@@ -84,6 +92,7 @@ void ReadStreamflow(char rundir[400],char upstreamfile[400],double **STREAMFLOW,
 		    float lat,float lon,int ndays);
 void ReadReservoirRouted(char rundir[400],double **ROUTED,int basin,int cell,
 			 float latitude,float longitude,int ndays);
+float *ReadRoutedBinary(char file[400],double **DATES,int ndays);
 void ReadSoil(char soilfile[400],float *lat,float *lon,int *cell);
 void FindPointsToExtractWaterFrom(char extractfile[400],float LL[25][5],
 				  float lat,float lon,int *count);
@@ -387,13 +396,20 @@ void ReadReservoirRouted(char routdir[400],
   int i;
   char file[400];
   char LATLONG[150];
+  float *flow;
 
   /* Make filename */
   strcpy(file,routdir);
   sprintf(LATLONG,"streamflow_%.4f_%.4f",latitude,longitude);
   strcat(file,LATLONG);
 
-  if((fp = fopen(file,"r"))==NULL){ 
+  if((flow = ReadRoutedBinary(file,ROUTED,ndays)) != NULL) {
+    printf("\tRouted file (i.e. from reservoir) read: %s.bin \n",file);
+    for(i=0;i<ndays;i++) 
+      ROUTED[i][3]=flow[i];
+    free(flow);
+  }
+  else if((fp = fopen(file,"r"))==NULL){ 
     for(i=0;i<ndays;i++) 
       ROUTED[i][0]=ROUTED[i][1]=ROUTED[i][2]=ROUTED[i][3]=0.;
     printf("\tReadRouted file not found, %s, setting numbers to 0\n",file);
@@ -425,6 +441,7 @@ void ReadStreamflow(char rundir[400],
   int i,j,ncells;
   char file[400];
   char CELLNR[50];
+  float *flow;
 
 
   /* Open and read streamflow of upstream cells */
@@ -442,6 +459,13 @@ void ReadStreamflow(char rundir[400],
       strcpy(file,rundir);
       sprintf(CELLNR,"streamflow_%.4f_%.4f",LL[i][0],LL[i][1]);
       strcat(file,CELLNR);
+      if((flow = ReadRoutedBinary(file,STREAMFLOW,ndays)) != NULL) {
+	  printf("File read: %s.bin \n",file);
+	  for(j=0;j<ndays;j++) 
+	      if(flow[j]>0.5) STREAMFLOW[j][3]+=flow[j]-0.49;
+	  free(flow);
+	  continue;
+      }
       if((fp = fopen(file,"r"))==NULL){ 
 	  printf("Cannot open file %s \n",file);exit(0);} 
       else printf("File opened: %s \n",file);
@@ -457,6 +481,55 @@ void ReadStreamflow(char rundir[400],
   fclose(fup); 
 }
 
+/*************************************************************************/
+/*                 ReadRoutedBinary                                      */
+/*************************************************************************/
+/* Reads the first ndays of <file>.bin, the binary version of the routed
+   streamflow file <file>. Fills year, month and day (columns 0-2 of
+   DATES) and returns the streamflow (m3/s, to be freed by the caller),
+   or NULL if there is no binary file. Stops if the ascii file was
+   modified after the binary file (see RoutBinaryStale()), since the
+   two no longer hold the same streamflow. */
+float *ReadRoutedBinary(char file[400],
+			double **DATES,
+			int ndays)
+{
+  ROUTBIN *rb;
+  char binfile[410];
+  float *flow;
+  int year,month,day;
+  int i;
+
+  sprintf(binfile,"%s.bin",file);
+  if((rb = OpenRoutBinaryRead(binfile)) == NULL)
+    return NULL;
+  if(RoutBinaryStale(binfile,file)) {
+    printf("Routed file %s is older than %s, which was modified after routing.\n",binfile,file);
+    printf("Route with OUTPUT_FORMAT ASCII, or remove %s.\n",binfile);
+    exit(1);
+  }
+
+  if(rb->header.step != ROUTBIN_DAILY || rb->header.nrecs < ndays) {
+    printf("Routed file %s does not cover the %d days simulated\n",binfile,ndays);
+    exit(0);
+  }
+  flow = (float*)calloc(ndays,sizeof(float));
+  ReadRoutBinary(rb,ROUTBIN_FLOW,0,ndays,flow);
+
+  year = rb->header.start_year;
+  month = rb->header.start_month;
+  day = rb->header.start_day;
+  for(i=0;i<ndays;i++) {
+    if(i>0) RoutBinaryNextDate(ROUTBIN_DAILY,&year,&month,&day);
+    DATES[i][0]=year;
+    DATES[i][1]=month;
+    DATES[i][2]=day;
+  }
+  CloseRoutBinary(rb);
+
+  return flow;
+}
+
 /*************************************************************************/
 /*                 ReadSoil                                              */
 /*************************************************************************/